@@ -4,12 +4,25 @@
 #include "atomics/data/RadicalData.hpp"
 #include "data/def/Object.hpp"
 
+#include <string_view>
+
 class AtomRepository
 {
 private:
     using ContainerT = std::unordered_map<Symbol, std::unique_ptr<AtomBaseData>>;
     ContainerT atoms;
 
+    // Definitions indexed by the id of their interned symbol.
+    std::vector<const AtomBaseData*> symbolIndex;
+
+    // Direct-index table of the symbols made of a letter, optionally followed by a lowercase letter.
+    // These cover all of the symbols which can be used outside of brackets in SMILES.
+    static constexpr size_t          ShortSymbolCount = 52 * 27;
+    std::vector<const AtomBaseData*> shortSymbols     = std::vector<const AtomBaseData*>(ShortSymbolCount, nullptr);
+
+    static size_t getShortSymbolIdx(const std::string_view symbol);
+    void          indexSymbol(const AtomBaseData& data);
+
 public:
     AtomRepository()                      = default;
     AtomRepository(const AtomRepository&) = delete;
@@ -18,12 +31,27 @@ public:
     template <typename AtomT>
     bool add(const def::Object& definition);
 
+    /// <summary>
+    /// Complexity: O(1), definitions are indexed by symbol id
+    /// </summary>
     const AtomBaseData* find(const Symbol& symbol) const;
     bool                contains(const Symbol& symbol) const;
     const AtomBaseData& at(const Symbol& symbol) const;
 
+    /// <summary>
+    /// Same as find(), but without having to build a Symbol. Short symbols are resolved through a direct-index
+    /// table, longer ones through the symbol table, without interning unknown symbols.
+    /// Complexity: O(1) for symbols of up to two letters, otherwise O(n) in the length of the symbol
+    /// </summary>
+    const AtomBaseData* findSymbol(const std::string_view symbol) const;
+
     size_t totalDefinitionCount() const;
 
+    /// <summary>
+    /// Returns the approximate memory used by the repository and its definitions, in bytes.
+    /// </summary>
+    size_t getMemoryUsage() const;
+
     using Iterator = ContainerT::const_iterator;
     Iterator begin() const;
     Iterator end() const;
@@ -3,6 +3,7 @@
 #include "atomics/Bond.hpp"
 #include "atomics/kinds/Atom.hpp"
 #include "global/SizeTypedefs.hpp"
+#include "utils/Memory.hpp"
 
 #include <memory>
 #include <vector>
@@ -24,8 +25,9 @@ public:
 
     bool isSame(const BondedAtomBase& other) const;
 
-    virtual const AtomBase&                 getAtom() const = 0;
-    virtual std::unique_ptr<BondedAtomBase> clone() const   = 0;
+    virtual const AtomBase&                 getAtom() const        = 0;
+    virtual std::unique_ptr<BondedAtomBase> clone() const          = 0;
+    virtual size_t                          getMemoryUsage() const = 0;
 
     const Bond* getBondTo(const BondedAtomBase& other) const;
 
@@ -33,6 +35,8 @@ public:
 
     static std::unique_ptr<BondedAtomBase> create(const Symbol& symbol, const c_size index, std::vector<Bond>&& bonds);
     static std::unique_ptr<BondedAtomBase> create(const AtomBase& atom, const c_size index, std::vector<Bond>&& bonds);
+    static std::unique_ptr<BondedAtomBase>
+    create(const AtomBaseData& data, const c_size index, std::vector<Bond>&& bonds);
 };
 
 template <typename AtomT>
@@ -50,6 +54,7 @@ public:
 
     const AtomT&                    getAtom() const override final;
     std::unique_ptr<BondedAtomBase> clone() const override final;
+    size_t                          getMemoryUsage() const override final;
 };
 
 template <typename AtomT>
@@ -69,3 +74,9 @@ std::unique_ptr<BondedAtomBase> BondedAtom<AtomT>::clone() const
 {
     return std::make_unique<BondedAtom<AtomT>>(this->atom, index, utils::copy(this->bonds));
 }
+
+template <typename AtomT>
+size_t BondedAtom<AtomT>::getMemoryUsage() const
+{
+    return sizeof(*this) + utils::getHeapUsage(bonds);
+}
@@ -14,6 +14,11 @@ public:
 protected:
     AtomBaseData(Symbol&& symbol, std::string&& name, const Amount<Unit::GRAM_PER_MOLE> weight) noexcept;
 
+    /// <summary>
+    /// Returns the approximate heap memory owned by the common members, in bytes.
+    /// </summary>
+    size_t getHeapUsage() const;
+
 public:
     AtomBaseData(const AtomBaseData&) = delete;
     AtomBaseData(AtomBaseData&&)      = default;
@@ -29,6 +34,11 @@ public:
 
     virtual uint8_t getPrecedence() const = 0;
 
+    /// <summary>
+    /// Returns the approximate memory used by this definition, in bytes.
+    /// </summary>
+    virtual size_t getMemoryUsage() const = 0;
+
     virtual void dumpDefinition(std::ostream& out, const bool prettify) const = 0;
     void         print(std::ostream& out = std::cout) const;
 
@@ -23,6 +23,8 @@ public:
 
     uint8_t getPrecedence() const override final;
 
+    size_t getMemoryUsage() const override final;
+
     void dumpDefinition(std::ostream& out, const bool prettify) const override final;
 
     static const uint8_t NullValence = static_cast<uint8_t>(-1);
@@ -26,6 +26,8 @@ public:
 
     uint8_t getPrecedence() const override final;
 
+    size_t getMemoryUsage() const override final;
+
     void dumpDefinition(std::ostream& out, const bool prettify) const override final;
 
     static const ImmutableSet<uint8_t> AnyValence;
@@ -17,4 +17,5 @@ public:
     bool matches(const AtomBase& other) const override final;
 
     static std::optional<Atom> fromSymbol(const Symbol& symbol);
+    static std::optional<Atom> fromData(const AtomBaseData& data);
 };
@@ -4,6 +4,8 @@
 #include "data/Accessor.hpp"
 #include "structs/Cloneable.hpp"
 
+#include <string_view>
+
 class AtomBase : public Accessor<>,
                  public CloneableBase<AtomBase>
 {
@@ -27,5 +29,8 @@ public:
     bool         equals(const AtomBase& other) const;
     virtual bool matches(const AtomBase& other) const = 0;
 
-    static bool isDefined(const Symbol& symbol);
+    /// <summary>
+    /// Unlike building a Symbol, the lookup never interns the given string, so it can be used on untrusted input.
+    /// </summary>
+    static bool isDefined(const std::string_view symbol);
 };
@@ -17,4 +17,5 @@ public:
     bool matches(const AtomBase& other) const override final;
 
     static std::optional<Radical> fromSymbol(const Symbol& symbol);
+    static std::optional<Radical> fromData(const AtomBaseData& data);
 };
@@ -3,13 +3,25 @@
 #include "atomics/AtomRepository.hpp"
 #include "data/FileStore.hpp"
 #include "data/OutlineDefRepository.hpp"
+#include "data/Predefined.hpp"
 #include "estimators/EstimatorRepository.hpp"
 #include "labware/LabwareRepository.hpp"
 #include "molecules/MoleculeRepository.hpp"
 #include "reactions/ReactionRepository.hpp"
 
+/// <summary>
+/// Holds all the loaded definitions. Once frozen, the store rejects new definitions and can be shared by
+/// simulations running on multiple threads, as the molecules and estimators discovered at runtime are
+/// added to synchronized overlays.
+/// </summary>
 class DataStore
 {
+private:
+    bool                      frozen = false;
+    std::optional<Predefined> predefined;
+
+    void updatePredefined();
+
 public:
     FileStore fileStore;
 
@@ -19,8 +31,8 @@ public:
 
     EstimatorRepository estimators;
 
-    mutable MoleculeRepository molecules;
-    ReactionRepository         reactions;
+    MoleculeRepository molecules;
+    ReactionRepository reactions;
 
     LabwareRepository labware;
 
@@ -30,6 +42,31 @@ public:
 
     size_t totalDefinitionCount() const;
 
+    /// <summary>
+    /// Returns the approximate memory used by all the repositories, in bytes.
+    /// The figures are estimated from container sizes and capacities, allocator overhead and
+    /// texture memory are not included.
+    /// </summary>
+    size_t getMemoryUsage() const;
+
+    /// <summary>
+    /// Returns a hash of the definitions which runtime state depends on (atoms, reactions and labware), used to
+    /// check if persisted state was created using the same definitions.
+    /// Molecules are excluded since they are discovered at runtime.
+    /// </summary>
+    uint64_t getFingerprint() const;
+
+    /// <summary>
+    /// Marks the store as fully loaded.
+    /// </summary>
+    void freeze();
+    bool isFrozen() const;
+
+    /// <summary>
+    /// Returns the commonly used atoms, which must have been defined.
+    /// </summary>
+    const Predefined& getPredefined() const;
+
     bool addDefinition(def::Object&& definition);
 
     bool load(const std::string& path);
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <atomic>
+
 class DataStore;
 
+/// <summary>
+/// Shared link to a DataStore. The link itself is atomic, so a frozen store can be accessed from multiple
+/// threads through the same accessor.
+/// </summary>
 class DataStoreAccessor
 {
 private:
-    const DataStore* dataStore = nullptr;
+    std::atomic<const DataStore*> dataStore = nullptr;
 
 public:
     DataStoreAccessor() = default;
@@ -27,6 +27,11 @@ public:
 
     const std::unordered_map<std::string, bool>& getHistory() const;
 
+    /// <summary>
+    /// Returns the approximate memory used by the store, in bytes.
+    /// </summary>
+    size_t getMemoryUsage() const;
+
     void clear();
 
     ParseStatus getFileStatus(const std::string& filePath) const;
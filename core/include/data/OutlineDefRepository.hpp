@@ -27,5 +27,10 @@ public:
 
     size_t totalDefinitionCount() const;
 
+    /// <summary>
+    /// Returns the approximate memory used by the repository and its definitions, in bytes.
+    /// </summary>
+    size_t getMemoryUsage() const;
+
     void clear();
 };
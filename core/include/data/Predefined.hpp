@@ -2,6 +2,12 @@
 
 #include "atomics/kinds/Atom.hpp"
 
+class AtomRepository;
+
+/// <summary>
+/// Commonly used atoms, resolved once by the current data store when they are defined and reset when the store is
+/// cleared.
+/// </summary>
 class Predefined
 {
 public:
@@ -9,8 +15,10 @@ public:
     const Atom Carbon;
 
 private:
-    Predefined() noexcept;
+    Predefined(const AtomRepository& atoms) noexcept;
 
 public:
     static const Predefined& get();
+
+    friend class DataStore;
 };
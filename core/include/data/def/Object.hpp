@@ -60,6 +60,16 @@ public:
 
     void logUnusedWarnings() const;
 
+    /// <summary>
+    /// Returns the approximate memory used by this definition and its inline sub-definitions, in bytes.
+    /// </summary>
+    size_t getMemoryUsage() const;
+
+    /// <summary>
+    /// Sets or replaces the property with the given key.
+    /// </summary>
+    void setProperty(const std::string_view key, std::string&& value);
+
     /// <summary>
     /// Extracts and returns the property with the given key.
     /// If the property isn't found, an error message is logged.
@@ -3,26 +3,47 @@
 #include "data/def/Parsers.hpp"
 #include "data/def/Printers.hpp"
 
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 
+/// <summary>
+/// Interned symbol: each distinct string gets a dense id when first used, the string being stored once in a
+/// global table. Comparisons and hashing only use the id.
+/// </summary>
 class Symbol
 {
-private:
-    const std::string symbol;
-
 public:
+    using IdT   = uint16_t;
     using SizeT = uint8_t;
 
-    Symbol(const std::string& str) noexcept;
-    Symbol(std::string&& str) noexcept;
+private:
+    const IdT id;
+
+    struct InternedTag
+    {};
+
+    Symbol(const IdT id, InternedTag) noexcept;
+
+public:
+    /// <summary>
+    /// Interns the string, which is then never removed. Use find() for strings which might not be symbols.
+    /// </summary>
+    explicit Symbol(const std::string& str) noexcept;
+    explicit Symbol(std::string&& str) noexcept;
     Symbol(const char chr) noexcept;
     Symbol(const char* str) noexcept;
 
     Symbol(const Symbol&) = default;
     Symbol(Symbol&&)      = default;
 
+    /// <summary>
+    /// Complexity: O(1), the string is owned by the global table
+    /// </summary>
     const std::string& str() const;
 
+    IdT   getId() const;
     SizeT size() const;
 
     bool operator==(const Symbol& other) const;
@@ -30,9 +51,18 @@ public:
     bool operator==(const std::string& other) const;
     bool operator!=(const std::string& other) const;
 
-    friend std::ostream& operator<<(std::ostream& out, const Symbol& obj);
+    /// <summary>
+    /// Returns the symbol of the given string, if the string was already interned.
+    /// Unlike the constructors, it never adds the string to the table.
+    /// </summary>
+    static std::optional<Symbol> find(const std::string_view str);
 
-    friend struct std::hash<Symbol>;
+    /// <summary>
+    /// Returns the number of interned symbols, all ids are smaller than this value.
+    /// </summary>
+    static size_t getInternedCount();
+
+    friend std::ostream& operator<<(std::ostream& out, const Symbol& obj);
 };
 
 //
@@ -42,7 +72,7 @@ public:
 template <>
 struct std::hash<Symbol>
 {
-    size_t operator()(const Symbol& s) const noexcept { return std::hash<std::string>()(s.symbol); }
+    size_t operator()(const Symbol& s) const noexcept { return s.getId(); }
 };
 
 template <>
@@ -3,22 +3,36 @@
 #include "estimators/kinds/EstimatorBase.hpp"
 
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 
+/// <summary>
+/// Repository of the estimators, equivalent estimators are only stored once.
+/// Once frozen, the existing estimators are read without locking and new estimators are added to a
+/// synchronized append-only overlay, so that the repository can be shared between threads.
+/// </summary>
 class EstimatorRepository
 {
 private:
-    uint16_t                                                              maxEstimatorNesting = 0;
-    std::unordered_map<EstimatorId, std::unique_ptr<const EstimatorBase>> estimators;
+    using EstimatorMap = std::unordered_map<EstimatorId, std::unique_ptr<const EstimatorBase>>;
 
-    EstimatorId getFreeId() const;
+    uint16_t     maxEstimatorNesting = 0;
+    EstimatorId  nextId              = 0;
+    bool         frozen              = false;
+    EstimatorMap estimators;
+
+    mutable std::shared_mutex overlayMutex;
+    EstimatorMap              overlay;
+
+    const EstimatorBase* findEquivalent(const EstimatorMap& map, const EstimatorBase& estimator) const;
 
     const EstimatorBase& add(std::unique_ptr<const EstimatorBase>&& estimator);
 
 public:
-    EstimatorRepository()                           = default;
+    EstimatorRepository() = default;
     EstimatorRepository(const EstimatorRepository&) = delete;
-    EstimatorRepository(EstimatorRepository&&)      = default;
+    EstimatorRepository(EstimatorRepository&& other) noexcept;
     ~EstimatorRepository() noexcept;
 
     /// <summary>
@@ -27,6 +41,15 @@ public:
     template <typename EstT, typename... Args>
     CountedRef<const EstT> add(Args&&... args);
 
+    /// <summary>
+    /// Redirects all the following additions to the synchronized overlay.
+    /// </summary>
+    void freeze();
+    bool isFrozen() const;
+
+    /// <summary>
+    /// Drops the unreferenced estimators. Not synchronized.
+    /// </summary>
     void dropUnusedEstimators();
 
     bool                 contains(const EstimatorId id) const;
@@ -34,7 +57,15 @@ public:
 
     size_t totalDefinitionCount() const;
 
-    using Iterator = std::unordered_map<EstimatorId, std::unique_ptr<const EstimatorBase>>::const_iterator;
+    /// <summary>
+    /// Returns the approximate memory used by the repository and its estimators, in bytes.
+    /// </summary>
+    size_t getMemoryUsage() const;
+
+    /// <summary>
+    /// Iterates over the estimators added before the repository was frozen.
+    /// </summary>
+    using Iterator = EstimatorMap::const_iterator;
     Iterator begin() const;
     Iterator end() const;
 
@@ -47,6 +78,10 @@ CountedRef<const EstT> EstimatorRepository::add(Args&&... args)
     static_assert(
         std::is_base_of_v<EstimatorBase, EstT>, "EstimatorRepository: EstT must be an EstimatorBase derived type.");
 
-    const auto id = getFreeId();
-    return static_cast<const EstT&>(add(std::make_unique<EstT>(id, std::forward<Args>(args)...)));
+    if (not frozen)
+        return static_cast<const EstT&>(add(std::make_unique<EstT>(nextId, std::forward<Args>(args)...)));
+
+    // The id is only consumed if the estimator is actually inserted, so it must not change in between.
+    std::unique_lock lock(overlayMutex);
+    return static_cast<const EstT&>(add(std::make_unique<EstT>(nextId, std::forward<Args>(args)...)));
 }
@@ -28,6 +28,8 @@ public:
     bool isEquivalent(const EstimatorBase& other, const float_s epsilon = std::numeric_limits<float_s>::epsilon())
         const override final;
 
+    size_t getMemoryUsage() const override final;
+
     void dumpDefinition(
         std::ostream&                    out,
         const bool                       prettify,
@@ -68,6 +70,12 @@ bool AffineEstimator<OutU, InU>::isEquivalent(const EstimatorBase& other, const
            Base::isEquivalent(oth, epsilon);
 }
 
+template <Unit OutU, Unit InU>
+size_t AffineEstimator<OutU, InU>::getMemoryUsage() const
+{
+    return sizeof(*this);
+}
+
 template <Unit OutU, Unit InU>
 void AffineEstimator<OutU, InU>::dumpDefinition(
     std::ostream&                    out,
@@ -19,6 +19,8 @@ public:
     bool isEquivalent(const EstimatorBase& other, const float_s epsilon = std::numeric_limits<float_s>::epsilon())
         const override final;
 
+    size_t getMemoryUsage() const override final;
+
     void dumpDefinition(
         std::ostream&                    out,
         const bool                       prettify,
@@ -49,6 +51,12 @@ bool ConstantEstimator<OutU, InUs...>::isEquivalent(const EstimatorBase& other,
     return this->constant.equals(oth.constant, epsilon);
 }
 
+template <Unit OutU, Unit... InUs>
+size_t ConstantEstimator<OutU, InUs...>::getMemoryUsage() const
+{
+    return sizeof(*this);
+}
+
 template <Unit OutU, Unit... InUs>
 void ConstantEstimator<OutU, InUs...>::dumpDefinition(
     std::ostream&                    out,
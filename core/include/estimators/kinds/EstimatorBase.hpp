@@ -28,6 +28,12 @@ public:
 
     virtual uint16_t getNestingDepth() const;
 
+    /// <summary>
+    /// Returns the approximate memory used by this estimator, in bytes.
+    /// Referenced base estimators are not included, since they are owned by the repository.
+    /// </summary>
+    virtual size_t getMemoryUsage() const = 0;
+
     virtual void dumpDefinition(
         std::ostream&                    out,
         const bool                       prettify,
@@ -30,6 +30,8 @@ public:
     bool isEquivalent(const EstimatorBase& other, const float_s epsilon = std::numeric_limits<float_s>::epsilon())
         const override final;
 
+    size_t getMemoryUsage() const override final;
+
     void dumpDefinition(
         std::ostream&                    out,
         const bool                       prettify,
@@ -72,6 +74,12 @@ bool RegressionEstimator<RegT, OutU, InUs...>::isEquivalent(const EstimatorBase&
     return this->regressor.isEquivalent(oth.regressor, epsilon);
 }
 
+template <typename RegT, Unit OutU, Unit... InUs>
+size_t RegressionEstimator<RegT, OutU, InUs...>::getMemoryUsage() const
+{
+    return sizeof(*this);
+}
+
 template <typename RegT, Unit OutU, Unit... InUs>
 void RegressionEstimator<RegT, OutU, InUs...>::dumpDefinition(
     std::ostream&                    out,
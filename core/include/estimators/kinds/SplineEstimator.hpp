@@ -4,6 +4,7 @@
 #include "estimators/EstimationMode.hpp"
 #include "estimators/kinds/UnitizedEstimator.hpp"
 #include "structs/Spline.hpp"
+#include "utils/Memory.hpp"
 
 template <Unit OutU, Unit InU>
 class SplineEstimator : public UnitizedEstimator<OutU, InU>
@@ -26,6 +27,8 @@ public:
     bool isEquivalent(const EstimatorBase& other, const float_s epsilon = std::numeric_limits<float_s>::epsilon())
         const override final;
 
+    size_t getMemoryUsage() const override final;
+
     void dumpDefinition(
         std::ostream&                    out,
         const bool                       prettify,
@@ -70,6 +73,12 @@ bool SplineEstimator<OutU, InU>::isEquivalent(const EstimatorBase& other, const
     return this->spline.isEquivalent(oth.spline, epsilon);
 }
 
+template <Unit OutU, Unit InU>
+size_t SplineEstimator<OutU, InU>::getMemoryUsage() const
+{
+    return sizeof(*this) + utils::getHeapUsage(spline.getContent());
+}
+
 template <Unit OutU, Unit InU>
 void SplineEstimator<OutU, InU>::dumpDefinition(
     std::ostream&                    out,
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "data/values/Amount.hpp"
+#include "molecules/kinds/Molecule.hpp"
+#include "utils/Bin.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+class DataStore;
+
+namespace bin::details
+{
+
+template <Unit UnitT>
+class Formatter<Amount<UnitT>>
+{
+public:
+    static void print(std::ostream& os, const Amount<UnitT> amount) { bin::print(os, amount.asStd()); }
+
+    static std::optional<Amount<UnitT>> parse(std::istream& is)
+    {
+        const auto value = bin::parse<typename Amount<UnitT>::StorageType>(is);
+        return value ? std::optional(Amount<UnitT>(*value)) : std::nullopt;
+    }
+};
+
+}  // namespace bin::details
+
+/// <summary>
+/// Writes simulation state in the binary checkpoint format. The stream starts with a header holding the magic
+/// "CHGCKPT", the format version and the fingerprint of the data store, the rest being written by the
+/// checkpointed objects themselves, in the same order they are read back.
+/// Molecule ids depend on the order in which molecules are discovered, so molecules are written by their
+/// SMILES on first use and referenced by their index in the checkpoint afterwards.
+/// </summary>
+class CheckpointWriter
+{
+private:
+    std::ostream&                            os;
+    std::unordered_map<MoleculeId, uint32_t> moleculeIndices;
+
+public:
+    CheckpointWriter(std::ostream& os, const DataStore& dataStore) noexcept;
+    CheckpointWriter(const CheckpointWriter&) = delete;
+
+    bool isValid() const;
+
+    template <typename T>
+    void write(const T& value);
+    void write(const std::string& str);
+    void write(const Molecule& molecule);
+
+    static constexpr uint16_t Version = 1;
+};
+
+template <typename T>
+void CheckpointWriter::write(const T& value)
+{
+    bin::print(os, value);
+}
+
+/// <summary>
+/// Reads the checkpoints written by CheckpointWriter. Checkpoints written using different definitions can still
+/// be read, but definition dependent data (such as cached reactions) should be discarded and recomputed.
+/// </summary>
+class CheckpointReader
+{
+private:
+    std::istream&         is;
+    std::vector<Molecule> molecules;
+    bool                  validHeader     = false;
+    bool                  sameDefinitions = false;
+
+public:
+    CheckpointReader(std::istream& is, const DataStore& dataStore) noexcept;
+    CheckpointReader(const CheckpointReader&) = delete;
+
+    bool isValid() const;
+
+    /// <summary>
+    /// Returns true if the checkpoint was written using the same definitions as the ones currently loaded.
+    /// </summary>
+    bool hasSameDefinitions() const;
+
+    /// <summary>
+    /// Returns true if the whole checkpoint was read.
+    /// </summary>
+    bool isAtEnd() const;
+
+    template <typename T>
+    std::optional<T>           read();
+    /// <summary>
+    /// Strings longer than MaxStringSize are rejected, and strings are read in chunks so that the allocated size
+    /// never exceeds what the stream actually holds.
+    /// </summary>
+    std::optional<std::string> readString();
+    std::optional<Molecule>    readMolecule();
+
+    static constexpr uint32_t MaxStringSize = 1 << 20;
+};
+
+template <typename T>
+std::optional<T> CheckpointReader::read()
+{
+    return bin::parse<T>(is);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+
+/// <summary>
+/// Read-only memory mapping of a whole file. The mapped bytes are paged in by the OS on first access and stay
+/// valid, at the same address, until the mapping is destroyed.
+/// </summary>
+class MappedFile
+{
+private:
+    const char* data = nullptr;
+    size_t      size = 0;
+
+    MappedFile(const char* data, const size_t size) noexcept;
+
+public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    ~MappedFile() noexcept;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    std::span<const char> getBytes() const;
+
+    static std::optional<MappedFile> open(const std::string& path);
+};
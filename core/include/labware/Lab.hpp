@@ -4,6 +4,10 @@
 #include "mixtures/kinds/Atmosphere.hpp"
 
 #include <SFML/Graphics/Drawable.hpp>
+#include <iosfwd>
+
+class CheckpointWriter;
+class CheckpointReader;
 
 class Lab : public sf::Drawable
 {
@@ -23,6 +27,12 @@ public:
     template <typename CompT, typename... Args>
     CompT& add(Args&&... args);
 
+    /// <summary>
+    /// Adds a component of the kind given by the type of its labware definition. Returns nullptr if the
+    /// labware is undefined or its type has no component kind.
+    /// </summary>
+    LabwareComponentBase* addComponent(const LabwareId id);
+
     void removeEmptySystems();
 
     size_t               getSystemCount() const;
@@ -35,7 +45,22 @@ public:
     std::pair<size_t, l_size> getSystemComponentAt(const sf::Vector2f& point) const;
     size_t                    anyIntersects(const size_t targetIdx) const;
 
+    /// <summary>
+    /// Returns the system and component indices of the given component, or npos if it's not part of the lab.
+    /// Complexity: O(n)
+    /// </summary>
+    std::pair<size_t, l_size> findComponent(const LabwareComponentBase& component) const;
+
     bool tryConnect(const size_t targetIdx, const float_s maxSqDistance);
+    /// <summary>
+    /// Connects the source component on the specified port to the destination component, merging their
+    /// systems. Empty systems resulted from the merge are removed.
+    /// </summary>
+    bool tryConnect(
+        const LabwareComponentBase& destination,
+        const uint8_t               destinationPort,
+        const LabwareComponentBase& source,
+        const uint8_t               sourcePort);
     bool tryDisconnect(const sf::Vector2f& point);
 
     using LabSystemsConstIterator = std::vector<LabwareSystem>::const_iterator;
@@ -48,6 +73,20 @@ public:
 
     void tick(const Amount<Unit::SECOND> timespan);
 
+    void toCheckpoint(CheckpointWriter& writer) const;
+    void toCheckpoint(std::ostream& os) const;
+    bool toCheckpointFile(const std::string& path) const;
+
+    /// <summary>
+    /// Loads the atmosphere and the labware from the checkpoint. If the lab already holds the same labware
+    /// (same systems, holding the same components in the same order), only the states of the components are
+    /// replaced, so references to them remain valid. Otherwise, the labware is rebuilt.
+    /// On failure, the lab might be partially loaded.
+    /// </summary>
+    bool loadFromCheckpoint(CheckpointReader& reader);
+    bool loadFromCheckpoint(std::istream& is);
+    bool loadCheckpointFile(const std::string& path);
+
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override final;
 
     static constexpr const size_t npos = static_cast<size_t>(-1);
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "io/Checkpoint.hpp"
+#include "labware/Lab.hpp"
+
+#include <optional>
+
+class BaseContainerComponent;
+
+/// <summary>
+/// The kinds of externally applied inputs which can be recorded.
+/// </summary>
+enum class LabInput : uint8_t
+{
+    TICK,
+    TIME_MULTIPLIER,
+    ADD,
+    ADD_ENERGY,
+    MOVE,
+    ROTATE,
+    CONNECT,
+    DISCONNECT,
+    REMOVE_EMPTY_SYSTEMS
+};
+
+/// <summary>
+/// Applies external inputs to a lab, optionally recording them.
+/// A recording is a checkpoint holding the initial state of the lab, followed by the inputs in the order they
+/// were applied. Components are addressed by their system and component indices at the time of the input,
+/// which remain valid during replays since the lab goes through the exact same changes.
+/// Tick timespans are recorded before being scaled by the time multiplier, as measured by the caller.
+/// </summary>
+class LabRecorder
+{
+private:
+    Lab&                            lab;
+    std::optional<CheckpointWriter> writer;
+    float_s                         timeMultiplier = 1.0f;
+    size_t                          inputCount     = 0;
+
+    void record(const LabInput input);
+
+    BaseContainerComponent* getContainer(const size_t systemIdx, const l_size componentIdx);
+
+public:
+    /// <summary>
+    /// Creates a recorder which only applies the inputs.
+    /// </summary>
+    LabRecorder(Lab& lab) noexcept;
+    LabRecorder(Lab& lab, std::ostream& os) noexcept;
+    LabRecorder(const LabRecorder&) = delete;
+
+    bool isRecording() const;
+
+    /// <summary>
+    /// Returns false if recording was requested and writing the recording failed.
+    /// </summary>
+    bool isValid() const;
+
+    size_t getInputCount() const;
+
+    const Lab& getLab() const;
+    Lab&       getLab();
+
+    float_s getTimeMultiplier() const;
+    void    setTimeMultiplier(const float_s multiplier);
+
+    void tick(const Amount<Unit::SECOND> timespan);
+
+    bool add(
+        const size_t             systemIdx,
+        const l_size             componentIdx,
+        const Molecule&          molecule,
+        const Amount<Unit::MOLE> amount);
+    bool addEnergy(const size_t systemIdx, const l_size componentIdx, const Amount<Unit::JOULE> energy);
+
+    void move(const size_t systemIdx, const sf::Vector2f& offset);
+    void rotate(const size_t systemIdx, const Amount<Unit::DEGREE> angle);
+
+    bool tryConnect(const size_t systemIdx, const float_s maxSqDistance);
+    bool tryDisconnect(const sf::Vector2f& point);
+    void removeEmptySystems();
+};
+
+/// <summary>
+/// Replays the inputs recorded by a LabRecorder onto a lab, headlessly and independently of real time.
+/// </summary>
+class LabReplayer
+{
+private:
+    CheckpointReader reader;
+    LabRecorder      target;
+    bool             failed    = false;
+    size_t           tickCount = 0;
+
+    bool replayInput(const LabInput input);
+
+public:
+    /// <summary>
+    /// Loads the initial state of the recording into the given lab.
+    /// </summary>
+    LabReplayer(std::istream& is, Lab& lab) noexcept;
+    LabReplayer(const LabReplayer&) = delete;
+
+    /// <summary>
+    /// Returns false if the recording couldn't be loaded or replaying an input failed.
+    /// </summary>
+    bool isValid() const;
+    bool isAtEnd() const;
+
+    size_t getTickCount() const;
+
+    const Lab& getLab() const;
+
+    /// <summary>
+    /// Replays the inputs up to and including the next tick. Returns false once the recording has ended or if
+    /// replaying it failed.
+    /// </summary>
+    bool replayTick();
+
+    /// <summary>
+    /// Replays all of the remaining inputs, returning false if replaying them failed.
+    /// </summary>
+    bool replay();
+};
@@ -29,6 +29,11 @@ public:
 
     size_t totalDefinitionCount() const;
 
+    /// <summary>
+    /// Returns the approximate memory used by the repository and its definitions, in bytes.
+    /// </summary>
+    size_t getMemoryUsage() const;
+
     using Iterator = std::unordered_map<LabwareId, std::unique_ptr<const BaseLabwareData>>::const_iterator;
     Iterator begin() const;
     Iterator end() const;
@@ -84,6 +84,13 @@ public:
     bool isFree(const l_size componentIdx, const uint8_t portIdx) const;
 
     l_size findFirst() const;
+    l_size find(const LabwareComponentBase& component) const;
+
+    /// <summary>
+    /// Returns the identifier of the given port of a component in this system, or an invalid
+    /// identifier if the component or the port doesn't exist.
+    /// </summary>
+    PortIdentifier getPort(const l_size componentIdx, const uint8_t portIdx);
 
     /// <summary>
     /// Finds the closest port to a given point and returns a pair of the port and the squared
@@ -113,8 +120,18 @@ public:
     /// </summary>
     std::vector<LabwareSystem> disconnect(const l_size componentIdx);
 
+    /// <summary>
+    /// Returns true if all of the components are sleeping.
+    /// </summary>
+    bool isSleeping() const;
     void tick(const Amount<Unit::SECOND> timespan);
 
+    /// <summary>
+    /// Writes the labware ids, positions and connections of the components. Their states are written
+    /// separately, by the lab, so that the layout of the whole lab is known before loading any state.
+    /// </summary>
+    void toCheckpoint(CheckpointWriter& writer) const;
+
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override final;
 
     static constexpr const l_size npos = static_cast<l_size>(-1);
@@ -13,5 +13,7 @@ public:
         const std::string&         textureFile,
         const float_s              textureScale) noexcept;
 
+    size_t getMemoryUsage() const override final;
+
     void dumpCustomProperties(def::DataDumper& dump) const override final;
 };
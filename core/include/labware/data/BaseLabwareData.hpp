@@ -16,6 +16,12 @@ class BaseLabwareData
 private:
     virtual void dumpCustomProperties(def::DataDumper& dump) const = 0;
 
+protected:
+    /// <summary>
+    /// Returns the approximate heap memory owned by the common members, in bytes.
+    /// </summary>
+    size_t getHeapUsage() const;
+
 public:
     const LabwareId                id;
     const LabwareType              type;
@@ -28,6 +34,12 @@ public:
     BaseLabwareData(BaseLabwareData&&)      = default;
     virtual ~BaseLabwareData()              = default;
 
+    /// <summary>
+    /// Returns the approximate memory used by this definition, in bytes.
+    /// Texture memory is not included, since it is mostly owned by the graphics driver.
+    /// </summary>
+    virtual size_t getMemoryUsage() const = 0;
+
     void         dumpDefinition(std::ostream& out, const bool prettify) const;
     virtual void dumpTextures(const std::string& path) const = 0;
     void         print(std::ostream& out = std::cout) const;
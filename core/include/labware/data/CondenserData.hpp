@@ -20,5 +20,7 @@ public:
         const std::string&            coolantfillTextureFile,
         const float_s                 textureScale) noexcept;
 
+    size_t getMemoryUsage() const override final;
+
     void dumpCustomProperties(def::DataDumper& dump) const override final;
 };
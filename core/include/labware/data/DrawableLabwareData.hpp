@@ -15,6 +15,8 @@ protected:
         const float_s              textureScale,
         const LabwareType          type) noexcept;
 
+    size_t getHeapUsage() const;
+
 public:
     const float_s     textureScale;
     const std::string textureFile;
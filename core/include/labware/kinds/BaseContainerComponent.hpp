@@ -44,8 +44,8 @@ inline void BaseContainerComponent::draw<Reactor>(
 {
     float_s lastSection = 0.0f;
     for (auto l = container.getLayersUpBegin(); l != container.getLayersUpEnd(); ++l) {
-        const auto layerSection = (l->second.getVolume() / container.getMaxVolume()).asStd();
-        fill.setDrawSection(lastSection, lastSection + layerSection, utils::colorCast(l->second.getColor()));
+        const auto layerSection = (l->getVolume() / container.getMaxVolume()).asStd();
+        fill.setDrawSection(lastSection, lastSection + layerSection, utils::colorCast(l->getColor()));
         lastSection += layerSection;
 
         target.draw(fill, states);
@@ -53,7 +53,11 @@ public:
 
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
+    bool isSleeping() const override;
     void tick(const Amount<Unit::SECOND> timespan) override;
+
+    void toCheckpoint(CheckpointWriter& writer) const override final;
+    bool loadFromCheckpoint(CheckpointReader& reader) override final;
 };
 
 template <typename... Args>
@@ -203,8 +207,34 @@ void ContainerComponent<Args...>::draw(sf::RenderTarget& target, sf::RenderState
     DrawableComponent::draw(target, states);
 }
 
+template <typename... Args>
+bool ContainerComponent<Args...>::isSleeping() const
+{
+    // Only containers which can detect quiescence are allowed to sleep.
+    const auto isContainerSleeping = [](const auto& container) {
+        if constexpr (requires { container.isSleeping(); })
+            return container.isSleeping();
+        else
+            return false;
+    };
+    return std::apply(
+        [&isContainerSleeping](const auto&... c) { return (isContainerSleeping(c) && ...); }, containers);
+}
+
 template <typename... Args>
 void ContainerComponent<Args...>::tick(const Amount<Unit::SECOND> timespan)
 {
     std::apply([timespan](auto&... c) { (c.tick(timespan), ...); }, containers);
 }
+
+template <typename... Args>
+void ContainerComponent<Args...>::toCheckpoint(CheckpointWriter& writer) const
+{
+    std::apply([&writer](const auto&... c) { (c.toCheckpoint(writer), ...); }, containers);
+}
+
+template <typename... Args>
+bool ContainerComponent<Args...>::loadFromCheckpoint(CheckpointReader& reader)
+{
+    return std::apply([&reader](auto&... c) { return (c.loadFromCheckpoint(reader) && ...); }, containers);
+}
@@ -9,6 +9,7 @@ class Heatsource : public EquipmentComponent
 {
 private:
     Ref<ContainerBase> target;
+    Amount<Unit::WATT> powerOutput;
 
 public:
     Heatsource(const LabwareId id, Atmosphere& atmosphere) noexcept;
@@ -18,8 +19,18 @@ public:
     void setTarget(const Ref<ContainerBase> newTarget);
     void setTarget(BaseContainerComponent& newTarget);
 
+    Amount<Unit::WATT> getPowerOutput() const;
+    /// <summary>
+    /// Sets the power output, clamped to the [0, maxPowerOutput] range.
+    /// </summary>
+    void setPowerOutput(const Amount<Unit::WATT> power);
+
     bool tryConnect(LabwareComponentBase& other) override final;
     void disconnect(const Ref<ContainerBase> dump, const LabwareComponentBase& other) override final;
 
+    bool isSleeping() const override final;
     void tick(const Amount<Unit::SECOND> timespan) override final;
+
+    void toCheckpoint(CheckpointWriter& writer) const override final;
+    bool loadFromCheckpoint(CheckpointReader& reader) override final;
 };
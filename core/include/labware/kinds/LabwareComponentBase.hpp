@@ -9,6 +9,9 @@
 
 #include <SFML/Graphics.hpp>
 
+class CheckpointWriter;
+class CheckpointReader;
+
 class LabwareComponentBase : public Accessor<>,
                              public sf::Drawable
 {
@@ -51,8 +54,20 @@ public:
     virtual bool tryConnect(LabwareComponentBase& other);
     virtual void disconnect(const Ref<ContainerBase> dump, const LabwareComponentBase& other);
 
+    /// <summary>
+    /// Returns true if ticking the component would have no effect, in which case its ticks are skipped.
+    /// Components are awake by default and must opt in to sleeping.
+    /// </summary>
+    virtual bool isSleeping() const;
     virtual void tick(const Amount<Unit::SECOND> timespan);
 
+    /// <summary>
+    /// Writes the state of the component (such as its content), the position and connections being written
+    /// by the owning system.
+    /// </summary>
+    virtual void toCheckpoint(CheckpointWriter& writer) const;
+    virtual bool loadFromCheckpoint(CheckpointReader& reader);
+
     template <typename L, typename = std::enable_if<std::is_base_of_v<LabwareComponentBase, L>>>
     L& as();
     template <typename L, typename = std::enable_if<std::is_base_of_v<LabwareComponentBase, L>>>
@@ -11,6 +11,9 @@ template <LayerType L>
 class SingleLayerMixture;
 class MultiLayerMixture;
 class Reactor;
+class CheckpointWriter;
+class CheckpointReader;
+class MixtureTransaction;
 
 class Layer
 {
@@ -31,11 +34,15 @@ private:
     StateNucleator lowNucleator;
     StateNucleator highNucleator;
 
-    void findNewLowNucleator();
-    void findNewHighNucleator();
+    // The nucleators are searched using the amounts pending in the transaction.
+    void findNewLowNucleator(const MixtureTransaction& pending);
+    void findNewHighNucleator(const MixtureTransaction& pending);
 
-    void consumePositivePotentialEnergy();
-    void consumeNegativePotentialEnergy();
+    Amount<Unit::JOULE_PER_CELSIUS> getTotalHeatCapacity(const MixtureTransaction& pending) const;
+
+    // Phase changes are collected into the transaction. Returns true if the whole layer changed its state.
+    bool consumePositivePotentialEnergy(MixtureTransaction& transaction);
+    bool consumeNegativePotentialEnergy(MixtureTransaction& transaction);
 
     // Returns the least amount of energy required to react a target temperature.
     // More energy might be needed.
@@ -85,6 +92,14 @@ public:
 
     Layer makeCopy(const Ref<Mixture> newContainer) const;
 
+    void toCheckpoint(CheckpointWriter& writer) const;
+
+    /// <summary>
+    /// Loads the temperature, amounts and energy of the layer. The nucleators are unset, since they refer to the
+    /// previous content and have to be set again by the mixture once its content is loaded.
+    /// </summary>
+    bool loadFromCheckpoint(CheckpointReader& reader);
+
     template <LayerType L>
     friend class SingleLayerMixture;
     friend class MultiLayerMixture;
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "mixtures/LayerType.hpp"
+
+#include <optional>
+
+class Layer;
+
+/// <summary>
+/// Iterates over the layers stored by a MultiLayerMixture, either from the top down or from the bottom up,
+/// by scanning the bitmask of the existing layers.
+/// </summary>
+class LayerIterator
+{
+private:
+    const std::optional<Layer>* layers;
+    uint8_t                     mask;
+    const bool                  isDownward;
+
+    LayerIterator(const std::optional<Layer>* layers, const uint8_t mask, const bool isDownward) noexcept;
+
+    uint8_t getIndex() const;
+
+public:
+    LayerIterator(const LayerIterator&) = default;
+
+    const Layer&   operator*() const;
+    const Layer*   operator->() const;
+    LayerIterator& operator++();
+    bool           operator==(const LayerIterator& other) const;
+    bool           operator!=(const LayerIterator& other) const;
+
+    friend class MultiLayerMixture;
+};
@@ -3,6 +3,8 @@
 #include "mixtures/AggregationType.hpp"
 #include "utils/Math.hpp"
 
+#include <bit>
+
 enum class LayerType : uint8_t
 {
     NONE = 0,
@@ -37,7 +39,10 @@ static inline constexpr bool isLiquidLayer(const LayerType type)
 
 static inline constexpr bool isSolidLayer(const LayerType type) { return type == LayerType::SOLID; }
 
-static inline bool getLayerCount() { return toIndex(LayerType::LAST); }
+static inline constexpr uint8_t getLayerCount()
+{
+    return std::countr_zero(static_cast<uint8_t>(LayerType::LAST)) + 1;
+}
 
 AggregationType getAggregationType(const LayerType type);
 LayerType       getLowerAggregationLayer(const LayerType type);
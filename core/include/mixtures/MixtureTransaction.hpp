@@ -0,0 +1,52 @@
+#pragma once
+
+#include "reactions/Reactant.hpp"
+#include "reactions/ReactantSet.hpp"
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+class Mixture;
+
+/// <summary>
+/// Collects changes of the content and of the energy of a mixture and applies them in a single pass on commit.
+/// Changes of the same reactant or of the same layer energy are merged, so the derived quantities of the mixture
+/// (layer totals, nucleators, revision) are updated once per reactant instead of once per change.
+/// The mixture is left untouched until the transaction is committed.
+/// </summary>
+class MixtureTransaction
+{
+private:
+    Ref<Mixture> mixture;
+
+    std::vector<Reactant>                            reactants;
+    std::unordered_map<ReactantId, size_t>           reactantIndices;
+    std::array<Amount<Unit::JOULE>, getLayerCount()> heats;
+    uint8_t                                          heatMask = 0;
+
+public:
+    MixtureTransaction(const Ref<Mixture> mixture) noexcept;
+    MixtureTransaction(const MixtureTransaction&) = delete;
+    MixtureTransaction(MixtureTransaction&&)      = default;
+
+    void add(const Reactant& reactant);
+    void add(const Amount<Unit::JOULE> heat, const LayerType layer);
+
+    /// <summary>
+    /// Returns the amount the reactant will have after commit.
+    /// </summary>
+    Amount<Unit::MOLE> getAmountOf(const Reactant& reactant) const;
+    Amount<Unit::MOLE> getAmountOf(const ReactantSet& reactantSet) const;
+
+    bool isEmpty() const;
+
+    /// <summary>
+    /// Applies the collected changes to the mixture and clears the transaction.
+    /// </summary>
+    void commit();
+    void discard();
+
+    friend class Mixture;
+    friend class MultiLayerMixture;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "mixtures/kinds/Reactor.hpp"
+
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// Holds replicas of the same reactor, differing only in their state (such as amounts and energy), which are
+/// ticked together. The replicas share a single reaction cache and their explicit reactions are applied by a
+/// kernel working on structure-of-arrays state: every species touched by the cached reactions is a row, and so is
+/// every layer, holding one column for each replica. The rate law of each reaction is evaluated across all of the
+/// replicas in one loop, and the updates it does are contiguous loops over the replicas.
+/// The state persists across ticks, the column of a replica being gathered again only if its revision changed
+/// since the last sync, while the rows changed by the reactions are read back after being committed.
+/// Results are identical to ticking each replica on its own, as long as the replicas find the same reactions.
+/// Otherwise, all of them use the union of the found reactions, which can change the order in which the
+/// reactions are applied. Replicas using implicit kinetics are integrated separately.
+/// The replicas are ticked phase by phase, so they should not interact through a shared overflow target.
+/// </summary>
+class ReactorBatch
+{
+private:
+    std::vector<Reactor> replicas;
+
+    // Replicas due to run their explicit reactions in the current tick, with the timespan they're due for.
+    std::vector<uint8_t>              isDue;
+    std::vector<Amount<Unit::SECOND>> timespans;
+
+    // Species (SoA), the columns of species i are in: [i * replicaCount, (i + 1) * replicaCount).
+    std::vector<Reactant>                  species;
+    std::unordered_map<ReactantId, size_t> speciesIndices;
+    std::vector<Amount<Unit::MOLE>>        amounts;
+    std::vector<Amount<Unit::MOLE>>        deltas;
+    std::vector<uint8_t>                   isChanged;
+
+    // Layers (SoA), the columns of layer l are in: [l * replicaCount, (l + 1) * replicaCount).
+    std::vector<Amount<Unit::CELSIUS>> temperatures;
+    std::vector<Amount<Unit::JOULE>>   heats;
+
+    // Replicas (SoA).
+    std::vector<uint64_t>           syncedRevisions;
+    std::vector<Amount<Unit::MOLE>> totalMoles;
+    std::vector<uint8_t>            layerMasks;
+    std::vector<Amount<Unit::MOLE>> reactantAmounts;
+    std::vector<Amount<Unit::MOLE>> speedCoefficients;
+    std::vector<uint8_t>            isReacting;
+    std::vector<uint8_t>            heatMasks;
+
+    // The species changed in each replica, in the order of their first change.
+    std::vector<std::vector<size_t>> changeOrders;
+
+    static constexpr uint64_t NoRevision = std::numeric_limits<uint64_t>::max();
+
+    size_t getSpeciesIdx(const Reactant& reactant);
+
+    void syncLayers(const size_t replicaIdx);
+    /// <summary>
+    /// Gathers the state of the replica into its columns, unless it is unchanged since the last sync.
+    /// </summary>
+    void sync(const size_t replicaIdx);
+
+    /// <summary>
+    /// Makes all of the replicas share the same reaction cache, merging the reactions found by any of them.
+    /// </summary>
+    void shareReactionCache();
+
+    /// <summary>
+    /// Applies the explicit reactions of the due replicas, same as Reactor::runReactions().
+    /// </summary>
+    void runReactions();
+
+public:
+    ReactorBatch(const Reactor& prototype, const size_t replicaCount) noexcept;
+    ReactorBatch(const ReactorBatch&) = delete;
+    ReactorBatch(ReactorBatch&&)      = default;
+
+    size_t size() const;
+
+    const Reactor& getReplica(const size_t idx) const;
+    Reactor&       getReplica(const size_t idx);
+
+    void tick(const Amount<Unit::SECOND> timespan);
+};
@@ -3,12 +3,19 @@
 #include "ContainerBase.hpp"
 #include "data/values/Amount.hpp"
 
+#include <mutex>
+
+class CheckpointWriter;
+class CheckpointReader;
+
 /// <summary>
 /// Reactant container with no storage or properties. Just a dump for reactants.
+/// Dumps can be shared by simulations running on different threads, so the totals are guarded.
 /// </summary>
 class DumpContainer final : public ContainerBase
 {
 private:
+    mutable std::mutex  mutex;
     Amount<Unit::GRAM>  totalMass   = 0.0;
     Amount<Unit::JOULE> totalEnergy = 0.0;
 
@@ -19,5 +26,8 @@ public:
     Amount<Unit::GRAM>  getTotalMass() const;
     Amount<Unit::JOULE> getTotalEnergy() const;
 
+    void toCheckpoint(CheckpointWriter& writer) const;
+    bool loadFromCheckpoint(CheckpointReader& reader);
+
     static DumpContainer GlobalDumpContainer;
 };
@@ -34,4 +34,12 @@ public:
     void                               addRule(ForwardingRule rule);
     ForwardingRule                     getRule(const size_t idx) const;
     const std::vector<ForwardingRule>& getRules() const;
+
+    /// <summary>
+    /// Forwarding containers hold no state besides their rules, which refer to other containers and are
+    /// restored along with them. Only the number of rules is written, in order to check that the loading
+    /// container was set up the same way.
+    /// </summary>
+    void toCheckpoint(CheckpointWriter& writer) const;
+    bool loadFromCheckpoint(CheckpointReader& reader);
 };
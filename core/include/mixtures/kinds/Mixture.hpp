@@ -5,8 +5,13 @@
 #include "reactions/ReactantSet.hpp"
 #include "structs/Ref.hpp"
 
+#include <optional>
+
 class Layer;
 class Catalyst;
+class CheckpointWriter;
+class CheckpointReader;
+class MixtureTransaction;
 
 /// <summary>
 /// The simplest type of reactant container with internal storage.
@@ -22,6 +27,18 @@ protected:
 
     virtual LayerType findLayerFor(const Reactant& reactant) const = 0;
 
+    /// <summary>
+    /// Applies the merged changes of a committed transaction, reactants first.
+    /// </summary>
+    virtual void apply(const MixtureTransaction& transaction);
+
+    void contentToCheckpoint(CheckpointWriter& writer) const;
+
+    /// <summary>
+    /// Reads the content written by contentToCheckpoint(), without replacing the current content.
+    /// </summary>
+    std::optional<ReactantSet> loadContentFromCheckpoint(CheckpointReader& reader);
+
 public:
     Mixture()          = default;
     Mixture(Mixture&&) = default;
@@ -56,4 +73,5 @@ public:
     virtual void               setOverflowTarget(const Ref<ContainerBase> target) = 0;
 
     friend class Layer;
+    friend class MixtureTransaction;
 };
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "mixtures/Layer.hpp"
+#include "mixtures/LayerIterator.hpp"
 #include "mixtures/kinds/Atmosphere.hpp"
 #include "mixtures/kinds/DumpContainer.hpp"
 #include "mixtures/kinds/Mixture.hpp"
 
-#include <map>
+#include <array>
+#include <optional>
 
 class MultiLayerMixture : public Mixture
 {
@@ -18,11 +20,29 @@ protected:
     const Amount<Unit::LITER> maxVolume;
     Ref<ContainerBase>        overflowTarget = DumpContainer::GlobalDumpContainer;
 
-    std::map<LayerType, Layer> layers;
+    // Layers are indexed by toIndex(LayerType). Since layer types are single bits, the masks below hold the
+    // types of the existing layers and of the non-empty ones, ordered from the top (LSB) to the bottom (MSB).
+    std::array<std::optional<Layer>, getLayerCount()> layers;
+    uint8_t                                           layerMask       = 0;
+    uint8_t                                           filledLayerMask = 0;
+
+    uint64_t revision = 0;
 
     bool tryCreateLayer(const LayerType layer);
-    void addToLayer(const Reactant& reactant);
-    void add(const Amount<Unit::JOULE> heat, const LayerType layer) override final;
+    /// <summary>
+    /// Updates the totals of the layer of the reactant, creating the layer if needed.
+    /// </summary>
+    Layer& addToLayerTotals(const Reactant& reactant);
+    void   addToLayer(const Reactant& reactant);
+    void   add(const Amount<Unit::JOULE> heat, const LayerType layer) override final;
+
+    /// <summary>
+    /// Accumulates the layer totals of all the reactants first, then checks the nucleators once for the reactants
+    /// new to the content and bumps the revision once.
+    /// </summary>
+    void apply(const MixtureTransaction& transaction) override final;
+
+    Layer& getMutableLayer(const LayerType layer);
 
     void removeNegligibles();
     void checkOverflow();
@@ -38,6 +58,12 @@ protected:
 
     MultiLayerMixture(const MultiLayerMixture&) noexcept;
 
+    /// <summary>
+    /// Replaces the content with the given one, which has to hold the content of the other mixture, and the
+    /// layers with copies of those of the other mixture.
+    /// </summary>
+    void restore(const MultiLayerMixture& other, ReactantSet&& newContent);
+
 public:
     MultiLayerMixture(
         const Ref<Atmosphere>     atmosphere,
@@ -52,6 +78,12 @@ public:
 
     Amount<Unit::LITER> getMaxVolume() const;
 
+    /// <summary>
+    /// Returns a counter which is incremented on every change of the content or of the energy of the mixture.
+    /// Equal revisions imply an unchanged state.
+    /// </summary>
+    uint64_t getRevision() const;
+
     Amount<Unit::TORR>  getPressure() const override final;
     Amount<Unit::MOLE>  getTotalMoles() const override final;
     Amount<Unit::GRAM>  getTotalMass() const override final;
@@ -70,11 +102,11 @@ public:
     Ref<ContainerBase> getOverflowTarget() const override final;
     void               setOverflowTarget(const Ref<ContainerBase> target) override final;
 
-    using LayerDownIterator = std::map<LayerType, Layer>::const_iterator;
+    using LayerDownIterator = LayerIterator;
     LayerDownIterator getLayersDownBegin() const;
     LayerDownIterator getLayersDownEnd() const;
 
-    using LayerUpIterator = std::map<LayerType, Layer>::const_reverse_iterator;
+    using LayerUpIterator = LayerIterator;
     LayerUpIterator getLayersUpBegin() const;
     LayerUpIterator getLayersUpEnd() const;
 
@@ -83,4 +115,12 @@ public:
     void moveContentTo(Ref<ContainerBase> destination, const Amount<Unit::LITER> volume, const LayerType sourceLayer);
 
     MultiLayerMixture makeCopy() const;
+
+    void toCheckpoint(CheckpointWriter& writer) const;
+
+    /// <summary>
+    /// Replaces the content and the layers with the ones read from the checkpoint. On failure, the mixture is
+    /// left unchanged. The maximum volume and the overflow target are kept.
+    /// </summary>
+    bool loadFromCheckpoint(CheckpointReader& reader);
 };
@@ -4,10 +4,14 @@
 #include "data/DataStoreAccessor.hpp"
 #include "mixtures/kinds/Atmosphere.hpp"
 #include "mixtures/kinds/MultiLayerMixture.hpp"
+#include "reactions/EquilibriumSolver.hpp"
+#include "reactions/KineticsSolver.hpp"
 #include "reactions/kinds/ConcreteReaction.hpp"
 #include "structs/FlagField.hpp"
+#include "structs/TickScheduler.hpp"
 
 #include <array>
+#include <memory>
 #include <unordered_set>
 
 enum class TickMode : uint8_t
@@ -26,24 +30,85 @@ enum class TickMode : uint8_t
 class Reactor : public MultiLayerMixture,
                 public Accessor<>
 {
+public:
+    using Snapshot = std::shared_ptr<const Reactor>;
+
 private:
+    using ReactionCache = std::unordered_set<ConcreteReaction>;
+
     float_s stirSpeed = 0.0;
 
-    FlagField<TickMode> tickMode = TickMode::ENABLE_ALL;
+    FlagField<TickMode>     tickMode = TickMode::ENABLE_ALL;
+    TickScheduler<TickMode> scheduler;
+
+    // Found reactions don't depend on the state of the reactor, so the cache is shared between copies and only
+    // copied when a shared cache needs to be extended.
+    std::shared_ptr<ReactionCache>   cachedReactions = std::make_shared<ReactionCache>();
+    std::optional<KineticsSolver>    kineticsSolver;
+    std::optional<EquilibriumSolver> equilibriumSolver;
+    float_h                          equilibriumThreshold = 0.0;
 
-    std::unordered_set<ConcreteReaction> cachedReactions;
+    Amount<>::StorageType    quiescenceEpsilon   = Amount<>::Epsilon.asStd();
+    uint32_t                 quiescenceTickCount = 16;
+    uint32_t                 quiescentTicks      = 0;
+    std::unique_ptr<Reactor> quiescenceReference;
+    std::optional<uint64_t>  sleepRevision;
 
     float_s getInterLayerReactivityCoefficient(const Reactant& r1, const Reactant& r2) const;
     float_s getInterLayerReactivityCoefficient(const ReactantSet& reactants) const;
     float_s getCatalyticReactivityCoefficient(const ImmutableSet<Catalyst>& catalysts) const;
 
+    /// <summary>
+    /// Returns a cache holding copies of the given reactions, inserted in an order that only depends on the
+    /// reactions themselves. Reactions run in the order of the cache, so reactors holding the same reactions
+    /// run them in the same order, no matter in which order they were found, merged or restored. Duplicates are
+    /// only inserted once.
+    /// </summary>
+    static std::shared_ptr<ReactionCache> makeReactionCache(std::vector<const ConcreteReaction*>&& reactions);
+    void                                  addToReactionCache(const ReactionCache& reactions);
+
     void findNewReactions();
+    float_s getReactivityCoefficient(const ConcreteReaction& reaction) const;
+
+    /// <summary>
+    /// Returns the rate law of the reaction as a function of the summed amount of its reactants, in the
+    /// current conditions.
+    /// </summary>
+    KineticsSolver::RateFunction getRateFunction(const ConcreteReaction& reaction, const float_s coefficient) const;
+
     void runReactions(const Amount<Unit::SECOND> timespan);
+    void runImplicitReactions(const Amount<Unit::SECOND> timespan);
+
+    /// <summary>
+    /// Moves the reversible reactions (pairs of cached reactions where the reactants of one are the products
+    /// of the other) directly to their equilibrium, if they are close enough to it.
+    /// </summary>
+    void runEquilibrium();
     void runLayerEnergyConduction(const Amount<Unit::SECOND> timespan);
     void consumePotentialEnergy();
 
+    /// <summary>
+    /// Compares the state with the one from the start of the current quiescence window, putting the reactor
+    /// to sleep if it didn't change.
+    /// </summary>
+    void checkQuiescence();
+
+    std::optional<Amount<Unit::SECOND>> beginPhase(const TickMode phase);
+    void                                endPhase(const TickMode phase);
+
+    /// <summary>
+    /// Runs the phases preceding the reactions. Returns false if the reactor is asleep, in which case the
+    /// whole tick is skipped.
+    /// </summary>
+    bool beginTick(const Amount<Unit::SECOND> timespan);
+    void endTick();
+
+    void restore(const Reactor& other, ReactantSet&& newContent);
+
     Reactor(const Reactor& other) noexcept;
 
+    friend class ReactorBatch;
+
 public:
     Reactor(
         const Ref<Atmosphere>     atmosphere,
@@ -57,9 +122,43 @@ public:
     void addEnergy(const Amount<Unit::JOULE> energy) override final;
     void add(const Molecule& molecule, const Amount<Unit::MOLE> amount) override;
 
+    /// <summary>
+    /// Enables the adaptive implicit kinetics integrator, which keeps stiff reaction systems stable at
+    /// large tick timespans. Otherwise, reactions are applied using one explicit Euler step per tick.
+    /// </summary>
+    void enableImplicitKinetics(const float_h relativeTolerance = 1e-3, const float_h absoluteTolerance = 1e-6);
+    void disableImplicitKinetics();
+    bool hasImplicitKinetics() const;
+
+    /// <summary>
+    /// Enables fast-forwarding reversible reactions to their equilibrium once their relative net rate drops
+    /// below the given threshold, replacing the many ticks needed to approach it.
+    /// </summary>
+    void enableEquilibriumSolver(const float_h threshold = 0.1, const float_h tolerance = 1e-4);
+    void disableEquilibriumSolver();
+    bool hasEquilibriumSolver() const;
+
     FlagField<TickMode> getTickMode() const;
     void                setTickMode(const FlagField<TickMode> mode);
-    void                tick(const Amount<Unit::SECOND> timespan);
+
+    /// <summary>
+    /// Sets the minimum simulated time between two runs of a tick phase. Phases with an interval larger than
+    /// the tick timespan are batched, running once over the accumulated time.
+    /// Regardless of the interval, phases are skipped while the reactor is in a steady state.
+    /// </summary>
+    void                 setTickInterval(const TickMode phase, const Amount<Unit::SECOND> interval);
+    Amount<Unit::SECOND> getTickInterval(const TickMode phase) const;
+
+    /// <summary>
+    /// Reactors whose state changes by less than the given epsilon over the given number of ticks are put
+    /// to sleep, skipping their ticks until their content or energy is changed from outside.
+    /// A tick count of 0 disables sleeping.
+    /// </summary>
+    void setQuiescenceThreshold(const Amount<>::StorageType epsilon, const uint32_t tickCount);
+    bool isSleeping() const;
+    void wake();
+
+    void tick(const Amount<Unit::SECOND> timespan);
 
     bool hasSameState(const Reactor& other, const Amount<>::StorageType epsilon = Amount<>::Epsilon.asStd()) const;
     bool hasSameContent(const Reactor& other, const Amount<>::StorageType epsilon = Amount<>::Epsilon.asStd()) const;
@@ -67,4 +166,34 @@ public:
     bool isSame(const Reactor& other, const Amount<>::StorageType epsilon = Amount<>::Epsilon.asStd()) const;
 
     Reactor makeCopy() const;
+
+    /// <summary>
+    /// Returns an immutable copy of the current state, which can be restored any number of times.
+    /// Snapshots share the reaction cache and the content with the reactor, the content being handed over to the
+    /// snapshot and only copied once the reactor changes. Only the fixed-size layers are copied.
+    /// Shared reactants read the temperatures and pressure of the snapshot, so any change of the layers copies the
+    /// content as well, including energy only changes. Branches restored from a snapshot therefore still copy the
+    /// whole content on their first tick which changes anything.
+    /// </summary>
+    Snapshot makeSnapshot();
+
+    /// <summary>
+    /// Replaces the state of the reactor (content, layers, energy, reactions and tick settings) with that of the
+    /// given reactor. The maximum volume and the overflow target are kept.
+    /// </summary>
+    void restore(const Reactor& other);
+    /// <summary>
+    /// Same as above, except that the content is shared with the snapshot until the reactor changes, so
+    /// restoring the same snapshot into many reactors doesn't copy it.
+    /// </summary>
+    void restore(const Snapshot& snapshot);
+
+    void toCheckpoint(CheckpointWriter& writer) const;
+
+    /// <summary>
+    /// Replaces the state of the reactor with the one read from the checkpoint, same as restore(). On failure,
+    /// the reactor is left unchanged. Cached reactions are only loaded if the checkpoint was written using the
+    /// same definitions, otherwise they are found again on the next tick.
+    /// </summary>
+    bool loadFromCheckpoint(CheckpointReader& reader);
 };
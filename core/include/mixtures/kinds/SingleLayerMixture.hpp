@@ -1,6 +1,7 @@
 #pragma once
 
 #include "data/values/Constants.hpp"
+#include "io/Checkpoint.hpp"
 #include "io/Log.hpp"
 #include "mixtures/ContentInitializer.hpp"
 #include "mixtures/Layer.hpp"
@@ -85,6 +86,14 @@ public:
     void moveContentTo(const Ref<ContainerBase> destination, const Amount<Unit::LITER> volume);
 
     SingleLayerMixture<L> makeCopy() const;
+
+    void toCheckpoint(CheckpointWriter& writer) const;
+
+    /// <summary>
+    /// Replaces the content and the layer with the ones read from the checkpoint. On failure, the mixture is
+    /// left unchanged. The maximum volume and the overflow and incompatibility targets are kept.
+    /// </summary>
+    bool loadFromCheckpoint(CheckpointReader& reader);
 };
 
 template <LayerType L>
@@ -435,3 +444,37 @@ SingleLayerMixture<L> SingleLayerMixture<L>::makeCopy() const
 {
     return SingleLayerMixture<L>(*this);
 }
+
+template <LayerType L>
+void SingleLayerMixture<L>::toCheckpoint(CheckpointWriter& writer) const
+{
+    writer.write(maxVolume);
+    writer.write(pressure);
+    contentToCheckpoint(writer);
+    layer.toCheckpoint(writer);
+}
+
+template <LayerType L>
+bool SingleLayerMixture<L>::loadFromCheckpoint(CheckpointReader& reader)
+{
+    const auto newMaxVolume = reader.read<Amount<Unit::LITER>>();
+    const auto newPressure  = reader.read<Amount<Unit::TORR>>();
+    if (not newPressure) {
+        Log(this).error("Failed to read mixture from checkpoint.");
+        return false;
+    }
+
+    if (*newMaxVolume != maxVolume)
+        Log(this).warn("Loading a mixture with a different maximum volume from checkpoint.");
+
+    auto newContent = loadContentFromCheckpoint(reader);
+    if (not newContent || not layer.loadFromCheckpoint(reader))
+        return false;
+
+    content  = std::move(*newContent);
+    pressure = *newPressure;
+    for (const auto& [_, r] : content)
+        layer.setIfNucleator(r);
+
+    return true;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "molecules/MolecularStructure.hpp"
+
+#include <atomic>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+/// <summary>
+/// Holds the ASCII renderings of an immutable structure, one for each set of print options used.
+/// Structures are read concurrently without locking, so renderings are published atomically into an append-only
+/// list and any concurrently rendered duplicate is discarded. Returned references are stable until destruction.
+/// Copies start empty.
+/// </summary>
+class ASCIICache
+{
+private:
+    class Node
+    {
+    public:
+        const ASCII::PrintOptions options;
+        const ColoredTextBlock    block;
+        const Node*               next;
+
+        Node(const ASCII::PrintOptions options, ColoredTextBlock&& block, const Node* next) noexcept;
+    };
+
+    std::atomic<const Node*> head = nullptr;
+
+    static const ColoredTextBlock* find(const Node* begin, const Node* end, const ASCII::PrintOptions options);
+
+public:
+    ASCIICache() = default;
+    ASCIICache(const ASCIICache&) noexcept;
+    ASCIICache(ASCIICache&& other) noexcept;
+    ~ASCIICache() noexcept;
+
+    ASCIICache& operator=(const ASCIICache&) = delete;
+    ASCIICache& operator=(ASCIICache&& other) noexcept;
+
+    /// <summary>
+    /// Returns the cached rendering or nullptr if nothing was cached for the given options yet.
+    /// </summary>
+    const ColoredTextBlock* get(const ASCII::PrintOptions options) const;
+    /// <summary>
+    /// Caches the rendering unless another one was cached for the same options in the meantime.
+    /// Returns the cached rendering.
+    /// </summary>
+    const ColoredTextBlock& set(const ASCII::PrintOptions options, ColoredTextBlock&& block);
+    /// <summary>
+    /// Discards the cached renderings. Must not be called concurrently with any other method.
+    /// </summary>
+    void clear();
+
+    size_t getHeapUsage() const;
+};
+
+/// <summary>
+/// Persistent store of the ASCII renderings of structures, keyed by canonical SMILES and print options.
+/// Cycle layout searches dominate the rendering of cyclic structures, and the same molecules get printed by every
+/// run, so renderings can be saved to a file and reused by later runs.
+/// New renderings are only stored once the store is opened on a file, otherwise the per-structure caches already
+/// hold them. The number of entries is bounded, renderings being returned without storing once the store is full.
+/// Renderings which depend on the order of the atoms (PRINT_ATOM_INDICES) are never stored.
+/// The store is synchronized and can be shared by multiple threads.
+/// </summary>
+class ASCIILayoutStore
+{
+private:
+    class Key
+    {
+    public:
+        std::string smiles;
+        uint8_t     options;
+
+        bool operator==(const Key& other) const;
+    };
+
+    class KeyHash
+    {
+    public:
+        size_t operator()(const Key& key) const;
+    };
+
+    size_t                                                  maxSize;
+    std::string                                             path;
+    mutable std::shared_mutex                               mutex;
+    mutable std::unordered_map<Key, ColoredString, KeyHash> entries;
+    mutable bool                                            modified = false;
+
+public:
+    ASCIILayoutStore(const size_t maxSize = DefaultMaxSize) noexcept;
+    ASCIILayoutStore(const ASCIILayoutStore&) = delete;
+    ASCIILayoutStore(ASCIILayoutStore&& other) noexcept;
+
+    /// <summary>
+    /// Returns the stored rendering of the structure, rendering and storing it if missing.
+    /// The structure is expected to be canonical, otherwise its SMILES may miss the stored entries.
+    /// </summary>
+    ColoredTextBlock render(const MolecularStructure& structure, const ASCII::PrintOptions options) const;
+
+    size_t size() const;
+    bool   isOpen() const;
+    bool   isModified() const;
+
+    /// <summary>
+    /// Backs the store by the given file, loading its entries if it exists.
+    /// A file which fails to load is overwritten by the next flush.
+    /// </summary>
+    bool open(const std::string& path);
+    /// <summary>
+    /// Saves the entries to the backing file, if the store is open and was modified.
+    /// </summary>
+    bool flush() const;
+
+    /// <summary>
+    /// Merges the stored entries into this store, up to its maximum size. Entries already present are kept.
+    /// </summary>
+    bool load(std::istream& is);
+    bool loadFile(const std::string& path);
+    /// <summary>
+    /// Writes all the entries and clears the modified flag.
+    /// </summary>
+    bool save(std::ostream& os) const;
+    bool saveFile(const std::string& path) const;
+    void clear();
+
+    size_t getMemoryUsage() const;
+
+    static constexpr uint16_t Version        = 1;
+    static constexpr size_t   DefaultMaxSize = 1 << 16;
+};
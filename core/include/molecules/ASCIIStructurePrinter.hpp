@@ -6,6 +6,7 @@
 #include "structs/HLine.hpp"
 #include "structs/UndirectedEdge.hpp"
 
+#include <chrono>
 #include <ranges>
 #include <source_location>
 
@@ -92,6 +93,7 @@ private:
 
 public:
     Cycle(std::vector<const BondedAtomBase*>&& cycle) noexcept;
+    Cycle(const std::vector<const BondedAtomBase*>& cycle) noexcept;
     Cycle(const Cycle&) = delete;
     Cycle(Cycle&&)      = default;
 
@@ -136,6 +138,22 @@ public:
     static const PrintOptions Default;
 };
 
+//
+// LayoutBudget
+//
+
+/// <summary>
+/// Limits the cycle layout searches done while printing a structure. Both limits apply to the whole print: once
+/// either is exceeded, searches return the best layout found so far and the remaining cycles fall back to cheaper
+/// layouts. The default node limit is deterministic and is not reached by common polycycles, time limits are meant
+/// for interactive use.
+/// </summary>
+struct LayoutBudget
+{
+    size_t                   nodeCount = 1 << 14;
+    std::chrono::nanoseconds time      = std::chrono::nanoseconds::max();
+};
+
 //
 // StructurePrinter
 //
@@ -147,6 +165,11 @@ private:
     c_size       errorCount         = 0;
     PrintOptions options;
 
+    const LayoutBudget                    budget;
+    std::chrono::steady_clock::time_point startTime;
+    size_t                                layoutNodeCount         = 0;
+    bool                                  isLayoutBudgetExhausted = false;
+
     std::vector<Node>                                nodes;
     std::vector<Cycle>                               cycles;
     std::unordered_map<UndirectedEdge<c_size>, Edge> edges;
@@ -185,13 +208,19 @@ private:
         const BondType                  prevBondType,
         const std::array<Direction, 8>& directions) const;
 
+    bool checkLayoutBudget();
+
+    /// <summary>
+    /// Best-first search over the cycle layouts, ordered by the average score of the placed edges.
+    /// If the layout budget is exhausted, the best complete layout found so far is returned (if any).
+    /// </summary>
     std::vector<PositionLine> generateOptimalCycleLayout(
         const std::vector<const BondedAtomBase*>& cycle,
         const c_size                              firstCycleIdx,
         const c_size                              secondCycleIdx,
         const c_size                              lastCycleIdx,
         const bool                                noConstraints,
-        const Direction                           enteringDirection) const;
+        const Direction                           enteringDirection);
     std::vector<PositionLine> generateOneShotCycleLayout(
         const std::vector<const BondedAtomBase*>& cycle,
         const c_size                              firstCycleIdx,
@@ -216,7 +245,8 @@ public:
         std::vector<Node>&&                                nodes,
         std::vector<Cycle>&&                               cycles,
         std::unordered_map<UndirectedEdge<c_size>, Edge>&& edges,
-        const PrintOptions                                 options) noexcept;
+        const PrintOptions                                 options,
+        const LayoutBudget&                                budget = LayoutBudget()) noexcept;
 
     void print();
     void reset();
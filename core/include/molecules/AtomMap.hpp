@@ -0,0 +1,126 @@
+#pragma once
+
+#include "global/SizeTypedefs.hpp"
+
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+class AtomMap;
+
+class AtomMapIterator
+{
+private:
+    const AtomMap* map;
+    c_size         key;
+
+    AtomMapIterator(const AtomMap& map, const c_size key) noexcept;
+
+    void findNext();
+
+public:
+    std::pair<c_size, c_size> operator*() const;
+
+    AtomMapIterator& operator++();
+
+    bool operator==(const AtomMapIterator& other) const;
+    bool operator!=(const AtomMapIterator& other) const;
+
+    friend class AtomMap;
+};
+
+/// <summary>
+/// Mapping between the atom indices of two structures. Indices are small and dense, so the mapping is stored as a
+/// vector indexed by key, with npos marking the unmapped keys. Lookups and insertions don't hash or allocate
+/// (once the keys are reserved) and entries are iterated in increasing order of their keys.
+/// </summary>
+class AtomMap
+{
+private:
+    std::vector<c_size> values;
+    c_size              count = 0;
+
+public:
+    static constexpr c_size npos = static_cast<c_size>(-1);
+
+    AtomMap() = default;
+    AtomMap(std::initializer_list<std::pair<c_size, c_size>> entries) noexcept;
+    AtomMap(const AtomMap&) = default;
+    AtomMap(AtomMap&&)      = default;
+
+    AtomMap& operator=(const AtomMap&) = default;
+    AtomMap& operator=(AtomMap&&)      = default;
+
+    /// <summary>
+    /// Reserves space for the keys smaller than keyCount, so insertions of these keys don't allocate.
+    /// </summary>
+    void reserve(const c_size keyCount);
+
+    inline c_size size() const;
+    inline bool   empty() const;
+    inline bool   contains(const c_size key) const;
+
+    /// <summary>
+    /// Returns the value mapped to the key, or npos if the key isn't mapped.
+    /// </summary>
+    inline c_size find(const c_size key) const;
+
+    /// <summary>
+    /// Returns the value mapped to the key. The key must be mapped.
+    /// </summary>
+    c_size at(const c_size key) const;
+
+    /// <summary>
+    /// Maps the key to the value if the key isn't already mapped.
+    /// Returns true if the entry was inserted.
+    /// </summary>
+    inline bool emplace(const c_size key, const c_size value);
+    inline void erase(const c_size key);
+    void        clear();
+
+    /// <summary>
+    /// Returns the mapping from values to keys, assuming the values are unique.
+    /// Complexity: O(k + v), where k and v are the largest key and value
+    /// </summary>
+    AtomMap reversed() const;
+
+    bool operator==(const AtomMap& other) const;
+    bool operator!=(const AtomMap& other) const;
+
+    size_t getHeapUsage() const;
+
+    using Iterator = AtomMapIterator;
+    Iterator begin() const;
+    Iterator end() const;
+
+    friend class AtomMapIterator;
+};
+
+c_size AtomMap::size() const { return count; }
+
+bool AtomMap::empty() const { return count == 0; }
+
+bool AtomMap::contains(const c_size key) const { return find(key) != npos; }
+
+c_size AtomMap::find(const c_size key) const { return key < values.size() ? values[key] : npos; }
+
+bool AtomMap::emplace(const c_size key, const c_size value)
+{
+    if (key >= values.size())
+        values.resize(key + 1, npos);
+    else if (values[key] != npos)
+        return false;
+
+    values[key] = value;
+    ++count;
+    return true;
+}
+
+void AtomMap::erase(const c_size key)
+{
+    if (key >= values.size() || values[key] == npos)
+        return;
+
+    values[key] = npos;
+    --count;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "io/MappedFile.hpp"
+#include "molecules/MolBinFormat.hpp"
+#include "molecules/MolecularStructure.hpp"
+
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Writes structures into a MolBin batch (see MolBinFormat.hpp). Structures are streamed out as they are added,
+/// only the molecule and symbol tables being kept until finish() writes them and completes the header.
+/// The stream must be binary and seekable.
+/// </summary>
+class MolBinBatchWriter
+{
+private:
+    std::ostream&                      os;
+    const std::streampos               start;
+    uint64_t                           offset = sizeof(MolBin::Header);
+    std::vector<MolBin::MoleculeEntry> entries;
+    std::vector<Symbol>                symbols;
+    // Index in the symbol table of each interned symbol id, npos if not in the table yet.
+    std::vector<uint16_t>              symbolIndices;
+    std::vector<MolBin::Atom>          atomBuffer;
+    std::vector<MolBin::Bond>          bondBuffer;
+    bool                               finished = false;
+
+    uint16_t getSymbolIdx(const Symbol& symbol);
+
+public:
+    MolBinBatchWriter(std::ostream& os) noexcept;
+    MolBinBatchWriter(const MolBinBatchWriter&) = delete;
+
+    bool   isValid() const;
+    size_t size() const;
+
+    bool add(const MolecularStructure& structure);
+    /// <summary>
+    /// Writes the tables and the header. No structures can be added afterwards.
+    /// </summary>
+    bool finish();
+
+    static constexpr uint16_t npos = static_cast<uint16_t>(-1);
+};
+
+/// <summary>
+/// Read-only view of a MolBin batch, either over a caller owned buffer or over a memory mapped file.
+/// Opening a batch only validates the header and the tables and resolves the symbol table, the packed arrays of
+/// the structures are used in place and only read when the structures are accessed.
+/// Symbols which aren't defined by the current data store only fail the structures using them.
+/// </summary>
+class MolBinBatch
+{
+private:
+    std::optional<MappedFile>              file;
+    std::span<const char>                  bytes;
+    std::span<const MolBin::MoleculeEntry> entries;
+    std::vector<const AtomBaseData*>       symbolTable;
+
+    MolBinBatch() = default;
+
+    bool load(const std::span<const char> bytes);
+
+public:
+    MolBinBatch(const MolBinBatch&) = delete;
+    MolBinBatch(MolBinBatch&&)      = default;
+
+    size_t size() const;
+
+    std::span<const MolBin::Atom>        getAtoms(const size_t idx) const;
+    std::span<const MolBin::Bond>        getBonds(const size_t idx) const;
+    std::span<const AtomBaseData* const> getSymbolTable() const;
+
+    /// <summary>
+    /// Complexity: O(n_comps * n_bonds)
+    /// </summary>
+    std::optional<MolecularStructure> getStructure(const size_t idx) const;
+
+    /// <summary>
+    /// The buffer isn't copied, it must outlive the batch and be aligned to 8 bytes.
+    /// </summary>
+    static std::optional<MolBinBatch> fromBytes(const std::span<const char> bytes);
+    static std::optional<MolBinBatch> loadFile(const std::string& path);
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "atomics/BondType.hpp"
+#include "global/SizeTypedefs.hpp"
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+/// <summary>
+/// Records of the MolBin batch format (version 2), a container of many structures laid out so that it can be
+/// memory mapped and used in place. All values are little-endian and every record is naturally aligned:
+///
+///   Header                                   | at offset 0
+///   Atom[atomCount] Bond[bondCount]          | one block per structure, 4-byte aligned
+///   MoleculeEntry[moleculeCount]             | at header.moleculeTableOffset, 8-byte aligned
+///   ([size: uint8][chars])[symbolCount]      | at header.symbolTableOffset
+///
+/// The bonds of each atom follow the bonds of the previous atom, in the same order as in the structure, and are
+/// stored once for each of the two bonded atoms. Structures without atoms represent the virtual hydrogen (H2).
+/// </summary>
+namespace MolBin
+{
+
+constexpr std::string_view Magic   = "CHGMOLBN";
+constexpr uint16_t         Version = 2;
+
+struct Header
+{
+    char     magic[8];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t symbolCount;
+    uint64_t moleculeCount;
+    uint64_t moleculeTableOffset;
+    uint64_t symbolTableOffset;
+};
+
+struct MoleculeEntry
+{
+    uint64_t offset;
+    uint32_t atomCount;
+    uint32_t bondCount;
+};
+
+struct Atom
+{
+    uint16_t symbolIdx;  // index in the symbol table of the batch
+    c_size   bondCount;
+};
+
+struct Bond
+{
+    c_size   other;
+    BondType type;
+    uint8_t  reserved;
+};
+
+static_assert(sizeof(Header) == 40 && alignof(Header) == 8);
+static_assert(sizeof(MoleculeEntry) == 16 && alignof(MoleculeEntry) == 8);
+static_assert(sizeof(Atom) == 4 && sizeof(Bond) == 4);
+static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<MoleculeEntry>);
+static_assert(std::is_trivially_copyable_v<Atom> && std::is_trivially_copyable_v<Bond>);
+
+}  // namespace MolBin
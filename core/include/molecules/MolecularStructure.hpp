@@ -3,21 +3,39 @@
 #include "data/def/Parsers.hpp"
 #include "data/def/Printers.hpp"
 #include "molecules/ASCIIStructurePrinter.hpp"
+#include "molecules/AtomMap.hpp"
+#include "molecules/MolBinFormat.hpp"
+#include "molecules/RingInfo.hpp"
 
+#include <chrono>
+#include <limits>
 #include <map>
 #include <memory>
+#include <span>
 #include <stack>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+/// <summary>
+/// Limits the search done by MolecularStructure::maximalMapTo(). Once either limit is exceeded, the largest
+/// mapping found so far is returned.
+/// </summary>
+struct MappingBudget
+{
+    size_t                   nodeCount = std::numeric_limits<size_t>::max();
+    std::chrono::nanoseconds time      = std::chrono::nanoseconds::max();
+};
+
 class MolecularStructure
 {
 private:
     std::vector<std::unique_ptr<BondedAtomBase>> atoms;
     Amount<Unit::GRAM_PER_MOLE>                  molarMass            = 0.0f;
     uint16_t                                     impliedHydrogenCount = 0;
+    mutable RingInfoCache                        ringInfo;
 
     static void addBond(BondedAtomBase& from, BondedAtomBase& to, const BondType bondType);
     static bool addBondChecked(BondedAtomBase& from, BondedAtomBase& to, const BondType bondType);
@@ -46,20 +64,35 @@ public:
 
     MolecularStructure& operator=(MolecularStructure&&) = default;
 
-    static std::optional<MolecularStructure> fromSMILES(const std::string& smiles);
+    static std::optional<MolecularStructure> fromSMILES(const std::string_view smiles);
     static std::optional<MolecularStructure> fromASCII(const std::string& ascii);
     static std::optional<MolecularStructure> fromMolBin(std::istream& is);
     static std::optional<MolecularStructure> loadMolBinFile(const std::string& path);
+    /// <summary>
+    /// Builds the structure straight from the packed arrays of a MolBin batch, where symbolTable resolves the
+    /// symbol indices of the atoms. Nothing is parsed, the arrays are only validated.
+    /// Complexity: O(n_comps * n_bonds)
+    /// </summary>
+    static std::optional<MolecularStructure> fromMolBin(
+        const std::span<const MolBin::Atom>        atoms,
+        const std::span<const MolBin::Bond>        bonds,
+        const std::span<const AtomBaseData* const> symbolTable);
 
     std::string      toSMILES(const c_size startAtomIdx = 0) const;
-    ColoredTextBlock toASCII(const ASCII::PrintOptions options = ASCII::PrintOptions::Default) const;
+    ColoredTextBlock toASCII(
+        const ASCII::PrintOptions  options = ASCII::PrintOptions::Default,
+        const ASCII::LayoutBudget& budget  = ASCII::LayoutBudget()) const;
     void             toMolBin(std::ostream& os) const;
     void             toMolBinFile(const std::string& path) const;
 
 private:
-    bool loadFromSMILES(const std::string& smiles);
+    bool loadFromSMILES(const std::string_view smiles);
     bool loadFromASCII(const std::string& ascii);
     bool loadFromMolBin(std::istream& is);
+    bool loadFromMolBin(
+        const std::span<const MolBin::Atom>        atoms,
+        const std::span<const MolBin::Bond>        bonds,
+        const std::span<const AtomBaseData* const> symbolTable);
 
 public:
     /// <summary>
@@ -91,7 +124,7 @@ public:
     c_size getRadicalAtomsCount() const;
 
     /// <summary>
-    /// Complexity: equal to getBondCount()
+    /// Complexity: O(1) if the ring information is cached, equal to getBondCount() otherwise
     /// </summary>
     c_size getCycleCount() const;
 
@@ -124,10 +157,10 @@ public:
     bool isOrganic() const;
 
     /// <summary>
-    /// Returns a map representing a histogram of all the atoms in this structure.
-    /// Complexity: O(n)
+    /// Returns a histogram of all the atoms in this structure, in the order of their first appearance.
+    /// Complexity: O(n + s), where s is the number of interned symbols
     /// </summary>
-    std::unordered_map<Symbol, c_size> getComponentCountMap() const;
+    std::vector<std::pair<Symbol, c_size>> getComponentCountMap() const;
 
     /// <summary>
     /// Returns true if the molecule contains no real or virtual atoms.
@@ -155,7 +188,7 @@ public:
 
     /// <summary>
     /// Checks if the molecule contains at least one cycle.
-    /// Complexity: equal to getBondCount()
+    /// Complexity: O(1) if the ring information is cached, equal to getBondCount() otherwise
     /// </summary>
     bool isCyclic() const;
 
@@ -166,6 +199,12 @@ public:
     /// </summary>
     bool isVirtualHydrogen() const;
 
+    /// <summary>
+    /// Returns the approximate heap memory owned by the structure graph (atoms and bonds), in bytes.
+    /// Complexity: O(n)
+    /// </summary>
+    size_t getHeapUsage() const;
+
     /// <summary>
     /// Checks if the two atoms are adjacent.
     /// Complexity: O(n)
@@ -178,7 +217,7 @@ public:
 
 private:
     template <bool Exact>
-    std::unordered_map<c_size, c_size> _mapTo(const MolecularStructure& pattern) const;
+    AtomMap _mapTo(const MolecularStructure& pattern) const;
 
 public:
     /// <summary>
@@ -186,16 +225,22 @@ public:
     /// Radicals are escaped but the whole pattern structure must be matched.
     /// Complexity: rather large
     /// </summary>
-    std::unordered_map<c_size, c_size> mapTo(const MolecularStructure& pattern) const;
+    AtomMap mapTo(const MolecularStructure& pattern) const;
 
     /// <summary>
-    /// Returns the largest mapping between the atoms of the pattern and the atoms of *this.
-    /// Complexity: rather large
+    /// Returns the largest connected mapping between the atoms of the pattern and the atoms of *this, grown
+    /// through bonds of matching types. The search is exact unless the budget is exceeded.
+    /// Among mappings of equal size, the one with the smallest total difference in bond counts between the
+    /// mapped atoms wins, and the returned score is 255 minus that difference (floored at 0). Remaining ties
+    /// keep the first mapping found. The default budget is unbounded, callers on untrusted input should pass
+    /// a finite one.
+    /// Complexity: exponential in the worst case, bounded by the budget
     /// </summary>
-    std::pair<std::unordered_map<c_size, c_size>, uint8_t> maximalMapTo(
+    std::pair<AtomMap, uint8_t> maximalMapTo(
         const MolecularStructure&         pattern,
         const std::unordered_set<c_size>& targetIgnore  = std::unordered_set<c_size>(),
-        const std::unordered_set<c_size>& patternIgnore = std::unordered_set<c_size>()) const;
+        const std::unordered_set<c_size>& patternIgnore = std::unordered_set<c_size>(),
+        const MappingBudget&              budget        = MappingBudget()) const;
 
     void recountImpliedHydrogens();
 
@@ -207,14 +252,15 @@ public:
     /// branch starts</param> <param name="sdMapping">: a map between the atoms of the source and
     /// those of the destination.</param> <param name="canonicalize">: if true, canonicalization and
     /// implied hydrogen recount occurs after the copy is made and sdMapping is invalidated.
-    /// </param>
+    /// </param> <param name="sourceIgnore">: the atoms of the source which are keys of this map
+    /// aren't copied.</param>
     static void copyBranch(
-        MolecularStructure&                 destination,
-        const MolecularStructure&           source,
-        const c_size                        sourceIdx,
-        std::unordered_map<c_size, c_size>& sdMapping,
-        bool                                canonicalize = true,
-        const std::unordered_set<c_size>& sourceIgnore   = std::unordered_set<c_size>());
+        MolecularStructure&       destination,
+        const MolecularStructure& source,
+        const c_size              sourceIdx,
+        AtomMap&                  sdMapping,
+        bool                      canonicalize = true,
+        const AtomMap&            sourceIgnore = AtomMap());
 
     /// <summary>
     /// Returns a molecule derived from pattern by adding all the substituents of instance that
@@ -223,10 +269,8 @@ public:
     /// <param name="pattern">: the base structure </param>
     /// <param name="instance">: a structure that has common substructures with the pattern </param>
     /// <param name="ipMap">: a map between the common atoms of pattern and instance </param>
-    static MolecularStructure addSubstituents(
-        const MolecularStructure&                 pattern,
-        const MolecularStructure&                 instance,
-        const std::unordered_map<c_size, c_size>& ipMap);
+    static MolecularStructure
+    addSubstituents(const MolecularStructure& pattern, const MolecularStructure& instance, const AtomMap& ipMap);
 
     using Cycle = std::vector<const BondedAtomBase*>;
     /// <summary>
@@ -237,6 +281,19 @@ public:
     /// Computes and returns the set of minimal non-overlapping cycles of the molecule.
     /// </summary>
     std::vector<Cycle> getMinimalCycleBasis() const;
+    /// <summary>
+    /// Returns the minimal cycle basis along with the ring membership of each atom. It is computed on the
+    /// first call and cached until the structure is changed.
+    /// Complexity: equal to getMinimalCycleBasis() on the first call, O(1) afterwards
+    /// </summary>
+    const RingInfo& getRingInfo() const;
+
+    /// <summary>
+    /// Returns a hash of the atom order independent properties of the structure, equal structures
+    /// always have equal hashes. Allows operator== checks to be skipped for most non-matching structures.
+    /// Complexity: O(n)
+    /// </summary>
+    size_t getInvariantHash() const;
 
     /// <summary>
     /// Returns true if both structures represent the exact same molecule.
@@ -5,21 +5,75 @@
 #include "molecules/data/GenericMoleculeData.hpp"
 #include "molecules/data/MoleculeData.hpp"
 
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <shared_mutex>
+
+/// <summary>
+/// Repository of the molecule definitions.
+/// Molecules loaded from definitions are immutable once loading is done and are read without locking.
+/// Molecules discovered at runtime (findOrAdd*) are stored in an append-only overlay, sharded by the
+/// invariant hash of their structures, so that simulations running on multiple threads can share the
+/// same repository. Iteration is not synchronized.
+/// </summary>
 class MoleculeRepository
 {
 private:
-    std::unordered_map<MoleculeId, std::unique_ptr<const MoleculeData>>        concreteMolecules;
-    std::unordered_map<MoleculeId, std::unique_ptr<const GenericMoleculeData>> genericMolecules;
+    using ConcreteMap = std::unordered_map<MoleculeId, std::unique_ptr<const MoleculeData>>;
+    using GenericMap  = std::unordered_map<MoleculeId, std::unique_ptr<const GenericMoleculeData>>;
+
+    /// <summary>
+    /// Molecule storage indexed by the invariant hash of the structures.
+    /// </summary>
+    class Partition
+    {
+    public:
+        ConcreteMap                                                 concreteMolecules;
+        GenericMap                                                  genericMolecules;
+        std::unordered_multimap<size_t, const MoleculeData*>        concreteIndex;
+        std::unordered_multimap<size_t, const GenericMoleculeData*> genericIndex;
+
+        const MoleculeData*        findConcrete(const MolecularStructure& structure, const size_t hash) const;
+        const GenericMoleculeData* findGeneric(const MolecularStructure& structure, const size_t hash) const;
+
+        const MoleculeData&        addConcrete(std::unique_ptr<const MoleculeData>&& molecule, const size_t hash);
+        const GenericMoleculeData& addGeneric(std::unique_ptr<const GenericMoleculeData>&& molecule, const size_t hash);
+
+        size_t getMemoryUsage() const;
+        void   clear();
+    };
+
+    struct Shard
+    {
+        mutable std::shared_mutex mutex;
+        Partition                 molecules;
+    };
+
+    static constexpr size_t ShardCount = 16;
+
+    Partition                             definitions;
+    mutable std::array<Shard, ShardCount> discovered;
+    mutable std::atomic<MoleculeId>       nextId = 0;
 
     EstimatorRepository& estimators;
 
+    ASCIILayoutStore layouts;
+
     MoleculeId getFreeId() const;
+    Shard&     getShard(const size_t hash) const;
+
+    const Partition& getPartition(const size_t idx) const;
 
 public:
     MoleculeRepository(EstimatorRepository& estimators) noexcept;
     MoleculeRepository(const MoleculeRepository&) = delete;
-    MoleculeRepository(MoleculeRepository&&)      = default;
+    MoleculeRepository(MoleculeRepository&& other) noexcept;
 
+    /// <summary>
+    /// Adds a molecule definition. Not synchronized, definitions must be added before the repository is
+    /// shared between threads.
+    /// </summary>
     bool add(const def::Object& definition);
 
     bool                contains(const MoleculeId id) const;
@@ -27,13 +81,54 @@ public:
 
     size_t totalDefinitionCount() const;
 
+    /// <summary>
+    /// Returns the approximate memory used by the repository and its definitions, in bytes.
+    /// </summary>
+    size_t getMemoryUsage() const;
+
     const MoleculeData*        findFirstConcrete(const MolecularStructure& structure) const;
     const GenericMoleculeData* findFirstGeneric(const MolecularStructure& structure) const;
 
-    const MoleculeData&        findOrAddConcrete(MolecularStructure&& structure);
-    const GenericMoleculeData& findOrAdd(MolecularStructure&& structure);
+    const MoleculeData&        findOrAddConcrete(MolecularStructure&& structure) const;
+    const GenericMoleculeData& findOrAdd(MolecularStructure&& structure) const;
+
+    /// <summary>
+    /// Returns the store of ASCII renderings used when printing the molecules of this repository.
+    /// Loading a previously saved store lets repeated runs skip the layout searches of known molecules.
+    /// </summary>
+    const ASCIILayoutStore& getLayoutStore() const;
+    ASCIILayoutStore&       getLayoutStore();
+
+    /// <summary>
+    /// Iterates over the concrete molecules, the defined ones first.
+    /// </summary>
+    class Iterator
+    {
+    private:
+        const MoleculeRepository*   repository;
+        size_t                      partitionIdx;
+        ConcreteMap::const_iterator it;
+
+        void skipEmptyPartitions();
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = ConcreteMap::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const value_type*;
+        using reference         = const value_type&;
+
+        Iterator(const MoleculeRepository& repository, const size_t partitionIdx) noexcept;
+
+        reference operator*() const;
+        pointer   operator->() const;
+
+        Iterator& operator++();
+        Iterator  operator++(int);
+
+        bool operator==(const Iterator& other) const;
+    };
 
-    using Iterator = std::unordered_map<MoleculeId, std::unique_ptr<const MoleculeData>>::const_iterator;
     Iterator begin() const;
     Iterator end() const;
 
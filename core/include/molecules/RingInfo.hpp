@@ -0,0 +1,81 @@
+#pragma once
+
+#include "atomics/BondedAtom.hpp"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// Ring perception results of a structure: the minimal cycle basis and the rings each atom is part of.
+/// Atoms are referenced by their index in the structure, so the information is invalidated by any change of the
+/// structure.
+/// </summary>
+class RingInfo
+{
+public:
+    using Ring = std::vector<const BondedAtomBase*>;
+
+private:
+    static constexpr c_size WordBits = 64;
+
+    std::vector<Ring>     rings;
+    c_size                wordsPerAtom = 0;
+    // Bitset of the rings containing each atom, stored as wordsPerAtom words per atom.
+    std::vector<uint64_t> membership;
+
+public:
+    RingInfo(std::vector<Ring>&& rings, const c_size atomCount) noexcept;
+    RingInfo(const RingInfo&) = delete;
+    RingInfo(RingInfo&&)      = default;
+
+    const std::vector<Ring>& getRings() const;
+    c_size                   getRingCount() const;
+
+    /// <summary>
+    /// Complexity: O(r / 64), where r is the number of rings
+    /// </summary>
+    bool isRingAtom(const c_size atomIdx) const;
+    bool isInRing(const c_size atomIdx, const c_size ringIdx) const;
+    /// <summary>
+    /// Checks if the bond between the two adjacent atoms is part of a ring. Bonds between two atoms of the same
+    /// ring are either ring bonds or chords, which are part of a ring as well.
+    /// Complexity: O(r / 64), where r is the number of rings
+    /// </summary>
+    bool isRingBond(const c_size idxA, const c_size idxB) const;
+
+    size_t getHeapUsage() const;
+};
+
+/// <summary>
+/// Holds lazily computed ring information. Structures are read concurrently without locking, so the first
+/// computed value is published atomically and any concurrently computed duplicate is discarded.
+/// Copies start empty, since the ring information references the atoms of the copied structure.
+/// </summary>
+class RingInfoCache
+{
+private:
+    std::atomic<const RingInfo*> info = nullptr;
+
+public:
+    RingInfoCache() = default;
+    RingInfoCache(const RingInfoCache&) noexcept;
+    RingInfoCache(RingInfoCache&& other) noexcept;
+    ~RingInfoCache() noexcept;
+
+    RingInfoCache& operator=(const RingInfoCache&) = delete;
+    RingInfoCache& operator=(RingInfoCache&& other) noexcept;
+
+    /// <summary>
+    /// Returns the cached value or nullptr if nothing was cached yet.
+    /// </summary>
+    const RingInfo* get() const;
+    /// <summary>
+    /// Caches the value unless another value was cached in the meantime. Returns the cached value.
+    /// </summary>
+    const RingInfo& set(std::unique_ptr<const RingInfo>&& value);
+    /// <summary>
+    /// Discards the cached value. Must not be called concurrently with any other method.
+    /// </summary>
+    void reset();
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "molecules/ASCIICache.hpp"
 #include "molecules/MolecularStructure.hpp"
 #include "molecules/MoleculeId.hpp"
 
@@ -11,6 +12,9 @@ public:
 protected:
     MolecularStructure structure;
 
+private:
+    mutable ASCIICache ascii;
+
 public:
     GenericMoleculeData(const MoleculeId id, MolecularStructure&& structure) noexcept;
 
@@ -19,4 +23,19 @@ public:
     ~GenericMoleculeData()                          = default;
 
     const MolecularStructure& getStructure() const;
+
+    /// <summary>
+    /// Returns the ASCII rendering of the structure. Structures of molecules never change, so renderings are
+    /// computed once for each set of print options and reused afterwards.
+    /// </summary>
+    const ColoredTextBlock& toASCII(const ASCII::PrintOptions options = ASCII::PrintOptions::Default) const;
+    /// <summary>
+    /// Same as toASCII(options) but missing renderings are first looked up in (and added to) the layout store.
+    /// </summary>
+    const ColoredTextBlock& toASCII(const ASCII::PrintOptions options, const ASCIILayoutStore& layouts) const;
+
+    /// <summary>
+    /// Returns the approximate memory used by this definition, in bytes.
+    /// </summary>
+    size_t getMemoryUsage() const;
 };
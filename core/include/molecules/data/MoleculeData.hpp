@@ -60,6 +60,12 @@ public:
 
     const MolecularStructure& getStructure() const;
 
+    /// <summary>
+    /// Returns the approximate memory used by this definition, in bytes.
+    /// Estimators are shared and accounted for by the EstimatorRepository.
+    /// </summary>
+    size_t getMemoryUsage() const;
+
     void dumpDefinition(std::ostream& out, const bool prettify, std::unordered_set<EstimatorId>& alreadyPrinted) const;
     void print(std::ostream& out = std::cout) const;
 };
@@ -24,6 +24,11 @@ public:
 
     const MolecularStructure& getStructure() const;
 
+    /// <summary>
+    /// Returns the cached ASCII rendering of the structure, using the layout store of the data store.
+    /// </summary>
+    const ColoredTextBlock& toASCII(const ASCII::PrintOptions options = ASCII::PrintOptions::Default) const;
+
     Polarity getPolarity() const;
     Color    getColor() const;
 
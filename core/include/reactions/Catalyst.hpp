@@ -14,13 +14,13 @@ private:
 public:
     Catalyst(const Catalyst&) = default;
 
-    MoleculeId                         getId() const;
-    const MolecularStructure&          getStructure() const;
-    Amount<Unit::MOLE_RATIO>           getIdealAmount() const;
-    std::unordered_map<c_size, c_size> matchWith(const Catalyst& other) const;
-    std::unordered_map<c_size, c_size> matchWith(const MolecularStructure& structure) const;
-    bool                               matchesWith(const Catalyst& other) const;
-    bool                               matchesWith(const MolecularStructure& structure) const;
+    MoleculeId                getId() const;
+    const MolecularStructure& getStructure() const;
+    Amount<Unit::MOLE_RATIO>  getIdealAmount() const;
+    AtomMap                   matchWith(const Catalyst& other) const;
+    AtomMap                   matchWith(const MolecularStructure& structure) const;
+    bool                      matchesWith(const Catalyst& other) const;
+    bool                      matchesWith(const MolecularStructure& structure) const;
 
     bool operator==(const Catalyst& other) const;
     bool operator!=(const Catalyst& other) const;
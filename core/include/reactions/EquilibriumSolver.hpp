@@ -0,0 +1,100 @@
+#pragma once
+
+#include "reactions/KineticsSolver.hpp"
+
+/// <summary>
+/// Finds the equilibrium composition of a set of reversible reactions directly, by applying a damped
+/// Newton's method on their extents of reaction.
+/// Each reversible reaction is given by the rate laws of its forward and backward directions, in the same
+/// form as used by the KineticsSolver, the equilibrium being the state in which the two rates are equal for
+/// every reaction. Amounts are kept non-negative.
+/// </summary>
+class EquilibriumSolver
+{
+public:
+    using RateFunction = KineticsSolver::RateFunction;
+    using Term         = KineticsSolver::Term;
+
+private:
+    float_h relativeTolerance;
+    float_h absoluteTolerance;
+
+    // Species (SoA).
+    std::vector<float_h> initialAmounts;
+    std::vector<float_h> amounts;
+
+    // Reactions (SoA), the terms of reaction i are in: [termOffsets[i], termOffsets[i + 1]), the forward
+    // reactants being the first: reactantCounts[i] terms.
+    std::vector<RateFunction> forwardRates;
+    std::vector<RateFunction> backwardRates;
+    std::vector<float_h>      extents;
+    std::vector<size_t>       termOffsets = {0};
+    std::vector<size_t>       reactantCounts;
+
+    // Terms (SoA), forward reactant coefficients are negative.
+    std::vector<size_t>  termSpecies;
+    std::vector<float_h> termCoefficients;
+
+    size_t getReactionCount() const;
+
+    void getAmounts(const std::vector<float_h>& extents, std::vector<float_h>& result) const;
+
+    /// <summary>
+    /// Returns the factor by which the rate of a direction is scaled down as its limiting species runs out,
+    /// same as done by the KineticsSolver.
+    /// </summary>
+    float_h getAvailability(const std::vector<float_h>& state, const size_t termBegin, const size_t termEnd) const;
+    void getRates(
+        const std::vector<float_h>& state, const size_t reactionIdx, float_h& forward, float_h& backward) const;
+
+    /// <summary>
+    /// Computes the net rates (forward - backward) of every reaction, scaled by the given scales.
+    /// </summary>
+    void getResiduals(
+        const std::vector<float_h>& state, const std::vector<float_h>& scales, std::vector<float_h>& result) const;
+
+    /// <summary>
+    /// Computes the gross rate (max(forward, backward)) of every reaction, used to scale its net rate.
+    /// </summary>
+    void getScales(const std::vector<float_h>& state, std::vector<float_h>& result) const;
+
+public:
+    EquilibriumSolver(const float_h relativeTolerance = 1e-4, const float_h absoluteTolerance = 1e-6) noexcept;
+    EquilibriumSolver(const EquilibriumSolver&) = default;
+    EquilibriumSolver(EquilibriumSolver&&)      = default;
+
+    float_h getRelativeTolerance() const;
+    float_h getAbsoluteTolerance() const;
+
+    size_t addSpecies(const float_h amount);
+
+    void addReaction(
+        std::vector<Term>&& reactants,
+        std::vector<Term>&& products,
+        RateFunction&&      forwardRate,
+        RateFunction&&      backwardRate);
+
+    float_h getAmount(const size_t speciesIdx) const;
+
+    /// <summary>
+    /// Returns the extent of the reaction in the forward direction since the last reset, in moles of reaction.
+    /// </summary>
+    float_h getExtent(const size_t reactionIdx) const;
+
+    /// <summary>
+    /// Returns the largest relative net rate: |forward - backward| / max(forward, backward), over all of the
+    /// reactions. Values close to 0 indicate that the system is close to equilibrium.
+    /// </summary>
+    float_h getImbalance() const;
+
+    /// <summary>
+    /// Moves the system to equilibrium, returning false if the solution didn't converge. Unconverged
+    /// solutions are still closer to equilibrium than the initial state.
+    /// </summary>
+    bool solve();
+
+    /// <summary>
+    /// Removes all species and reactions, keeping the tolerances.
+    /// </summary>
+    void reset();
+};
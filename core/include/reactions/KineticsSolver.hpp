@@ -0,0 +1,152 @@
+#pragma once
+
+#include "global/Precision.hpp"
+
+#include <functional>
+#include <vector>
+
+/// <summary>
+/// Integrates reaction rate systems of the form: dn/dt = S * r(n), where n holds the species amounts,
+/// S the stoichiometric matrix and r the reaction rates, using an adaptive second order Rosenbrock
+/// method (ROS2) with an embedded first order error estimate.
+/// Being linearly implicit, it remains stable for stiff systems and allows timespans much larger than
+/// the time scale of the fastest reaction.
+/// The rate law of each reaction depends only on the summed amount of its reactants, and is scaled down
+/// smoothly as its limiting reactant runs out, so the Jacobian is sparse: per reaction, a derivative
+/// shared by all of its reactant columns plus one for the limiting reactant column.
+/// The linear systems of each step are stored in CSR form and solved by a sparse LU factorization, whose
+/// pattern (fill-in included) only depends on which species take part in which reactions.
+/// </summary>
+class KineticsSolver
+{
+public:
+    using RateFunction = std::function<float_h(const float_h reactantAmount)>;
+    using Term         = std::pair<size_t, float_h>;
+
+private:
+    static constexpr float_h Gamma = 1.0 + 0.70710678118654752;
+
+    struct Jacobian
+    {
+        std::vector<float_h> derivatives;
+        std::vector<float_h> limitDerivatives;
+        std::vector<size_t>  limitTerms;
+    };
+
+    /// <summary>
+    /// The matrix: I - gamma * h * J in CSR form, with the rows and columns permuted into elimination order.
+    /// The pattern includes the fill-in of the factorization, so that the LU factors can replace the values
+    /// in place (L having an implied unit diagonal).
+    /// </summary>
+    struct StepMatrix
+    {
+        // Elimination position of each species.
+        std::vector<size_t>  positions;
+        std::vector<size_t>  rowOffsets;
+        std::vector<size_t>  columns;
+        std::vector<size_t>  diagonals;
+        std::vector<float_h> values;
+        // For each reaction i, each of its terms t and each of its reactant terms r, in this order, the index of
+        // the entry (species of t, species of r), starting from: entryOffsets[i].
+        std::vector<size_t>  entryOffsets;
+        std::vector<size_t>  entries;
+        bool                 isOutdated = true;
+    };
+
+    float_h relativeTolerance;
+    float_h absoluteTolerance;
+    float_h lastTimestep = 0.0;
+
+    // Species (SoA).
+    std::vector<float_h> amounts;
+
+    // Reactions (SoA), the terms of reaction i are in: [termOffsets[i], termOffsets[i + 1]), the reactants
+    // being the first: reactantCounts[i] terms.
+    std::vector<RateFunction> rates;
+    std::vector<float_h>      extents;
+    std::vector<size_t>       termOffsets = {0};
+    std::vector<size_t>       reactantCounts;
+
+    // Terms (SoA), reactant coefficients are negative.
+    std::vector<size_t>  termSpecies;
+    std::vector<float_h> termCoefficients;
+
+    StepMatrix           stepMatrix;
+    std::vector<float_h> workspace;
+
+    size_t getReactionCount() const;
+
+    void getReactantAmounts(
+        const std::vector<float_h>& state,
+        const size_t                reactionIdx,
+        float_h&                    total,
+        float_h&                    limit,
+        size_t&                     limitTerm) const;
+
+    /// <summary>
+    /// Returns the factor by which rates are scaled down as the limiting reactant runs out, ensuring that
+    /// reactions stop smoothly instead of overshooting into negative amounts.
+    /// </summary>
+    float_h getAvailability(const float_h limit) const;
+
+    void getRates(const std::vector<float_h>& state, std::vector<float_h>& result) const;
+    void getJacobian(const std::vector<float_h>& state, Jacobian& result) const;
+
+    /// <summary>
+    /// Computes: result = S * reactionValues.
+    /// </summary>
+    void toSpecies(const std::vector<float_h>& reactionValues, std::vector<float_h>& result) const;
+
+    /// <summary>
+    /// Computes: result = base + scale * D * speciesValues, where D is the rate Jacobian.
+    /// </summary>
+    void toReactions(
+        const std::vector<float_h>& base,
+        const float_h               scale,
+        const Jacobian&             jacobian,
+        const std::vector<float_h>& speciesValues,
+        std::vector<float_h>&       result) const;
+
+    /// <summary>
+    /// Computes the pattern of the step matrix and of its LU factors, eliminating the species which take part in
+    /// the fewest reactions first to limit the fill-in.
+    /// </summary>
+    void buildStepPattern();
+
+    /// <summary>
+    /// Fills and factorizes: I - gamma * h * S * D. Returns false if a pivot vanishes, since the factorization
+    /// doesn't pivot.
+    /// </summary>
+    bool factorizeStepMatrix(const float_h timestep, const Jacobian& jacobian);
+
+    void solve(const std::vector<float_h>& rhs, std::vector<float_h>& result);
+
+public:
+    KineticsSolver(const float_h relativeTolerance = 1e-3, const float_h absoluteTolerance = 1e-6) noexcept;
+    KineticsSolver(const KineticsSolver&) = default;
+    KineticsSolver(KineticsSolver&&)      = default;
+
+    float_h getRelativeTolerance() const;
+    float_h getAbsoluteTolerance() const;
+
+    size_t addSpecies(const float_h amount);
+    void   addReaction(std::vector<Term>&& reactants, std::vector<Term>&& products, RateFunction&& rate);
+
+    float_h getAmount(const size_t speciesIdx) const;
+
+    /// <summary>
+    /// Returns the total extent of the reaction since the last reset, in moles of reaction.
+    /// </summary>
+    float_h getExtent(const size_t reactionIdx) const;
+
+    /// <summary>
+    /// Integrates the system over the given timespan and returns the number of accepted steps.
+    /// The last accepted timestep is kept as the initial guess for the next call.
+    /// </summary>
+    size_t integrate(const float_h timespan);
+
+    /// <summary>
+    /// Removes all species and reactions, keeping the tolerances and the last timestep.
+    /// </summary>
+    void reset();
+};
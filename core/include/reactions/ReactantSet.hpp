@@ -2,16 +2,27 @@
 
 #include "reactions/Reactant.hpp"
 
+#include <memory>
 #include <unordered_map>
 
 class Mixture;
 class Catalyst;
 
+/// <summary>
+/// Set of reactants, indexed by molecule and layer.
+/// The reactants can be shared with other sets through share(), in which case they are only copied once the set
+/// changes. Shared reactants stay bound to the container of the set that made them shareable, which must not
+/// change anymore and is kept alive by the sets sharing them.
+/// </summary>
 class ReactantSet
 {
 private:
-    Ref<Mixture>                             container;
-    std::unordered_map<ReactantId, Reactant> reactants;
+    using Map = std::unordered_map<ReactantId, Reactant>;
+
+    Ref<Mixture>                   container;
+    Map                            reactants;
+    std::shared_ptr<const Map>     sharedReactants;
+    std::shared_ptr<const Mixture> owner;
 
     ReactantSet(const ReactantSet& other, const Ref<Mixture> newContainer) noexcept;
 
@@ -21,6 +32,8 @@ public:
     ReactantSet(const std::vector<Reactant>& reactants) noexcept;
     ReactantSet(ReactantSet&&) = default;
 
+    ReactantSet& operator=(ReactantSet&&) = default;
+
     using pairT          = std::pair<ReactantId, Reactant>;
     using const_iterator = std::unordered_map<ReactantId, Reactant>::const_iterator;
     using iterator       = std::unordered_map<ReactantId, Reactant>::iterator;
@@ -30,7 +43,10 @@ public:
 
     bool contains(const ReactantId& reactantId) const;
 
-    void add(const Reactant& reactant);
+    /// <summary>
+    /// Returns false if the reactant was rejected, which happens when removing a reactant which isn't in the set.
+    /// </summary>
+    bool add(const Reactant& reactant);
     void add(const ReactantSet& other);
 
     /// <summary>
@@ -58,5 +74,29 @@ public:
     bool operator==(const ReactantSet& other) const;
     bool operator!=(const ReactantSet& other) const;
 
+    /// <summary>
+    /// Returns a copy bound to the given container. Reactants shared with a kept alive owner are not copied.
+    /// </summary>
     ReactantSet makeCopy(const Ref<Mixture> newContainer) const;
+
+    bool isShared() const;
+
+    /// <summary>
+    /// Copies the shared reactants, binding them to the container of this set. Called before any change of the
+    /// set, and by containers before any change of the state their reactants read (temperatures, pressure).
+    /// </summary>
+    void detach();
+
+    /// <summary>
+    /// Binds the reactants to the given container, which must not change anymore, and moves them into shared
+    /// storage. Afterwards, share() can be called on this set.
+    /// </summary>
+    void makeShareable(const Ref<Mixture> newContainer);
+
+    /// <summary>
+    /// Returns a set holding the same reactants without copying them. Unless the reactants already have an
+    /// owner, the given owner has to be the container of this set. Owners are kept alive for as long as their
+    /// reactants are shared. Sets which aren't shareable are copied.
+    /// </summary>
+    ReactantSet share(const Ref<Mixture> newContainer, const std::shared_ptr<const Mixture>& owner) const;
 };
@@ -45,6 +45,11 @@ public:
 
     std::string print() const;
 
+    /// <summary>
+    /// Returns the approximate heap memory owned by the network, excluding the reactions themselves, in bytes.
+    /// </summary>
+    size_t getHeapUsage() const;
+
     void clear();
 
     static constexpr size_t npos = decltype(graph)::npos;
@@ -29,6 +29,11 @@ public:
 
     size_t totalDefinitionCount() const;
 
+    /// <summary>
+    /// Returns the approximate memory used by the repository, its definitions and the reaction network, in bytes.
+    /// </summary>
+    size_t getMemoryUsage() const;
+
     using Iterator = std::unordered_map<ReactionId, std::unique_ptr<ReactionData>>::const_iterator;
     Iterator begin() const;
     Iterator end() const;
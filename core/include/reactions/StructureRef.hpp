@@ -17,10 +17,11 @@ public:
 
     MoleculeId                getId() const;
     const MolecularStructure& getStructure() const;
+    const ColoredTextBlock&   toASCII(const ASCII::PrintOptions options = ASCII::PrintOptions::Default) const;
 
-    std::unordered_map<c_size, c_size> matchWith(const MolecularStructure& structure) const;
-    std::unordered_map<c_size, c_size> matchWith(const StructureRef& other) const;
-    bool                               matchesWith(const StructureRef& other) const;
+    AtomMap matchWith(const MolecularStructure& structure) const;
+    AtomMap matchWith(const StructureRef& other) const;
+    bool    matchesWith(const StructureRef& other) const;
 
     bool operator==(const StructureRef& other) const;
     bool operator!=(const StructureRef& other) const;
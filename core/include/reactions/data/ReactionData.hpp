@@ -23,6 +23,12 @@ private:
         std::vector<std::pair<StructureRef, uint8_t>>& reactants,
         std::vector<std::pair<StructureRef, uint8_t>>& products);
 
+    /// <summary>
+    /// Limits each reactant-to-product mapping search, so that loading a pathological reaction definition stays
+    /// bounded. Only a node limit is used, as a time limit would make the loaded mappings machine dependent.
+    /// </summary>
+    static constexpr MappingBudget MappingSearchBudget{.nodeCount = 1 << 14};
+
     /// <summary>
     /// Maps every component from reactants to every component from products.
     /// Complexity: large
@@ -39,11 +45,13 @@ public:
     const EstimatorRef<Unit::NONE, Unit::MOLE_RATIO>         concSpeedEstimator;
 
 private:
-    Ref<const ReactionData>                                                  baseReaction = NullRef;
-    std::vector<StructureRef>                                                reactants;
-    std::vector<StructureRef>                                                products;
-    ImmutableSet<Catalyst>                                                   catalysts;
-    std::unordered_map<std::pair<size_t, c_size>, std::pair<size_t, c_size>> componentMapping;
+    Ref<const ReactionData>   baseReaction = NullRef;
+    std::vector<StructureRef> reactants;
+    std::vector<StructureRef> products;
+    ImmutableSet<Catalyst>    catalysts;
+
+    // Maps the radical atoms of the reactants to the atoms of the products, as pairs of component and atom indices.
+    std::vector<std::pair<std::pair<size_t, c_size>, std::pair<size_t, c_size>>> componentMapping;
 
 public:
     ReactionData(
@@ -76,31 +84,29 @@ public:
     /// Tries to map the i-th molecule in the given vector with i-th reactant of the reaction.
     /// If successful, a non-empty vector of atom maps is returned.
     /// </summary>
-    std::vector<std::unordered_map<c_size, c_size>>
-    generateConcreteReactantMatches(const std::vector<Reactant>& molecules) const;
+    std::vector<AtomMap> generateConcreteReactantMatches(const std::vector<Reactant>& molecules) const;
 
     /// <summary>
     /// Tries to map one of the products of the reaction to the given target molecule.
     /// If successful, the index of the product and an atom map are returned,
     /// otherwise npos is returned.
     /// </summary>
-    std::pair<size_t, std::unordered_map<c_size, c_size>>
-    generateRetrosynthProductMatches(const StructureRef& targetProduct) const;
+    std::pair<size_t, AtomMap> generateRetrosynthProductMatches(const StructureRef& targetProduct) const;
 
     /// <summary>
     /// Generates the concrete products of the reaction for the given molecules, using the matches
     /// resulted from generateConcreteReactantMatches(...).
     /// </summary>
-    std::vector<Molecule> generateConcreteProducts(
-        const std::vector<Reactant>& molecules, const std::vector<std::unordered_map<c_size, c_size>>& matches) const;
+    std::vector<Molecule>
+    generateConcreteProducts(const std::vector<Reactant>& molecules, const std::vector<AtomMap>& matches) const;
 
     /// <summary>
     /// Generates the concrete reactants of the reaction leading to the given target, using the
     /// matches resulted from generateConcreteProductMatches(...). Radical atoms which unmatched by
     /// the target remain unsubstituted in the resulted reactants.
     /// </summary>
-    RetrosynthReaction generateRetrosynthReaction(
-        const StructureRef& targetProduct, const std::pair<size_t, std::unordered_map<c_size, c_size>>& match) const;
+    RetrosynthReaction
+    generateRetrosynthReaction(const StructureRef& targetProduct, const std::pair<size_t, AtomMap>& match) const;
 
     const std::vector<StructureRef>& getReactants() const;
     const std::vector<StructureRef>& getProducts() const;
@@ -118,6 +124,12 @@ public:
 
     std::string getHRTag() const;
 
+    /// <summary>
+    /// Returns the approximate memory used by this definition, in bytes.
+    /// Reactant and product structures are shared and accounted for by the MoleculeRepository.
+    /// </summary>
+    size_t getMemoryUsage() const;
+
     void dumpDefinition(std::ostream& out, const bool prettify, std::unordered_set<EstimatorId>& alreadyPrinted) const;
     void print(std::ostream& out = std::cout) const;
 
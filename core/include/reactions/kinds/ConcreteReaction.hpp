@@ -44,11 +44,16 @@ struct std::hash<ConcreteReaction>
 {
     size_t operator()(const ConcreteReaction& reaction) const
     {
-        size_t hash = 0;
+        // Reactant sets are unordered and equal sets might iterate in different orders, so the hashes of their
+        // elements are summed.
+        size_t reactantsHash = 0;
         for (const auto& [rId, _] : reaction.reactants)
-            utils::hashCombineWith(hash, rId);
+            reactantsHash += std::hash<ReactantId>()(rId);
+        size_t productsHash = 0;
         for (const auto& [pId, _] : reaction.products)
-            utils::hashCombineWith(hash, pId);
+            productsHash += std::hash<ReactantId>()(pId);
+
+        size_t hash = utils::hashCombine(reactantsHash, productsHash);
         for (const auto& cat : reaction.baseReaction.getCatalysts())
             utils::hashCombineWith(hash, cat.getId());
         return hash;
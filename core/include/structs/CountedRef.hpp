@@ -3,6 +3,7 @@
 #include "io/Log.hpp"
 #include "utils/Casts.hpp"
 
+#include <atomic>
 #include <type_traits>
 
 template <typename CountT>
@@ -23,12 +24,16 @@ class Countable
     static_assert(std::is_integral_v<CountT>, "Countable: CountT must be an integral type.");
 
 private:
-    mutable CountT count = 0;
+    // Atomic since shared objects might be referenced from multiple threads.
+    mutable std::atomic<CountT> count = 0;
 
 public:
-    Countable()                 = default;
-    Countable(const Countable&) = default;
-    Countable(Countable&&)      = default;
+    Countable() = default;
+    /// <summary>
+    /// Copies start with no references.
+    /// </summary>
+    Countable(const Countable&) noexcept;
+    Countable(Countable&&) noexcept;
     virtual ~Countable();
 
     CountT getRefCount() const;
@@ -37,6 +42,14 @@ public:
     friend class CountedRef;
 };
 
+template <typename CountT>
+Countable<CountT>::Countable(const Countable&) noexcept
+{}
+
+template <typename CountT>
+Countable<CountT>::Countable(Countable&&) noexcept
+{}
+
 template <typename CountT>
 Countable<CountT>::~Countable()
 {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "utils/Memory.hpp"
+
 #include <vector>
 
 /// <summary>
@@ -63,6 +65,12 @@ public:
 
     size_t size() const;
 
+    /// <summary>
+    /// Returns the approximate heap memory owned by the nodes and the adjacency matrix, in bytes.
+    /// Complexity: O(n)
+    /// </summary>
+    size_t getHeapUsage() const;
+
     void clear();
 
     const NodeT& operator[](const size_t idx) const;
@@ -180,6 +188,15 @@ size_t DirectedGraph<NodeT>::size() const
     return nodes.size();
 }
 
+template <class NodeT>
+size_t DirectedGraph<NodeT>::getHeapUsage() const
+{
+    auto usage = utils::getHeapUsage(nodes) + utils::getHeapUsage(edges);
+    for (const auto& e : edges)
+        usage += utils::getHeapUsage(e);
+    return usage;
+}
+
 template <class NodeT>
 void DirectedGraph<NodeT>::clear()
 {
@@ -57,11 +57,16 @@ public:
     void remove(const FlagField<EnumT> flags);
     bool has(const FlagField<EnumT> flags) const;
 
+    StorageT toUnderlying() const;
+
     FlagField<EnumT> operator|(const FlagField<EnumT> other) const;
     FlagField<EnumT> operator&(const FlagField<EnumT> other) const;
     FlagField<EnumT> operator^(const FlagField<EnumT> other) const;
     FlagField<EnumT> operator-(const FlagField<EnumT> other) const;
 
+    bool operator==(const FlagField<EnumT> other) const;
+    bool operator!=(const FlagField<EnumT> other) const;
+
     FlagIterator<EnumT> begin() const;
     FlagIterator<EnumT> end() const;
 
@@ -156,6 +161,12 @@ bool FlagField<EnumT>::has(const FlagField<EnumT> flags) const
     return (field & flags.field) != 0;
 }
 
+template <typename EnumT>
+typename FlagField<EnumT>::StorageT FlagField<EnumT>::toUnderlying() const
+{
+    return field;
+}
+
 template <typename EnumT>
 FlagField<EnumT> FlagField<EnumT>::operator|(const FlagField<EnumT> other) const
 {
@@ -180,6 +191,18 @@ FlagField<EnumT> FlagField<EnumT>::operator-(const FlagField<EnumT> other) const
     return this->field & ~other.field;
 }
 
+template <typename EnumT>
+bool FlagField<EnumT>::operator==(const FlagField<EnumT> other) const
+{
+    return this->field == other.field;
+}
+
+template <typename EnumT>
+bool FlagField<EnumT>::operator!=(const FlagField<EnumT> other) const
+{
+    return this->field != other.field;
+}
+
 template <typename EnumT>
 FlagIterator<EnumT> FlagField<EnumT>::begin() const
 {
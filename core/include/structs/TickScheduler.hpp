@@ -0,0 +1,129 @@
+#pragma once
+
+#include "data/values/Amount.hpp"
+#include "structs/FlagField.hpp"
+#include "utils/Math.hpp"
+
+#include <array>
+#include <limits>
+#include <optional>
+
+/// <summary>
+/// Schedules the phases of a periodic update, each phase being identified by a single-bit value of EnumT.
+/// A phase is due once its interval has elapsed and it receives the whole timespan accumulated since its
+/// last run, so slow phases can be batched over multiple ticks.
+/// The updated state is tracked through a revision counter: a phase whose last run left the revision
+/// unchanged is skipped until something else changes it, in which case the skipped time is discarded.
+/// </summary>
+template <typename EnumT>
+class TickScheduler
+{
+public:
+    using Revision = uint64_t;
+
+private:
+    using StorageT = std::underlying_type_t<EnumT>;
+
+    static constexpr Revision NoRevision = std::numeric_limits<Revision>::max();
+
+    struct Phase
+    {
+        Amount<Unit::SECOND> interval     = 0.0;
+        Amount<Unit::SECOND> elapsed      = 0.0;
+        Revision             runRevision  = NoRevision;
+        Revision             idleRevision = NoRevision;
+    };
+
+    std::array<Phase, sizeof(StorageT) * 8> phases;
+
+    Phase&       getPhase(const EnumT phase);
+    const Phase& getPhase(const EnumT phase) const;
+
+public:
+    TickScheduler() = default;
+
+    Amount<Unit::SECOND> getInterval(const EnumT phase) const;
+    void                 setInterval(const EnumT phase, const Amount<Unit::SECOND> interval);
+
+    /// <summary>
+    /// Adds the timespan to the given phases only, so that disabled phases don't accumulate the time they were
+    /// disabled for.
+    /// </summary>
+    void advance(const Amount<Unit::SECOND> timespan, const FlagField<EnumT> enabled);
+
+    /// <summary>
+    /// If the phase is due at the given revision, returns the timespan it has to run for.
+    /// Every run must be followed by a call to end().
+    /// </summary>
+    std::optional<Amount<Unit::SECOND>> begin(const EnumT phase, const Revision revision);
+    void                                end(const EnumT phase, const Revision revision);
+
+    /// <summary>
+    /// Makes all of the phases run once they are due, regardless of the revision.
+    /// </summary>
+    void invalidate();
+};
+
+template <typename EnumT>
+typename TickScheduler<EnumT>::Phase& TickScheduler<EnumT>::getPhase(const EnumT phase)
+{
+    return phases[utils::ilog2(static_cast<StorageT>(phase))];
+}
+
+template <typename EnumT>
+const typename TickScheduler<EnumT>::Phase& TickScheduler<EnumT>::getPhase(const EnumT phase) const
+{
+    return phases[utils::ilog2(static_cast<StorageT>(phase))];
+}
+
+template <typename EnumT>
+Amount<Unit::SECOND> TickScheduler<EnumT>::getInterval(const EnumT phase) const
+{
+    return getPhase(phase).interval;
+}
+
+template <typename EnumT>
+void TickScheduler<EnumT>::setInterval(const EnumT phase, const Amount<Unit::SECOND> interval)
+{
+    getPhase(phase).interval = interval;
+}
+
+template <typename EnumT>
+void TickScheduler<EnumT>::advance(const Amount<Unit::SECOND> timespan, const FlagField<EnumT> enabled)
+{
+    const auto mask = enabled.toUnderlying();
+    for (size_t i = 0; i < phases.size(); ++i)
+        if (mask & (StorageT(1) << i))
+            phases[i].elapsed += timespan;
+}
+
+template <typename EnumT>
+std::optional<Amount<Unit::SECOND>> TickScheduler<EnumT>::begin(const EnumT phase, const Revision revision)
+{
+    auto& p = getPhase(phase);
+    if (p.elapsed < p.interval)
+        return std::nullopt;
+
+    const auto timespan = p.elapsed;
+    p.elapsed           = 0.0;
+    if (revision == p.idleRevision)
+        return std::nullopt;
+
+    p.runRevision = revision;
+    return timespan;
+}
+
+template <typename EnumT>
+void TickScheduler<EnumT>::end(const EnumT phase, const Revision revision)
+{
+    // Phases which changed the state are run again, since they might not have reached a steady state yet.
+    auto& p        = getPhase(phase);
+    p.idleRevision = revision == p.runRevision ? revision : NoRevision;
+}
+
+template <typename EnumT>
+void TickScheduler<EnumT>::invalidate()
+{
+    for (auto& p : phases)
+        p.idleRevision = NoRevision;
+}
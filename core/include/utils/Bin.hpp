@@ -5,6 +5,7 @@
 #include <istream>
 #include <optional>
 #include <ostream>
+#include <string>
 
 namespace bin
 {
@@ -62,6 +63,13 @@ public:
 };
 
 }  // namespace details
+
+/// <summary>
+/// Reads the given number of chars in chunks, so that a corrupt size only allocates as much as the stream holds.
+/// Callers are expected to bound the size beforehand.
+/// </summary>
+std::optional<std::string> parseChars(std::istream& is, const size_t size);
+
 }  // namespace bin
 
 namespace utils
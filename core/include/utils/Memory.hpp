@@ -0,0 +1,89 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/// <summary>
+/// Approximations of the heap memory owned by standard containers, excluding the size of the container
+/// object itself and any memory owned by the contained elements.
+/// Node-based containers are estimated using the common implementation layouts (node links, cached hash).
+/// </summary>
+namespace utils
+{
+
+inline size_t getHeapUsage(const std::string& str);
+
+template <typename T, typename AllocT>
+size_t getHeapUsage(const std::vector<T, AllocT>& vector);
+
+template <typename KeyT, typename ObjT, typename HashT, typename EqualT, typename AllocT>
+size_t getHeapUsage(const std::unordered_map<KeyT, ObjT, HashT, EqualT, AllocT>& map);
+
+template <typename KeyT, typename ObjT, typename HashT, typename EqualT, typename AllocT>
+size_t getHeapUsage(const std::unordered_multimap<KeyT, ObjT, HashT, EqualT, AllocT>& map);
+
+template <typename KeyT, typename HashT, typename EqualT, typename AllocT>
+size_t getHeapUsage(const std::unordered_set<KeyT, HashT, EqualT, AllocT>& set);
+
+template <typename KeyT, typename ObjT, typename CompareT, typename AllocT>
+size_t getHeapUsage(const std::map<KeyT, ObjT, CompareT, AllocT>& map);
+
+template <typename KeyT, typename CompareT, typename AllocT>
+size_t getHeapUsage(const std::set<KeyT, CompareT, AllocT>& set);
+
+}  // namespace utils
+
+inline size_t utils::getHeapUsage(const std::string& str)
+{
+    // Short strings are stored inline.
+    const auto* data  = reinterpret_cast<const char*>(str.data());
+    const auto* begin = reinterpret_cast<const char*>(&str);
+    if (data >= begin && data < begin + sizeof(str))
+        return 0;
+
+    return str.capacity() + 1;
+}
+
+template <typename T, typename AllocT>
+size_t utils::getHeapUsage(const std::vector<T, AllocT>& vector)
+{
+    return vector.capacity() * sizeof(T);
+}
+
+template <typename KeyT, typename ObjT, typename HashT, typename EqualT, typename AllocT>
+size_t utils::getHeapUsage(const std::unordered_map<KeyT, ObjT, HashT, EqualT, AllocT>& map)
+{
+    using NodeT = std::pair<const KeyT, ObjT>;
+    return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(NodeT) + sizeof(void*) + sizeof(size_t));
+}
+
+template <typename KeyT, typename ObjT, typename HashT, typename EqualT, typename AllocT>
+size_t utils::getHeapUsage(const std::unordered_multimap<KeyT, ObjT, HashT, EqualT, AllocT>& map)
+{
+    using NodeT = std::pair<const KeyT, ObjT>;
+    return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(NodeT) + sizeof(void*) + sizeof(size_t));
+}
+
+template <typename KeyT, typename HashT, typename EqualT, typename AllocT>
+size_t utils::getHeapUsage(const std::unordered_set<KeyT, HashT, EqualT, AllocT>& set)
+{
+    return set.bucket_count() * sizeof(void*) + set.size() * (sizeof(KeyT) + sizeof(void*) + sizeof(size_t));
+}
+
+template <typename KeyT, typename ObjT, typename CompareT, typename AllocT>
+size_t utils::getHeapUsage(const std::map<KeyT, ObjT, CompareT, AllocT>& map)
+{
+    using NodeT = std::pair<const KeyT, ObjT>;
+    return map.size() * (sizeof(NodeT) + 3 * sizeof(void*) + sizeof(int));
+}
+
+template <typename KeyT, typename CompareT, typename AllocT>
+size_t utils::getHeapUsage(const std::set<KeyT, CompareT, AllocT>& set)
+{
+    return set.size() * (sizeof(KeyT) + 3 * sizeof(void*) + sizeof(int));
+}
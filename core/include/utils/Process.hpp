@@ -1,6 +1,7 @@
 #pragma once
 
 #include <bitset>
+#include <cstddef>
 #include <cstdint>
 
 namespace OS
@@ -25,6 +26,11 @@ constexpr uint8_t MaxPocressorCount = 64;
 using ProcessorIndex                = uint8_t;
 using ProcessorAffinityMask         = std::bitset<MaxPocressorCount>;
 
+/// <summary>
+/// Returns the resident memory (working set) of the current process, in bytes.
+/// </summary>
+size_t getCurrentProcessMemoryUsage();
+
 ProcessorAffinityMask getAvailableProcessorMask();
 ProcessorAffinityMask getAvailablePhysicalProcessorMask();
 ProcessorAffinityMask setCurrentThreadProcessorAffinity(const ProcessorAffinityMask mask);
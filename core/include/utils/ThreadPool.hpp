@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// Fixed-size pool of worker threads with per-worker task queues and work stealing.
+/// Submitted tasks are distributed round-robin over the worker queues. Each worker consumes its own
+/// queue from the back and, once empty, steals from the front of the other queues, which keeps all the
+/// cores busy when task durations vary widely.
+/// </summary>
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread>                  workers;
+
+    std::atomic<size_t> nextQueue = 0;
+    bool                stopping  = false;
+
+    // Guarded by idleMutex when incremented, so that sleeping workers can't miss new tasks.
+    std::atomic<size_t>     queuedCount = 0;
+    std::mutex              idleMutex;
+    std::condition_variable idleCondition;
+
+    std::atomic<size_t>     pendingCount = 0;
+    std::mutex              doneMutex;
+    std::condition_variable doneCondition;
+
+    bool tryPop(const size_t workerIdx, Task& task);
+    bool trySteal(const size_t workerIdx, Task& task);
+    void runWorker(const size_t workerIdx);
+
+public:
+    /// <summary>
+    /// Creates a pool with the given number of threads. If 0, the hardware concurrency is used.
+    /// </summary>
+    ThreadPool(const size_t threadCount = 0) noexcept;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&)      = delete;
+    ~ThreadPool() noexcept;
+
+    size_t getThreadCount() const;
+
+    void submit(Task&& task);
+
+    /// <summary>
+    /// Blocks until all the submitted tasks have completed.
+    /// </summary>
+    void wait();
+};
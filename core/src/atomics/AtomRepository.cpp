@@ -4,10 +4,40 @@
 #include "data/values/DynamicAmount.hpp"
 #include "io/Log.hpp"
 #include "utils/Build.hpp"
+#include "utils/Memory.hpp"
 #include "utils/STL.hpp"
 
 #include <fstream>
 
+size_t AtomRepository::getShortSymbolIdx(const std::string_view symbol)
+{
+    if (symbol.empty() || symbol.size() > 2)
+        return npos;
+
+    const auto first = symbol[0];
+    if (not std::isalpha(static_cast<unsigned char>(first)))
+        return npos;
+
+    const size_t row = std::isupper(static_cast<unsigned char>(first)) ? first - 'A' : 26 + (first - 'a');
+    if (symbol.size() == 1)
+        return row * 27;
+
+    const auto second = symbol[1];
+    return std::islower(static_cast<unsigned char>(second)) ? row * 27 + 1 + (second - 'a') : npos;
+}
+
+void AtomRepository::indexSymbol(const AtomBaseData& data)
+{
+    const auto id = data.symbol.getId();
+    if (id >= symbolIndex.size())
+        symbolIndex.resize(id + 1, nullptr);
+    symbolIndex[id] = &data;
+
+    const auto idx = getShortSymbolIdx(data.symbol.str());
+    if (idx != npos)
+        shortSymbols[idx] = &data;
+}
+
 template <>
 bool AtomRepository::add<AtomData>(const def::Object& definition)
 {
@@ -27,10 +57,12 @@ bool AtomRepository::add<AtomData>(const def::Object& definition)
     }
 
     auto data = std::make_unique<AtomData>(std::move(*symbol), std::move(*name), *weight, std::move(*valences));
+    const auto& inserted = *data;
     if (not atoms.emplace(data->symbol, std::move(data)).second) {
         Log(this).warn("Atom with duplicate symbol: '{}' skipped.", data->symbol);
         return false;
     }
+    indexSymbol(inserted);
 
     definition.logUnusedWarnings();
     return true;
@@ -114,10 +146,12 @@ bool AtomRepository::add<RadicalData>(const def::Object& definition)
     }
 
     auto data = std::make_unique<RadicalData>(std::move(*symbol), std::move(name), minWeight, std::move(matchSet));
+    const auto& inserted = *data;
     if (not atoms.emplace(data->symbol, std::move(data)).second) {
         Log(this).warn("Radical with duplicate symbol: '{}' skipped.", data->symbol);
         return false;
     }
+    indexSymbol(inserted);
 
     definition.logUnusedWarnings();
     return true;
@@ -125,25 +159,48 @@ bool AtomRepository::add<RadicalData>(const def::Object& definition)
 
 const AtomBaseData* AtomRepository::find(const Symbol& symbol) const
 {
-    const auto aIt = atoms.find(symbol);
-    return aIt != atoms.end() ? aIt->second.get() : nullptr;
+    const auto id = symbol.getId();
+    return id < symbolIndex.size() ? symbolIndex[id] : nullptr;
 }
 
-bool AtomRepository::contains(const Symbol& symbol) const { return atoms.contains(symbol); }
+bool AtomRepository::contains(const Symbol& symbol) const { return find(symbol) != nullptr; }
 
 const AtomBaseData& AtomRepository::at(const Symbol& symbol) const
 {
-    if (const auto aIt = atoms.find(symbol); aIt != atoms.end())
-        return *aIt->second;
+    if (const auto data = find(symbol))
+        return *data;
 
     Log(this).fatal("Tried to access an atom using an undefined symbol: '{}'", symbol);
     CHG_UNREACHABLE();
 }
 
+const AtomBaseData* AtomRepository::findSymbol(const std::string_view symbol) const
+{
+    if (const auto idx = getShortSymbolIdx(symbol); idx != npos)
+        return shortSymbols[idx];
+
+    const auto interned = Symbol::find(symbol);
+    return interned ? find(*interned) : nullptr;
+}
+
 size_t AtomRepository::totalDefinitionCount() const { return atoms.size(); }
 
+size_t AtomRepository::getMemoryUsage() const
+{
+    auto usage = sizeof(*this) + utils::getHeapUsage(atoms) + utils::getHeapUsage(symbolIndex) +
+                 utils::getHeapUsage(shortSymbols);
+    for (const auto& a : atoms)
+        usage += a.second->getMemoryUsage();
+    return usage;
+}
+
 AtomRepository::Iterator AtomRepository::begin() const { return atoms.begin(); }
 
 AtomRepository::Iterator AtomRepository::end() const { return atoms.end(); }
 
-void AtomRepository::clear() { atoms.clear(); }
+void AtomRepository::clear()
+{
+    atoms.clear();
+    symbolIndex.clear();
+    std::ranges::fill(shortSymbols, nullptr);
+}
@@ -45,3 +45,13 @@ BondedAtomBase::create(const AtomBase& atom, const c_size index, std::vector<Bon
                : static_cast<std::unique_ptr<BondedAtomBase>>(
                      std::make_unique<BondedAtom<Atom>>(static_cast<const Atom&>(atom), index, std::move(bonds)));
 }
+
+std::unique_ptr<BondedAtomBase>
+BondedAtomBase::create(const AtomBaseData& data, const c_size index, std::vector<Bond>&& bonds)
+{
+    return data.isRadical()
+               ? static_cast<std::unique_ptr<BondedAtomBase>>(
+                     std::make_unique<BondedAtom<Radical>>(*Radical::fromData(data), index, std::move(bonds)))
+               : static_cast<std::unique_ptr<BondedAtomBase>>(
+                     std::make_unique<BondedAtom<Atom>>(*Atom::fromData(data), index, std::move(bonds)));
+}
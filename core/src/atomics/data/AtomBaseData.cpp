@@ -1,11 +1,15 @@
 #include "atomics/data/AtomBaseData.hpp"
 
+#include "utils/Memory.hpp"
+
 AtomBaseData::AtomBaseData(Symbol&& symbol, std::string&& name, const Amount<Unit::GRAM_PER_MOLE> weight) noexcept :
     symbol(std::move(symbol)),
     name(std::move(name)),
     weight(weight)
 {}
 
+size_t AtomBaseData::getHeapUsage() const { return utils::getHeapUsage(name); }
+
 std::string AtomBaseData::getSMILES() const
 {
     const auto smiles = symbol.str();
@@ -4,6 +4,7 @@
 #include "data/def/Keywords.hpp"
 #include "data/def/Object.hpp"
 #include "data/def/Printers.hpp"
+#include "utils/Memory.hpp"
 
 namespace
 {
@@ -60,6 +61,11 @@ bool AtomData::hasValence(const uint8_t valence) const
 
 uint8_t AtomData::getPrecedence() const { return rarity; }
 
+size_t AtomData::getMemoryUsage() const
+{
+    return sizeof(*this) + AtomBaseData::getHeapUsage() + utils::getHeapUsage(valences.getContent());
+}
+
 void AtomData::dumpDefinition(std::ostream& out, const bool prettify) const
 {
     static constexpr auto valueOffset = checked_cast<uint8_t>(
@@ -5,6 +5,7 @@
 #include "data/def/Keywords.hpp"
 #include "data/def/Object.hpp"
 #include "io/Log.hpp"
+#include "utils/Memory.hpp"
 
 const ImmutableSet<uint8_t> RadicalData::AnyValence = {AtomData::NullValence};
 const SymbolMatchSet        RadicalData::MatchAny   = SymbolMatchSet{
@@ -35,6 +36,11 @@ uint8_t RadicalData::getPrecedence() const
     return 0;
 }
 
+size_t RadicalData::getMemoryUsage() const
+{
+    return sizeof(*this) + AtomBaseData::getHeapUsage() + utils::getHeapUsage(matches);
+}
+
 void RadicalData::dumpDefinition(std::ostream& out, const bool prettify) const
 {
     static constexpr auto valueOffset =
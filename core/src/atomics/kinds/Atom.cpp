@@ -10,5 +10,10 @@ bool Atom::matches(const AtomBase& other) const { return this->equals(other); }
 std::optional<Atom> Atom::fromSymbol(const Symbol& symbol)
 {
     const auto data = Accessor<>::getDataStore().atoms.find(symbol);
-    return data != nullptr && not data->isRadical() ? std::optional(Atom(*data)) : std::nullopt;
+    return data != nullptr ? fromData(*data) : std::nullopt;
+}
+
+std::optional<Atom> Atom::fromData(const AtomBaseData& data)
+{
+    return not data.isRadical() ? std::optional(Atom(data)) : std::nullopt;
 }
@@ -22,4 +22,4 @@ std::string AtomBase::getSMILES() const { return data.getSMILES(); }
 
 bool AtomBase::equals(const AtomBase& other) const { return &this->data == &other.data; }
 
-bool AtomBase::isDefined(const Symbol& symbol) { return getDataStore().atoms.contains(symbol); }
+bool AtomBase::isDefined(const std::string_view symbol) { return getDataStore().atoms.findSymbol(symbol) != nullptr; }
@@ -17,5 +17,10 @@ bool Radical::matches(const AtomBase& other) const
 std::optional<Radical> Radical::fromSymbol(const Symbol& symbol)
 {
     const auto data = Accessor<>::getDataStore().atoms.find(symbol);
-    return data != nullptr && data->isRadical() ? std::optional(Radical(*data)) : std::nullopt;
+    return data != nullptr ? fromData(*data) : std::nullopt;
+}
+
+std::optional<Radical> Radical::fromData(const AtomBaseData& data)
+{
+    return data.isRadical() ? std::optional(Radical(data)) : std::nullopt;
 }
@@ -3,6 +3,7 @@
 #include "data/def/FileAnalyzer.hpp"
 #include "data/def/FileParser.hpp"
 #include "io/Log.hpp"
+#include "utils/Hash.hpp"
 #include "utils/Path.hpp"
 
 #include <fstream>
@@ -27,8 +28,58 @@ size_t DataStore::totalDefinitionCount() const
            labware.totalDefinitionCount();
 }
 
+size_t DataStore::getMemoryUsage() const
+{
+    return fileStore.getMemoryUsage() +
+           outlineDefinitions.getMemoryUsage() +
+           atoms.getMemoryUsage() +
+           estimators.getMemoryUsage() +
+           molecules.getMemoryUsage() +
+           reactions.getMemoryUsage() +
+           labware.getMemoryUsage();
+}
+
+uint64_t DataStore::getFingerprint() const
+{
+    // Repositories are unordered, so the hashes of the entries are summed.
+    uint64_t result = utils::hashCombine(atoms.totalDefinitionCount(), reactions.size(), labware.size());
+    for (const auto& [id, reaction] : reactions)
+        result += utils::hashCombine(id, reaction->getHRTag());
+    for (const auto& [id, data] : labware)
+        result += utils::hashCombine(id, underlying_cast(data->type));
+
+    return result;
+}
+
+void DataStore::freeze()
+{
+    frozen = true;
+    estimators.freeze();
+}
+
+bool DataStore::isFrozen() const { return frozen; }
+
+void DataStore::updatePredefined()
+{
+    if (not predefined && atoms.contains("H") && atoms.contains("C"))
+        predefined.emplace(Predefined(atoms));
+}
+
+const Predefined& DataStore::getPredefined() const
+{
+    if (not predefined)
+        Log(this).fatal("Predefined atoms were used before being defined.");
+
+    return *predefined;
+}
+
 bool DataStore::addDefinition(def::Object&& definition)
 {
+    if (frozen) {
+        Log(this).error("Tried to add a definition to a frozen data store, at: {}.", definition.getLocationName());
+        return false;
+    }
+
     switch (definition.getType()) {
     case def::DefinitionType::AUTO:
         Log(this).error("Cannot infer type for out-of-line definition, at: {}.", definition.getLocationName());
@@ -37,7 +88,11 @@ bool DataStore::addDefinition(def::Object&& definition)
     case def::DefinitionType::DATA:
         return outlineDefinitions.add(std::move(definition));
     case def::DefinitionType::ATOM:
-        return atoms.add<AtomData>(definition);
+        if (not atoms.add<AtomData>(definition))
+            return false;
+
+        updatePredefined();
+        return true;
     case def::DefinitionType::RADICAL:
         return atoms.add<RadicalData>(definition);
     case def::DefinitionType::MOLECULE:
@@ -58,6 +113,11 @@ bool DataStore::addDefinition(def::Object&& definition)
 
 bool DataStore::load(const std::string& path)
 {
+    if (frozen) {
+        Log(this).error("Tried to load file: '{}' into a frozen data store.", path);
+        return false;
+    }
+
     const auto normPath = utils::normalizePath(path);
 
     const auto analysis = def::FileAnalyzer(normPath, fileStore).analyze();
@@ -151,7 +211,9 @@ void DataStore::clear()
     reactions.clear();
     molecules.clear();
     estimators.clear();
+    predefined.reset();
     atoms.clear();
     outlineDefinitions.clear();
     fileStore.clear();
+    frozen = false;
 }
@@ -4,16 +4,16 @@
 
 const DataStore& DataStoreAccessor::get() const
 {
-    if (dataStore == nullptr)
+    const auto store = dataStore.load(std::memory_order_acquire);
+    if (store == nullptr)
         Log(this).fatal("Tried to access a data store with an uninitialized accessor.");
-    return *dataStore;
+    return *store;
 }
 
 void DataStoreAccessor::set(const DataStore& newStore)
 {
-    if (dataStore != nullptr)
+    if (dataStore.exchange(&newStore, std::memory_order_acq_rel) != nullptr)
         Log(this).warn("Already initialized data store accessor has been modified.");
-    dataStore = &newStore;
 }
 
-void DataStoreAccessor::unset() { dataStore = nullptr; }
+void DataStoreAccessor::unset() { dataStore.store(nullptr, std::memory_order_release); }
@@ -1,7 +1,17 @@
 #include "data/FileStore.hpp"
 
+#include "utils/Memory.hpp"
+
 const std::unordered_map<std::string, bool>& FileStore::getHistory() const { return parseHistory; }
 
+size_t FileStore::getMemoryUsage() const
+{
+    auto usage = sizeof(*this) + utils::getHeapUsage(parseHistory);
+    for (const auto& [k, _] : parseHistory)
+        usage += utils::getHeapUsage(k);
+    return usage;
+}
+
 void FileStore::clear() { parseHistory.clear(); }
 
 ParseStatus FileStore::getFileStatus(const std::string& filePath) const
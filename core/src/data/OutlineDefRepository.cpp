@@ -1,6 +1,7 @@
 #include "data/OutlineDefRepository.hpp"
 
 #include "data/def/Object.hpp"
+#include "utils/Memory.hpp"
 
 const def::Object* OutlineDefRepository::add(def::Object&& definition)
 {
@@ -29,6 +30,14 @@ const def::Object* OutlineDefRepository::getDefinition(const std::string& identi
 
 size_t OutlineDefRepository::totalDefinitionCount() const { return definitions.size(); }
 
+size_t OutlineDefRepository::getMemoryUsage() const
+{
+    auto usage = sizeof(*this) + utils::getHeapUsage(definitions);
+    for (const auto& [k, d] : definitions)
+        usage += utils::getHeapUsage(k) + d->getMemoryUsage();
+    return usage;
+}
+
 void OutlineDefRepository::clear()
 {
     for (const auto& [_, d] : definitions)
@@ -2,13 +2,9 @@
 
 #include "data/DataStore.hpp"
 
-Predefined::Predefined() noexcept :
-    Hydrogen(*Atom::fromSymbol("H")),
-    Carbon(*Atom::fromSymbol("C"))
+Predefined::Predefined(const AtomRepository& atoms) noexcept :
+    Hydrogen(*Atom::fromData(atoms.at("H"))),
+    Carbon(*Atom::fromData(atoms.at("C")))
 {}
 
-const Predefined& Predefined::get()
-{
-    static const Predefined predefined;
-    return predefined;
-}
+const Predefined& Predefined::get() { return Accessor<>::getDataStore().getPredefined(); }
@@ -1,6 +1,7 @@
 #include "data/def/Object.hpp"
 
 #include "data/DataStore.hpp"
+#include "utils/Memory.hpp"
 
 using namespace def;
 
@@ -31,6 +32,28 @@ const def::Location& Object::getLocation() const { return location; }
 
 std::string Object::getLocationName() const { return location.toString(); }
 
+size_t Object::getMemoryUsage() const
+{
+    auto usage = sizeof(*this) + utils::getHeapUsage(identifier) + utils::getHeapUsage(specifier) +
+                 utils::getHeapUsage(location.getFile()) + utils::getHeapUsage(accessedProperties) +
+                 utils::getHeapUsage(accessedSubDefs) + utils::getHeapUsage(properties) +
+                 utils::getHeapUsage(ilSubDefs) + utils::getHeapUsage(outlineSubDefs);
+
+    for (const auto& k : accessedProperties)
+        usage += utils::getHeapUsage(k);
+    for (const auto& k : accessedSubDefs)
+        usage += utils::getHeapUsage(k);
+    for (const auto& [k, v] : properties)
+        usage += utils::getHeapUsage(k) + utils::getHeapUsage(v);
+    // Inline sub-definitions are stored in the map nodes, which are already accounted for.
+    for (const auto& [k, v] : ilSubDefs)
+        usage += utils::getHeapUsage(k) + v.getMemoryUsage() - sizeof(v);
+    for (const auto& [k, _] : outlineSubDefs)
+        usage += utils::getHeapUsage(k);
+
+    return usage;
+}
+
 void Object::logUnusedWarnings() const
 {
     for (const auto& [k, _] : properties)
@@ -46,6 +69,17 @@ void Object::logUnusedWarnings() const
             Log(this).warn("Unused sub-definition for property: '{}', at: {}.", k, location.toString());
 }
 
+void Object::setProperty(const std::string_view key, std::string&& value)
+{
+    const auto it = properties.find(key);
+    if (it != properties.end()) {
+        it->second = std::move(value);
+        return;
+    }
+
+    properties.emplace(key, std::move(value));
+}
+
 std::optional<std::string> Object::getOptionalProperty(const std::string_view key) const
 {
     auto it = properties.find(key);
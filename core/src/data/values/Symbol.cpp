@@ -2,34 +2,113 @@
 
 #include "io/Log.hpp"
 
+#include <deque>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace
+{
+
+class SymbolTable
+{
+private:
+    mutable std::shared_mutex mutex;
+
+    // References to the elements of a deque are stable, so the views of the index remain valid.
+    std::deque<std::string>                             strings;
+    std::unordered_map<std::string_view, Symbol::IdT> ids;
+
+public:
+    std::optional<Symbol::IdT> find(const std::string_view str) const
+    {
+        std::shared_lock lock(mutex);
+        const auto       it = ids.find(str);
+        return it != ids.end() ? std::optional(it->second) : std::nullopt;
+    }
+
+    Symbol::IdT intern(const std::string_view str)
+    {
+        if (const auto id = find(str))
+            return *id;
+
+        std::unique_lock lock(mutex);
+        if (const auto it = ids.find(str); it != ids.end())
+            return it->second;  // Interned by another thread in the meantime.
+
+        if (strings.size() > std::numeric_limits<Symbol::IdT>::max()) {
+            Log<Symbol>().fatal("Exceeded the maximum number of interned symbols: {}.", strings.size());
+        }
+
+        const auto id = static_cast<Symbol::IdT>(strings.size());
+        ids.emplace(strings.emplace_back(str), id);
+        return id;
+    }
+
+    const std::string& get(const Symbol::IdT id) const
+    {
+        std::shared_lock lock(mutex);
+        return strings[id];
+    }
+
+    size_t size() const
+    {
+        std::shared_lock lock(mutex);
+        return strings.size();
+    }
+
+    // Symbols are used during static initialization, so the table is constructed on first use.
+    static SymbolTable& get()
+    {
+        static SymbolTable table;
+        return table;
+    }
+};
+
+}  // namespace
+
+Symbol::Symbol(const IdT id, InternedTag) noexcept :
+    id(id)
+{}
 
 Symbol::Symbol(const std::string& str) noexcept :
-    symbol(str.c_str())
+    id(SymbolTable::get().intern(str.c_str()))
 {}
 
 Symbol::Symbol(std::string&& str) noexcept :
-    symbol(std::move(str))
+    id(SymbolTable::get().intern(str))
 {}
 
 Symbol::Symbol(const char chr) noexcept :
-    symbol(std::string(1, chr))
+    id(SymbolTable::get().intern(std::string_view(&chr, 1)))
 {}
 
 Symbol::Symbol(const char* str) noexcept :
-    Symbol(std::string(str))
+    id(SymbolTable::get().intern(str))
 {}
 
-const std::string& Symbol::str() const { return symbol; }
+const std::string& Symbol::str() const { return SymbolTable::get().get(id); }
+
+Symbol::IdT Symbol::getId() const { return id; }
+
+Symbol::SizeT Symbol::size() const { return static_cast<SizeT>(str().size()); }
+
+bool Symbol::operator==(const Symbol& other) const { return this->id == other.id; }
 
-Symbol::SizeT Symbol::size() const { return static_cast<SizeT>(symbol.size()); }
+bool Symbol::operator!=(const Symbol& other) const { return this->id != other.id; }
 
-bool Symbol::operator==(const Symbol& other) const { return this->symbol == other.symbol; }
+bool Symbol::operator==(const std::string& other) const { return this->str() == other; }
 
-bool Symbol::operator!=(const Symbol& other) const { return this->symbol != other.symbol; }
+bool Symbol::operator!=(const std::string& other) const { return this->str() != other; }
 
-bool Symbol::operator==(const std::string& other) const { return this->symbol == other; }
+std::optional<Symbol> Symbol::find(const std::string_view str)
+{
+    const auto id = SymbolTable::get().find(str);
+    return id ? std::optional(Symbol(*id, InternedTag())) : std::nullopt;
+}
 
-bool Symbol::operator!=(const std::string& other) const { return this->symbol != other; }
+size_t Symbol::getInternedCount() { return SymbolTable::get().size(); }
 
-std::ostream& operator<<(std::ostream& out, const Symbol& obj) { return out << obj.symbol; }
+std::ostream& operator<<(std::ostream& out, const Symbol& obj) { return out << obj.str(); }
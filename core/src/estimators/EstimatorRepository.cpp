@@ -3,36 +3,94 @@
 #include "data/def/Keywords.hpp"
 #include "data/def/Parsers.hpp"
 #include "io/Log.hpp"
+#include "utils/Memory.hpp"
 
 #include <cmath>
 
+EstimatorRepository::EstimatorRepository(EstimatorRepository&& other) noexcept :
+    maxEstimatorNesting(other.maxEstimatorNesting),
+    nextId(other.nextId),
+    frozen(other.frozen),
+    estimators(std::move(other.estimators)),
+    overlay(std::move(other.overlay))
+{}
+
 EstimatorRepository::~EstimatorRepository() noexcept { clear(); }
 
+const EstimatorBase* EstimatorRepository::findEquivalent(const EstimatorMap& map, const EstimatorBase& estimator) const
+{
+    const auto it =
+        std::find_if(map.cbegin(), map.cend(), [&estimator](const auto& e) { return e.second->isEquivalent(estimator); });
+    return it != map.cend() ? it->second.get() : nullptr;
+}
+
 const EstimatorBase& EstimatorRepository::add(std::unique_ptr<const EstimatorBase>&& estimator)
 {
-    const auto it = std::find_if(estimators.cbegin(), estimators.cend(), [&estimator](const auto& e) {
-        return e.second->isEquivalent(*estimator);
-    });
+    if (const auto existing = findEquivalent(estimators, *estimator))
+        return *existing;
 
-    if (it != estimators.end())
-        return *it->second;
+    if (frozen) {
+        if (const auto existing = findEquivalent(overlay, *estimator))
+            return *existing;
+    }
 
-    maxEstimatorNesting = std::max(maxEstimatorNesting, estimator->getNestingDepth());
+    if (nextId == std::numeric_limits<EstimatorId>::max())
+        Log(this).fatal("Estimator id limit reached: {}.", nextId);
 
-    const auto inserted = estimators.emplace(estimator->getId(), std::move(estimator));
-    return *inserted.first->second;
+    if (not frozen) {
+        maxEstimatorNesting = std::max(maxEstimatorNesting, estimator->getNestingDepth());
+        return *estimators.emplace(nextId++, std::move(estimator)).first->second;
+    }
+
+    // The nesting depth is only used when clearing, which isn't synchronized, so it can be updated here.
+    maxEstimatorNesting = std::max(maxEstimatorNesting, estimator->getNestingDepth());
+    return *overlay.emplace(nextId++, std::move(estimator)).first->second;
 }
 
+void EstimatorRepository::freeze() { frozen = true; }
+
+bool EstimatorRepository::isFrozen() const { return frozen; }
+
 void EstimatorRepository::dropUnusedEstimators()
 {
+    std::erase_if(overlay, [](const auto& p) { return p.second->getRefCount() == 0; });
     std::erase_if(estimators, [](const auto& p) { return p.second->getRefCount() == 0; });
 }
 
-bool EstimatorRepository::contains(const EstimatorId id) const { return estimators.contains(id); }
+bool EstimatorRepository::contains(const EstimatorId id) const
+{
+    if (estimators.contains(id))
+        return true;
 
-const EstimatorBase& EstimatorRepository::at(const EstimatorId id) const { return *estimators.at(id); }
+    std::shared_lock lock(overlayMutex);
+    return overlay.contains(id);
+}
 
-size_t EstimatorRepository::totalDefinitionCount() const { return estimators.size(); }
+const EstimatorBase& EstimatorRepository::at(const EstimatorId id) const
+{
+    if (const auto it = estimators.find(id); it != estimators.end())
+        return *it->second;
+
+    std::shared_lock lock(overlayMutex);
+    return *overlay.at(id);
+}
+
+size_t EstimatorRepository::totalDefinitionCount() const
+{
+    std::shared_lock lock(overlayMutex);
+    return estimators.size() + overlay.size();
+}
+
+size_t EstimatorRepository::getMemoryUsage() const
+{
+    std::shared_lock lock(overlayMutex);
+    auto             usage = sizeof(*this) + utils::getHeapUsage(estimators) + utils::getHeapUsage(overlay);
+    for (const auto& e : estimators)
+        usage += e.second->getMemoryUsage();
+    for (const auto& e : overlay)
+        usage += e.second->getMemoryUsage();
+    return usage;
+}
 
 EstimatorRepository::Iterator EstimatorRepository::begin() const { return estimators.begin(); }
 
@@ -40,22 +98,20 @@ EstimatorRepository::Iterator EstimatorRepository::end() const { return estimato
 
 void EstimatorRepository::clear()
 {
-    if (maxEstimatorNesting == 0)
+    if (maxEstimatorNesting == 0) {
+        overlay.clear();
         estimators.clear();
+    }
 
     // Ensure referenced estimators are deleted after those which reference them
-    for (; maxEstimatorNesting-- > 0;)
+    for (auto i = maxEstimatorNesting; i-- > 0;)
         dropUnusedEstimators();
     dropUnusedEstimators();
-}
 
-EstimatorId EstimatorRepository::getFreeId() const
-{
-    static EstimatorId id = 0;
-    while (estimators.contains(id)) {
-        if (id == std::numeric_limits<EstimatorId>::max())
-            Log(this).fatal("Estimator id limit reached: {}.", id);
-        ++id;
+    frozen = false;
+    // Estimators which are still referenced are kept, so ids can only be reused once all are gone.
+    if (estimators.empty() && overlay.empty()) {
+        maxEstimatorNesting = 0;
+        nextId              = 0;
     }
-    return id;
 }
@@ -178,8 +178,8 @@ void MixturePropertyPane::draw(sf::RenderTarget& target, sf::RenderStates states
         layerPane.setPosition(propertyName.getPosition() + sf::Vector2f(22.0f, 32.0f));
         contentPane.setPosition(propertyName.getPosition() + sf::Vector2f(240.0f, 32.0f));
         for (auto l = multiLayerMixture->getLayersDownBegin(); l != multiLayerMixture->getLayersDownEnd(); ++l) {
-            layerPane.setSubject(l->second);
-            contentPane.setSubject(l->second);
+            layerPane.setSubject(*l);
+            contentPane.setSubject(*l);
             target.draw(layerPane, states);
             target.draw(contentPane, states);
             layerPane.setPosition(layerPane.getPosition() + sf::Vector2f(0.0f, 130.0f));
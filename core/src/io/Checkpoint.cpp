@@ -0,0 +1,118 @@
+#include "io/Checkpoint.hpp"
+
+#include "data/DataStore.hpp"
+#include "io/Log.hpp"
+
+namespace
+{
+
+constexpr std::string_view Magic = "CHGCKPT";
+
+}  // namespace
+
+CheckpointWriter::CheckpointWriter(std::ostream& os, const DataStore& dataStore) noexcept :
+    os(os)
+{
+    os.write(Magic.data(), Magic.size());
+    bin::print(os, Version);
+    bin::print(os, dataStore.getFingerprint());
+}
+
+bool CheckpointWriter::isValid() const { return static_cast<bool>(os); }
+
+void CheckpointWriter::write(const std::string& str)
+{
+    bin::print(os, static_cast<uint32_t>(str.size()));
+    os.write(str.data(), str.size());
+}
+
+void CheckpointWriter::write(const Molecule& molecule)
+{
+    // New molecules get the next index, which the reader recognizes as a definition.
+    const auto [it, isNew] = moleculeIndices.emplace(molecule.getId(), static_cast<uint32_t>(moleculeIndices.size()));
+    bin::print(os, it->second);
+    if (isNew)
+        write(molecule.getStructure().toSMILES());
+}
+
+CheckpointReader::CheckpointReader(std::istream& is, const DataStore& dataStore) noexcept :
+    is(is)
+{
+    std::string magic(Magic.size(), '\0');
+    is.read(magic.data(), magic.size());
+    if (not is || magic != Magic) {
+        Log(this).error("Invalid checkpoint header.");
+        return;
+    }
+
+    const auto version = bin::parse<uint16_t>(is);
+    if (not version || *version != CheckpointWriter::Version) {
+        Log(this).error(
+            "Unsupported checkpoint version: {} (expected: {}).",
+            version ? *version : 0,
+            CheckpointWriter::Version);
+        return;
+    }
+
+    const auto fingerprint = bin::parse<uint64_t>(is);
+    if (not fingerprint) {
+        Log(this).error("Invalid checkpoint header.");
+        return;
+    }
+
+    validHeader     = true;
+    sameDefinitions = *fingerprint == dataStore.getFingerprint();
+    if (not sameDefinitions)
+        Log(this).warn("Checkpoint was written using different definitions, definition dependent data is discarded.");
+}
+
+bool CheckpointReader::isValid() const { return validHeader && is; }
+
+bool CheckpointReader::hasSameDefinitions() const { return sameDefinitions; }
+
+bool CheckpointReader::isAtEnd() const { return is.peek() == std::istream::traits_type::eof(); }
+
+std::optional<std::string> CheckpointReader::readString()
+{
+    const auto size = bin::parse<uint32_t>(is);
+    if (not size)
+        return std::nullopt;
+
+    if (*size > MaxStringSize) {
+        Log(this).error("Checkpoint string size: {} exceeds the maximum of {}.", *size, MaxStringSize);
+        is.setstate(std::ios::failbit);
+        return std::nullopt;
+    }
+
+    auto result = bin::parseChars(is, *size);
+    if (not result)
+        Log(this).error("Checkpoint string of size: {} is truncated.", *size);
+    return result;
+}
+
+std::optional<Molecule> CheckpointReader::readMolecule()
+{
+    const auto idx = bin::parse<uint32_t>(is);
+    if (not idx)
+        return std::nullopt;
+
+    if (*idx < molecules.size())
+        return molecules[*idx];
+
+    if (*idx != molecules.size()) {
+        Log(this).error("Checkpoint molecule index: {} refers to an undefined molecule.", *idx);
+        return std::nullopt;
+    }
+
+    const auto smiles = readString();
+    if (not smiles)
+        return std::nullopt;
+
+    MolecularStructure structure(*smiles);
+    if (structure.isEmpty()) {
+        Log(this).error("Invalid checkpoint molecule: '{}'.", *smiles);
+        return std::nullopt;
+    }
+
+    return molecules.emplace_back(std::move(structure));
+}
@@ -0,0 +1,130 @@
+#include "io/MappedFile.hpp"
+
+#include "io/Log.hpp"
+#include "utils/Build.hpp"
+#include "utils/Path.hpp"
+
+#include <utility>
+
+#if defined(CHG_BUILD_WINDOWS)
+    #include <Windows.h>
+#elif defined(CHG_BUILD_LINUX)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+#endif
+
+namespace
+{
+
+void unmap(const char* data, [[maybe_unused]] const size_t size)
+{
+    if (data == nullptr)
+        return;
+
+#if defined(CHG_BUILD_WINDOWS)
+    UnmapViewOfFile(data);
+#elif defined(CHG_BUILD_LINUX)
+    munmap(const_cast<char*>(data), size);
+#endif
+}
+
+}  // namespace
+
+MappedFile::MappedFile(const char* data, const size_t size) noexcept :
+    data(data),
+    size(size)
+{}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+    data(std::exchange(other.data, nullptr)),
+    size(std::exchange(other.size, 0))
+{}
+
+MappedFile::~MappedFile() noexcept { unmap(data, size); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        unmap(data, size);
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+    }
+    return *this;
+}
+
+std::span<const char> MappedFile::getBytes() const { return std::span(data, size); }
+
+std::optional<MappedFile> MappedFile::open(const std::string& path)
+{
+    const auto normPath = utils::normalizePath(path);
+
+#if defined(CHG_BUILD_WINDOWS)
+    const auto file = CreateFileA(
+        normPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        Log<MappedFile>().error("Failed to open file: '{}' for reading (error code: {}).", normPath, GetLastError());
+        return std::nullopt;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (not GetFileSizeEx(file, &fileSize)) {
+        Log<MappedFile>().error("Failed to get the size of file: '{}' (error code: {}).", normPath, GetLastError());
+        CloseHandle(file);
+        return std::nullopt;
+    }
+    if (fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return MappedFile(nullptr, 0);
+    }
+
+    // The view keeps the file and the mapping objects alive, so their handles can be closed right away.
+    const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        Log<MappedFile>().error("Failed to map file: '{}' (error code: {}).", normPath, GetLastError());
+        return std::nullopt;
+    }
+
+    const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        Log<MappedFile>().error("Failed to map file: '{}' (error code: {}).", normPath, GetLastError());
+        return std::nullopt;
+    }
+
+    return MappedFile(static_cast<const char*>(view), static_cast<size_t>(fileSize.QuadPart));
+
+#elif defined(CHG_BUILD_LINUX)
+    const auto file = ::open(normPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) {
+        Log<MappedFile>().error("Failed to open file: '{}' for reading (error code: {}).", normPath, errno);
+        return std::nullopt;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0) {
+        Log<MappedFile>().error("Failed to get the size of file: '{}' (error code: {}).", normPath, errno);
+        close(file);
+        return std::nullopt;
+    }
+    if (status.st_size == 0) {
+        close(file);
+        return MappedFile(nullptr, 0);
+    }
+
+    // The mapping keeps the file alive, so its descriptor can be closed right away.
+    const auto size = static_cast<size_t>(status.st_size);
+    const auto view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED) {
+        Log<MappedFile>().error("Failed to map file: '{}' (error code: {}).", normPath, errno);
+        return std::nullopt;
+    }
+
+    return MappedFile(static_cast<const char*>(view), size);
+#endif
+}
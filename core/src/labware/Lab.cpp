@@ -1,7 +1,84 @@
 #include "labware/Lab.hpp"
 
+#include "data/DataStore.hpp"
+#include "io/Checkpoint.hpp"
+#include "io/Log.hpp"
+#include "labware/kinds/Adaptor.hpp"
+#include "labware/kinds/Condenser.hpp"
+#include "labware/kinds/Flask.hpp"
+#include "labware/kinds/Heatsource.hpp"
+#include "utils/Path.hpp"
 #include "utils/SFML.hpp"
 
+#include <fstream>
+
+namespace
+{
+
+struct ComponentRecord
+{
+    LabwareId            id;
+    sf::Vector2f         position;
+    Amount<Unit::DEGREE> rotation;
+};
+
+struct ConnectionRecord
+{
+    l_size  component;
+    uint8_t port;
+    l_size  otherComponent;
+    uint8_t otherPort;
+};
+
+struct SystemRecord
+{
+    std::vector<ComponentRecord>  components;
+    std::vector<ConnectionRecord> connections;
+};
+
+/// <summary>
+/// Reads a system written by LabwareSystem::toCheckpoint().
+/// </summary>
+std::optional<SystemRecord> readSystem(CheckpointReader& reader)
+{
+    const auto componentCount = reader.read<l_size>();
+    if (not componentCount)
+        return std::nullopt;
+
+    SystemRecord result;
+    result.components.reserve(*componentCount);
+    for (l_size i = 0; i < *componentCount; ++i) {
+        const auto id       = reader.read<LabwareId>();
+        const auto x        = reader.read<float_s>();
+        const auto y        = reader.read<float_s>();
+        const auto rotation = reader.read<Amount<Unit::DEGREE>>();
+        if (not rotation)
+            return std::nullopt;
+
+        result.components.emplace_back(*id, sf::Vector2f(*x, *y), *rotation);
+    }
+
+    const auto connectionCount = reader.read<uint16_t>();
+    if (not connectionCount)
+        return std::nullopt;
+
+    result.connections.reserve(*connectionCount);
+    for (uint16_t i = 0; i < *connectionCount; ++i) {
+        const auto component      = reader.read<l_size>();
+        const auto port           = reader.read<uint8_t>();
+        const auto otherComponent = reader.read<l_size>();
+        const auto otherPort      = reader.read<uint8_t>();
+        if (not otherPort || *component >= *componentCount || *otherComponent >= *componentCount)
+            return std::nullopt;
+
+        result.connections.emplace_back(*component, *port, *otherComponent, *otherPort);
+    }
+
+    return result;
+}
+
+}  // namespace
+
 Lab::Lab() noexcept :
     atmosphere(Atmosphere::createDefaultAtmosphere())
 {}
@@ -12,6 +89,26 @@ Lab::Lab(std::unique_ptr<Atmosphere>&& atmosphere) noexcept :
 
 void Lab::add(LabwareSystem&& system) { systems.emplace_back(std::move(system)); }
 
+LabwareComponentBase* Lab::addComponent(const LabwareId id)
+{
+    const auto& labware = Accessor<>::getDataStore().labware;
+    if (not labware.contains(id))
+        return nullptr;
+
+    switch (labware.at(id).type) {
+    case LabwareType::FLASK:
+        return &add<Flask>(id);
+    case LabwareType::ADAPTOR:
+        return &add<Adaptor>(id);
+    case LabwareType::CONDENSER:
+        return &add<Condenser>(id);
+    case LabwareType::HEATSOURCE:
+        return &add<Heatsource>(id);
+    default:
+        return nullptr;
+    }
+}
+
 void Lab::removeEmptySystems()
 {
     systems.erase(
@@ -53,6 +150,14 @@ size_t Lab::anyIntersects(const size_t targetIdx) const
     return npos;
 }
 
+std::pair<size_t, l_size> Lab::findComponent(const LabwareComponentBase& component) const
+{
+    for (size_t i = 0; i < systems.size(); ++i)
+        if (const auto c = systems[i].find(component); c != LabwareSystem::npos)
+            return std::make_pair(i, c);
+    return std::make_pair(npos, LabwareSystem::npos);
+}
+
 bool Lab::tryConnect(const size_t targetIdx, const float_s maxSqDistance)
 {
     for (size_t i = 0; i < systems.size(); ++i) {
@@ -68,6 +173,27 @@ bool Lab::tryConnect(const size_t targetIdx, const float_s maxSqDistance)
     return false;
 }
 
+bool Lab::tryConnect(
+    const LabwareComponentBase& destination,
+    const uint8_t               destinationPort,
+    const LabwareComponentBase& source,
+    const uint8_t               sourcePort)
+{
+    const auto [destSys, destComp] = findComponent(destination);
+    const auto [srcSys, srcComp]   = findComponent(source);
+    if (destSys == npos || srcSys == npos || destSys == srcSys)
+        return false;
+
+    auto destPort = systems[destSys].getPort(destComp, destinationPort);
+    auto srcPort  = systems[srcSys].getPort(srcComp, sourcePort);
+    if (not destPort.isValid() || not srcPort.isValid() || not LabwareSystem::canConnect(destPort, srcPort))
+        return false;
+
+    LabwareSystem::connect(destPort, srcPort);
+    removeEmptySystems();
+    return true;
+}
+
 bool Lab::tryDisconnect(const sf::Vector2f& point)
 {
     for (size_t i = 0; i < systems.size(); ++i) {
@@ -103,6 +229,139 @@ void Lab::tick(const Amount<Unit::SECOND> timespan)
     atmosphere->tick(timespan);
 }
 
+void Lab::toCheckpoint(CheckpointWriter& writer) const
+{
+    atmosphere->toCheckpoint(writer);
+
+    writer.write(static_cast<uint32_t>(systems.size()));
+    for (const auto& system : systems)
+        system.toCheckpoint(writer);
+
+    for (const auto& system : systems)
+        for (l_size i = 0; i < system.size(); ++i)
+            system.getComponent(i).toCheckpoint(writer);
+}
+
+void Lab::toCheckpoint(std::ostream& os) const
+{
+    CheckpointWriter writer(os, Accessor<>::getDataStore());
+    toCheckpoint(writer);
+}
+
+bool Lab::toCheckpointFile(const std::string& path) const
+{
+    const auto    normPath = utils::normalizePath(path);
+    std::ofstream os(normPath, std::ios::binary);
+    if (not os) {
+        Log(this).error("Failed to open file: '{}' for writing.", normPath);
+        return false;
+    }
+
+    toCheckpoint(os);
+    return true;
+}
+
+bool Lab::loadFromCheckpoint(CheckpointReader& reader)
+{
+    if (not reader.isValid() || not atmosphere->loadFromCheckpoint(reader))
+        return false;
+
+    const auto systemCount = reader.read<uint32_t>();
+    if (not systemCount) {
+        Log(this).error("Failed to read lab from checkpoint.");
+        return false;
+    }
+
+    std::vector<SystemRecord> records;
+    records.reserve(*systemCount);
+    for (uint32_t i = 0; i < *systemCount; ++i) {
+        auto record = readSystem(reader);
+        if (not record) {
+            Log(this).error("Failed to read labware system from checkpoint.");
+            return false;
+        }
+
+        records.emplace_back(std::move(*record));
+    }
+
+    const auto isSameLabware = [&]() {
+        if (systems.size() != records.size())
+            return false;
+
+        for (size_t i = 0; i < systems.size(); ++i) {
+            if (systems[i].size() != records[i].components.size())
+                return false;
+            for (l_size j = 0; j < systems[i].size(); ++j)
+                if (systems[i].getComponent(j).id != records[i].components[j].id)
+                    return false;
+        }
+        return true;
+    };
+
+    // Components are collected in the order in which their states were written.
+    std::vector<LabwareComponentBase*> components;
+    if (isSameLabware()) {
+        for (auto& system : systems)
+            for (l_size i = 0; i < system.size(); ++i)
+                components.emplace_back(&system.getComponent(i));
+    }
+    else {
+        systems.clear();
+        for (const auto& record : records) {
+            const auto first = components.size();
+            for (const auto& c : record.components) {
+                const auto component = addComponent(c.id);
+                if (not component) {
+                    Log(this).error("Unsupported checkpoint labware id: {}.", c.id);
+                    return false;
+                }
+
+                component->setRotation(c.rotation);
+                component->setPosition(c.position);
+                components.emplace_back(component);
+            }
+
+            // The direction of the original connections isn't known, so both are tried.
+            for (const auto& c : record.connections) {
+                auto& component      = *components[first + c.component];
+                auto& otherComponent = *components[first + c.otherComponent];
+                if (not tryConnect(component, c.port, otherComponent, c.otherPort) &&
+                    not tryConnect(otherComponent, c.otherPort, component, c.port)) {
+                    Log(this).error(
+                        "Failed to restore checkpoint connection between labware: {} and: {}.",
+                        component.id,
+                        otherComponent.id);
+                    return false;
+                }
+            }
+        }
+    }
+
+    for (const auto component : components)
+        if (not component->loadFromCheckpoint(reader))
+            return false;
+
+    return true;
+}
+
+bool Lab::loadFromCheckpoint(std::istream& is)
+{
+    CheckpointReader reader(is, Accessor<>::getDataStore());
+    return loadFromCheckpoint(reader);
+}
+
+bool Lab::loadCheckpointFile(const std::string& path)
+{
+    const auto    normPath = utils::normalizePath(path);
+    std::ifstream is(normPath, std::ios::binary);
+    if (not is) {
+        Log(this).error("Failed to open file: '{}' for reading.", normPath);
+        return false;
+    }
+
+    return loadFromCheckpoint(is);
+}
+
 void Lab::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
     atmosphereOverlay.setSize(utils::vectorCast<float>(target.getSize()));
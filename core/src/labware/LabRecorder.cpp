@@ -0,0 +1,292 @@
+#include "labware/LabRecorder.hpp"
+
+#include "data/DataStore.hpp"
+#include "io/Log.hpp"
+#include "labware/kinds/BaseContainerComponent.hpp"
+
+LabRecorder::LabRecorder(Lab& lab) noexcept :
+    lab(lab)
+{}
+
+LabRecorder::LabRecorder(Lab& lab, std::ostream& os) noexcept :
+    lab(lab)
+{
+    writer.emplace(os, Accessor<>::getDataStore());
+    lab.toCheckpoint(*writer);
+}
+
+void LabRecorder::record(const LabInput input)
+{
+    ++inputCount;
+    if (writer)
+        writer->write(input);
+}
+
+BaseContainerComponent* LabRecorder::getContainer(const size_t systemIdx, const l_size componentIdx)
+{
+    if (systemIdx >= lab.getSystemCount() || componentIdx >= lab.getSystem(systemIdx).size())
+        return nullptr;
+
+    auto container = lab.getSystem(systemIdx).getComponent(componentIdx).cast<BaseContainerComponent>();
+    return container ? &*container : nullptr;
+}
+
+bool LabRecorder::isRecording() const { return writer.has_value(); }
+
+bool LabRecorder::isValid() const { return not writer || writer->isValid(); }
+
+size_t LabRecorder::getInputCount() const { return inputCount; }
+
+const Lab& LabRecorder::getLab() const { return lab; }
+
+Lab& LabRecorder::getLab() { return lab; }
+
+float_s LabRecorder::getTimeMultiplier() const { return timeMultiplier; }
+
+void LabRecorder::setTimeMultiplier(const float_s multiplier)
+{
+    record(LabInput::TIME_MULTIPLIER);
+    if (writer)
+        writer->write(multiplier);
+
+    timeMultiplier = multiplier;
+}
+
+void LabRecorder::tick(const Amount<Unit::SECOND> timespan)
+{
+    record(LabInput::TICK);
+    if (writer)
+        writer->write(timespan);
+
+    lab.tick(timespan * timeMultiplier);
+}
+
+bool LabRecorder::add(
+    const size_t systemIdx, const l_size componentIdx, const Molecule& molecule, const Amount<Unit::MOLE> amount)
+{
+    const auto container = getContainer(systemIdx, componentIdx);
+    if (not container)
+        return false;
+
+    record(LabInput::ADD);
+    if (writer) {
+        writer->write(static_cast<uint32_t>(systemIdx));
+        writer->write(componentIdx);
+        writer->write(molecule);
+        writer->write(amount);
+    }
+
+    container->add(molecule, amount);
+    return true;
+}
+
+bool LabRecorder::addEnergy(const size_t systemIdx, const l_size componentIdx, const Amount<Unit::JOULE> energy)
+{
+    const auto container = getContainer(systemIdx, componentIdx);
+    if (not container)
+        return false;
+
+    record(LabInput::ADD_ENERGY);
+    if (writer) {
+        writer->write(static_cast<uint32_t>(systemIdx));
+        writer->write(componentIdx);
+        writer->write(energy);
+    }
+
+    container->addEnergy(energy);
+    return true;
+}
+
+void LabRecorder::move(const size_t systemIdx, const sf::Vector2f& offset)
+{
+    record(LabInput::MOVE);
+    if (writer) {
+        writer->write(static_cast<uint32_t>(systemIdx));
+        writer->write(offset.x);
+        writer->write(offset.y);
+    }
+
+    lab.getSystem(systemIdx).move(offset);
+}
+
+void LabRecorder::rotate(const size_t systemIdx, const Amount<Unit::DEGREE> angle)
+{
+    record(LabInput::ROTATE);
+    if (writer) {
+        writer->write(static_cast<uint32_t>(systemIdx));
+        writer->write(angle);
+    }
+
+    lab.getSystem(systemIdx).rotate(angle);
+}
+
+bool LabRecorder::tryConnect(const size_t systemIdx, const float_s maxSqDistance)
+{
+    record(LabInput::CONNECT);
+    if (writer) {
+        writer->write(static_cast<uint32_t>(systemIdx));
+        writer->write(maxSqDistance);
+    }
+
+    return lab.tryConnect(systemIdx, maxSqDistance);
+}
+
+bool LabRecorder::tryDisconnect(const sf::Vector2f& point)
+{
+    record(LabInput::DISCONNECT);
+    if (writer) {
+        writer->write(point.x);
+        writer->write(point.y);
+    }
+
+    return lab.tryDisconnect(point);
+}
+
+void LabRecorder::removeEmptySystems()
+{
+    record(LabInput::REMOVE_EMPTY_SYSTEMS);
+    lab.removeEmptySystems();
+}
+
+LabReplayer::LabReplayer(std::istream& is, Lab& lab) noexcept :
+    reader(is, Accessor<>::getDataStore()),
+    target(lab)
+{
+    if (not lab.loadFromCheckpoint(reader)) {
+        Log(this).error("Failed to load the initial state of the recording.");
+        failed = true;
+    }
+}
+
+bool LabReplayer::isValid() const { return not failed && reader.isValid(); }
+
+bool LabReplayer::isAtEnd() const { return reader.isAtEnd(); }
+
+size_t LabReplayer::getTickCount() const { return tickCount; }
+
+const Lab& LabReplayer::getLab() const { return target.getLab(); }
+
+bool LabReplayer::replayInput(const LabInput input)
+{
+    // Only the last read of each input is checked, since reads fail once the stream has failed.
+    const auto& lab = target.getLab();
+    switch (input) {
+    case LabInput::TICK:
+        {
+            const auto timespan = reader.read<Amount<Unit::SECOND>>();
+            if (not timespan)
+                return false;
+
+            target.tick(*timespan);
+            ++tickCount;
+            return true;
+        }
+
+    case LabInput::TIME_MULTIPLIER:
+        {
+            const auto multiplier = reader.read<float_s>();
+            if (not multiplier)
+                return false;
+
+            target.setTimeMultiplier(*multiplier);
+            return true;
+        }
+
+    case LabInput::ADD:
+        {
+            const auto systemIdx    = reader.read<uint32_t>();
+            const auto componentIdx = reader.read<l_size>();
+            const auto molecule     = reader.readMolecule();
+            const auto amount       = reader.read<Amount<Unit::MOLE>>();
+            return molecule && amount && target.add(*systemIdx, *componentIdx, *molecule, *amount);
+        }
+
+    case LabInput::ADD_ENERGY:
+        {
+            const auto systemIdx    = reader.read<uint32_t>();
+            const auto componentIdx = reader.read<l_size>();
+            const auto energy       = reader.read<Amount<Unit::JOULE>>();
+            return energy && target.addEnergy(*systemIdx, *componentIdx, *energy);
+        }
+
+    case LabInput::MOVE:
+        {
+            const auto systemIdx = reader.read<uint32_t>();
+            const auto x         = reader.read<float_s>();
+            const auto y         = reader.read<float_s>();
+            if (not y || *systemIdx >= lab.getSystemCount())
+                return false;
+
+            target.move(*systemIdx, sf::Vector2f(*x, *y));
+            return true;
+        }
+
+    case LabInput::ROTATE:
+        {
+            const auto systemIdx = reader.read<uint32_t>();
+            const auto angle     = reader.read<Amount<Unit::DEGREE>>();
+            if (not angle || *systemIdx >= lab.getSystemCount())
+                return false;
+
+            target.rotate(*systemIdx, *angle);
+            return true;
+        }
+
+    case LabInput::CONNECT:
+        {
+            const auto systemIdx     = reader.read<uint32_t>();
+            const auto maxSqDistance = reader.read<float_s>();
+            if (not maxSqDistance || *systemIdx >= lab.getSystemCount())
+                return false;
+
+            target.tryConnect(*systemIdx, *maxSqDistance);
+            return true;
+        }
+
+    case LabInput::DISCONNECT:
+        {
+            const auto x = reader.read<float_s>();
+            const auto y = reader.read<float_s>();
+            if (not y)
+                return false;
+
+            target.tryDisconnect(sf::Vector2f(*x, *y));
+            return true;
+        }
+
+    case LabInput::REMOVE_EMPTY_SYSTEMS:
+        target.removeEmptySystems();
+        return true;
+
+    default:
+        Log(this).error("Unknown recorded input: {}.", underlying_cast(input));
+        return false;
+    }
+}
+
+bool LabReplayer::replayTick()
+{
+    if (failed)
+        return false;
+
+    while (not reader.isAtEnd()) {
+        const auto input = reader.read<LabInput>();
+        if (not input || not replayInput(*input)) {
+            Log(this).error("Failed to replay input: {} of the recording.", target.getInputCount() + 1);
+            failed = true;
+            return false;
+        }
+
+        if (*input == LabInput::TICK)
+            return true;
+    }
+
+    return false;
+}
+
+bool LabReplayer::replay()
+{
+    while (replayTick())
+        ;
+    return not failed;
+}
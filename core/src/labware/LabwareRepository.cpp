@@ -7,6 +7,7 @@
 #include "labware/data/CondenserData.hpp"
 #include "labware/data/FlaskData.hpp"
 #include "labware/data/HeatsourceData.hpp"
+#include "utils/Memory.hpp"
 
 bool LabwareRepository::checkTextureFile(std::string path, const def::Location& location)
 {
@@ -154,6 +155,14 @@ const BaseLabwareData& LabwareRepository::at(const LabwareId id) const { return
 
 size_t LabwareRepository::totalDefinitionCount() const { return labware.size(); }
 
+size_t LabwareRepository::getMemoryUsage() const
+{
+    auto usage = sizeof(*this) + utils::getHeapUsage(labware);
+    for (const auto& l : labware)
+        usage += l.second->getMemoryUsage();
+    return usage;
+}
+
 LabwareRepository::Iterator LabwareRepository::begin() const { return labware.begin(); }
 
 LabwareRepository::Iterator LabwareRepository::end() const { return labware.end(); }
@@ -1,10 +1,12 @@
 #include "labware/LabwareSystem.hpp"
 
+#include "io/Checkpoint.hpp"
 #include "labware/Lab.hpp"
 #include "labware/kinds/ContainerComponent.hpp"
 #include "labware/kinds/Flask.hpp"
 #include "labware/kinds/Heatsource.hpp"
 
+#include <algorithm>
 #include <queue>
 
 PortIdentifier::PortIdentifier(LabwareSystem& system, const l_size componentIdx, const uint8_t portIdx) noexcept :
@@ -152,10 +154,16 @@ bool LabwareSystem::isOnBoundary(const sf::FloatRect& box) const
            box.position.y + box.size.y >= boundingBox.position.y + boundingBox.size.y;
 }
 
+bool LabwareSystem::isSleeping() const
+{
+    return std::all_of(components.begin(), components.end(), [](const auto& c) { return c->isSleeping(); });
+}
+
 void LabwareSystem::tick(const Amount<Unit::SECOND> timespan)
 {
     for (l_size i = 0; i < components.size(); ++i)
-        components[i]->tick(timespan);
+        if (components[i]->isSleeping() == false)
+            components[i]->tick(timespan);
 }
 
 void LabwareSystem::draw(sf::RenderTarget& target, sf::RenderStates states) const
@@ -244,6 +252,22 @@ bool LabwareSystem::isFree(const l_size componentIdx, const uint8_t portIdx) con
 
 l_size LabwareSystem::findFirst() const { return components.empty() ? npos : 0; }
 
+l_size LabwareSystem::find(const LabwareComponentBase& component) const
+{
+    for (l_size i = 0; i < components.size(); ++i)
+        if (components[i].get() == &component)
+            return i;
+    return npos;
+}
+
+PortIdentifier LabwareSystem::getPort(const l_size componentIdx, const uint8_t portIdx)
+{
+    if (componentIdx >= components.size() || portIdx >= components[componentIdx]->getPorts().size())
+        return PortIdentifier(*this, npos, 0);
+
+    return PortIdentifier(*this, componentIdx, portIdx);
+}
+
 std::pair<PortIdentifier, float_s>
 LabwareSystem::findClosestPort(const sf::Vector2f& point, const float_s maxSqDistance)
 {
@@ -495,3 +519,29 @@ std::vector<LabwareSystem> LabwareSystem::disconnect(const l_size componentIdx)
     result.emplace_back(LabwareSystem(std::move(temp), *lab));
     return result;
 }
+
+void LabwareSystem::toCheckpoint(CheckpointWriter& writer) const
+{
+    writer.write(size());
+    for (const auto& c : components) {
+        writer.write(c->id);
+        writer.write(c->getPosition().x);
+        writer.write(c->getPosition().y);
+        writer.write(c->getRotation());
+    }
+
+    // Connections are symmetric, so each one is written once, from its lower component index.
+    std::vector<std::pair<l_size, uint8_t>> sources;
+    for (l_size i = 0; i < connections.size(); ++i)
+        for (uint8_t p = 0; p < connections[i].size(); ++p)
+            if (not connections[i][p].isFree() && i < connections[i][p].otherComponent)
+                sources.emplace_back(i, p);
+
+    writer.write(static_cast<uint16_t>(sources.size()));
+    for (const auto& [i, p] : sources) {
+        writer.write(i);
+        writer.write(p);
+        writer.write(connections[i][p].otherComponent);
+        writer.write(connections[i][p].otherPort);
+    }
+}
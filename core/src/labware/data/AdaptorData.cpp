@@ -10,6 +10,8 @@ AdaptorData::AdaptorData(
     ContainerLabwareData(id, name, std::move(ports), textureFile, textureScale, volume, LabwareType::ADAPTOR)
 {}
 
+size_t AdaptorData::getMemoryUsage() const { return sizeof(*this) + getHeapUsage(); }
+
 void AdaptorData::dumpCustomProperties(def::DataDumper& dump) const
 {
     dump.property(def::Labware::Volume, getVolume())
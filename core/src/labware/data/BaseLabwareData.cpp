@@ -1,5 +1,7 @@
 #include "labware/data/BaseLabwareData.hpp"
 
+#include "utils/Memory.hpp"
+
 BaseLabwareData::BaseLabwareData(
     const LabwareId id, const std::string& name, std::vector<LabwarePort>&& ports, const LabwareType type) noexcept :
     id(id),
@@ -8,6 +10,8 @@ BaseLabwareData::BaseLabwareData(
     ports(std::move(ports))
 {}
 
+size_t BaseLabwareData::getHeapUsage() const { return utils::getHeapUsage(name) + utils::getHeapUsage(ports); }
+
 void BaseLabwareData::dumpDefinition(std::ostream& out, const bool prettify) const
 {
     static constexpr auto valueOffset = checked_cast<uint8_t>(utils::max(
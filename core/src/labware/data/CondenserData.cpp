@@ -24,6 +24,8 @@ CondenserData::CondenserData(
     efficiency(efficiency)
 {}
 
+size_t CondenserData::getMemoryUsage() const { return sizeof(*this) + getHeapUsage(); }
+
 void CondenserData::dumpCustomProperties(def::DataDumper& dump) const
 {
     dump.property(def::Labware::Volume, getVolume<0>())
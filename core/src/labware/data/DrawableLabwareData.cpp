@@ -2,6 +2,7 @@
 
 #include "graphics/Collision.hpp"
 #include "graphics/ShapeFill.hpp"
+#include "utils/Memory.hpp"
 #include "utils/Path.hpp"
 
 DrawableLabwareData::DrawableLabwareData(
@@ -18,6 +19,11 @@ DrawableLabwareData::DrawableLabwareData(
     Collision::createTextureAndBitmask(texture, textureFile);
 }
 
+size_t DrawableLabwareData::getHeapUsage() const
+{
+    return BaseLabwareData::getHeapUsage() + utils::getHeapUsage(textureFile);
+}
+
 void DrawableLabwareData::dumpTextures(const std::string& path) const
 {
     const auto txPath = utils::combinePaths(path, textureFile);
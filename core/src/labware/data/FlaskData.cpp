@@ -12,6 +12,8 @@ FlaskData::FlaskData(
     ContainerLabwareData(id, name, std::move(ports), textureFile, textureScale, volume, LabwareType::FLASK)
 {}
 
+size_t FlaskData::getMemoryUsage() const { return sizeof(*this) + getHeapUsage(); }
+
 void FlaskData::dumpCustomProperties(def::DataDumper& dump) const
 {
     dump.property(def::Labware::Volume, getVolume())
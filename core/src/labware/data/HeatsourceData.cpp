@@ -11,6 +11,8 @@ HeatsourceData::HeatsourceData(
     maxPowerOutput(maxPowerOutput)
 {}
 
+size_t HeatsourceData::getMemoryUsage() const { return sizeof(*this) + getHeapUsage(); }
+
 void HeatsourceData::dumpCustomProperties(def::DataDumper& dump) const
 {
     dump.property(def::Labware::Power, maxPowerOutput)
@@ -1,8 +1,14 @@
 #include "labware/kinds/Heatsource.hpp"
 
+#include "io/Checkpoint.hpp"
+#include "io/Log.hpp"
+
+#include <algorithm>
+
 Heatsource::Heatsource(const LabwareId id, Atmosphere& atmosphere) noexcept :
     EquipmentComponent(id, LabwareType::HEATSOURCE),
-    target(atmosphere)
+    target(atmosphere),
+    powerOutput(getData().maxPowerOutput)
 {}
 
 const HeatsourceData& Heatsource::getData() const { return static_cast<const HeatsourceData&>(data); }
@@ -11,6 +17,13 @@ void Heatsource::setTarget(const Ref<ContainerBase> newTarget) { target = newTar
 
 void Heatsource::setTarget(BaseContainerComponent& newTarget) { target = newTarget.getContent(); }
 
+Amount<Unit::WATT> Heatsource::getPowerOutput() const { return powerOutput; }
+
+void Heatsource::setPowerOutput(const Amount<Unit::WATT> power)
+{
+    powerOutput = std::clamp<float_s>(power.asStd(), 0.0f, getData().maxPowerOutput.asStd());
+}
+
 bool Heatsource::tryConnect(LabwareComponentBase& other)
 {
     if (other.isContainer()) {
@@ -23,10 +36,26 @@ bool Heatsource::tryConnect(LabwareComponentBase& other)
 
 void Heatsource::disconnect(const Ref<ContainerBase> dump, const LabwareComponentBase&) { this->setTarget(dump); }
 
+bool Heatsource::isSleeping() const { return target.isSet() == false || powerOutput == 0.0; }
+
 void Heatsource::tick(const Amount<Unit::SECOND> timespan)
 {
     if (target.isSet() == false)
         return;
 
-    target->addEnergy(getData().maxPowerOutput.to<Unit::JOULE>(timespan));
+    target->addEnergy(powerOutput.to<Unit::JOULE>(timespan));
+}
+
+void Heatsource::toCheckpoint(CheckpointWriter& writer) const { writer.write(powerOutput); }
+
+bool Heatsource::loadFromCheckpoint(CheckpointReader& reader)
+{
+    const auto power = reader.read<Amount<Unit::WATT>>();
+    if (not power) {
+        Log(this).error("Failed to read heat source from checkpoint.");
+        return false;
+    }
+
+    setPowerOutput(*power);
+    return true;
 }
@@ -25,4 +25,10 @@ bool LabwareComponentBase::tryConnect(LabwareComponentBase&) { return false; }
 
 void LabwareComponentBase::disconnect(Ref<ContainerBase>, const LabwareComponentBase&) {}
 
+bool LabwareComponentBase::isSleeping() const { return false; }
+
 void LabwareComponentBase::tick(const Amount<Unit::SECOND>) {}
+
+void LabwareComponentBase::toCheckpoint(CheckpointWriter&) const {}
+
+bool LabwareComponentBase::loadFromCheckpoint(CheckpointReader&) { return true; }
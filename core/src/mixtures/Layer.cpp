@@ -1,6 +1,9 @@
 #include "mixtures/Layer.hpp"
 
 #include "data/values/Constants.hpp"
+#include "io/Checkpoint.hpp"
+#include "io/Log.hpp"
+#include "mixtures/MixtureTransaction.hpp"
 #include "mixtures/kinds/Mixture.hpp"
 
 Layer::Layer(const Ref<Mixture> container, const LayerType layerType, const Amount<Unit::CELSIUS> temperature) noexcept
@@ -25,33 +28,41 @@ Layer::Layer(const Ref<Mixture> container, const LayerType layerType, const Amou
     }
 }
 
-void Layer::findNewLowNucleator()
+void Layer::findNewLowNucleator(const MixtureTransaction& pending)
 {
     lowNucleator.unset();
-    for (const auto& [_, r] : container->content)
-        if (r.layer == layerType && r.amount >= Constants::MOLAR_EXISTENCE_THRESHOLD)
+    for (const auto& [_, r] : container->getContent())
+        if (r.layer == layerType && pending.getAmountOf(r) >= Constants::MOLAR_EXISTENCE_THRESHOLD)
             lowNucleator.setIfLower(r);
+
+    // Shared content is bound to the mixture it was shared from.
+    if (lowNucleator.isSet())
+        lowNucleator.setReactant(lowNucleator.getReactant().mutate(container));
 }
 
-void Layer::findNewHighNucleator()
+void Layer::findNewHighNucleator(const MixtureTransaction& pending)
 {
     highNucleator.unset();
-    for (const auto& [_, r] : container->content)
-        if (r.layer == layerType && r.amount >= Constants::MOLAR_EXISTENCE_THRESHOLD)
+    for (const auto& [_, r] : container->getContent())
+        if (r.layer == layerType && pending.getAmountOf(r) >= Constants::MOLAR_EXISTENCE_THRESHOLD)
             highNucleator.setIfLower(r);
+
+    if (highNucleator.isSet())
+        highNucleator.setReactant(highNucleator.getReactant().mutate(container));
 }
 
-void Layer::consumePositivePotentialEnergy()
+bool Layer::consumePositivePotentialEnergy(MixtureTransaction& transaction)
 {
     const auto higherAggregationLayer = getHigherAggregationLayer(layerType);
-    while (isEmpty() == false) {
-        const auto hC = getTotalHeatCapacity();
+    auto       remainingMoles         = moles;
+    while (remainingMoles != 0.0) {
+        const auto hC = getTotalHeatCapacity(transaction);
 
         // no transition point
         if (highNucleator.isNull()) {
             temperature     += potentialEnergy.to<Unit::CELSIUS>(hC);
             potentialEnergy  = 0.0_J;
-            return;
+            return false;
         }
 
         // reach transition point
@@ -60,48 +71,50 @@ void Layer::consumePositivePotentialEnergy()
         if (reqE >= potentialEnergy) {
             temperature     += potentialEnergy.to<Unit::CELSIUS>(hC);
             potentialEnergy  = 0.0_J;
-            return;
+            return false;
         }
         temperature      = maxT;
         potentialEnergy -= reqE;
 
         // change the state of the nucleator
         const auto& nucleator = highNucleator.getReactant();
-        const auto  maxMoles  = container->getAmountOf(nucleator);
+        const auto  maxMoles  = transaction.getAmountOf(nucleator);
         const auto  lH        = highNucleator.getTransitionHeat();
         const auto  convMoles = potentialEnergy.to<Unit::MOLE>(lH);
         if (maxMoles >= convMoles) {
-            container->add(nucleator.mutate(convMoles, higherAggregationLayer));
-            container->add(nucleator.mutate(-convMoles));
+            transaction.add(nucleator.mutate(convMoles, higherAggregationLayer));
+            transaction.add(nucleator.mutate(-convMoles));
             potentialEnergy = 0.0_J;
-            return;
+            return false;
         }
-        container->add(nucleator.mutate(maxMoles, higherAggregationLayer));
-        container->add(nucleator.mutate(-maxMoles));
+        transaction.add(nucleator.mutate(maxMoles, higherAggregationLayer));
+        transaction.add(nucleator.mutate(-maxMoles));
+        remainingMoles  -= maxMoles;
         potentialEnergy -= lH.to<Unit::JOULE>(maxMoles);
 
         // find the new nucleator, repeat
-        findNewHighNucleator();
+        findNewHighNucleator(transaction);
     }
 
     if (higherAggregationLayer != LayerType::NONE)
-        container->add(potentialEnergy, higherAggregationLayer);
+        transaction.add(potentialEnergy, higherAggregationLayer);
 
     potentialEnergy = 0.0_J;
-    temperature     = Amount<Unit::CELSIUS>::Infinity;
+    return true;
 }
 
-void Layer::consumeNegativePotentialEnergy()
+bool Layer::consumeNegativePotentialEnergy(MixtureTransaction& transaction)
 {
     const auto lowerAggregationLayer = getLowerAggregationLayer(layerType);
-    while (isEmpty() == false) {
-        const auto hC = getTotalHeatCapacity();
+    auto       remainingMoles        = moles;
+    while (remainingMoles != 0.0) {
+        const auto hC = getTotalHeatCapacity(transaction);
 
         // no transition point
         if (lowNucleator.isNull()) {
             temperature     += potentialEnergy.to<Unit::CELSIUS>(hC);
             potentialEnergy  = 0.0_J;
-            return;
+            return false;
         }
 
         // reach transition point
@@ -110,35 +123,36 @@ void Layer::consumeNegativePotentialEnergy()
         if (reqE <= potentialEnergy) {
             temperature     += potentialEnergy.to<Unit::CELSIUS>(hC);
             potentialEnergy  = 0.0_J;
-            return;
+            return false;
         }
         temperature      = minT;
         potentialEnergy -= reqE;
 
         // change the state of the whole nucleator
         const auto& nucleator = lowNucleator.getReactant();
-        const auto  maxMoles  = container->getAmountOf(nucleator);
+        const auto  maxMoles  = transaction.getAmountOf(nucleator);
         const auto  lH        = lowNucleator.getTransitionHeat();
         const auto  convMoles = potentialEnergy.to<Unit::MOLE>(lH);
         if (maxMoles >= convMoles) {
-            container->add(nucleator.mutate(convMoles, lowerAggregationLayer));
-            container->add(nucleator.mutate(-convMoles));
+            transaction.add(nucleator.mutate(convMoles, lowerAggregationLayer));
+            transaction.add(nucleator.mutate(-convMoles));
             potentialEnergy = 0.0_J;
-            return;
+            return false;
         }
-        container->add(nucleator.mutate(maxMoles, lowerAggregationLayer));
-        container->add(nucleator.mutate(-maxMoles));
+        transaction.add(nucleator.mutate(maxMoles, lowerAggregationLayer));
+        transaction.add(nucleator.mutate(-maxMoles));
+        remainingMoles  -= maxMoles;
         potentialEnergy -= lH.to<Unit::JOULE>(maxMoles);
 
         // find the new nucleator, repeat
-        findNewLowNucleator();
+        findNewLowNucleator(transaction);
     }
 
     if (lowerAggregationLayer != LayerType::NONE)
-        container->add(potentialEnergy, lowerAggregationLayer);
+        transaction.add(potentialEnergy, lowerAggregationLayer);
 
     potentialEnergy = 0.0_J;
-    temperature     = Amount<Unit::CELSIUS>::Infinity;
+    return true;
 }
 
 Amount<Unit::JOULE> Layer::getLeastEnergyDiff(const Amount<Unit::CELSIUS> target) const
@@ -178,61 +192,68 @@ void Layer::convertTemporaryStateReactants()
     //        - temp reactats with smaller diffs act towards reaching the tp of those with higher or
     //        equal diffs
     //        - each contributes proportionally to its diff * mass
+
+    // The content can't be changed while being iterated.
+    // Transition heats are absorbed by the converted reactant while the energy diff is what the layer needs in order
+    // to reach the transition point, so the energy available for the conversion is the negated diff.
+    MixtureTransaction transaction(container);
     if (isLiquidLayer(layerType)) {
-        for (const auto& [_, r] : container->content) {
+        for (const auto& [_, r] : container->getContent()) {
             if (r.layer != layerType)
                 continue;
 
             auto tp = r.getBoilingPoint();
             if (tp < temperature) {
                 const auto lH        = r.getVaporizationHeat();
-                const auto convMoles = std::min(r.amount, lH.to<Unit::MOLE>(getLeastEnergyDiff(tp)));
-                container->add(r.mutate(convMoles, LayerType::GASEOUS));
-                container->add(r.mutate(-convMoles));
-                container->add(lH.to<Unit::JOULE>(convMoles), layerType);
+                const auto convMoles = std::min(r.amount, lH.to<Unit::MOLE>(-getLeastEnergyDiff(tp)));
+                transaction.add(r.mutate(convMoles, LayerType::GASEOUS));
+                transaction.add(r.mutate(-convMoles));
+                transaction.add(-lH.to<Unit::JOULE>(convMoles), layerType);
                 continue;
             }
 
             tp = r.getMeltingPoint();
             if (tp > temperature) {
                 const auto lH        = r.getFusionHeat();
-                const auto convMoles = std::min(r.amount, lH.to<Unit::MOLE>(getLeastEnergyDiff(tp)));
-                container->add(r.mutate(convMoles, LayerType::SOLID));
-                container->add(r.mutate(-convMoles));
-                container->add(lH.to<Unit::JOULE>(convMoles), layerType);
+                const auto convMoles = std::min(r.amount, lH.to<Unit::MOLE>(-getLeastEnergyDiff(tp)));
+                transaction.add(r.mutate(convMoles, LayerType::SOLID));
+                transaction.add(r.mutate(-convMoles));
+                transaction.add(-lH.to<Unit::JOULE>(convMoles), layerType);
             }
         }
     }
     else if (isGasLayer(layerType)) {
-        for (const auto& [_, r] : container->content) {
+        for (const auto& [_, r] : container->getContent()) {
             if (r.layer != layerType)
                 continue;
 
             const auto ltp = r.getBoilingPoint();
             if (ltp > temperature) {
                 const auto lH        = r.getCondensationHeat();
-                const auto convMoles = std::min(r.amount, lH.to<Unit::MOLE>(getLeastEnergyDiff(ltp)));
-                container->add(r.mutate(convMoles, LayerType::POLAR));
-                container->add(r.mutate(-convMoles));
-                container->add(lH.to<Unit::JOULE>(convMoles), layerType);
+                const auto convMoles = std::min(r.amount, lH.to<Unit::MOLE>(-getLeastEnergyDiff(ltp)));
+                transaction.add(r.mutate(convMoles, LayerType::POLAR));
+                transaction.add(r.mutate(-convMoles));
+                transaction.add(-lH.to<Unit::JOULE>(convMoles), layerType);
             }
         }
     }
     else if (isSolidLayer(layerType)) {
-        for (const auto& [_, r] : container->content) {
+        for (const auto& [_, r] : container->getContent()) {
             if (r.layer != layerType)
                 continue;
 
             const auto htp = r.getMeltingPoint();
             if (htp < temperature) {
                 const auto lH        = r.getLiquefactionHeat();
-                const auto convMoles = std::min(r.amount, lH.to<Unit::MOLE>(getLeastEnergyDiff(htp)));
-                container->add(r.mutate(convMoles, LayerType::POLAR));
-                container->add(r.mutate(-convMoles));
-                container->add(lH.to<Unit::JOULE>(convMoles), layerType);
+                const auto convMoles = std::min(r.amount, lH.to<Unit::MOLE>(-getLeastEnergyDiff(htp)));
+                transaction.add(r.mutate(convMoles, LayerType::POLAR));
+                transaction.add(r.mutate(-convMoles));
+                transaction.add(-lH.to<Unit::JOULE>(convMoles), layerType);
             }
         }
     }
+
+    transaction.commit();
 }
 
 LayerType Layer::getType() const { return layerType; }
@@ -293,6 +314,24 @@ Amount<Unit::JOULE_PER_CELSIUS> Layer::getTotalHeatCapacity() const
     return (hC / ms.asStd()).to<Unit::JOULE_PER_CELSIUS>(mo);
 }
 
+Amount<Unit::JOULE_PER_CELSIUS> Layer::getTotalHeatCapacity(const MixtureTransaction& pending) const
+{
+    Amount<Unit::JOULE_PER_MOLE_CELSIUS> hC = 0.0;
+    Amount<Unit::GRAM>                   ms = 0.0_g;
+    Amount<Unit::MOLE>                   mo = 0.0_mol;
+    for (const auto& [_, r] : container->content) {
+        if (r.layer == layerType && hasTemporaryState(r) == false) {
+            const auto amount  = pending.getAmountOf(r);
+            const auto mass    = amount.to<Unit::GRAM>(r.molecule.getMolarMass());
+            hC                += r.getHeatCapacity() * mass.asStd();
+            ms                += mass;
+            mo                += amount;
+        }
+    }
+
+    return (hC / ms.asStd()).to<Unit::JOULE_PER_CELSIUS>(mo);
+}
+
 Amount<Unit::JOULE_PER_MOLE> Layer::getKineticEnergy() const
 {
     return getHeatCapacity().to<Unit::JOULE_PER_MOLE>(temperature);
@@ -333,8 +372,11 @@ bool Layer::isEmpty() const { return moles == 0.0; }
 
 void Layer::setIfNucleator(const Reactant& reactant)
 {
-    lowNucleator.setIfLower(reactant);
-    highNucleator.setIfHigher(reactant);
+    // Shared content is bound to the mixture it was shared from.
+    if (lowNucleator.setIfLower(reactant))
+        lowNucleator.setReactant(reactant.mutate(container));
+    if (highNucleator.setIfHigher(reactant))
+        highNucleator.setReactant(reactant.mutate(container));
 }
 
 void Layer::unsetIfNucleator(const Reactant& reactant)
@@ -347,10 +389,19 @@ void Layer::unsetIfNucleator(const Reactant& reactant)
 
 void Layer::consumePotentialEnergy()
 {
-    if (potentialEnergy > 0.0)
-        consumePositivePotentialEnergy();
-    else if (potentialEnergy < 0.0)
-        consumeNegativePotentialEnergy();
+    if (potentialEnergy == 0.0)
+        return;
+
+    // Phase changes are applied at once, the loops using the pending amounts in between.
+    MixtureTransaction transaction(container);
+    const auto isConsumed = potentialEnergy > 0.0 ? consumePositivePotentialEnergy(transaction)
+                                                  : consumeNegativePotentialEnergy(transaction);
+    transaction.commit();
+
+    // Layers which changed their state entirely are left empty, and the layers they were moved to were created
+    // at the transition point.
+    if (isConsumed)
+        temperature = Amount<Unit::CELSIUS>::Infinity;
 }
 
 bool Layer::equals(const Layer& other, const Amount<>::StorageType epsilon) const
@@ -382,3 +433,42 @@ Layer Layer::makeCopy(const Ref<Mixture> newContainer) const
         temp.highNucleator.setReactant(temp.highNucleator.getReactant().mutate(newContainer));
     return temp;
 }
+
+void Layer::toCheckpoint(CheckpointWriter& writer) const
+{
+    writer.write(temperature);
+    writer.write(moles);
+    writer.write(mass);
+    writer.write(volume);
+    writer.write(potentialEnergy);
+    writer.write(polarity.hydrophilicity);
+    writer.write(polarity.lipophilicity);
+}
+
+bool Layer::loadFromCheckpoint(CheckpointReader& reader)
+{
+    const auto newTemperature     = reader.read<Amount<Unit::CELSIUS>>();
+    const auto newMoles           = reader.read<Amount<Unit::MOLE>>();
+    const auto newMass            = reader.read<Amount<Unit::GRAM>>();
+    const auto newVolume          = reader.read<Amount<Unit::LITER>>();
+    const auto newPotentialEnergy = reader.read<Amount<Unit::JOULE>>();
+    const auto newHydrophilicity  = reader.read<Amount<Unit::MOLE_RATIO>>();
+    const auto newLipophilicity   = reader.read<Amount<Unit::MOLE_RATIO>>();
+
+    // Reads fail once the stream fails, so checking the last one is enough.
+    if (not newLipophilicity) {
+        Log(this).error("Failed to read layer from checkpoint.");
+        return false;
+    }
+
+    temperature     = *newTemperature;
+    moles           = *newMoles;
+    mass            = *newMass;
+    volume          = *newVolume;
+    potentialEnergy = *newPotentialEnergy;
+    polarity        = Polarity(*newHydrophilicity, *newLipophilicity);
+
+    lowNucleator.unset();
+    highNucleator.unset();
+    return true;
+}
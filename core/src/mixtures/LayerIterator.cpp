@@ -0,0 +1,31 @@
+#include "mixtures/LayerIterator.hpp"
+
+#include "mixtures/Layer.hpp"
+
+#include <bit>
+
+LayerIterator::LayerIterator(const std::optional<Layer>* layers, const uint8_t mask, const bool isDownward) noexcept :
+    layers(layers),
+    mask(mask),
+    isDownward(isDownward)
+{}
+
+uint8_t LayerIterator::getIndex() const
+{
+    // Lower bits are upper layers.
+    return isDownward ? std::countr_zero(mask) : 7 - std::countl_zero(mask);
+}
+
+const Layer& LayerIterator::operator*() const { return *layers[getIndex()]; }
+
+const Layer* LayerIterator::operator->() const { return &*layers[getIndex()]; }
+
+LayerIterator& LayerIterator::operator++()
+{
+    mask &= ~static_cast<uint8_t>(1 << getIndex());
+    return *this;
+}
+
+bool LayerIterator::operator==(const LayerIterator& other) const { return this->mask == other.mask; }
+
+bool LayerIterator::operator!=(const LayerIterator& other) const { return this->mask != other.mask; }
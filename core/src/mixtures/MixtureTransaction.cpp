@@ -0,0 +1,57 @@
+#include "mixtures/MixtureTransaction.hpp"
+
+#include "mixtures/kinds/Mixture.hpp"
+
+MixtureTransaction::MixtureTransaction(const Ref<Mixture> mixture) noexcept :
+    mixture(mixture)
+{
+    heats.fill(0.0_J);
+}
+
+void MixtureTransaction::add(const Reactant& reactant)
+{
+    const auto [it, inserted] = reactantIndices.emplace(reactant.getId(), reactants.size());
+    if (inserted) {
+        reactants.emplace_back(reactant.mutate(mixture));
+        return;
+    }
+
+    reactants[it->second].amount += reactant.amount;
+}
+
+void MixtureTransaction::add(const Amount<Unit::JOULE> heat, const LayerType layer)
+{
+    heats[toIndex(layer)] += heat;
+    heatMask              |= static_cast<uint8_t>(layer);
+}
+
+Amount<Unit::MOLE> MixtureTransaction::getAmountOf(const Reactant& reactant) const
+{
+    const auto amount = mixture->getAmountOf(reactant);
+    const auto it     = reactantIndices.find(reactant.getId());
+    return it == reactantIndices.end() ? amount : amount + reactants[it->second].amount;
+}
+
+Amount<Unit::MOLE> MixtureTransaction::getAmountOf(const ReactantSet& reactantSet) const
+{
+    auto s = 0.0_mol;
+    for (const auto& [_, r] : reactantSet)
+        s += getAmountOf(r);
+    return s;
+}
+
+bool MixtureTransaction::isEmpty() const { return reactants.empty() && heatMask == 0; }
+
+void MixtureTransaction::commit()
+{
+    mixture->apply(*this);
+    discard();
+}
+
+void MixtureTransaction::discard()
+{
+    reactants.clear();
+    reactantIndices.clear();
+    heats.fill(0.0_J);
+    heatMask = 0;
+}
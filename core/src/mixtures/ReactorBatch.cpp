@@ -0,0 +1,276 @@
+#include "mixtures/ReactorBatch.hpp"
+
+#include "mixtures/MixtureTransaction.hpp"
+
+#include <bit>
+
+ReactorBatch::ReactorBatch(const Reactor& prototype, const size_t replicaCount) noexcept :
+    temperatures(getLayerCount() * replicaCount, 0.0_C),
+    heats(getLayerCount() * replicaCount, 0.0_J),
+    syncedRevisions(replicaCount, NoRevision),
+    totalMoles(replicaCount, 0.0_mol),
+    layerMasks(replicaCount, 0),
+    changeOrders(replicaCount)
+{
+    replicas.reserve(replicaCount);
+    for (size_t i = 0; i < replicaCount; ++i)
+        replicas.emplace_back(prototype.makeCopy());
+}
+
+size_t ReactorBatch::size() const { return replicas.size(); }
+
+const Reactor& ReactorBatch::getReplica(const size_t idx) const { return replicas[idx]; }
+
+Reactor& ReactorBatch::getReplica(const size_t idx) { return replicas[idx]; }
+
+size_t ReactorBatch::getSpeciesIdx(const Reactant& reactant)
+{
+    const auto [it, inserted] = speciesIndices.emplace(reactant.getId(), species.size());
+    if (inserted) {
+        species.emplace_back(reactant);
+        for (const auto& r : replicas)
+            amounts.emplace_back(r.getAmountOf(reactant));
+        deltas.resize(deltas.size() + replicas.size(), 0.0_mol);
+        isChanged.resize(isChanged.size() + replicas.size(), false);
+    }
+    return it->second;
+}
+
+void ReactorBatch::shareReactionCache()
+{
+    const auto& shared = replicas.front().cachedReactions;
+    if (std::all_of(
+            replicas.begin(), replicas.end(), [&](const Reactor& r) { return r.cachedReactions == shared; }))
+        return;
+
+    // Caches holding the same reactions are shared as they are, keeping the order of the reactions.
+    const auto isSubsetOf = [](const Reactor::ReactionCache& subset, const Reactor::ReactionCache& set) {
+        return subset.size() <= set.size() &&
+               std::all_of(subset.begin(), subset.end(), [&](const auto& r) { return set.contains(r); });
+    };
+
+    auto largest = std::max_element(replicas.begin(), replicas.end(), [](const Reactor& r1, const Reactor& r2) {
+                       return r1.cachedReactions->size() < r2.cachedReactions->size();
+                   })->cachedReactions;
+    if (std::any_of(replicas.begin(), replicas.end(), [&](const Reactor& r) {
+            return not isSubsetOf(*r.cachedReactions, *largest);
+        })) {
+        std::vector<const ConcreteReaction*> reactions;
+        for (const auto& r : replicas)
+            for (const auto& reaction : *r.cachedReactions)
+                reactions.emplace_back(&reaction);
+
+        largest = Reactor::makeReactionCache(std::move(reactions));
+    }
+
+    for (auto& r : replicas)
+        r.cachedReactions = largest;
+}
+
+void ReactorBatch::syncLayers(const size_t replicaIdx)
+{
+    const auto& replica      = replicas[replicaIdx];
+    const auto  replicaCount = replicas.size();
+
+    layerMasks[replicaIdx] = 0;
+    for (uint8_t l = 0; l < getLayerCount(); ++l) {
+        const auto layer = static_cast<LayerType>(1 << l);
+        if (not replica.hasLayer(layer))
+            continue;
+
+        layerMasks[replicaIdx]                     |= static_cast<uint8_t>(layer);
+        temperatures[l * replicaCount + replicaIdx] = replica.getLayerTemperature(layer);
+    }
+
+    totalMoles[replicaIdx]      = replica.totalMoles;
+    syncedRevisions[replicaIdx] = replica.getRevision();
+}
+
+void ReactorBatch::sync(const size_t replicaIdx)
+{
+    const auto& replica = replicas[replicaIdx];
+    if (syncedRevisions[replicaIdx] == replica.getRevision())
+        return;
+
+    for (size_t i = 0; i < species.size(); ++i)
+        amounts[i * replicas.size() + replicaIdx] = replica.getAmountOf(species[i]);
+    syncLayers(replicaIdx);
+}
+
+void ReactorBatch::runReactions()
+{
+    const auto replicaCount = replicas.size();
+
+    reactantAmounts.resize(replicaCount);
+    speedCoefficients.resize(replicaCount);
+    isReacting.resize(replicaCount);
+    heatMasks.assign(replicaCount, 0);
+
+    const auto addDelta = [&](const size_t speciesIdx, const size_t replicaIdx, const Amount<Unit::MOLE> delta) {
+        const auto idx = speciesIdx * replicaCount + replicaIdx;
+        deltas[idx]   += delta;
+        if (not isChanged[idx]) {
+            isChanged[idx] = true;
+            changeOrders[replicaIdx].emplace_back(speciesIdx);
+        }
+    };
+
+    std::vector<size_t> reactantIndices;
+    for (const auto& r : *replicas.front().cachedReactions) {
+        const auto& data  = r.getData();
+        const auto  layer = r.getReactants().any().layer;
+
+        reactantIndices.clear();
+        for (const auto& [_, i] : r.getReactants())
+            reactantIndices.emplace_back(getSpeciesIdx(i));
+
+        std::fill(reactantAmounts.begin(), reactantAmounts.end(), 0.0_mol);
+        for (const auto i : reactantIndices) {
+            const auto* rowAmounts = &amounts[i * replicaCount];
+            const auto* rowDeltas  = &deltas[i * replicaCount];
+            for (size_t k = 0; k < replicaCount; ++k)
+                reactantAmounts[k] += rowAmounts[k] + rowDeltas[k];
+        }
+
+        // Rate laws are given by estimators, evaluated across the replicas. A replica without the layer of the
+        // reactants has none of them, so the reaction can't run there.
+        const auto* layerTemperatures = &temperatures[toIndex(layer) * replicaCount];
+        for (size_t k = 0; k < replicaCount; ++k) {
+            if (not isDue[k] || (layerMasks[k] & static_cast<uint8_t>(layer)) == 0) {
+                speedCoefficients[k] = 0.0_mol;
+                continue;
+            }
+
+            speedCoefficients[k] =
+                data.getSpeedAt(layerTemperatures[k], reactantAmounts[k].to<Unit::MOLE_RATIO>(totalMoles[k]))
+                    .to<Unit::MOLE>(timespans[k]) *
+                replicas[k].getReactivityCoefficient(r);
+        }
+
+        for (size_t k = 0; k < replicaCount; ++k)
+            isReacting[k] = speedCoefficients[k] != 0;
+
+        // If there isn't enough of a reactant, the speed coefficient is adjusted.
+        size_t reactantIdx = 0;
+        for (const auto& [_, i] : r.getReactants()) {
+            const auto* rowAmounts = &amounts[reactantIndices[reactantIdx] * replicaCount];
+            const auto* rowDeltas  = &deltas[reactantIndices[reactantIdx] * replicaCount];
+            for (size_t k = 0; k < replicaCount; ++k) {
+                const auto a = rowAmounts[k] + rowDeltas[k];
+                if (isReacting[k] && a < i.amount * speedCoefficients[k])
+                    speedCoefficients[k] = a / i.amount;
+            }
+            ++reactantIdx;
+        }
+
+        for (size_t k = 0; k < replicaCount; ++k)
+            isReacting[k] = speedCoefficients[k] != 0;
+
+        reactantIdx = 0;
+        for (const auto& [_, i] : r.getReactants()) {
+            const auto speciesIdx = reactantIndices[reactantIdx++];
+            for (size_t k = 0; k < replicaCount; ++k)
+                if (isReacting[k])
+                    addDelta(speciesIdx, k, -i.amount * speedCoefficients[k]);
+        }
+
+        // Products are placed in the layers they fit in, which depend on the state of each replica.
+        for (const auto& [_, i] : r.getProducts())
+            for (size_t k = 0; k < replicaCount; ++k) {
+                if (not isReacting[k])
+                    continue;
+
+                const auto p = i.mutate(i.amount * speedCoefficients[k], replicas[k]);
+                addDelta(getSpeciesIdx(p.mutate(replicas[k].findLayerFor(p))), k, p.amount);
+            }
+
+        auto* layerHeats = &heats[toIndex(layer) * replicaCount];
+        for (size_t k = 0; k < replicaCount; ++k) {
+            if (not isReacting[k])
+                continue;
+
+            layerHeats[k] += data.reactionEnergy.to<Unit::JOULE>(speedCoefficients[k]);
+            heatMasks[k]  |= static_cast<uint8_t>(layer);
+        }
+    }
+
+    // Changes are committed in the same order as done by the transaction of a single reactor. Only the changed
+    // rows are read back, the other ones being left untouched by the commit.
+    for (size_t k = 0; k < replicaCount; ++k) {
+        if (not isDue[k])
+            continue;
+
+        auto&              replica = replicas[k];
+        MixtureTransaction transaction(replica);
+        for (const auto i : changeOrders[k])
+            transaction.add(species[i].mutate(deltas[i * replicaCount + k]));
+
+        for (auto mask = heatMasks[k]; mask; mask &= mask - 1) {
+            const auto layer = static_cast<LayerType>(1 << std::countr_zero(mask));
+            auto&      heat  = heats[toIndex(layer) * replicaCount + k];
+            transaction.add(heat, layer);
+            heat = 0.0_J;
+        }
+
+        transaction.commit();
+
+        for (const auto i : changeOrders[k]) {
+            const auto idx = i * replicaCount + k;
+            amounts[idx]   = replica.getAmountOf(species[i]);
+            deltas[idx]    = 0.0_mol;
+            isChanged[idx] = false;
+        }
+        changeOrders[k].clear();
+        syncLayers(k);
+    }
+}
+
+void ReactorBatch::tick(const Amount<Unit::SECOND> timespan)
+{
+    if (replicas.empty())
+        return;
+
+    isDue.assign(replicas.size(), false);
+    timespans.assign(replicas.size(), 0.0_s);
+
+    std::vector<uint8_t> isAwake(replicas.size(), false);
+    for (size_t k = 0; k < replicas.size(); ++k) {
+        auto& replica = replicas[k];
+        if (not replica.beginTick(timespan))
+            continue;
+
+        isAwake[k] = true;
+        if (const auto elapsed = replica.beginPhase(TickMode::ENABLE_REACTIONS)) {
+            replica.findNewReactions();
+            if (replica.equilibriumSolver)
+                replica.runEquilibrium();
+
+            if (replica.kineticsSolver) {
+                replica.runImplicitReactions(*elapsed);
+                replica.endPhase(TickMode::ENABLE_REACTIONS);
+                continue;
+            }
+
+            isDue[k]     = true;
+            timespans[k] = *elapsed;
+        }
+    }
+
+    if (std::any_of(isDue.begin(), isDue.end(), [](const auto d) { return d; })) {
+        shareReactionCache();
+        for (size_t k = 0; k < replicas.size(); ++k)
+            if (isDue[k])
+                sync(k);
+
+        runReactions();
+    }
+
+    for (size_t k = 0; k < replicas.size(); ++k) {
+        if (not isAwake[k])
+            continue;
+
+        if (isDue[k])
+            replicas[k].endPhase(TickMode::ENABLE_REACTIONS);
+        replicas[k].endTick();
+    }
+}
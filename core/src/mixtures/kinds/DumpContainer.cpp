@@ -1,5 +1,6 @@
 #include "mixtures/kinds/DumpContainer.hpp"
 
+#include "io/Checkpoint.hpp"
 #include "io/Log.hpp"
 #include "reactions/Reactant.hpp"
 
@@ -8,6 +9,8 @@ DumpContainer DumpContainer::GlobalDumpContainer = DumpContainer();
 void DumpContainer::add(const Reactant& reactant)
 {
     const auto rMass = reactant.getMass();
+
+    std::lock_guard lock(mutex);
     if (totalMass.overflowsOnAdd(rMass)) {
         Log(this).warn("Mass overflowed and was set to 0 (some checks might fail).");
         totalMass = 0.0;
@@ -19,15 +22,46 @@ void DumpContainer::add(const Reactant& reactant)
 
 void DumpContainer::addEnergy(const Amount<Unit::JOULE> energy)
 {
+    std::lock_guard lock(mutex);
     if (totalEnergy.overflowsOnAdd(energy)) {
         Log(this).warn("Energy overflowed and was set to 0 (some checks might fail).");
-        totalMass = 0.0;
+        totalEnergy = 0.0;
         return;
     }
 
     totalEnergy += energy;
 }
 
-Amount<Unit::GRAM> DumpContainer::getTotalMass() const { return totalMass; }
+Amount<Unit::GRAM> DumpContainer::getTotalMass() const
+{
+    std::lock_guard lock(mutex);
+    return totalMass;
+}
+
+Amount<Unit::JOULE> DumpContainer::getTotalEnergy() const
+{
+    std::lock_guard lock(mutex);
+    return totalEnergy;
+}
+
+void DumpContainer::toCheckpoint(CheckpointWriter& writer) const
+{
+    std::lock_guard lock(mutex);
+    writer.write(totalMass);
+    writer.write(totalEnergy);
+}
 
-Amount<Unit::JOULE> DumpContainer::getTotalEnergy() const { return totalEnergy; }
+bool DumpContainer::loadFromCheckpoint(CheckpointReader& reader)
+{
+    const auto newTotalMass   = reader.read<Amount<Unit::GRAM>>();
+    const auto newTotalEnergy = reader.read<Amount<Unit::JOULE>>();
+    if (not newTotalEnergy) {
+        Log(this).error("Failed to read dump container from checkpoint.");
+        return false;
+    }
+
+    std::lock_guard lock(mutex);
+    totalMass   = *newTotalMass;
+    totalEnergy = *newTotalEnergy;
+    return true;
+}
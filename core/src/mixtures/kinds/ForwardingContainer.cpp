@@ -1,5 +1,8 @@
 #include "mixtures/kinds/ForwardingContainer.hpp"
 
+#include "io/Checkpoint.hpp"
+#include "io/Log.hpp"
+
 ForwardingContainer::ForwardingContainer(
     std::initializer_list<ForwardingRule> forwardingRules, Ref<ContainerBase> defaultTarget) noexcept :
     defaultTarget(defaultTarget),
@@ -31,3 +34,27 @@ void ForwardingContainer::addRule(ForwardingRule rule) { forwardingRules.push_ba
 ForwardingRule ForwardingContainer::getRule(const size_t idx) const { return forwardingRules[idx]; }
 
 const std::vector<ForwardingRule>& ForwardingContainer::getRules() const { return forwardingRules; }
+
+void ForwardingContainer::toCheckpoint(CheckpointWriter& writer) const
+{
+    writer.write(static_cast<uint32_t>(forwardingRules.size()));
+}
+
+bool ForwardingContainer::loadFromCheckpoint(CheckpointReader& reader)
+{
+    const auto ruleCount = reader.read<uint32_t>();
+    if (not ruleCount) {
+        Log(this).error("Failed to read forwarding container from checkpoint.");
+        return false;
+    }
+
+    if (*ruleCount != forwardingRules.size()) {
+        Log(this).error(
+            "Checkpoint forwarding container has: {} rules, but the loading container has: {}.",
+            *ruleCount,
+            forwardingRules.size());
+        return false;
+    }
+
+    return true;
+}
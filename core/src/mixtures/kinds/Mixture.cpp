@@ -1,7 +1,13 @@
 #include "mixtures/kinds/Mixture.hpp"
 
+#include "io/Checkpoint.hpp"
+#include "io/Log.hpp"
+#include "mixtures/MixtureTransaction.hpp"
 #include "reactions/Catalyst.hpp"
 
+#include <bit>
+#include <unordered_set>
+
 Mixture::Mixture(const Mixture& other) noexcept :
     content(other.content.makeCopy(*this))
 {}
@@ -19,6 +25,68 @@ void Mixture::add(const Molecule& molecule, const Amount<Unit::MOLE> amount)
     add(Reactant(molecule, LayerType::NONE, amount, *this));
 }
 
+void Mixture::apply(const MixtureTransaction& transaction)
+{
+    for (const auto& r : transaction.reactants)
+        if (r.amount != 0.0)
+            add(r);
+
+    for (auto mask = transaction.heatMask; mask; mask &= mask - 1) {
+        const auto layer = static_cast<LayerType>(1 << std::countr_zero(mask));
+        add(transaction.heats[toIndex(layer)], layer);
+    }
+}
+
+void Mixture::contentToCheckpoint(CheckpointWriter& writer) const
+{
+    writer.write(static_cast<uint32_t>(content.size()));
+    for (const auto& [_, r] : content) {
+        writer.write(r.molecule);
+        writer.write(r.layer);
+        writer.write(r.amount);
+        writer.write(r.isNew);
+    }
+}
+
+std::optional<ReactantSet> Mixture::loadContentFromCheckpoint(CheckpointReader& reader)
+{
+    const auto size = reader.read<uint32_t>();
+    if (not size) {
+        Log(this).error("Failed to read content from checkpoint.");
+        return std::nullopt;
+    }
+
+    ReactantSet                    result(*this);
+    std::unordered_set<ReactantId> oldReactants;
+    result.reserve(*size);
+    for (uint32_t i = 0; i < *size; ++i) {
+        const auto molecule = reader.readMolecule();
+        if (not molecule) {
+            Log(this).error("Failed to read content molecule from checkpoint.");
+            return std::nullopt;
+        }
+
+        const auto layer  = reader.read<LayerType>();
+        const auto amount = reader.read<Amount<Unit::MOLE>>();
+        const auto isNew  = reader.read<bool>();
+        if (not isNew || not isRealLayer(*layer)) {
+            Log(this).error(
+                "Failed to read content reactant: '{}' from checkpoint.", molecule->getStructure().toSMILES());
+            return std::nullopt;
+        }
+
+        result.add(Reactant(*molecule, *layer, *amount, *this));
+        if (not *isNew)
+            oldReactants.emplace(molecule->getId(), *layer);
+    }
+
+    // Reactants are always new when added.
+    for (auto& [id, r] : result)
+        r.isNew = not oldReactants.contains(id);
+
+    return result;
+}
+
 const ReactantSet& Mixture::getContent() const { return content; }
 
 ContentInitializer Mixture::getContentInitializer() const { return ContentInitializer(content); }
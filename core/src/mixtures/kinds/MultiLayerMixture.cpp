@@ -1,6 +1,39 @@
 #include "mixtures/kinds/MultiLayerMixture.hpp"
 
 #include "data/values/Constants.hpp"
+#include "io/Checkpoint.hpp"
+#include "mixtures/MixtureTransaction.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+namespace
+{
+
+constexpr uint8_t toMask(const LayerType layer) { return static_cast<uint8_t>(layer); }
+
+/// <summary>
+/// Returns the mask of the layer types placed above the given one.
+/// </summary>
+constexpr uint8_t getAboveMask(const LayerType layer) { return static_cast<uint8_t>(toMask(layer) - 1); }
+
+/// <summary>
+/// Returns the mask of the layer types placed below the given one.
+/// </summary>
+constexpr uint8_t getBelowMask(const LayerType layer) { return static_cast<uint8_t>(~((toMask(layer) << 1) - 1)); }
+
+LayerType getTopmostLayer(const uint8_t mask)
+{
+    return mask ? static_cast<LayerType>(1 << std::countr_zero(mask)) : LayerType::NONE;
+}
+
+LayerType getBottommostLayer(const uint8_t mask)
+{
+    return mask ? static_cast<LayerType>(1 << (7 - std::countl_zero(mask))) : LayerType::NONE;
+}
+
+}  // namespace
 
 MultiLayerMixture::MultiLayerMixture(const MultiLayerMixture& other) noexcept :
     Mixture(other),
@@ -9,10 +42,14 @@ MultiLayerMixture::MultiLayerMixture(const MultiLayerMixture& other) noexcept :
     totalMass(other.totalMass),
     totalVolume(other.totalVolume),
     maxVolume(other.maxVolume),
-    overflowTarget(other.overflowTarget)
+    overflowTarget(other.overflowTarget),
+    layerMask(other.layerMask),
+    filledLayerMask(other.filledLayerMask),
+    revision(other.revision)
 {
-    for (const auto& l : other.layers)
-        this->layers.emplace(std::make_pair(l.first, l.second.makeCopy(*this)));
+    for (size_t i = 0; i < layers.size(); ++i)
+        if (other.layers[i])
+            this->layers[i].emplace(other.layers[i]->makeCopy(*this));
 }
 
 MultiLayerMixture::MultiLayerMixture(
@@ -23,25 +60,57 @@ MultiLayerMixture::MultiLayerMixture(
     maxVolume(maxVolume),
     overflowTarget(overflowTarget)
 {
-    layers.emplace(LayerType::GASEOUS, Layer(*this, LayerType::GASEOUS, atmosphere->getLayer().temperature));
+    layers[toIndex(LayerType::GASEOUS)].emplace(*this, LayerType::GASEOUS, atmosphere->getLayer().temperature);
+    layerMask = toMask(LayerType::GASEOUS);
     atmosphere->copyContentTo(*this, maxVolume);
 }
 
+void MultiLayerMixture::restore(const MultiLayerMixture& other, ReactantSet&& newContent)
+{
+    if (this == &other)
+        return;
+
+    if (this->maxVolume != other.maxVolume)
+        Log(this).warn("Restoring a mixture with a different maximum volume.");
+
+    content     = std::move(newContent);
+    pressure    = other.pressure;
+    totalMoles  = other.totalMoles;
+    totalMass   = other.totalMass;
+    totalVolume = other.totalVolume;
+
+    for (size_t i = 0; i < layers.size(); ++i) {
+        if (other.layers[i])
+            layers[i].emplace(other.layers[i]->makeCopy(*this));
+        else
+            layers[i].reset();
+    }
+    layerMask       = other.layerMask;
+    filledLayerMask = other.filledLayerMask;
+
+    // Revisions must never repeat, since equal revisions imply an unchanged state.
+    revision = std::max(revision, other.revision) + 1;
+}
+
 bool MultiLayerMixture::tryCreateLayer(const LayerType layer)
 {
-    if (isRealLayer(layer) == false || layers.contains(layer))
+    if (isRealLayer(layer) == false || (layerMask & toMask(layer)))
         return false;
 
+    // The gaseous layer always exists, even if empty.
     const auto adjacentLayer = getClosestLayer(layer);
-    layers.emplace(std::make_pair(layer, Layer(*this, layer, layers.at(adjacentLayer).temperature)));
+    const auto temperature   = getLayer(adjacentLayer != LayerType::NONE ? adjacentLayer : LayerType::GASEOUS)
+                                 .temperature;
+
+    layers[toIndex(layer)].emplace(*this, layer, temperature);
+    layerMask |= toMask(layer);
     return true;
 }
 
-void MultiLayerMixture::addToLayer(const Reactant& reactant)
+Layer& MultiLayerMixture::addToLayerTotals(const Reactant& reactant)
 {
     tryCreateLayer(reactant.layer);
-
-    auto& layer = layers[reactant.layer];
+    auto& layer = getMutableLayer(reactant.layer);
 
     // add polarity to layer average polarity
     const auto polarity           = reactant.molecule.getPolarity();
@@ -52,6 +121,10 @@ void MultiLayerMixture::addToLayer(const Reactant& reactant)
 
     totalMoles  += reactant.amount;
     layer.moles += reactant.amount;
+    if (layer.isEmpty())
+        filledLayerMask &= ~toMask(reactant.layer);
+    else
+        filledLayerMask |= toMask(reactant.layer);
 
     const auto mass  = reactant.getMass();
     totalMass       += mass;
@@ -61,6 +134,15 @@ void MultiLayerMixture::addToLayer(const Reactant& reactant)
     totalVolume    += vol;
     layer.volume   += vol;
 
+    return layer;
+}
+
+void MultiLayerMixture::addToLayer(const Reactant& reactant)
+{
+    if (reactant.amount != 0.0)
+        ++revision;
+
+    auto& layer = addToLayerTotals(reactant);
     if (reactant.isNew)
         layer.setIfNucleator(reactant);
     else if (content.contains(reactant) == false)
@@ -69,11 +151,57 @@ void MultiLayerMixture::addToLayer(const Reactant& reactant)
 
 void MultiLayerMixture::add(const Amount<Unit::JOULE> heat, const LayerType layer)
 {
-    layers.at(layer).potentialEnergy += heat;
+    if (heat == 0.0)
+        return;
+
+    getMutableLayer(layer).potentialEnergy += heat;
+    ++revision;
+}
+
+void MultiLayerMixture::apply(const MixtureTransaction& transaction)
+{
+    // The nucleators are only checked once all the layers hold their final amounts.
+    std::vector<const Reactant*> applied;
+    applied.reserve(transaction.reactants.size());
+    for (const auto& r : transaction.reactants) {
+        if (r.amount == 0.0 || content.add(r) == false)
+            continue;
+
+        addToLayerTotals(r.mutate(*this));
+        applied.emplace_back(&r);
+    }
+
+    for (const auto r : applied) {
+        if (r->isNew)
+            getMutableLayer(r->layer).setIfNucleator(*r);
+        else if (content.contains(*r) == false)
+            getMutableLayer(r->layer).unsetIfNucleator(*r);
+    }
+
+    bool changed = not applied.empty();
+    for (auto mask = transaction.heatMask; mask; mask &= mask - 1) {
+        const auto layer = static_cast<LayerType>(1 << std::countr_zero(mask));
+        const auto heat  = transaction.heats[toIndex(layer)];
+        if (heat == 0.0)
+            continue;
+
+        getMutableLayer(layer).potentialEnergy += heat;
+        changed                                 = true;
+    }
+
+    if (changed)
+        ++revision;
 }
 
 void MultiLayerMixture::removeNegligibles()
 {
+    // Checked beforehand, since iterating over shared content for changes copies it.
+    const auto& reactants = content.getReactants();
+    if (std::none_of(reactants.begin(), reactants.end(), [](const auto& r) {
+            return r.second.amount < Constants::MOLAR_EXISTENCE_THRESHOLD;
+        }))
+        return;
+
     bool removedAny = false;
     for (auto r = content.begin(); r != content.end();) {
         if (r->second.amount < Constants::MOLAR_EXISTENCE_THRESHOLD) {
@@ -91,7 +219,7 @@ void MultiLayerMixture::removeNegligibles()
         return;
 
     for (const auto& [_, r] : content) {
-        layers.at(r.layer).setIfNucleator(r);
+        getMutableLayer(r.layer).setIfNucleator(r);
     }
 }
 
@@ -104,92 +232,47 @@ void MultiLayerMixture::checkOverflow()
     if (overflow <= 0.0)
         return;
 
-    auto  topLayerType = getTopLayer();
-    auto* topLayer     = &layers.at(topLayerType);
+    auto        topLayerType = getTopLayer();
+    const auto* topLayer     = &getLayer(topLayerType);
 
     while (overflow > topLayer->volume) {
         overflow -= topLayer->volume;
         moveContentTo(overflowTarget, topLayer->volume, topLayerType);
 
         topLayerType = getTopLayer();
-        topLayer     = &layers.at(topLayerType);
+        topLayer     = &getLayer(topLayerType);
     }
 
     moveContentTo(overflowTarget, overflow, topLayerType);
 }
 
-LayerType MultiLayerMixture::getTopLayer() const
-{
-    for (auto l = layers.cbegin(); l != layers.cend(); ++l)
-        if (l->second.isEmpty() == false)
-            return l->first;
-
-    return LayerType::NONE;
-}
+LayerType MultiLayerMixture::getTopLayer() const { return getTopmostLayer(filledLayerMask); }
 
-LayerType MultiLayerMixture::getBottomLayer() const
-{
-    for (auto l = layers.crbegin(); l != layers.crend(); ++l)
-        if (l->second.isEmpty() == false)
-            return l->first;
-
-    return LayerType::NONE;
-}
+LayerType MultiLayerMixture::getBottomLayer() const { return getBottommostLayer(filledLayerMask); }
 
 LayerType MultiLayerMixture::getLayerAbove(LayerType layer) const
 {
-    auto l = std::map<LayerType, Layer>::const_reverse_iterator(layers.lower_bound(layer));
-    if (l != layers.crend() && l->first == layer)
-        ++l;
-
-    for (; l != layers.crend(); ++l)
-        if (l->second.isEmpty() == false)
-            return l->first;
-
-    return LayerType::NONE;
+    return getBottommostLayer(filledLayerMask & getAboveMask(layer));
 }
 
 LayerType MultiLayerMixture::getLayerBelow(LayerType layer) const
 {
-    for (auto l = layers.upper_bound(layer); l != layers.cend(); ++l)
-        if (l->second.isEmpty() == false)
-            return l->first;
-
-    return LayerType::NONE;
+    return getTopmostLayer(filledLayerMask & getBelowMask(layer));
 }
 
 LayerType MultiLayerMixture::getClosestLayer(LayerType layer) const
 {
-    if (layers.empty())
-        return LayerType::NONE;
-
-    auto l     = layers.lower_bound(layer);
-    auto below = (l != layers.cend() && l->first == layer) ? std::next(l) : l;
-    auto above = std::map<LayerType, Layer>::const_reverse_iterator(l);
-
-    while (below != layers.cend() && above != layers.crend()) {
-        if (below->second.isEmpty() == false)
-            return below->first;
-        if (above->second.isEmpty() == false)
-            return above->first;
-
-        ++below;
-        ++above;
-    }
-
-    while (below != layers.cend()) {
-        if (below->second.isEmpty() == false)
-            return below->first;
-        ++below;
-    }
-
-    while (above != layers.crend()) {
-        if (above->second.isEmpty() == false)
-            return above->first;
-        ++above;
-    }
-
-    return LayerType::NONE;
+    const auto above = getLayerAbove(layer);
+    const auto below = getLayerBelow(layer);
+    if (above == LayerType::NONE || below == LayerType::NONE)
+        return above == LayerType::NONE ? below : above;
+
+    // The distance is given by the number of existing layers in between, the layer below being preferred.
+    const uint8_t aboveRange    = layerMask & getAboveMask(layer) & ~getAboveMask(above);
+    const uint8_t belowRange    = layerMask & getBelowMask(layer) & ~getBelowMask(below);
+    const auto    aboveDistance = std::popcount(aboveRange);
+    const auto    belowDistance = std::popcount(belowRange);
+    return belowDistance <= aboveDistance ? below : above;
 }
 
 bool MultiLayerMixture::areAdjacentLayers(LayerType layer1, LayerType layer2) const
@@ -206,21 +289,24 @@ bool MultiLayerMixture::areAdjacentLayers(LayerType layer1, LayerType layer2) co
 LayerType MultiLayerMixture::findLayerFor(const Reactant& reactant) const
 {
     for (const auto& l : layers) {
-        const auto rAggr = reactant.getAggregationAt(l.second.temperature);
-        const auto lAggr = getAggregationType(l.first);
+        if (not l)
+            continue;
+
+        const auto rAggr = reactant.getAggregationAt(l->temperature);
+        const auto lAggr = getAggregationType(l->layerType);
 
         if (rAggr != lAggr)
             continue;
 
         if (lAggr != AggregationType::LIQUID)
-            return l.first;
+            return l->layerType;
 
         const auto polarity = reactant.molecule.getPolarity();
-        const auto density  = reactant.molecule.getDensityAt(l.second.temperature, pressure);
-        return getLayerType(getAggregationType(l.first), polarity.getPartitionCoefficient() > 1.0, density > 1.0);
+        const auto density  = reactant.molecule.getDensityAt(l->temperature, pressure);
+        return getLayerType(getAggregationType(l->layerType), polarity.getPartitionCoefficient() > 1.0, density > 1.0);
     }
 
-    const auto defaultT = layers.at(LayerType::GASEOUS).temperature;
+    const auto defaultT = getLayer(LayerType::GASEOUS).temperature;
     const auto newAgg   = reactant.getAggregationAt(defaultT);
     const auto polarity = reactant.molecule.getPolarity();
     const auto density  = reactant.molecule.getDensityAt(defaultT, pressure);
@@ -229,8 +315,9 @@ LayerType MultiLayerMixture::findLayerFor(const Reactant& reactant) const
 
 void MultiLayerMixture::add(const Reactant& reactant)
 {
-    content.add(reactant);
-    addToLayer(reactant.mutate(*this));
+    // The layers must only account for what the content holds.
+    if (content.add(reactant))
+        addToLayer(reactant.mutate(*this));
 }
 
 void MultiLayerMixture::add(const Molecule& molecule, const Amount<Unit::MOLE> amount)
@@ -241,51 +328,61 @@ void MultiLayerMixture::add(const Molecule& molecule, const Amount<Unit::MOLE> a
 
 void MultiLayerMixture::addEnergy(const Amount<Unit::JOULE> energy)
 {
-    const auto  lA = getLayerAbove(LayerType::SOLID);
-    const auto& lS = layers.find(LayerType::SOLID);
+    if (energy == 0.0)
+        return;
 
-    if (lS == layers.end()) {
-        layers.at(lA).potentialEnergy += energy;
+    ++revision;
+    const auto lA = getLayerAbove(LayerType::SOLID);
+    if ((layerMask & toMask(LayerType::SOLID)) == 0) {
+        getMutableLayer(lA).potentialEnergy += energy;
         return;
     }
 
-    lS->second.potentialEnergy    += energy * 0.5;
-    layers.at(lA).potentialEnergy += energy * 0.5;
+    getMutableLayer(LayerType::SOLID).potentialEnergy += energy * 0.5;
+    getMutableLayer(lA).potentialEnergy               += energy * 0.5;
 }
 
 bool MultiLayerMixture::hasLayer(const LayerType layer) const
 {
-    const auto& l = layers.find(layer);
-    return l != layers.cend() && l->second.isEmpty() == false;
+    return isRealLayer(layer) && (filledLayerMask & toMask(layer));
 }
 
 Amount<Unit::LITER> MultiLayerMixture::getMaxVolume() const { return maxVolume; }
 
-const Layer& MultiLayerMixture::getLayer(const LayerType layer) const { return layers.at(layer); }
+uint64_t MultiLayerMixture::getRevision() const { return revision; }
+
+Layer& MultiLayerMixture::getMutableLayer(const LayerType layer)
+{
+    // Shared reactants read the temperatures of the mixture they were shared from.
+    content.detach();
+    return layers.at(toIndex(layer)).value();
+}
+
+const Layer& MultiLayerMixture::getLayer(const LayerType layer) const { return layers.at(toIndex(layer)).value(); }
 
 Amount<Unit::CELSIUS> MultiLayerMixture::getLayerTemperature(const LayerType layer) const
 {
-    return layers.at(layer).temperature;
+    return getLayer(layer).temperature;
 }
 
 Amount<Unit::JOULE_PER_MOLE_CELSIUS> MultiLayerMixture::getLayerHeatCapacity(const LayerType layer) const
 {
-    return layers.at(layer).getHeatCapacity();
+    return getLayer(layer).getHeatCapacity();
 }
 
 Amount<Unit::JOULE_PER_CELSIUS> MultiLayerMixture::getLayerTotalHeatCapacity(const LayerType layer) const
 {
-    return layers.at(layer).getTotalHeatCapacity();
+    return getLayer(layer).getTotalHeatCapacity();
 }
 
 Amount<Unit::JOULE_PER_MOLE> MultiLayerMixture::getLayerKineticEnergy(const LayerType layer) const
 {
-    return layers.at(layer).getKineticEnergy();
+    return getLayer(layer).getKineticEnergy();
 }
 
-Polarity MultiLayerMixture::getLayerPolarity(const LayerType layer) const { return layers.at(layer).getPolarity(); }
+Polarity MultiLayerMixture::getLayerPolarity(const LayerType layer) const { return getLayer(layer).getPolarity(); }
 
-Color MultiLayerMixture::getLayerColor(const LayerType layer) const { return layers.at(layer).getColor(); }
+Color MultiLayerMixture::getLayerColor(const LayerType layer) const { return getLayer(layer).getColor(); }
 
 bool MultiLayerMixture::isEmpty() const { return totalMoles == 0.0_mol; }
 
@@ -307,13 +404,25 @@ Amount<Unit::GRAM> MultiLayerMixture::getTotalMass() const { return totalMass; }
 
 Amount<Unit::LITER> MultiLayerMixture::getTotalVolume() const { return totalVolume; }
 
-MultiLayerMixture::LayerDownIterator MultiLayerMixture::getLayersDownBegin() const { return layers.cbegin(); }
+MultiLayerMixture::LayerDownIterator MultiLayerMixture::getLayersDownBegin() const
+{
+    return LayerIterator(layers.data(), layerMask, true);
+}
 
-MultiLayerMixture::LayerDownIterator MultiLayerMixture::getLayersDownEnd() const { return layers.cend(); }
+MultiLayerMixture::LayerDownIterator MultiLayerMixture::getLayersDownEnd() const
+{
+    return LayerIterator(layers.data(), 0, true);
+}
 
-MultiLayerMixture::LayerUpIterator MultiLayerMixture::getLayersUpBegin() const { return layers.crbegin(); }
+MultiLayerMixture::LayerUpIterator MultiLayerMixture::getLayersUpBegin() const
+{
+    return LayerIterator(layers.data(), layerMask, false);
+}
 
-MultiLayerMixture::LayerUpIterator MultiLayerMixture::getLayersUpEnd() const { return layers.crend(); }
+MultiLayerMixture::LayerUpIterator MultiLayerMixture::getLayersUpEnd() const
+{
+    return LayerIterator(layers.data(), 0, false);
+}
 
 void MultiLayerMixture::copyContentTo(
     Ref<ContainerBase> destination, const Amount<Unit::LITER> volume, const LayerType sourceLayer) const
@@ -322,7 +431,7 @@ void MultiLayerMixture::copyContentTo(
         return;
 
     // save and use initial volume
-    const auto sourceVolume = layers.at(sourceLayer).volume.asStd();
+    const auto sourceVolume = getLayer(sourceLayer).volume.asStd();
 
     for (const auto& [_, r] : content) {
         if (r.layer != sourceLayer)
@@ -340,7 +449,7 @@ void MultiLayerMixture::moveContentTo(
         return;
 
     // save and use initial volume
-    const auto sourceVolume = layers.at(sourceLayer).volume.asStd();
+    const auto sourceVolume = getLayer(sourceLayer).volume.asStd();
 
     if (volume > sourceVolume)
         volume = sourceVolume;
@@ -356,3 +465,79 @@ void MultiLayerMixture::moveContentTo(
 }
 
 MultiLayerMixture MultiLayerMixture::makeCopy() const { return MultiLayerMixture(*this); }
+
+void MultiLayerMixture::toCheckpoint(CheckpointWriter& writer) const
+{
+    writer.write(maxVolume);
+    writer.write(pressure);
+    writer.write(totalMoles);
+    writer.write(totalMass);
+    writer.write(totalVolume);
+    contentToCheckpoint(writer);
+
+    writer.write(layerMask);
+    writer.write(filledLayerMask);
+    for (const auto& l : layers)
+        if (l)
+            l->toCheckpoint(writer);
+}
+
+bool MultiLayerMixture::loadFromCheckpoint(CheckpointReader& reader)
+{
+    const auto newMaxVolume   = reader.read<Amount<Unit::LITER>>();
+    const auto newPressure    = reader.read<Amount<Unit::TORR>>();
+    const auto newTotalMoles  = reader.read<Amount<Unit::MOLE>>();
+    const auto newTotalMass   = reader.read<Amount<Unit::GRAM>>();
+    const auto newTotalVolume = reader.read<Amount<Unit::LITER>>();
+    if (not newTotalVolume) {
+        Log(this).error("Failed to read mixture from checkpoint.");
+        return false;
+    }
+
+    if (*newMaxVolume != maxVolume)
+        Log(this).warn("Loading a mixture with a different maximum volume from checkpoint.");
+
+    auto newContent = loadContentFromCheckpoint(reader);
+    if (not newContent)
+        return false;
+
+    static constexpr uint8_t AllLayersMask = (1 << getLayerCount()) - 1;
+
+    const auto newLayerMask       = reader.read<uint8_t>();
+    const auto newFilledLayerMask = reader.read<uint8_t>();
+    if (not newFilledLayerMask || (*newLayerMask & ~AllLayersMask) || (*newFilledLayerMask & ~*newLayerMask)) {
+        Log(this).error("Failed to read mixture layers from checkpoint.");
+        return false;
+    }
+
+    std::array<std::optional<Layer>, getLayerCount()> newLayers;
+    for (uint8_t i = 0; i < newLayers.size(); ++i) {
+        if ((*newLayerMask & (1 << i)) == 0)
+            continue;
+
+        newLayers[i].emplace(*this, static_cast<LayerType>(1 << i));
+        if (not newLayers[i]->loadFromCheckpoint(reader))
+            return false;
+    }
+
+    content     = std::move(*newContent);
+    pressure    = *newPressure;
+    totalMoles  = *newTotalMoles;
+    totalMass   = *newTotalMass;
+    totalVolume = *newTotalVolume;
+
+    for (size_t i = 0; i < layers.size(); ++i) {
+        layers[i].reset();
+        if (newLayers[i])
+            layers[i].emplace(std::move(*newLayers[i]));
+    }
+    layerMask       = *newLayerMask;
+    filledLayerMask = *newFilledLayerMask;
+
+    for (const auto& [_, r] : content)
+        if (layerMask & toMask(r.layer))
+            getMutableLayer(r.layer).setIfNucleator(r);
+
+    ++revision;
+    return true;
+}
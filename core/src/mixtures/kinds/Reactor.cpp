@@ -1,24 +1,37 @@
 #include "mixtures/kinds/Reactor.hpp"
 
 #include "data/DataStore.hpp"
+#include "io/Checkpoint.hpp"
 #include "io/Log.hpp"
+#include "mixtures/MixtureTransaction.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <map>
 
 Reactor::Reactor(const Reactor& other) noexcept :
     MultiLayerMixture(static_cast<const MultiLayerMixture&>(other).makeCopy()),
     stirSpeed(other.stirSpeed),
-    tickMode(other.tickMode)
-{
-    this->cachedReactions.reserve(other.cachedReactions.size());
-    for (const auto& r : other.cachedReactions)
-        this->cachedReactions.emplace(r.makeCopy());
-}
+    tickMode(other.tickMode),
+    scheduler(other.scheduler),
+    cachedReactions(other.cachedReactions),
+    kineticsSolver(other.kineticsSolver),
+    equilibriumSolver(other.equilibriumSolver),
+    equilibriumThreshold(other.equilibriumThreshold),
+    quiescenceEpsilon(other.quiescenceEpsilon),
+    quiescenceTickCount(other.quiescenceTickCount),
+    sleepRevision(other.sleepRevision)
+{}
 
 Reactor::Reactor(
     const Ref<Atmosphere>     atmosphere,
     const Amount<Unit::LITER> maxVolume,
     const Ref<ContainerBase>  overflowTarget) noexcept :
     MultiLayerMixture(atmosphere, maxVolume, overflowTarget)
-{}
+{
+    // Conduction is slow compared to the usual tick timespans, so it can be batched without loss of accuracy.
+    scheduler.setInterval(TickMode::ENABLE_CONDUCTION, 0.1_s);
+}
 
 Reactor::Reactor(const Ref<Atmosphere> atmosphere, const Amount<Unit::LITER> maxVolume) noexcept :
     Reactor(atmosphere, maxVolume, atmosphere)
@@ -74,13 +87,49 @@ float_s Reactor::getCatalyticReactivityCoefficient(const ImmutableSet<Catalyst>&
     return 1.0;
 }
 
+std::shared_ptr<Reactor::ReactionCache> Reactor::makeReactionCache(std::vector<const ConcreteReaction*>&& reactions)
+{
+    // Equal sets inserted in the same order into tables with the same bucket count iterate in the same order.
+    const std::hash<ConcreteReaction> hash;
+    std::sort(reactions.begin(), reactions.end(), [&](const auto lhs, const auto rhs) {
+        return std::pair(hash(*lhs), lhs->getData().id) < std::pair(hash(*rhs), rhs->getData().id);
+    });
+
+    auto result = std::make_shared<ReactionCache>();
+    result->reserve(reactions.size());
+    for (const auto r : reactions)
+        if (not result->contains(*r))
+            result->emplace(r->makeCopy());
+
+    return result;
+}
+
+void Reactor::addToReactionCache(const ReactionCache& reactions)
+{
+    // The cache is rebuilt even if it isn't shared, merging in place would make the order of its reactions
+    // depend on the order in which they were found.
+    std::vector<const ConcreteReaction*> all;
+    all.reserve(cachedReactions->size() + reactions.size());
+    for (const auto& r : *cachedReactions)
+        all.emplace_back(&r);
+    for (const auto& r : reactions)
+        all.emplace_back(&r);
+
+    cachedReactions = makeReactionCache(std::move(all));
+}
+
 void Reactor::findNewReactions()
 {
+    const auto& current = getContent();
+    if (std::none_of(current.begin(), current.end(), [](const auto& r) { return r.second.isNew; }))
+        return;
+
     // TODO: optimize (perhaps a generator would be good)
     const auto reactants = utils::extractValues(content.getReactants());
     const auto arrangements =
         utils::getArrangementsWithRepetitions(reactants, dataAccessor.get().reactions.getMaxReactantCount());
 
+    ReactionCache newReactions;
     for (size_t i = 0; i < arrangements.size(); ++i) {
         const bool anyNew =
             std::any_of(arrangements[i].begin(), arrangements[i].end(), [](const Reactant& r) { return r.isNew; });
@@ -88,24 +137,50 @@ void Reactor::findNewReactions()
         if (anyNew == false)
             continue;
 
-        auto newReactions = dataAccessor.get().reactions.findOccurringReactions(arrangements[i]);
-        cachedReactions.merge(std::move(newReactions));
+        auto found = dataAccessor.get().reactions.findOccurringReactions(arrangements[i]);
+        std::erase_if(found, [&](const auto& r) { return cachedReactions->contains(r); });
+        newReactions.merge(std::move(found));
     }
 
+    // The cache is only copied if something new was found.
+    if (newReactions.size())
+        addToReactionCache(newReactions);
+
     for (auto& [_, r] : content)
         r.isNew = false;
 }
 
+float_s Reactor::getReactivityCoefficient(const ConcreteReaction& reaction) const
+{
+    return totalVolume.asStd() *
+           getInterLayerReactivityCoefficient(reaction.getReactants()) *
+           getCatalyticReactivityCoefficient(reaction.getCatalysts());
+}
+
+KineticsSolver::RateFunction
+Reactor::getRateFunction(const ConcreteReaction& reaction, const float_s coefficient) const
+{
+    return [&data = reaction.getData(),
+            temperature = getLayerTemperature(reaction.getReactants().any().layer),
+            totalMoles  = totalMoles,
+            coefficient](const float_h reactantAmount) {
+        const auto concentration =
+            Amount<Unit::MOLE>(static_cast<float_s>(reactantAmount)).to<Unit::MOLE_RATIO>(totalMoles);
+        return static_cast<float_h>(data.getSpeedAt(temperature, concentration).asStd()) * coefficient;
+    };
+}
+
 void Reactor::runReactions(const Amount<Unit::SECOND> timespan)
 {
-    for (const auto& r : cachedReactions) {
-        auto speedCoef =
-            r.getData()
-                .getSpeedAt(r.getReactantTemperature(), getAmountOf(r.getReactants()).to<Unit::MOLE_RATIO>(totalMoles))
-                .to<Unit::MOLE>(timespan) *
-            totalVolume.asStd() *
-            getInterLayerReactivityCoefficient(r.getReactants()) *
-            getCatalyticReactivityCoefficient(r.getCatalysts());
+    // Reactions see the amounts left by the previous ones, but the mixture is only updated once at the end.
+    MixtureTransaction transaction(*this);
+    for (const auto& r : *cachedReactions) {
+        auto speedCoef = r.getData()
+                             .getSpeedAt(
+                                 getLayerTemperature(r.getReactants().any().layer),
+                                 transaction.getAmountOf(r.getReactants()).to<Unit::MOLE_RATIO>(totalMoles))
+                             .to<Unit::MOLE>(timespan) *
+                         getReactivityCoefficient(r);
 
         if (speedCoef == 0)
             continue;
@@ -114,7 +189,7 @@ void Reactor::runReactions(const Amount<Unit::SECOND> timespan)
 
         // if there isn't enough of a reactant, adjust the speed coefficient
         for (const auto& [_, i] : r.getReactants()) {
-            const auto a = getAmountOf(i);
+            const auto a = transaction.getAmountOf(i);
             if (a < i.amount * speedCoef)
                 speedCoef = a / i.amount;
         }
@@ -123,13 +198,171 @@ void Reactor::runReactions(const Amount<Unit::SECOND> timespan)
             continue;
 
         for (const auto& [_, i] : r.getReactants())
-            MultiLayerMixture::add(i.mutate(-i.amount * speedCoef, *this));
+            transaction.add(i.mutate(-i.amount * speedCoef, *this));
         for (const auto& [_, i] : r.getProducts()) {
             const auto p = i.mutate(i.amount * speedCoef, *this);
-            MultiLayerMixture::add(p.mutate(findLayerFor(p)));
+            transaction.add(p.mutate(findLayerFor(p)));
+        }
+
+        transaction.add(r.getData().reactionEnergy.to<Unit::JOULE>(speedCoef), r.getReactants().any().layer);
+    }
+
+    transaction.commit();
+}
+
+void Reactor::runImplicitReactions(const Amount<Unit::SECOND> timespan)
+{
+    // Temperatures, volume and total moles are considered constant during the tick, their changes are
+    // accounted for in the next tick.
+    kineticsSolver->reset();
+
+    std::vector<Reactant>                  species;
+    std::unordered_map<ReactantId, size_t> speciesIndices;
+    const auto                             getSpeciesIdx = [&](const Reactant& reactant) {
+        const auto [it, inserted] = speciesIndices.emplace(reactant.getId(), species.size());
+        if (inserted) {
+            species.emplace_back(reactant);
+            kineticsSolver->addSpecies(getAmountOf(reactant).asStd());
+        }
+        return it->second;
+    };
+
+    std::vector<const ConcreteReaction*> reactions;
+    for (const auto& r : *cachedReactions) {
+        const auto coefficient = getReactivityCoefficient(r);
+        if (coefficient == 0)
+            continue;
+
+        std::vector<KineticsSolver::Term> reactants;
+        reactants.reserve(r.getReactants().size());
+        for (const auto& [_, i] : r.getReactants())
+            reactants.emplace_back(getSpeciesIdx(i.mutate(*this)), i.amount.asStd());
+
+        std::vector<KineticsSolver::Term> products;
+        products.reserve(r.getProducts().size());
+        for (const auto& [_, i] : r.getProducts()) {
+            const auto p = i.mutate(*this);
+            products.emplace_back(getSpeciesIdx(p.mutate(findLayerFor(p))), i.amount.asStd());
+        }
+
+        kineticsSolver->addReaction(std::move(reactants), std::move(products), getRateFunction(r, coefficient));
+        reactions.emplace_back(&r);
+    }
+
+    const auto stepCount = kineticsSolver->integrate(timespan.asStd());
+    Log(this).trace(
+        "Integrated {} reactions over {} species in {} steps.", reactions.size(), species.size(), stepCount);
+
+    for (size_t i = 0; i < species.size(); ++i) {
+        // Small overshoots into negative amounts are clamped.
+        const auto before = getAmountOf(species[i]);
+        const auto after  = std::max(kineticsSolver->getAmount(i), 0.0);
+        const auto delta  = Amount<Unit::MOLE>(static_cast<float_s>(after)) - before;
+        if (delta != 0)
+            MultiLayerMixture::add(species[i].mutate(delta));
+    }
+
+    for (size_t i = 0; i < reactions.size(); ++i) {
+        const auto extent = Amount<Unit::MOLE>(static_cast<float_s>(kineticsSolver->getExtent(i)));
+        if (extent == 0)
+            continue;
+
+        const auto& data = reactions[i]->getData();
+        MultiLayerMixture::add(data.reactionEnergy.to<Unit::JOULE>(extent), reactions[i]->getReactants().any().layer);
+    }
+}
+
+void Reactor::runEquilibrium()
+{
+    using Stoichiometry = std::vector<std::pair<MoleculeId, float_s>>;
+    const auto getStoichiometry = [](const ReactantSet& reactants) {
+        Stoichiometry result;
+        result.reserve(reactants.size());
+        for (const auto& [_, r] : reactants)
+            result.emplace_back(r.molecule.getId(), r.amount.asStd());
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+
+    // Keyed by both sides, since the same reactants may react into different products.
+    std::map<std::pair<Stoichiometry, Stoichiometry>, const ConcreteReaction*> reactionsBySides;
+    for (const auto& r : *cachedReactions)
+        reactionsBySides.emplace(std::pair(getStoichiometry(r.getReactants()), getStoichiometry(r.getProducts())), &r);
+
+    std::vector<std::pair<const ConcreteReaction*, const ConcreteReaction*>> pairs;
+    for (const auto& [sides, r] : reactionsBySides) {
+        const auto& [reactants, products] = sides;
+        if (not(reactants < products))
+            continue;
+
+        const auto reverse = reactionsBySides.find(std::pair(products, reactants));
+        if (reverse != reactionsBySides.end())
+            pairs.emplace_back(r, reverse->second);
+    }
+
+    if (pairs.empty())
+        return;
+
+    equilibriumSolver->reset();
+
+    std::vector<Reactant>                  species;
+    std::unordered_map<ReactantId, size_t> speciesIndices;
+    const auto                             getTerms = [&](const ReactantSet& reactants) {
+        std::vector<EquilibriumSolver::Term> result;
+        result.reserve(reactants.size());
+        for (const auto& [_, i] : reactants) {
+            const auto reactant       = i.mutate(*this);
+            const auto [it, inserted] = speciesIndices.emplace(reactant.getId(), species.size());
+            if (inserted) {
+                species.emplace_back(reactant);
+                equilibriumSolver->addSpecies(getAmountOf(reactant).asStd());
+            }
+            result.emplace_back(it->second, i.amount.asStd());
         }
+        return result;
+    };
+
+    // The reactants of the reverse reaction are the products of the forward one, already placed in the layers
+    // in which they react.
+    std::vector<std::pair<const ConcreteReaction*, const ConcreteReaction*>> reversibleReactions;
+    for (const auto& [forward, backward] : pairs) {
+        const auto forwardCoefficient  = getReactivityCoefficient(*forward);
+        const auto backwardCoefficient = getReactivityCoefficient(*backward);
+        if (forwardCoefficient == 0 || backwardCoefficient == 0)
+            continue;
+
+        equilibriumSolver->addReaction(
+            getTerms(forward->getReactants()),
+            getTerms(backward->getReactants()),
+            getRateFunction(*forward, forwardCoefficient),
+            getRateFunction(*backward, backwardCoefficient));
+        reversibleReactions.emplace_back(forward, backward);
+    }
+
+    if (reversibleReactions.empty() || equilibriumSolver->getImbalance() > equilibriumThreshold)
+        return;
+
+    if (not equilibriumSolver->solve())
+        Log(this).warn("Equilibrium solution for {} reactions did not converge.", reversibleReactions.size());
 
-        MultiLayerMixture::add(r.getData().reactionEnergy.to<Unit::JOULE>(speedCoef), r.getReactants().any().layer);
+    for (size_t i = 0; i < species.size(); ++i) {
+        const auto before = getAmountOf(species[i]);
+        const auto after  = std::max(equilibriumSolver->getAmount(i), 0.0);
+        const auto delta  = Amount<Unit::MOLE>(static_cast<float_s>(after)) - before;
+        if (delta != 0)
+            MultiLayerMixture::add(species[i].mutate(delta));
+    }
+
+    for (size_t i = 0; i < reversibleReactions.size(); ++i) {
+        const auto extent = Amount<Unit::MOLE>(static_cast<float_s>(equilibriumSolver->getExtent(i)));
+        if (extent == 0)
+            continue;
+
+        // Negative extents are applied as extents of the reverse reaction.
+        const auto reaction = extent > 0 ? reversibleReactions[i].first : reversibleReactions[i].second;
+        MultiLayerMixture::add(
+            reaction->getData().reactionEnergy.to<Unit::JOULE>(extent > 0 ? extent : -extent),
+            reaction->getReactants().any().layer);
     }
 }
 
@@ -138,12 +371,18 @@ void Reactor::runLayerEnergyConduction(const Amount<Unit::SECOND> timespan)
     // TODO: find way to determine these based on molecular composition
     static const auto favourableC   = 0.000005_W;  // as relative conductivity
     static const auto unfavourableC = 0.000003_W;  // as relative conductivity
+    // Smaller differences are considered equilibrium, since they are only approached asymptotically.
+    static const auto minDiff = 0.0001_C;
 
-    for (auto& l : layers) {
-        if (const auto above = getLayerAbove(l.first); above != LayerType::NONE) {
-            const auto aboveLayer = layers.at(above);
-            const auto diff       = (l.second.temperature - aboveLayer.temperature);
-            if (diff == 0)
+    for (auto& layer : layers) {
+        if (not layer)
+            continue;
+
+        auto& l = *layer;
+        if (const auto above = getLayerAbove(l.layerType); above != LayerType::NONE) {
+            const auto& aboveLayer = getLayer(above);
+            const auto  diff       = (l.temperature - aboveLayer.temperature);
+            if (diff.equals(0.0_C, minDiff.asStd()))
                 continue;
 
             const auto diffE =
@@ -151,19 +390,19 @@ void Reactor::runLayerEnergyConduction(const Amount<Unit::SECOND> timespan)
                     ?
                     // molecules closer to the top usually have more
                     // energy than the layer avg. => favour up conversion
-                    l.second.getHeatCapacity().to<Unit::JOULE_PER_CELSIUS>(l.second.moles).to<Unit::JOULE>(diff) *
+                    l.getHeatCapacity().to<Unit::JOULE_PER_CELSIUS>(l.moles).to<Unit::JOULE>(diff) *
                         favourableC.to<Unit::JOULE>(timespan)
-                    : l.second.getHeatCapacity().to<Unit::JOULE_PER_CELSIUS>(aboveLayer.moles).to<Unit::JOULE>(diff) *
+                    : l.getHeatCapacity().to<Unit::JOULE_PER_CELSIUS>(aboveLayer.moles).to<Unit::JOULE>(diff) *
                           unfavourableC.to<Unit::JOULE>(timespan);
 
             MultiLayerMixture::add(diffE, above);
-            MultiLayerMixture::add(-diffE, l.first);
+            MultiLayerMixture::add(-diffE, l.layerType);
         }
 
-        if (const auto below = getLayerBelow(l.first); below != LayerType::NONE) {
-            const auto belowLayer = layers.at(below);
-            const auto diff       = (l.second.temperature - belowLayer.temperature);
-            if (diff == 0)
+        if (const auto below = getLayerBelow(l.layerType); below != LayerType::NONE) {
+            const auto& belowLayer = getLayer(below);
+            const auto  diff       = (l.temperature - belowLayer.temperature);
+            if (diff.equals(0.0_C, minDiff.asStd()))
                 continue;
 
             const auto diffE =
@@ -171,13 +410,13 @@ void Reactor::runLayerEnergyConduction(const Amount<Unit::SECOND> timespan)
                     ?
                     // molecules closer to the bottom usually have less
                     // energy than the layer avg. => favour down conversion
-                    l.second.getHeatCapacity().to<Unit::JOULE_PER_CELSIUS>(l.second.moles).to<Unit::JOULE>(diff) *
+                    l.getHeatCapacity().to<Unit::JOULE_PER_CELSIUS>(l.moles).to<Unit::JOULE>(diff) *
                         unfavourableC.to<Unit::JOULE>(timespan)
-                    : l.second.getHeatCapacity().to<Unit::JOULE_PER_CELSIUS>(belowLayer.moles).to<Unit::JOULE>(diff) *
+                    : l.getHeatCapacity().to<Unit::JOULE_PER_CELSIUS>(belowLayer.moles).to<Unit::JOULE>(diff) *
                           favourableC.to<Unit::JOULE>(timespan);
 
             MultiLayerMixture::add(diffE, below);
-            MultiLayerMixture::add(-diffE, l.first);
+            MultiLayerMixture::add(-diffE, l.layerType);
         }
     }
 }
@@ -185,11 +424,48 @@ void Reactor::runLayerEnergyConduction(const Amount<Unit::SECOND> timespan)
 void Reactor::consumePotentialEnergy()
 {
     for (auto& l : layers) {
-        l.second.convertTemporaryStateReactants();
-        l.second.consumePotentialEnergy();
+        if (not l)
+            continue;
+
+        l->convertTemporaryStateReactants();
+        if (l->potentialEnergy != 0.0)
+            content.detach();
+
+        const auto temperature = l->temperature;
+        l->consumePotentialEnergy();
+        if (l->temperature != temperature)
+            ++revision;
+    }
+}
+
+void Reactor::checkQuiescence()
+{
+    if (quiescenceTickCount == 0)
+        return;
+
+    if (quiescenceReference && ++quiescentTicks < quiescenceTickCount)
+        return;
+
+    // Unchanged revisions imply the same state, so the comparison is skipped for exact steady states.
+    if (quiescenceReference &&
+        (quiescenceReference->revision == revision || isSame(*quiescenceReference, quiescenceEpsilon))) {
+        Log(this).trace("Reactor is quiescent, going to sleep.");
+        sleepRevision = revision;
+        quiescenceReference.reset();
+        return;
     }
+
+    quiescenceReference.reset(new Reactor(*this));
+    quiescentTicks = 0;
+}
+
+std::optional<Amount<Unit::SECOND>> Reactor::beginPhase(const TickMode phase)
+{
+    return tickMode.has(phase) ? scheduler.begin(phase, revision) : std::nullopt;
 }
 
+void Reactor::endPhase(const TickMode phase) { scheduler.end(phase, revision); }
+
 void Reactor::addEnergy(const Amount<Unit::JOULE> energy) { MultiLayerMixture::addEnergy(energy); }
 
 void Reactor::add(const Molecule& molecule, const Amount<Unit::MOLE> amount)
@@ -197,28 +473,130 @@ void Reactor::add(const Molecule& molecule, const Amount<Unit::MOLE> amount)
     MultiLayerMixture::add(molecule, amount);
 }
 
+void Reactor::enableImplicitKinetics(const float_h relativeTolerance, const float_h absoluteTolerance)
+{
+    kineticsSolver.emplace(relativeTolerance, absoluteTolerance);
+    scheduler.invalidate();
+    wake();
+}
+
+void Reactor::disableImplicitKinetics()
+{
+    kineticsSolver.reset();
+    scheduler.invalidate();
+    wake();
+}
+
+bool Reactor::hasImplicitKinetics() const { return kineticsSolver.has_value(); }
+
+void Reactor::enableEquilibriumSolver(const float_h threshold, const float_h tolerance)
+{
+    equilibriumSolver.emplace(tolerance);
+    equilibriumThreshold = threshold;
+    scheduler.invalidate();
+    wake();
+}
+
+void Reactor::disableEquilibriumSolver()
+{
+    equilibriumSolver.reset();
+    scheduler.invalidate();
+    wake();
+}
+
+bool Reactor::hasEquilibriumSolver() const { return equilibriumSolver.has_value(); }
+
 FlagField<TickMode> Reactor::getTickMode() const { return tickMode; }
 
-void Reactor::setTickMode(const FlagField<TickMode> mode) { tickMode.set(mode); }
+void Reactor::setTickMode(const FlagField<TickMode> mode)
+{
+    tickMode.set(mode);
+    scheduler.invalidate();
+    wake();
+}
 
-void Reactor::tick(const Amount<Unit::SECOND> timespan)
+void Reactor::setTickInterval(const TickMode phase, const Amount<Unit::SECOND> interval)
+{
+    scheduler.setInterval(phase, interval);
+    wake();
+}
+
+Amount<Unit::SECOND> Reactor::getTickInterval(const TickMode phase) const { return scheduler.getInterval(phase); }
+
+void Reactor::setQuiescenceThreshold(const Amount<>::StorageType epsilon, const uint32_t tickCount)
 {
-    if (tickMode.has(TickMode::ENABLE_OVERFLOW))
+    quiescenceEpsilon   = epsilon;
+    quiescenceTickCount = tickCount;
+    wake();
+}
+
+bool Reactor::isSleeping() const { return sleepRevision == revision; }
+
+void Reactor::wake()
+{
+    sleepRevision.reset();
+    quiescenceReference.reset();
+    quiescentTicks = 0;
+}
+
+bool Reactor::beginTick(const Amount<Unit::SECOND> timespan)
+{
+    // Any change of the content or energy wakes the reactor up.
+    if (sleepRevision) {
+        if (*sleepRevision == revision)
+            return false;
+        wake();
+    }
+
+    // Each phase runs only if the state changed since its last run, except for its own changes, so reactors in
+    // a steady state are skipped.
+    scheduler.advance(timespan, tickMode);
+
+    if (beginPhase(TickMode::ENABLE_OVERFLOW)) {
         checkOverflow();
+        endPhase(TickMode::ENABLE_OVERFLOW);
+    }
 
-    if (tickMode.has(TickMode::ENABLE_NEGLIGIBLES))
+    if (beginPhase(TickMode::ENABLE_NEGLIGIBLES)) {
         removeNegligibles();
-
-    if (tickMode.has(TickMode::ENABLE_REACTIONS)) {
-        findNewReactions();
-        runReactions(timespan);
+        endPhase(TickMode::ENABLE_NEGLIGIBLES);
     }
 
-    if (tickMode.has(TickMode::ENABLE_CONDUCTION))
-        runLayerEnergyConduction(timespan);
+    return true;
+}
+
+void Reactor::endTick()
+{
+    if (const auto elapsed = beginPhase(TickMode::ENABLE_CONDUCTION)) {
+        runLayerEnergyConduction(*elapsed);
+        endPhase(TickMode::ENABLE_CONDUCTION);
+    }
 
-    if (tickMode.has(TickMode::ENABLE_ENERGY))
+    if (beginPhase(TickMode::ENABLE_ENERGY)) {
         consumePotentialEnergy();
+        endPhase(TickMode::ENABLE_ENERGY);
+    }
+
+    checkQuiescence();
+}
+
+void Reactor::tick(const Amount<Unit::SECOND> timespan)
+{
+    if (not beginTick(timespan))
+        return;
+
+    if (const auto elapsed = beginPhase(TickMode::ENABLE_REACTIONS)) {
+        findNewReactions();
+        if (equilibriumSolver)
+            runEquilibrium();
+        if (kineticsSolver)
+            runImplicitReactions(*elapsed);
+        else
+            runReactions(*elapsed);
+        endPhase(TickMode::ENABLE_REACTIONS);
+    }
+
+    endTick();
 }
 
 bool Reactor::hasSameState(const Reactor& other, const Amount<>::StorageType epsilon) const
@@ -236,15 +614,13 @@ bool Reactor::hasSameContent(const Reactor& other, const Amount<>::StorageType e
 
 bool Reactor::hasSameLayers(const Reactor& other, const Amount<>::StorageType epsilon) const
 {
-    auto l = LayerType::FIRST;
-    while (l <= LayerType::LAST) {
-        const bool hL = this->hasLayer(l);
-        if (hL != other.hasLayer(l))
-            return false;
+    if (this->filledLayerMask != other.filledLayerMask)
+        return false;
 
-        if (hL && (this->layers.at(l).equals(other.layers.at(l), epsilon)) == false)
+    for (auto mask = filledLayerMask; mask; mask &= mask - 1) {
+        const auto idx = std::countr_zero(mask);
+        if (this->layers[idx]->equals(*other.layers[idx], epsilon) == false)
             return false;
-        ++l;
     }
 
     return true;
@@ -258,3 +634,218 @@ bool Reactor::isSame(const Reactor& other, const Amount<>::StorageType epsilon)
 }
 
 Reactor Reactor::makeCopy() const { return Reactor(*this); }
+
+Reactor::Snapshot Reactor::makeSnapshot()
+{
+    // Copies of a reactor sharing its content share it as well.
+    if (content.isShared())
+        return Snapshot(new Reactor(*this));
+
+    // Otherwise, the content is handed over to the snapshot, bound to it, and shared back.
+    auto reactants = std::exchange(content, ReactantSet(*this));
+    auto snapshot  = std::shared_ptr<Reactor>(new Reactor(*this));
+    reactants.makeShareable(*snapshot);
+    snapshot->content = std::move(reactants);
+    content           = snapshot->content.share(*this, snapshot);
+    return snapshot;
+}
+
+void Reactor::restore(const Reactor& other)
+{
+    if (this != &other)
+        restore(other, other.content.makeCopy(*this));
+}
+
+void Reactor::restore(const Snapshot& snapshot)
+{
+    if (this != snapshot.get())
+        restore(*snapshot, snapshot->content.share(*this, snapshot));
+}
+
+void Reactor::restore(const Reactor& snapshot, ReactantSet&& newContent)
+{
+    MultiLayerMixture::restore(snapshot, std::move(newContent));
+    stirSpeed            = snapshot.stirSpeed;
+    tickMode             = snapshot.tickMode;
+    scheduler            = snapshot.scheduler;
+    cachedReactions      = snapshot.cachedReactions;
+    equilibriumThreshold = snapshot.equilibriumThreshold;
+    quiescenceEpsilon    = snapshot.quiescenceEpsilon;
+    quiescenceTickCount  = snapshot.quiescenceTickCount;
+
+    kineticsSolver.reset();
+    if (snapshot.kineticsSolver)
+        kineticsSolver.emplace(*snapshot.kineticsSolver);
+
+    equilibriumSolver.reset();
+    if (snapshot.equilibriumSolver)
+        equilibriumSolver.emplace(*snapshot.equilibriumSolver);
+
+    // The revision changed, so every phase runs again and the quiescence is checked from scratch.
+    scheduler.invalidate();
+    wake();
+}
+
+void Reactor::toCheckpoint(CheckpointWriter& writer) const
+{
+    writer.write(stirSpeed);
+
+    uint8_t mode = 0;
+    for (const auto phase : tickMode)
+        mode |= underlying_cast(phase);
+    writer.write(mode);
+    for (uint8_t i = 0; i < 8; ++i)
+        writer.write(scheduler.getInterval(static_cast<TickMode>(1 << i)));
+
+    writer.write(kineticsSolver.has_value());
+    if (kineticsSolver) {
+        writer.write(kineticsSolver->getRelativeTolerance());
+        writer.write(kineticsSolver->getAbsoluteTolerance());
+    }
+
+    writer.write(equilibriumSolver.has_value());
+    if (equilibriumSolver) {
+        writer.write(equilibriumThreshold);
+        writer.write(equilibriumSolver->getRelativeTolerance());
+        writer.write(equilibriumSolver->getAbsoluteTolerance());
+    }
+
+    writer.write(quiescenceEpsilon);
+    writer.write(quiescenceTickCount);
+
+    writer.write(static_cast<uint32_t>(cachedReactions->size()));
+    for (const auto& reaction : *cachedReactions) {
+        writer.write(reaction.getData().id);
+
+        writer.write(static_cast<uint8_t>(reaction.getReactants().size()));
+        for (const auto& [_, r] : reaction.getReactants()) {
+            writer.write(r.molecule);
+            writer.write(r.layer);
+            writer.write(r.amount);
+        }
+
+        writer.write(static_cast<uint8_t>(reaction.getProducts().size()));
+        for (const auto& [_, p] : reaction.getProducts())
+            writer.write(p.molecule);
+    }
+
+    MultiLayerMixture::toCheckpoint(writer);
+}
+
+bool Reactor::loadFromCheckpoint(CheckpointReader& reader)
+{
+    const auto newStirSpeed = reader.read<float_s>();
+    const auto newMode      = reader.read<uint8_t>();
+
+    std::array<Amount<Unit::SECOND>, 8> newIntervals;
+    for (auto& interval : newIntervals)
+        interval = reader.read<Amount<Unit::SECOND>>().value_or(0.0);
+
+    std::optional<KineticsSolver> newKineticsSolver;
+    if (reader.read<bool>().value_or(false)) {
+        const auto relativeTolerance = reader.read<float_h>();
+        const auto absoluteTolerance = reader.read<float_h>();
+        if (absoluteTolerance)
+            newKineticsSolver.emplace(*relativeTolerance, *absoluteTolerance);
+    }
+
+    std::optional<EquilibriumSolver> newEquilibriumSolver;
+    std::optional<float_h>           newEquilibriumThreshold = 0.0;
+    if (reader.read<bool>().value_or(false)) {
+        newEquilibriumThreshold      = reader.read<float_h>();
+        const auto relativeTolerance = reader.read<float_h>();
+        const auto absoluteTolerance = reader.read<float_h>();
+        if (absoluteTolerance)
+            newEquilibriumSolver.emplace(*relativeTolerance, *absoluteTolerance);
+    }
+
+    const auto newQuiescenceEpsilon   = reader.read<Amount<>::StorageType>();
+    const auto newQuiescenceTickCount = reader.read<uint32_t>();
+    const auto reactionCount          = reader.read<uint32_t>();
+
+    // Reads fail once the stream fails, so checking the last one is enough.
+    if (not reactionCount) {
+        Log(this).error("Failed to read reactor from checkpoint.");
+        return false;
+    }
+
+    const auto&   reactions      = dataAccessor.get().reactions;
+    ReactionCache newReactions;
+    bool          keepsReactions = reader.hasSameDefinitions();
+    for (uint32_t i = 0; i < *reactionCount; ++i) {
+        const auto id            = reader.read<ReactionId>();
+        const auto reactantCount = reader.read<uint8_t>();
+        if (not reactantCount) {
+            Log(this).error("Failed to read cached reaction from checkpoint.");
+            return false;
+        }
+
+        std::vector<Reactant> reactants;
+        reactants.reserve(*reactantCount);
+        for (uint8_t j = 0; j < *reactantCount; ++j) {
+            const auto molecule = reader.readMolecule();
+            const auto layer    = molecule ? reader.read<LayerType>() : std::nullopt;
+            const auto amount   = layer ? reader.read<Amount<Unit::MOLE>>() : std::nullopt;
+            if (not amount || not isRealLayer(*layer)) {
+                Log(this).error("Failed to read cached reaction reactant from checkpoint.");
+                return false;
+            }
+
+            reactants.emplace_back(*molecule, *layer, *amount, *this);
+        }
+
+        const auto productCount = reader.read<uint8_t>();
+        if (not productCount) {
+            Log(this).error("Failed to read cached reaction from checkpoint.");
+            return false;
+        }
+
+        std::vector<Molecule> products;
+        products.reserve(*productCount);
+        for (uint8_t j = 0; j < *productCount; ++j) {
+            const auto product = reader.readMolecule();
+            if (not product) {
+                Log(this).error("Failed to read cached reaction product from checkpoint.");
+                return false;
+            }
+
+            products.emplace_back(*product);
+        }
+
+        keepsReactions &= reactions.contains(*id);
+        if (keepsReactions)
+            newReactions.emplace(reactions.at(*id), reactants, products);
+    }
+
+    if (not MultiLayerMixture::loadFromCheckpoint(reader))
+        return false;
+
+    stirSpeed = *newStirSpeed;
+    tickMode  = FlagField<TickMode>(static_cast<TickMode>(*newMode));
+    for (uint8_t i = 0; i < newIntervals.size(); ++i)
+        scheduler.setInterval(static_cast<TickMode>(1 << i), newIntervals[i]);
+
+    kineticsSolver.reset();
+    if (newKineticsSolver)
+        kineticsSolver.emplace(std::move(*newKineticsSolver));
+
+    equilibriumSolver.reset();
+    if (newEquilibriumSolver)
+        equilibriumSolver.emplace(std::move(*newEquilibriumSolver));
+    equilibriumThreshold = *newEquilibriumThreshold;
+
+    quiescenceEpsilon   = *newQuiescenceEpsilon;
+    quiescenceTickCount = *newQuiescenceTickCount;
+
+    // Reactions are found again from scratch if they couldn't be restored.
+    cachedReactions = std::make_shared<ReactionCache>();
+    if (keepsReactions)
+        addToReactionCache(newReactions);
+    else
+        for (auto& [_, r] : content)
+            r.isNew = true;
+
+    scheduler.invalidate();
+    wake();
+    return true;
+}
@@ -0,0 +1,320 @@
+#include "molecules/ASCIICache.hpp"
+
+#include "io/Log.hpp"
+#include "utils/Bin.hpp"
+#include "utils/Hash.hpp"
+#include "utils/Memory.hpp"
+#include "utils/Path.hpp"
+
+#include <fstream>
+#include <mutex>
+
+namespace
+{
+
+constexpr std::string_view Magic = "CHGASCII";
+
+// Bounds for the sizes read from the file, which may be corrupt.
+constexpr uint32_t MaxSMILESSize = 1 << 16;
+constexpr uint32_t MaxBlockSize  = 1 << 20;
+
+void writeString(std::ostream& os, const std::string& str)
+{
+    bin::print(os, static_cast<uint32_t>(str.size()));
+    os.write(str.data(), str.size());
+}
+
+std::optional<std::string> readString(std::istream& is, const uint32_t maxSize)
+{
+    const auto size = bin::parse<uint32_t>(is);
+    if (not size || *size > maxSize)
+        return std::nullopt;
+
+    return bin::parseChars(is, *size);
+}
+
+void writeColoredString(std::ostream& os, const ColoredString& str)
+{
+    // Chars and colors are written separately, the chars remaining readable in the raw file.
+    bin::print(os, static_cast<uint32_t>(str.size()));
+    for (const auto c : str)
+        bin::print(os, c.chr);
+    for (const auto c : str)
+        bin::print(os, c.color);
+}
+
+std::optional<ColoredString> readColoredString(std::istream& is)
+{
+    const auto chars = readString(is, MaxBlockSize);
+    if (not chars)
+        return std::nullopt;
+
+    std::vector<ColoredChar> result;
+    result.reserve(chars->size());
+    for (const auto chr : *chars) {
+        const auto color = bin::parse<OS::BasicColor>(is);
+        if (not color)
+            return std::nullopt;
+        result.emplace_back(chr, *color);
+    }
+
+    return ColoredString(result.begin(), result.end());
+}
+
+}  // namespace
+
+//
+// ASCIICache
+//
+
+ASCIICache::Node::Node(const ASCII::PrintOptions options, ColoredTextBlock&& block, const Node* next) noexcept :
+    options(options),
+    block(std::move(block)),
+    next(next)
+{}
+
+ASCIICache::ASCIICache(const ASCIICache&) noexcept {}
+
+ASCIICache::ASCIICache(ASCIICache&& other) noexcept :
+    head(other.head.exchange(nullptr))
+{}
+
+ASCIICache::~ASCIICache() noexcept { clear(); }
+
+ASCIICache& ASCIICache::operator=(ASCIICache&& other) noexcept
+{
+    if (this != &other) {
+        clear();
+        head = other.head.exchange(nullptr);
+    }
+    return *this;
+}
+
+const ColoredTextBlock* ASCIICache::find(const Node* begin, const Node* end, const ASCII::PrintOptions options)
+{
+    for (auto node = begin; node != end; node = node->next)
+        if (node->options == options)
+            return &node->block;
+
+    return nullptr;
+}
+
+const ColoredTextBlock* ASCIICache::get(const ASCII::PrintOptions options) const
+{
+    return find(head.load(std::memory_order_acquire), nullptr, options);
+}
+
+const ColoredTextBlock& ASCIICache::set(const ASCII::PrintOptions options, ColoredTextBlock&& block)
+{
+    auto node     = std::make_unique<Node>(options, std::move(block), head.load(std::memory_order_acquire));
+    auto expected = node->next;
+    while (not head.compare_exchange_weak(expected, node.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+        // Only the nodes published since the last attempt need to be checked.
+        if (const auto existing = find(expected, node->next, options))
+            return *existing;
+        node->next = expected;
+    }
+
+    return node.release()->block;
+}
+
+void ASCIICache::clear()
+{
+    auto node = head.exchange(nullptr);
+    while (node != nullptr)
+        delete std::exchange(node, node->next);
+}
+
+size_t ASCIICache::getHeapUsage() const
+{
+    size_t usage = 0;
+    for (auto node = head.load(std::memory_order_acquire); node != nullptr; node = node->next) {
+        const auto size = node->block.getTrimmedDimensions();
+        usage += sizeof(Node) + size.x * size.y * sizeof(ColoredChar);
+    }
+    return usage;
+}
+
+//
+// ASCIILayoutStore
+//
+
+bool ASCIILayoutStore::Key::operator==(const Key& other) const
+{
+    return this->options == other.options && this->smiles == other.smiles;
+}
+
+size_t ASCIILayoutStore::KeyHash::operator()(const Key& key) const
+{
+    return utils::hashCombine(key.smiles, key.options);
+}
+
+ASCIILayoutStore::ASCIILayoutStore(const size_t maxSize) noexcept :
+    maxSize(maxSize)
+{}
+
+ASCIILayoutStore::ASCIILayoutStore(ASCIILayoutStore&& other) noexcept :
+    maxSize(other.maxSize),
+    path(std::move(other.path)),
+    entries(std::move(other.entries)),
+    modified(other.modified)
+{}
+
+ColoredTextBlock ASCIILayoutStore::render(const MolecularStructure& structure, const ASCII::PrintOptions options) const
+{
+    if (options.has(ASCII::PrintFlags::PRINT_ATOM_INDICES))
+        return structure.toASCII(options);
+
+    Key key{structure.toSMILES(), options.toUnderlying()};
+    {
+        std::shared_lock lock(mutex);
+        if (const auto it = entries.find(key); it != entries.end())
+            return ColoredTextBlock(it->second);
+    }
+
+    // Rendering is done without holding the lock, concurrent renderings of the same entry are identical.
+    auto block = structure.toASCII(options);
+    if (path.empty())
+        return block;
+
+    std::unique_lock lock(mutex);
+    if (entries.size() < maxSize && entries.try_emplace(std::move(key), block.toString()).second)
+        modified = true;
+    return block;
+}
+
+size_t ASCIILayoutStore::size() const
+{
+    std::shared_lock lock(mutex);
+    return entries.size();
+}
+
+bool ASCIILayoutStore::isOpen() const { return path.size(); }
+
+bool ASCIILayoutStore::isModified() const
+{
+    std::shared_lock lock(mutex);
+    return modified;
+}
+
+bool ASCIILayoutStore::load(std::istream& is)
+{
+    std::string magic(Magic.size(), '\0');
+    is.read(magic.data(), magic.size());
+    if (not is || magic != Magic) {
+        Log(this).error("Invalid layout store header.");
+        return false;
+    }
+
+    const auto version = bin::parse<uint16_t>(is);
+    if (not version || *version != Version) {
+        Log(this).warn("Unsupported layout store version: {} (expected: {}).", version ? *version : 0, Version);
+        return false;
+    }
+
+    const auto count = bin::parse<uint32_t>(is);
+    if (not count) {
+        Log(this).error("Invalid layout store header.");
+        return false;
+    }
+
+    std::unique_lock lock(mutex);
+    for (uint32_t i = 0; i < *count && entries.size() < maxSize; ++i) {
+        const auto options = bin::parse<uint8_t>(is);
+        auto       smiles  = options ? readString(is, MaxSMILESSize) : std::nullopt;
+        auto       block   = smiles ? readColoredString(is) : std::nullopt;
+        if (not block) {
+            Log(this).error("Invalid or truncated layout store entry: {}.", i);
+            return false;
+        }
+
+        entries.try_emplace(Key{std::move(*smiles), *options}, std::move(*block));
+    }
+
+    return true;
+}
+
+bool ASCIILayoutStore::loadFile(const std::string& path)
+{
+    const auto    normPath = utils::normalizePath(path);
+    std::ifstream is(normPath, std::ios::binary);
+    if (not is) {
+        Log(this).error("Failed to open file: '{}' for reading.", normPath);
+        return false;
+    }
+
+    return load(is);
+}
+
+bool ASCIILayoutStore::open(const std::string& path)
+{
+    this->path = utils::normalizePath(path);
+    if (not utils::fileExists(this->path))
+        return true;
+
+    if (not loadFile(this->path)) {
+        Log(this).warn("Discarded layout store: '{}'.", this->path);
+        clear();
+        return false;
+    }
+
+    Log(this).info("Loaded {} layouts from: '{}'.", size(), this->path);
+    return true;
+}
+
+bool ASCIILayoutStore::flush() const
+{
+    if (path.empty() || not isModified())
+        return true;
+
+    return saveFile(path);
+}
+
+bool ASCIILayoutStore::save(std::ostream& os) const
+{
+    std::unique_lock lock(mutex);
+    os.write(Magic.data(), Magic.size());
+    bin::print(os, Version);
+    bin::print(os, static_cast<uint32_t>(entries.size()));
+    for (const auto& [key, block] : entries) {
+        bin::print(os, key.options);
+        writeString(os, key.smiles);
+        writeColoredString(os, block);
+    }
+
+    if (not os) {
+        Log(this).error("Failed to write layout store.");
+        return false;
+    }
+
+    modified = false;
+    return true;
+}
+
+bool ASCIILayoutStore::saveFile(const std::string& path) const
+{
+    const auto    normPath = utils::normalizePath(path);
+    std::ofstream os(normPath, std::ios::binary);
+    if (not os) {
+        Log(this).error("Failed to open file: '{}' for writing.", normPath);
+        return false;
+    }
+
+    return save(os);
+}
+
+void ASCIILayoutStore::clear()
+{
+    std::unique_lock lock(mutex);
+    entries.clear();
+    modified = false;
+}
+
+size_t ASCIILayoutStore::getMemoryUsage() const
+{
+    std::shared_lock lock(mutex);
+    auto             usage = sizeof(*this) + utils::getHeapUsage(entries);
+    for (const auto& [key, block] : entries)
+        usage += utils::getHeapUsage(key.smiles) + block.size() * sizeof(ColoredChar);
+    return usage;
+}
@@ -95,6 +95,10 @@ Cycle::Cycle(std::vector<const BondedAtomBase*>&& cycle) noexcept :
     cycle(std::move(cycle))
 {}
 
+Cycle::Cycle(const std::vector<const BondedAtomBase*>& cycle) noexcept :
+    cycle(cycle)
+{}
+
 const std::vector<const BondedAtomBase*>& Cycle::getCycle() const { return cycle; }
 
 const BondedAtomBase& Cycle::getAtom(const c_size idx) const { return *cycle[idx]; }
@@ -340,8 +344,10 @@ StructurePrinter::StructurePrinter(
     std::vector<Node>&&                                nodes,
     std::vector<Cycle>&&                               cycles,
     std::unordered_map<UndirectedEdge<c_size>, Edge>&& edges,
-    const PrintOptions                                 options) noexcept :
+    const PrintOptions                                 options,
+    const LayoutBudget&                                budget) noexcept :
     options(options),
+    budget(budget),
     nodes(std::move(nodes)),
     cycles(std::move(cycles)),
     edges(std::move(edges))
@@ -414,6 +420,8 @@ StructurePrinter::getPossibleNextDirections(const PositionLine origin)
 
 void StructurePrinter::print()
 {
+    startTime = std::chrono::steady_clock::now();
+
     if (cycles.empty()) {
         // Non-cyclic:
         nodes.front().position = Position(0, 0);
@@ -443,6 +451,9 @@ void StructurePrinter::reset()
     expandedCycleCount = 0;
     errorCount         = 0;
 
+    layoutNodeCount         = 0;
+    isLayoutBudgetExhausted = false;
+
     for (auto& c : cycles)
         c.unvisit();
     for (auto& [_, e] : edges)
@@ -619,13 +630,24 @@ std::tuple<Position, PositionLine, ASCII::Direction> StructurePrinter::getFreeCy
     return utils::npos<std::tuple<Position, PositionLine, ASCII::Direction>>;
 }
 
+bool StructurePrinter::checkLayoutBudget()
+{
+    ++layoutNodeCount;
+    // Reading the clock is expensive compared to a node, so it's only done once in a while.
+    if (layoutNodeCount > budget.nodeCount ||
+        ((layoutNodeCount & 0xFF) == 0 && std::chrono::steady_clock::now() - startTime > budget.time))
+        isLayoutBudgetExhausted = true;
+
+    return not isLayoutBudgetExhausted;
+}
+
 std::vector<PositionLine> StructurePrinter::generateOptimalCycleLayout(
     const std::vector<const BondedAtomBase*>& cycle,
     const c_size                              firstCycleIdx,
     const c_size                              secondCycleIdx,
     const c_size                              lastCycleIdx,
     const bool                                noConstraints,
-    const Direction                           enteringDirection) const
+    const Direction                           enteringDirection)
 {
     const auto directions = utils::isNPos(enteringDirection) ? Direction::AllDirectionsVector
                                                              : getDirectionsByEnteringDirection(enteringDirection);
@@ -661,6 +683,22 @@ std::vector<PositionLine> StructurePrinter::generateOptimalCycleLayout(
         uint8_t(0), static_cast<uint8_t>(directions.size()), 1.0f, 0.9f);
 
     std::priority_queue<CyclePrintState> stack;
+
+    // The best complete layout added to the stack, used if the budget is exhausted before a complete layout is
+    // popped.
+    std::vector<PositionLine> bestLayout;
+    float                     bestLayoutScore = 0.0f;
+
+    const auto addCompleteLayout = [&](const float scoreSum, std::vector<PositionLine>&& positions) {
+        const auto score = scoreSum / positions.size();
+        if (bestLayout.empty() || score > bestLayoutScore) {
+            bestLayout      = positions;
+            bestLayoutScore = score;
+        }
+
+        stack.emplace(scoreSum, std::move(positions));
+    };
+
     if (totalAtomsToPrint == 2 && not noConstraints) {
         // Treat the case when only one atom (N) is missing from the cycle layout. This can only
         // occur in polycycles:
@@ -716,7 +754,7 @@ std::vector<PositionLine> StructurePrinter::generateOptimalCycleLayout(
                 3.0f;
 
             // Add the complete layout to the stack ensuring all results remain sorted by score.
-            stack.emplace(score, std::vector<PositionLine>{newNodePos});
+            addCompleteLayout(score, std::vector<PositionLine>{newNodePos});
 
             if (foundDirs == 3)
                 break;
@@ -748,6 +786,15 @@ std::vector<PositionLine> StructurePrinter::generateOptimalCycleLayout(
     }
 
     while (stack.size()) {
+        if (not checkLayoutBudget()) {
+            Log(this).trace(
+                "Cycle layout budget exhausted, using the best layout found of size {} (score: {}, stack size: {}).",
+                bestLayout.size(),
+                bestLayoutScore,
+                stack.size());
+            return bestLayout;
+        }
+
         // Trick to move the top element, it will be popped right after so it's safe.
         auto current = std::move(const_cast<CyclePrintState&>(stack.top()));
         stack.pop();
@@ -840,7 +887,7 @@ std::vector<PositionLine> StructurePrinter::generateOptimalCycleLayout(
                               (newPositions.size() + 2);
 
                 // Add the complete layout to the stack ensuring all results remain sorted by score.
-                stack.emplace(newScoreSum, std::move(newPositions));
+                addCompleteLayout(newScoreSum, std::move(newPositions));
 
                 if (foundDirs == 3)
                     break;
@@ -1483,7 +1530,7 @@ void StructurePrinter::printNeighbors(const Node& node, const Direction prevDire
             printError(node.position, "Insufficient space for atom: '" + other.getAtom().getSymbol().str() + "'.");
     }
 
-    static const auto& carbon = Predefined::get().Carbon;
+    const auto carbon = Predefined::get().Carbon;
     if (not options.has(PrintFlags::PRINT_ATOM_INDICES) &&
         ((options.has(PrintFlags::PRINT_IMPLIED_CARBON_HYDROGENS) && atom.getAtom().equals(carbon)) ||
          (options.has(PrintFlags::PRINT_IMPLIED_NON_CARBON_HYDROGENS) && atom.getAtom().equals(carbon))))
@@ -1560,6 +1607,10 @@ void StructurePrinter::printCycle(const c_size startCycleIdx, Cycle& cycle, cons
     if (positions.empty() && totalAtomsToPrint <= 18)
         positions = generateOptimalCycleLayout(
             cycle.getCycle(), firstCycleIdx, secondCycleIdx, lastCycleIdx, noConstraints, enteringDirection);
+    // Once the budget is exhausted, unconstrained cycles fall back to the one-shot layout, which is defined for
+    // cycles with at least 7 atoms.
+    if (positions.empty() && isLayoutBudgetExhausted && noConstraints && cycle.size() >= 7 && cycle.size() <= 12)
+        positions = generateOneShotCycleLayout(cycle.getCycle(), firstCycleIdx, secondCycleIdx, enteringDirection);
     if (positions.empty()) {
         Log(this).trace("Failed to print ASCII cycle, reverting to linear printing.");
         expandCycleLinearly(cycle, noConstraints ? startAtom : firstAtom, secondCycleIdx, lastCycleIdx);
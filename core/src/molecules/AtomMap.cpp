@@ -0,0 +1,104 @@
+#include "molecules/AtomMap.hpp"
+
+#include "io/Log.hpp"
+#include "utils/Build.hpp"
+#include "utils/Memory.hpp"
+
+#include <algorithm>
+
+//
+// AtomMapIterator
+//
+
+AtomMapIterator::AtomMapIterator(const AtomMap& map, const c_size key) noexcept :
+    map(&map),
+    key(key)
+{
+    findNext();
+}
+
+void AtomMapIterator::findNext()
+{
+    while (key < map->values.size() && map->values[key] == AtomMap::npos)
+        ++key;
+}
+
+std::pair<c_size, c_size> AtomMapIterator::operator*() const { return {key, map->values[key]}; }
+
+AtomMapIterator& AtomMapIterator::operator++()
+{
+    ++key;
+    findNext();
+    return *this;
+}
+
+bool AtomMapIterator::operator==(const AtomMapIterator& other) const
+{
+    return this->map == other.map && this->key == other.key;
+}
+
+bool AtomMapIterator::operator!=(const AtomMapIterator& other) const { return not(*this == other); }
+
+//
+// AtomMap
+//
+
+AtomMap::AtomMap(std::initializer_list<std::pair<c_size, c_size>> entries) noexcept
+{
+    for (const auto& [key, value] : entries)
+        emplace(key, value);
+}
+
+void AtomMap::reserve(const c_size keyCount)
+{
+    if (keyCount > values.size())
+        values.resize(keyCount, npos);
+}
+
+c_size AtomMap::at(const c_size key) const
+{
+    if (const auto value = find(key); value != npos)
+        return value;
+
+    Log(this).fatal("Tried to access an unmapped atom index: {}.", key);
+    CHG_UNREACHABLE();
+}
+
+void AtomMap::clear()
+{
+    std::ranges::fill(values, npos);
+    count = 0;
+}
+
+AtomMap AtomMap::reversed() const
+{
+    c_size keyCount = 0;
+    for (const auto& [_, value] : *this)
+        keyCount = std::max(keyCount, static_cast<c_size>(value + 1));
+
+    AtomMap result;
+    result.reserve(keyCount);
+    for (const auto& [key, value] : *this)
+        result.emplace(value, key);
+    return result;
+}
+
+bool AtomMap::operator==(const AtomMap& other) const
+{
+    if (this->count != other.count)
+        return false;
+
+    // Trailing unmapped keys don't matter.
+    for (const auto& [key, value] : *this)
+        if (other.find(key) != value)
+            return false;
+    return true;
+}
+
+bool AtomMap::operator!=(const AtomMap& other) const { return not(*this == other); }
+
+size_t AtomMap::getHeapUsage() const { return utils::getHeapUsage(values); }
+
+AtomMap::Iterator AtomMap::begin() const { return Iterator(*this, 0); }
+
+AtomMap::Iterator AtomMap::end() const { return Iterator(*this, static_cast<c_size>(values.size())); }
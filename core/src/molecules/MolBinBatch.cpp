@@ -0,0 +1,239 @@
+#include "molecules/MolBinBatch.hpp"
+
+#include "data/DataStore.hpp"
+#include "io/Log.hpp"
+#include "utils/Bin.hpp"
+
+#include <bit>
+#include <cstring>
+
+static_assert(
+    std::endian::native == std::endian::little, "MolBin batches are only supported on little-endian targets.");
+
+namespace
+{
+
+template <typename T>
+void writeArray(std::ostream& os, const std::vector<T>& array)
+{
+    os.write(reinterpret_cast<const char*>(array.data()), static_cast<std::streamsize>(array.size() * sizeof(T)));
+}
+
+}  // namespace
+
+//
+// MolBinBatchWriter
+//
+
+MolBinBatchWriter::MolBinBatchWriter(std::ostream& os) noexcept :
+    os(os),
+    start(os.tellp())
+{
+    // The header is completed by finish(), once the tables are written.
+    const MolBin::Header header{};
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+bool MolBinBatchWriter::isValid() const { return start != std::streampos(-1) && os; }
+
+size_t MolBinBatchWriter::size() const { return entries.size(); }
+
+uint16_t MolBinBatchWriter::getSymbolIdx(const Symbol& symbol)
+{
+    const auto id = symbol.getId();
+    if (id >= symbolIndices.size())
+        symbolIndices.resize(id + 1, npos);
+
+    if (symbolIndices[id] == npos) {
+        symbolIndices[id] = static_cast<uint16_t>(symbols.size());
+        symbols.emplace_back(symbol);
+    }
+    return symbolIndices[id];
+}
+
+bool MolBinBatchWriter::add(const MolecularStructure& structure)
+{
+    if (finished) {
+        Log(this).error("Cannot add structures to a finished MolBin batch.");
+        return false;
+    }
+    if (structure.isEmpty()) {
+        Log(this).error("Cannot add an empty structure to a MolBin batch.");
+        return false;
+    }
+
+    atomBuffer.clear();
+    bondBuffer.clear();
+
+    // The virtual hydrogen has no atoms.
+    const auto atomCount = structure.getNonImpliedAtomCount();
+    for (c_size i = 0; i < atomCount; ++i) {
+        const auto& atom = structure.getBondedAtom(i);
+        atomBuffer.push_back({getSymbolIdx(atom.getAtom().getSymbol()), static_cast<c_size>(atom.bonds.size())});
+        for (const auto& bond : atom.bonds)
+            bondBuffer.push_back({bond.getOther().index, bond.getType(), 0});
+    }
+
+    writeArray(os, atomBuffer);
+    writeArray(os, bondBuffer);
+    if (not os) {
+        Log(this).error("Failed to write MolBin batch structure: {}.", entries.size());
+        return false;
+    }
+
+    entries.push_back({offset, static_cast<uint32_t>(atomBuffer.size()), static_cast<uint32_t>(bondBuffer.size())});
+    offset += atomBuffer.size() * sizeof(MolBin::Atom) + bondBuffer.size() * sizeof(MolBin::Bond);
+    return true;
+}
+
+bool MolBinBatchWriter::finish()
+{
+    if (finished) {
+        Log(this).error("MolBin batch was already finished.");
+        return false;
+    }
+    finished = true;
+
+    MolBin::Header header{};
+    MolBin::Magic.copy(header.magic, sizeof(header.magic));
+    header.version       = MolBin::Version;
+    header.symbolCount   = static_cast<uint32_t>(symbols.size());
+    header.moleculeCount = entries.size();
+
+    constexpr char padding[alignof(MolBin::MoleculeEntry)] = {};
+    const auto     paddingSize = (sizeof(padding) - offset % sizeof(padding)) % sizeof(padding);
+    os.write(padding, paddingSize);
+    header.moleculeTableOffset = offset + paddingSize;
+
+    writeArray(os, entries);
+    header.symbolTableOffset = header.moleculeTableOffset + entries.size() * sizeof(MolBin::MoleculeEntry);
+
+    for (const auto& symbol : symbols) {
+        bin::print(os, symbol.size());
+        os.write(symbol.str().data(), symbol.size());
+    }
+
+    const auto end = os.tellp();
+    os.seekp(start);
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.seekp(end);
+
+    if (not os) {
+        Log(this).error("Failed to write MolBin batch tables.");
+        return false;
+    }
+    return true;
+}
+
+//
+// MolBinBatch
+//
+
+bool MolBinBatch::load(const std::span<const char> bytes)
+{
+    if (reinterpret_cast<uintptr_t>(bytes.data()) % alignof(MolBin::MoleculeEntry) != 0) {
+        Log(this).error("MolBin batch buffer isn't aligned to: {} bytes.", alignof(MolBin::MoleculeEntry));
+        return false;
+    }
+
+    MolBin::Header header;
+    if (bytes.size() < sizeof(header)) {
+        Log(this).error("Invalid MolBin batch header.");
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    if (std::string_view(header.magic, sizeof(header.magic)) != MolBin::Magic) {
+        Log(this).error("Invalid MolBin batch header.");
+        return false;
+    }
+    if (header.version != MolBin::Version) {
+        Log(this).warn("Unsupported MolBin batch version: {} (expected: {}).", header.version, MolBin::Version);
+        return false;
+    }
+
+    const auto tableOffset = header.moleculeTableOffset;
+    if (tableOffset % alignof(MolBin::MoleculeEntry) != 0 || tableOffset > bytes.size() ||
+        header.moleculeCount > (bytes.size() - tableOffset) / sizeof(MolBin::MoleculeEntry)) {
+        Log(this).error("Invalid MolBin batch molecule table (offset: {}).", tableOffset);
+        return false;
+    }
+
+    entries = std::span(
+        reinterpret_cast<const MolBin::MoleculeEntry*>(bytes.data() + tableOffset),
+        static_cast<size_t>(header.moleculeCount));
+
+    // Only the table is checked, the packed arrays of the structures are validated when the structures are built.
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const auto& entry = entries[i];
+        const auto  size  = (uint64_t(entry.atomCount) + entry.bondCount) * sizeof(MolBin::Atom);
+        if (entry.offset < sizeof(header) || entry.offset % sizeof(MolBin::Atom) != 0 || entry.offset > tableOffset ||
+            size > tableOffset - entry.offset) {
+            Log(this).error("Invalid MolBin batch entry: {} (offset: {}).", i, entry.offset);
+            return false;
+        }
+    }
+
+    const auto& atomRepository = Accessor<>::getDataStore().atoms;
+
+    auto pos = header.symbolTableOffset;
+    symbolTable.reserve(header.symbolCount);
+    for (uint32_t i = 0; i < header.symbolCount; ++i) {
+        const auto symbolSize = pos < bytes.size() ? static_cast<size_t>(static_cast<uint8_t>(bytes[pos])) : 0;
+        if (pos >= bytes.size() || symbolSize > bytes.size() - pos - 1) {
+            Log(this).error("Truncated MolBin batch symbol table entry: {}.", i);
+            return false;
+        }
+
+        const std::string_view symbol(bytes.data() + pos + 1, symbolSize);
+        const auto             data = atomRepository.findSymbol(symbol);
+        if (data == nullptr)
+            Log(this).warn("MolBin batch atomic symbol: '{}' is undefined.", symbol);
+
+        symbolTable.emplace_back(data);
+        pos += 1 + symbolSize;
+    }
+
+    this->bytes = bytes;
+    return true;
+}
+
+size_t MolBinBatch::size() const { return entries.size(); }
+
+std::span<const MolBin::Atom> MolBinBatch::getAtoms(const size_t idx) const
+{
+    const auto& entry = entries[idx];
+    return std::span(reinterpret_cast<const MolBin::Atom*>(bytes.data() + entry.offset), entry.atomCount);
+}
+
+std::span<const MolBin::Bond> MolBinBatch::getBonds(const size_t idx) const
+{
+    const auto& entry = entries[idx];
+    return std::span(
+        reinterpret_cast<const MolBin::Bond*>(bytes.data() + entry.offset + entry.atomCount * sizeof(MolBin::Atom)),
+        entry.bondCount);
+}
+
+std::span<const AtomBaseData* const> MolBinBatch::getSymbolTable() const { return symbolTable; }
+
+std::optional<MolecularStructure> MolBinBatch::getStructure(const size_t idx) const
+{
+    return MolecularStructure::fromMolBin(getAtoms(idx), getBonds(idx), symbolTable);
+}
+
+std::optional<MolBinBatch> MolBinBatch::fromBytes(const std::span<const char> bytes)
+{
+    MolBinBatch batch;
+    return batch.load(bytes) ? std::optional(std::move(batch)) : std::nullopt;
+}
+
+std::optional<MolBinBatch> MolBinBatch::loadFile(const std::string& path)
+{
+    auto file = MappedFile::open(path);
+    if (not file)
+        return std::nullopt;
+
+    MolBinBatch batch;
+    batch.file = std::move(file);
+    return batch.load(batch.file->getBytes()) ? std::optional(std::move(batch)) : std::nullopt;
+}
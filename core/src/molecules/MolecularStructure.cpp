@@ -1,15 +1,19 @@
 #include "molecules/MolecularStructure.hpp"
 
+#include "data/DataStore.hpp"
 #include "data/Predefined.hpp"
 #include "data/def/Parsers.hpp"
 #include "io/Log.hpp"
 #include "io/StringTable.hpp"
 #include "utils/ASCII.hpp"
 #include "utils/Bin.hpp"
+#include "utils/Hash.hpp"
+#include "utils/Memory.hpp"
 #include "utils/Path.hpp"
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <bitset>
 #include <boost/dynamic_bitset.hpp>
 #include <fstream>
@@ -36,6 +40,7 @@ MolecularStructure MolecularStructure::createCopy() const { return MolecularStru
 
 void MolecularStructure::clear()
 {
+    ringInfo.reset();
     atoms.clear();
     molarMass            = 0.0f;
     impliedHydrogenCount = 0;
@@ -65,6 +70,7 @@ MolecularStructure::addAtom(std::unique_ptr<BondedAtomBase>&& atom, BondedAtomBa
     if (atom->getAtom().equals(Predefined::get().Hydrogen) && bondType == BondType::SINGLE)
         return prev;
 
+    ringInfo.reset();
     auto& inserted = *atoms.emplace_back(std::move(atom));
     if (prev)
         addBond(inserted, *prev, bondType);
@@ -74,6 +80,7 @@ MolecularStructure::addAtom(std::unique_ptr<BondedAtomBase>&& atom, BondedAtomBa
 
 void MolecularStructure::removeAtom(const c_size idx)
 {
+    ringInfo.reset();
     auto& atom = *atoms[idx];
 
     // Remove all bonds leading to the removed atom
@@ -85,6 +92,7 @@ void MolecularStructure::removeAtom(const c_size idx)
 
 void MolecularStructure::canonicalize()
 {
+    ringInfo.reset();
     if (atoms.size() == 0)
         return;
 
@@ -193,46 +201,89 @@ bool MolecularStructure::isFullyConnected() const
 // SMILES
 //
 
-std::optional<MolecularStructure> MolecularStructure::fromSMILES(const std::string& smiles)
+std::optional<MolecularStructure> MolecularStructure::fromSMILES(const std::string_view smiles)
 {
     MolecularStructure temp;
     return temp.loadFromSMILES(smiles) ? std::optional(std::move(temp)) : std::nullopt;
 }
 
-bool MolecularStructure::loadFromSMILES(const std::string& smiles)
+bool MolecularStructure::loadFromSMILES(const std::string_view smiles)
 {
     clear();
 
+    const auto& atomRepository = Accessor<>::getDataStore().atoms;
+    const auto* hydrogen       = atomRepository.findSymbol("H");
+
     if (smiles == "HH")  // The only purely virtual molecule
     {
-        if (not AtomBase::isDefined("H"))
+        if (not hydrogen)
             return false;
 
-        molarMass            = Predefined::get().Hydrogen.getData().weight * 2;
+        molarMass            = hydrogen->weight * 2;
         impliedHydrogenCount = 2;
         return true;
     }
 
-    std::unordered_map<uint8_t, c_size> rings;
-    std::stack<c_size>                  branches;
+    // Every atom starts with a letter or a bracket, so this is an upper bound of the atom count.
+    atoms.reserve(std::ranges::count_if(smiles, [](const char c) { return isalpha(c) || c == '['; }));
+
+    // Ring labels are at most two digits long, so open rings are directly indexed by their label.
+    std::array<c_size, 100> rings;
+    rings.fill(npos);
+    std::stack<c_size, std::vector<c_size>> branches;
 
     BondedAtomBase* prev     = nullptr;  // TODO: Could unroll the first loop so that is always prev != nullptr
     BondType        bondType = BondType::SINGLE;
+
+    const auto addParsedAtom = [&](const AtomBaseData& data) {
+        // Implied atoms are ignored before being allocated.
+        if (&data != hydrogen || bondType != BondType::SINGLE) {
+            auto& inserted = *atoms.emplace_back(BondedAtomBase::create(data, static_cast<c_size>(atoms.size()), {}));
+            if (prev)
+                addBond(inserted, *prev, bondType);
+            prev = &inserted;
+        }
+
+        bondType = BondType::SINGLE;
+    };
+
+    const auto closeRing = [&](const uint8_t label, const size_t i) {
+        if (rings[label] == npos) {
+            // New label.
+            rings[label] = static_cast<c_size>(atoms.size() - 1);
+            return true;
+        }
+
+        if (not addBondChecked(*prev, *atoms[rings[label]], bondType)) {
+            Log(this).error(
+                "Cycle closure with label '{}' redefines an existing bond between two atoms in "
+                "SMILES:\n{}\n{}^",
+                label,
+                smiles,
+                std::string(i, ' '));
+            return false;
+        }
+
+        // Some SMILES generators prefer to reuse labels instead of using double digit labels.
+        rings[label] = npos;
+
+        bondType = BondType::SINGLE;
+        return true;
+    };
+
     for (size_t i = 0; i < smiles.size(); ++i) {
         // Basic atom
         if (isalpha(smiles[i])) {
             if (i < smiles.size() - 1) {
-                if (auto atom = BondedAtomBase::create(smiles.substr(i, 2), static_cast<c_size>(atoms.size()), {})) {
-                    prev     = addAtom(std::move(atom), prev, bondType);
-                    bondType = BondType::SINGLE;
+                if (const auto data = atomRepository.findSymbol(smiles.substr(i, 2))) {
+                    addParsedAtom(*data);
                     ++i;
                     continue;
                 }
             }
 
-            if (auto atom = BondedAtomBase::create(smiles[i], static_cast<c_size>(atoms.size()), {})) {
-                prev     = addAtom(std::move(atom), prev, bondType);
-                bondType = BondType::SINGLE;
+            if (const auto data = atomRepository.findSymbol(smiles.substr(i, 1))) {
+                addParsedAtom(*data);
                 continue;
             }
 
@@ -276,23 +327,22 @@ bool MolecularStructure::loadFromSMILES(const std::string& smiles)
         // Special atom
         if (smiles[i] == '[') {
             const auto t = smiles.find(']', i + 1);
-            if (t == std::string::npos) {
+            if (t == std::string_view::npos) {
                 Log(this).error("Unpaired '[' token in SMILES:\n{}\n{}^", smiles, std::string(i, ' '));
                 clear();
                 return false;
             }
 
             const auto symbol = smiles.substr(i + 1, t - i - 1);
-            auto       atom   = BondedAtomBase::create(symbol, static_cast<c_size>(atoms.size()), {});
-            if (atom == nullptr) {
+            const auto data   = atomRepository.findSymbol(symbol);
+            if (data == nullptr) {
                 Log(this).error(
                     "Undefined atomic symbol '{}' in SMILES:\n{}\n{}^", symbol, smiles, std::string(i, ' '));
                 clear();
                 return false;
             }
 
-            prev     = addAtom(std::move(atom), prev, bondType);
-            bondType = BondType::SINGLE;
+            addParsedAtom(*data);
 
             i = t;
             continue;
@@ -317,38 +367,11 @@ bool MolecularStructure::loadFromSMILES(const std::string& smiles)
             const uint8_t label  = (smiles[i + 1] - '0') * 10 + smiles[i + 2] - '0';
             i                   += 2;
 
-            const auto ringIt = rings.find(label);
-            if (ringIt == rings.end()) {
-                // New label.
-                rings.emplace(label, static_cast<c_size>(atoms.size() - 1));
-                continue;
-            }
-
-            if (prev == nullptr) {
-                Log(this).error(
-                    "Illegal ring-closing bond with label: '{}' in SMILES:\n{}\n{}^",
-                    label,
-                    smiles,
-                    std::string(i, ' '));
+            if (not closeRing(label, i)) {
                 clear();
                 return false;
             }
 
-            if (not addBondChecked(*prev, *atoms[rings[label]], bondType)) {
-                Log(this).error(
-                    "Cycle closure with label '{}' redefines an existing bond between two atoms in "
-                    "SMILES:\n{}\n{}^",
-                    label,
-                    smiles,
-                    std::string(i, ' '));
-                clear();
-                return false;
-            }
-
-            // Some SMILES generators prefer to reuse labels instead of using double digit labels.
-            rings.erase(ringIt);
-
-            bondType = BondType::SINGLE;
             continue;
         }
 
@@ -360,30 +383,11 @@ bool MolecularStructure::loadFromSMILES(const std::string& smiles)
                 return false;
             }
 
-            const uint8_t label = smiles[i] - '0';
-
-            const auto ringIt = rings.find(label);
-            if (ringIt == rings.end()) {
-                // New label.
-                rings.emplace(label, static_cast<c_size>(atoms.size() - 1));
-                continue;
-            }
-
-            if (not addBondChecked(*prev, *atoms[rings[label]], bondType)) {
-                Log(this).error(
-                    "Cycle closure with label '{}' redefines an existing bond between two atoms in "
-                    "SMILES:\n{}\n{}^",
-                    label,
-                    smiles,
-                    std::string(i, ' '));
+            if (not closeRing(smiles[i] - '0', i)) {
                 clear();
                 return false;
             }
 
-            // Some SMILES generators prefer to reuse labels instead of using double digit labels.
-            rings.erase(ringIt);
-
-            bondType = BondType::SINGLE;
             continue;
         }
 
@@ -701,6 +705,9 @@ c_size MolecularStructure::getRadicalAtomsCount() const
 
 c_size MolecularStructure::getCycleCount() const
 {
+    if (const auto info = ringInfo.get())
+        return info->getRingCount();
+
     return static_cast<c_size>(static_cast<int32_t>(getBondCount()) - atoms.size() + 1);
 }
 
@@ -730,25 +737,26 @@ bool MolecularStructure::isOrganic() const
     return std::any_of(atoms.begin(), atoms.end(), hasOrganicBond);
 }
 
-std::unordered_map<Symbol, c_size> MolecularStructure::getComponentCountMap() const
+std::vector<std::pair<Symbol, c_size>> MolecularStructure::getComponentCountMap() const
 {
-    std::unordered_map<Symbol, c_size> result;
-    for (const auto& a : atoms) {
-        const auto& symbol = a->getAtom().getData().symbol;
-        if (auto it = result.find(symbol); it != result.end())
-            ++it->second;
+    std::vector<std::pair<Symbol, c_size>> result;
+    std::vector<c_size>                    resultIndices(Symbol::getInternedCount(), npos);
+
+    const auto add = [&](const Symbol& symbol, const c_size count) {
+        auto& idx = resultIndices[symbol.getId()];
+        if (idx == npos) {
+            idx = static_cast<c_size>(result.size());
+            result.emplace_back(symbol, count);
+        }
         else
-            result.emplace(symbol, 1);
-    }
+            result[idx].second += count;
+    };
 
-    if (impliedHydrogenCount == 0)
-        return result;
+    for (const auto& a : atoms)
+        add(a->getAtom().getData().symbol, 1);
 
-    const auto& hSymbol = Predefined::get().Hydrogen.getData().symbol;
-    if (auto it = result.find(hSymbol); it != result.end())
-        it->second += impliedHydrogenCount;
-    else
-        result.emplace(hSymbol, impliedHydrogenCount);
+    if (impliedHydrogenCount != 0)
+        add(Predefined::get().Hydrogen.getData().symbol, impliedHydrogenCount);
 
     return result;
 }
@@ -772,8 +780,22 @@ c_size MolecularStructure::getBondCount() const
     return cnt / 2;
 }
 
+size_t MolecularStructure::getHeapUsage() const
+{
+    auto usage = utils::getHeapUsage(atoms);
+    for (const auto& a : atoms)
+        usage += a->getMemoryUsage();
+
+    if (const auto info = ringInfo.get())
+        usage += sizeof(RingInfo) + info->getHeapUsage();
+    return usage;
+}
+
 bool MolecularStructure::isCyclic() const
 {
+    if (const auto info = ringInfo.get())
+        return info->getRingCount() != 0;
+
     // Molecules are connected graphs, so cycles can only appear if E > V-1.
     return getBondCount() > atoms.size() - 1;
 }
@@ -824,21 +846,58 @@ bool MolecularStructure::areAdjacent(const c_size idxA, const c_size idxB) const
 namespace
 {
 
+/// <summary>
+/// Cheap feasibility filter: a ring atom of the pattern can only be mapped to a ring atom of the target.
+/// </summary>
+class RingFilter
+{
+private:
+    const RingInfo* targetRings  = nullptr;
+    const RingInfo* patternRings = nullptr;
+
+public:
+    RingFilter(const MolecularStructure& target, const MolecularStructure& pattern) noexcept;
+
+    bool allows(const BondedAtomBase& targetAtom, const BondedAtomBase& patternAtom) const;
+};
+
+RingFilter::RingFilter(const MolecularStructure& target, const MolecularStructure& pattern) noexcept
+{
+    // Acyclic patterns don't need ring perception.
+    if (not pattern.isCyclic())
+        return;
+
+    targetRings  = &target.getRingInfo();
+    patternRings = &pattern.getRingInfo();
+}
+
+bool RingFilter::allows(const BondedAtomBase& targetAtom, const BondedAtomBase& patternAtom) const
+{
+    return patternRings == nullptr ||
+           not patternRings->isRingAtom(patternAtom.index) ||
+           targetRings->isRingAtom(targetAtom.index);
+}
+
 template <bool Exact>
-bool areMatching(const BondedAtomBase& a, const BondedAtomBase& b)
+bool areMatching(const BondedAtomBase& a, const BondedAtomBase& b, const RingFilter& ringFilter)
 {
     if (a.bonds.size() != b.bonds.size())
         return false;
 
+    // Radicals of generic patterns may stand for any atom.
+    if ((Exact || not b.getAtom().isRadical()) && not ringFilter.allows(a, b))
+        return false;
+
     return Exact ? b.getAtom().equals(a.getAtom()) : b.getAtom().matches(a.getAtom());
 }
 
 template <bool Exact>
 bool areMatching(
-    const Bond&                               nextA,
-    const Bond&                               nextB,
-    const std::vector<uint8_t>&               visitedB,
-    const std::unordered_map<c_size, c_size>& mapping)
+    const Bond&                 nextA,
+    const Bond&                 nextB,
+    const std::vector<uint8_t>& visitedB,
+    const AtomMap&              mapping,
+    const RingFilter&           ringFilter)
 {
     if (nextA.getType() != nextB.getType())
         return false;
@@ -852,7 +911,9 @@ bool areMatching(
             return otherB.getAtom().matches(otherA.getAtom());
     }
 
-    if (otherA.bonds.size() != otherB.bonds.size() || not otherA.getAtom().equals(otherB.getAtom()))
+    if (otherA.bonds.size() != otherB.bonds.size() ||
+        not ringFilter.allows(otherA, otherB) ||
+        not otherA.getAtom().equals(otherB.getAtom()))
         return false;
 
     // Test to see if both have the same types of bonds
@@ -880,10 +941,11 @@ bool areMatching(
 /// execution</param>
 template <bool Exact>
 bool DFSCompare(
-    const BondedAtomBase&               a,
-    const BondedAtomBase&               b,
-    std::vector<uint8_t>&               visitedB,
-    std::unordered_map<c_size, c_size>& mapping)
+    const BondedAtomBase& a,
+    const BondedAtomBase& b,
+    std::vector<uint8_t>& visitedB,
+    AtomMap&              mapping,
+    const RingFilter&     ringFilter)
 {
     mapping.emplace(a.index, b.index);
     visitedB[b.index] = true;
@@ -894,10 +956,11 @@ bool DFSCompare(
 
         auto matchFound = false;
         for (const auto& bondA : a.bonds) {
-            if (mapping.contains(bondA.getOther().index) || not areMatching<Exact>(bondA, bondB, visitedB, mapping))
+            if (mapping.contains(bondA.getOther().index) ||
+                not areMatching<Exact>(bondA, bondB, visitedB, mapping, ringFilter))
                 continue;
 
-            if (DFSCompare<Exact>(bondA.getOther(), bondB.getOther(), visitedB, mapping)) {
+            if (DFSCompare<Exact>(bondA.getOther(), bondB.getOther(), visitedB, mapping, ringFilter)) {
                 matchFound = true;
                 break;
             }
@@ -917,42 +980,56 @@ bool DFSCompare(
 }  // namespace
 
 template <bool Exact>
-std::unordered_map<c_size, c_size> MolecularStructure::_mapTo(const MolecularStructure& pattern) const
+AtomMap MolecularStructure::_mapTo(const MolecularStructure& pattern) const
 {
     if (pattern.atoms.empty())
-        return std::unordered_map<c_size, c_size>();
+        return AtomMap();
 
+    const RingFilter     ringFilter(*this, pattern);
+    std::vector<uint8_t> visited;
+    AtomMap              mapping;
     for (const auto& a : this->atoms) {
         // Should start with a non radical type from pattern.
         // Canonicalization assures that if such atom exists, it is the first.
-        if (areMatching<Exact>(*a, *pattern.atoms.front())) {
-            std::vector<uint8_t>               visited(pattern.atoms.size(), false);
-            std::unordered_map<c_size, c_size> mapping;
+        if (areMatching<Exact>(*a, *pattern.atoms.front(), ringFilter)) {
+            visited.assign(pattern.atoms.size(), false);
+            mapping.clear();
+            mapping.reserve(static_cast<c_size>(this->atoms.size()));
 
-            if (DFSCompare<Exact>(*a, *pattern.atoms.front(), visited, mapping) == false)
+            if (DFSCompare<Exact>(*a, *pattern.atoms.front(), visited, mapping, ringFilter) == false)
                 continue;
 
             return mapping;
         }
     }
 
-    return std::unordered_map<c_size, c_size>();
+    return AtomMap();
 }
 
-template std::unordered_map<c_size, c_size> MolecularStructure::_mapTo<true>(const MolecularStructure& pattern) const;
-template std::unordered_map<c_size, c_size> MolecularStructure::_mapTo<false>(const MolecularStructure& pattern) const;
+template AtomMap MolecularStructure::_mapTo<true>(const MolecularStructure& pattern) const;
+template AtomMap MolecularStructure::_mapTo<false>(const MolecularStructure& pattern) const;
 
-std::unordered_map<c_size, c_size> MolecularStructure::mapTo(const MolecularStructure& pattern) const
+AtomMap MolecularStructure::mapTo(const MolecularStructure& pattern) const
 {
     // A patter will never match a smaller target.
     if (pattern.molarMass > this->molarMass ||
         pattern.atoms.size() > this->atoms.size() ||
         pattern.impliedHydrogenCount > this->impliedHydrogenCount)
-        return std::unordered_map<c_size, c_size>();
+        return AtomMap();
 
     return _mapTo<false>(pattern);
 }
 
+size_t MolecularStructure::getInvariantHash() const
+{
+    // Atom hashes are summed in order to be independent of the atom order.
+    size_t atomsHash = 0;
+    for (const auto& a : atoms)
+        atomsHash += utils::hashCombine(a->getAtom().getData().symbol, a->bonds.size());
+
+    return utils::hashCombine(atomsHash, atoms.size(), impliedHydrogenCount);
+}
+
 bool MolecularStructure::operator==(const MolecularStructure& other) const
 {
     if (this->isVirtualHydrogen() && other.isVirtualHydrogen())
@@ -980,126 +1057,322 @@ bool MolecularStructure::operator!=(const std::string& other) const { return !(*
 namespace
 {
 
-uint8_t getBondSimilarity(const BondedAtomBase& a, const BondedAtomBase& b)
+/// <summary>
+/// Returns the number of bonds by which the bond type histograms of the atoms differ.
+/// </summary>
+c_size getBondDifference(const BondedAtomBase& a, const BondedAtomBase& b)
 {
-    uint8_t                                       score = 255;
     std::array<int8_t, BondType::BOND_TYPE_COUNT> counts{};
-
     for (const auto& bondA : a.bonds)
         ++counts[bondA.getType()];
     for (const auto& bondB : b.bonds)
         --counts[bondB.getType()];
 
-    const auto scorePerBond = static_cast<uint8_t>(a.bonds.size() / 255);
-    for (const auto& c : counts)
-        score -= c * scorePerBond;
-
-    return score;
+    c_size difference = 0;
+    for (const auto c : counts)
+        difference += static_cast<c_size>(std::abs(c));
+    return difference;
 }
 
-uint8_t maximalSimilarity(const Bond& nextA, const Bond& nextB)
+/// <summary>
+/// Branch-and-bound search for the largest connected mapping between the atoms of a target and those of a
+/// pattern. Mappings are grown through the bonds of the pattern: each bond from a mapped atom to an unmapped one
+/// is either used to map the unmapped atom to a neighbor of the image of the mapped one, through a bond of the same
+/// type, or excluded from the mapping. The state is kept in bitsets and rolled back on backtracking, so branches
+/// never copy it. Among mappings of the same size, the one with the smallest total bond difference is preferred.
+/// </summary>
+class MaximalMapper
 {
-    if (nextA.getType() != nextB.getType())
-        return 0;
-
-    if (not nextB.getOther().getAtom().equals(nextA.getOther().getAtom()))
-        return 0;
+private:
+    using AtomsT = std::vector<std::unique_ptr<BondedAtomBase>>;
+
+    const AtomsT&                               targetAtoms;
+    const AtomsT&                               patternAtoms;
+    const MappingBudget                         budget;
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    // Mapped or ignored atoms.
+    boost::dynamic_bitset<uint64_t> unavailableTarget;
+    boost::dynamic_bitset<uint64_t> unavailablePattern;
+    // Pattern bonds excluded from the mapping, as a patternCount x patternCount matrix.
+    boost::dynamic_bitset<uint64_t> excludedBonds;
+
+    std::vector<c_size> patternToTarget;
+    std::vector<c_size> mappingOrder;
+    c_size              bondDifference        = 0;
+    c_size              availableTargetCount  = 0;
+    c_size              availablePatternCount = 0;
+    c_size              maxMappingSize        = 0;
+
+    std::vector<c_size> bestMappingOrder;
+    std::vector<c_size> bestPatternToTarget;
+    c_size              bestBondDifference = MolecularStructure::npos;
+    size_t              nodeCount          = 0;
+    bool                isExhausted        = false;
+
+    // Scratch space for the upper bound.
+    boost::dynamic_bitset<uint64_t> visited;
+    std::vector<c_size>             queue;
+    std::vector<c_size>             symbolCounts = std::vector<c_size>(Symbol::getInternedCount(), 0);
+
+    bool checkBudget()
+    {
+        ++nodeCount;
+        // Reading the clock is expensive compared to a node, so it's only done once in a while.
+        if (nodeCount > budget.nodeCount ||
+            ((nodeCount & 0x3FF) == 0 && std::chrono::steady_clock::now() - startTime > budget.time))
+            isExhausted = true;
 
-    return getBondSimilarity(nextA.getOther(), nextB.getOther());
-}
+        return not isExhausted;
+    }
 
-std::pair<std::unordered_map<c_size, c_size>, uint8_t> DFSMaximal(
-    const BondedAtomBase&       a,
-    std::unordered_set<c_size>& mappedA,
-    const BondedAtomBase&       b,
-    std::unordered_set<c_size>& mappedB)
-{
-    std::pair<std::unordered_map<c_size, c_size>, uint8_t> newMap;
-    newMap.first.emplace(a.index, b.index);
-    mappedA.emplace(a.index);
-    mappedB.emplace(b.index);
+    size_t getBondIdx(const c_size from, const c_size to) const { return from * patternAtoms.size() + to; }
 
-    for (const auto& bondB : b.bonds) {
-        if (mappedB.contains(bondB.getOther().index))
-            continue;
+    /// <summary>
+    /// Calls func for each available atom which can be reached from the mapped ones, without passing through other
+    /// mapped atoms or excluded bonds.
+    /// </summary>
+    template <typename FuncT>
+    void forEachReachable(const bool isPattern, FuncT&& func)
+    {
+        const auto& atoms = isPattern ? patternAtoms : targetAtoms;
+        visited           = isPattern ? unavailablePattern : unavailableTarget;
+
+        queue.clear();
+        for (const auto m : mappingOrder)
+            queue.emplace_back(isPattern ? m : patternToTarget[m]);
+
+        for (size_t i = 0; i < queue.size(); ++i) {
+            const auto idx      = queue[i];
+            const auto isMapped = i < mappingOrder.size();
+            for (const auto& bond : atoms[idx]->bonds) {
+                const auto& other = bond.getOther();
+                if (visited[other.index] || (isPattern && isMapped && excludedBonds[getBondIdx(idx, other.index)]))
+                    continue;
 
-        // Only the largest mapping is added into the final but states need to be copied
-        std::pair<std::unordered_map<c_size, c_size>, uint8_t> maxMapping;
-        std::unordered_set<c_size>                             maxMappedA;
-        std::unordered_set<c_size>                             maxMappedB;
-        for (const auto& bondA : a.bonds) {
-            if (mappedA.contains(bondA.getOther().index))
-                continue;
+                visited[other.index] = true;
+                queue.emplace_back(other.index);
+                func(other);
+            }
+        }
+    }
 
-            const auto score = maximalSimilarity(bondA, bondB);
-            if (score == 0)
-                continue;
+    /// <summary>
+    /// Atoms only match atoms with the same data, so the size of the mapping is bounded by the common part of the
+    /// symbol histograms of the reachable atoms.
+    /// </summary>
+    c_size getUpperBound()
+    {
+        const auto size = static_cast<c_size>(mappingOrder.size());
+        if (size + std::min(availableTargetCount, availablePatternCount) < bestMappingOrder.size())
+            return size;
 
-            // Reversing bad branches isn't possible here, so copies are needed
-            auto mappedACopy = mappedA;
-            auto mappedBCopy = mappedB;
-            auto subMap      = DFSMaximal(bondA.getOther(), mappedACopy, bondB.getOther(), mappedBCopy);
+        forEachReachable(false, [&](const BondedAtomBase& atom) {
+            ++symbolCounts[atom.getAtom().getData().symbol.getId()];
+        });
 
-            if (subMap.first.size() > maxMapping.first.size() ||
-                (subMap.first.size() == maxMapping.first.size() && score > maxMapping.second)) {
-                maxMapping = std::move(subMap);
-                maxMappedA = std::move(mappedACopy);
-                maxMappedB = std::move(mappedBCopy);
+        c_size bound = size;
+        forEachReachable(true, [&](const BondedAtomBase& atom) {
+            auto& count = symbolCounts[atom.getAtom().getData().symbol.getId()];
+            if (count > 0) {
+                --count;
+                ++bound;
             }
-        }
+        });
 
-        newMap.first.merge(std::move(maxMapping.first));
-        newMap.second = maxMapping.second;
-        mappedA.merge(std::move(maxMappedA));
-        mappedB.merge(std::move(maxMappedB));
+        std::ranges::fill(symbolCounts, 0);
+        return bound;
     }
 
-    return newMap;
-}
+    /// <summary>
+    /// Checks if the mappings which can be grown from the current one can't be better than the best mapping.
+    /// The bond difference never decreases as atoms are mapped.
+    /// </summary>
+    bool canPrune()
+    {
+        const auto bound = getUpperBound();
+        return bound < bestMappingOrder.size() ||
+               (bound == bestMappingOrder.size() && bondDifference >= bestBondDifference);
+    }
 
-}  // namespace
+    /// <summary>
+    /// Checks if the best mapping can't be improved upon, in which case the search stops.
+    /// </summary>
+    bool isOptimal() const { return bestMappingOrder.size() == maxMappingSize && bestBondDifference == 0; }
 
-std::pair<std::unordered_map<c_size, c_size>, uint8_t> MolecularStructure::maximalMapTo(
-    const MolecularStructure&         pattern,
-    const std::unordered_set<c_size>& targetIgnore,
-    const std::unordered_set<c_size>& patternIgnore) const
-{
-    if (pattern.atoms.size() == 0 || this->atoms.size() == 0)
-        return std::pair<std::unordered_map<c_size, c_size>, uint8_t>();
+    void map(const c_size targetIdx, const c_size patternIdx)
+    {
+        bondDifference += getBondDifference(*targetAtoms[targetIdx], *patternAtoms[patternIdx]);
+        unavailableTarget[targetIdx]   = true;
+        unavailablePattern[patternIdx] = true;
+        patternToTarget[patternIdx]    = targetIdx;
+        mappingOrder.emplace_back(patternIdx);
+        --availableTargetCount;
+        --availablePatternCount;
+    }
 
-    // Find matching atom in both target and pattern
-    std::pair<std::unordered_map<c_size, c_size>, uint8_t> maxMapping;
-    uint8_t                                                maxScore = 0;
-    for (c_size i = 0; i < this->atoms.size(); ++i) {
-        if (targetIgnore.contains(i))
-            continue;
+    void unmap()
+    {
+        const auto patternIdx = mappingOrder.back();
+        mappingOrder.pop_back();
+        bondDifference -= getBondDifference(*targetAtoms[patternToTarget[patternIdx]], *patternAtoms[patternIdx]);
+        unavailableTarget[patternToTarget[patternIdx]] = false;
+        unavailablePattern[patternIdx]                 = false;
+        patternToTarget[patternIdx]                    = MolecularStructure::npos;
+        ++availableTargetCount;
+        ++availablePatternCount;
+    }
 
-        if (maxMapping.first.contains(i))
-            continue;
+    /// <summary>
+    /// Checks if mapping the pattern atom to the target atom is covered by a branch in which one of the excluded
+    /// bonds of the pattern atom was used instead, in which case it's skipped.
+    /// </summary>
+    bool isCovered(const c_size patternIdx, const c_size targetIdx) const
+    {
+        for (const auto& patternBond : patternAtoms[patternIdx]->bonds) {
+            const auto neighborIdx = patternBond.getOther().index;
+            if (patternToTarget[neighborIdx] == MolecularStructure::npos ||
+                not excludedBonds[getBondIdx(neighborIdx, patternIdx)])
+                continue;
+
+            for (const auto& targetBond : targetAtoms[patternToTarget[neighborIdx]]->bonds)
+                if (targetBond.getOther().index == targetIdx && targetBond.getType() == patternBond.getType())
+                    return true;
+        }
 
-        for (c_size j = 0; j < pattern.atoms.size(); ++j) {
-            if (patternIgnore.contains(j))
+        return false;
+    }
+
+    void search()
+    {
+        if (mappingOrder.size() > bestMappingOrder.size() ||
+            (mappingOrder.size() == bestMappingOrder.size() && bondDifference < bestBondDifference)) {
+            bestMappingOrder    = mappingOrder;
+            bestPatternToTarget = patternToTarget;
+            bestBondDifference  = bondDifference;
+        }
+
+        if (not checkBudget() || isOptimal() || canPrune())
+            return;
+
+        // The next bond to branch on is the first one from a mapped atom to an available one, in mapping order.
+        const Bond* frontierBond = nullptr;
+        c_size      mappedIdx    = MolecularStructure::npos;
+        for (const auto m : mappingOrder) {
+            for (const auto& bond : patternAtoms[m]->bonds) {
+                const auto other = bond.getOther().index;
+                if (not unavailablePattern[other] && not excludedBonds[getBondIdx(m, other)]) {
+                    frontierBond = &bond;
+                    mappedIdx    = m;
+                    break;
+                }
+            }
+            if (frontierBond)
+                break;
+        }
+
+        if (frontierBond == nullptr)
+            return;
+
+        const auto& frontierAtom = frontierBond->getOther();
+        for (const auto& targetBond : targetAtoms[patternToTarget[mappedIdx]]->bonds) {
+            const auto& candidate = targetBond.getOther();
+            if (unavailableTarget[candidate.index] || targetBond.getType() != frontierBond->getType() ||
+                not frontierAtom.getAtom().equals(candidate.getAtom()) ||
+                isCovered(frontierAtom.index, candidate.index))
                 continue;
 
-            if (pattern.atoms[j]->getAtom().equals(this->atoms[i]->getAtom()) == false)
+            map(candidate.index, frontierAtom.index);
+            search();
+            unmap();
+
+            if (isExhausted)
+                return;
+        }
+
+        const auto bondIdx     = getBondIdx(mappedIdx, frontierAtom.index);
+        excludedBonds[bondIdx] = true;
+        search();
+        excludedBonds[bondIdx] = false;
+    }
+
+public:
+    MaximalMapper(
+        const AtomsT&                     targetAtoms,
+        const AtomsT&                     patternAtoms,
+        const std::unordered_set<c_size>& targetIgnore,
+        const std::unordered_set<c_size>& patternIgnore,
+        const MappingBudget&              budget) noexcept :
+        targetAtoms(targetAtoms),
+        patternAtoms(patternAtoms),
+        budget(budget),
+        unavailableTarget(targetAtoms.size()),
+        unavailablePattern(patternAtoms.size()),
+        excludedBonds(patternAtoms.size() * patternAtoms.size()),
+        patternToTarget(patternAtoms.size(), MolecularStructure::npos)
+    {
+        for (const auto i : targetIgnore)
+            if (i < unavailableTarget.size())
+                unavailableTarget[i] = true;
+        for (const auto i : patternIgnore)
+            if (i < unavailablePattern.size())
+                unavailablePattern[i] = true;
+
+        availableTargetCount  = static_cast<c_size>(unavailableTarget.size() - unavailableTarget.count());
+        availablePatternCount = static_cast<c_size>(unavailablePattern.size() - unavailablePattern.count());
+        maxMappingSize        = std::min(availableTargetCount, availablePatternCount);
+    }
+
+    std::pair<AtomMap, uint8_t> run()
+    {
+        std::pair<AtomMap, uint8_t> result;
+        for (c_size i = 0; i < targetAtoms.size(); ++i) {
+            if (unavailableTarget[i])
                 continue;
 
-            const auto score = getBondSimilarity(*this->atoms[i], *pattern.atoms[j]);
+            for (c_size j = 0; j < patternAtoms.size(); ++j) {
+                if (unavailablePattern[j] || not patternAtoms[j]->getAtom().equals(targetAtoms[i]->getAtom()))
+                    continue;
 
-            std::unordered_set<c_size> mappedA(targetIgnore), mappedB(patternIgnore);
-            auto                       map = DFSMaximal(*this->atoms[i], mappedA, *pattern.atoms[j], mappedB);
+                map(i, j);
+                search();
+                unmap();
 
-            // Picks largest mapping, then best 2nd comp. score, then best 1st comp. score
-            if (map.first.size() > maxMapping.first.size() ||
-                (map.first.size() == maxMapping.first.size() &&
-                 (map.second > maxMapping.second || (map.second == maxMapping.second && score > maxScore)))) {
-                maxMapping = std::move(map);
-                maxScore   = score;
+                if (isExhausted || isOptimal())
+                    break;
             }
+
+            // All of the mappings containing this target atom were explored, so it can be left out from now on.
+            unavailableTarget[i] = true;
+            --availableTargetCount;
+            const auto bound = std::min(availableTargetCount, availablePatternCount);
+            if (isExhausted || isOptimal() || bound < bestMappingOrder.size() ||
+                (bound == bestMappingOrder.size() && bestBondDifference == 0))
+                break;
         }
+
+        // The score is the bond similarity of the mapping.
+        result.second = static_cast<uint8_t>(255 - std::min<c_size>(bestBondDifference, 255));
+        result.first.reserve(bestMappingOrder.size());
+        for (const auto j : bestMappingOrder)
+            result.first.emplace(bestPatternToTarget[j], j);
+
+        return result;
     }
+};
+
+}  // namespace
+
+std::pair<AtomMap, uint8_t> MolecularStructure::maximalMapTo(
+    const MolecularStructure&         pattern,
+    const std::unordered_set<c_size>& targetIgnore,
+    const std::unordered_set<c_size>& patternIgnore,
+    const MappingBudget&              budget) const
+{
+    if (pattern.atoms.size() == 0 || this->atoms.size() == 0)
+        return std::pair<AtomMap, uint8_t>();
 
-    return maxMapping;
+    return MaximalMapper(this->atoms, pattern.atoms, targetIgnore, patternIgnore, budget).run();
 }
 
 //
@@ -1122,6 +1395,8 @@ void MolecularStructure::recountImpliedHydrogens()
 
 void MolecularStructure::mutateAtom(const c_size idx, const AtomBase& newAtom)
 {
+    // Rings reference the replaced atom.
+    ringInfo.reset();
     auto& oldBondedAtom = *atoms[idx];
     auto  newBondedAtom = oldBondedAtom.mutate(newAtom);
 
@@ -1137,17 +1412,18 @@ void MolecularStructure::mutateAtom(const c_size idx, const AtomBase& newAtom)
 }
 
 void MolecularStructure::copyBranch(
-    MolecularStructure&                 destination,
-    const MolecularStructure&           source,
-    const c_size                        sourceIdx,
-    std::unordered_map<c_size, c_size>& sdMapping,
-    bool                                canonicalize,
-    const std::unordered_set<c_size>&   sourceIgnore)
-{
+    MolecularStructure&       destination,
+    const MolecularStructure& source,
+    const c_size              sourceIdx,
+    AtomMap&                  sdMapping,
+    bool                      canonicalize,
+    const AtomMap&            sourceIgnore)
+{
+    destination.ringInfo.reset();
     const auto& sourceAtom = source.atoms[sourceIdx];
 
     // Overwrites first matching radical atom
-    const auto dstFirstIdx = sdMapping[sourceIdx];
+    const auto dstFirstIdx = sdMapping.at(sourceIdx);
     if (destination.atoms[dstFirstIdx]->getAtom().isRadical())
         destination.mutateAtom(dstFirstIdx, sourceAtom->getAtom());
 
@@ -1160,6 +1436,7 @@ void MolecularStructure::copyBranch(
     if (stack.empty())
         return;
 
+    sdMapping.reserve(static_cast<c_size>(source.atoms.size()));
     while (stack.size()) {
         const auto c = stack.top();
         stack.pop();
@@ -1171,8 +1448,8 @@ void MolecularStructure::copyBranch(
 
         // Add bonds to existing nodes and queue non-existing nodes
         for (const auto& bond : source.atoms[c]->bonds) {
-            if (const auto sdIt = sdMapping.find(bond.getOther().index); sdIt != sdMapping.end()) {
-                addBond(*destination.atoms.back(), *destination.atoms[sdIt->second], bond.getType());
+            if (const auto dstIdx = sdMapping.find(bond.getOther().index); dstIdx != AtomMap::npos) {
+                addBond(*destination.atoms.back(), *destination.atoms[dstIdx], bond.getType());
                 continue;
             }
 
@@ -1188,17 +1465,15 @@ void MolecularStructure::copyBranch(
     }
 }
 
-MolecularStructure MolecularStructure::addSubstituents(
-    const MolecularStructure&                 pattern,
-    const MolecularStructure&                 instance,
-    const std::unordered_map<c_size, c_size>& ipMap)
+MolecularStructure
+MolecularStructure::addSubstituents(const MolecularStructure& pattern, const MolecularStructure& instance, const AtomMap& ipMap)
 {
     MolecularStructure result(pattern);
 
     // Maintain the original mapping to ensure only the these atoms are substituted.
     auto sdMap = ipMap;
-    for (const auto& p : ipMap)
-        copyBranch(result, instance, p.first, sdMap, false);
+    for (const auto& [instanceIdx, _] : ipMap)
+        copyBranch(result, instance, instanceIdx, sdMap, false);
 
     result.canonicalize();
     result.recountImpliedHydrogens();
@@ -1490,7 +1765,7 @@ std::string MolecularStructure::toSMILES(const c_size startAtomIdx) const
 std::optional<MolecularStructure> MolecularStructure::loadMolBinFile(const std::string& path)
 {
     const auto    normPath = utils::normalizePath(path);
-    std::ifstream is(normPath);
+    std::ifstream is(normPath, std::ios::binary);
     if (not is) {
         Log<MolecularStructure>().error("Failed to open file: '{}' for reading.", normPath);
         return std::nullopt;
@@ -1530,12 +1805,12 @@ bool MolecularStructure::loadFromMolBin(std::istream& is)
         if (symbolStr.empty())
             break;
 
-        Symbol symbol(std::move(symbolStr));
-        if (not AtomBase::isDefined(symbol)) {
-            Log(this).error("MolBin atomic symbol: '{}' is undefined.", symbol);
+        if (not AtomBase::isDefined(symbolStr)) {
+            Log(this).error("MolBin atomic symbol: '{}' is undefined.", symbolStr);
             clear();
             return false;
         }
+        const Symbol symbol(std::move(symbolStr));
 
         atoms.emplace_back(BondedAtomBase::create(symbol, static_cast<c_size>(atoms.size()), {}));
         futureBonds.emplace_back();
@@ -1611,6 +1886,125 @@ bool MolecularStructure::loadFromMolBin(std::istream& is)
     return true;
 }
 
+std::optional<MolecularStructure> MolecularStructure::fromMolBin(
+    const std::span<const MolBin::Atom>        atoms,
+    const std::span<const MolBin::Bond>        bonds,
+    const std::span<const AtomBaseData* const> symbolTable)
+{
+    MolecularStructure temp;
+    return temp.loadFromMolBin(atoms, bonds, symbolTable) ? std::optional(std::move(temp)) : std::nullopt;
+}
+
+bool MolecularStructure::loadFromMolBin(
+    const std::span<const MolBin::Atom>        packedAtoms,
+    const std::span<const MolBin::Bond>        packedBonds,
+    const std::span<const AtomBaseData* const> symbolTable)
+{
+    if (packedAtoms.empty()) {
+        if (not packedBonds.empty()) {
+            Log(this).error("MolBin virtual hydrogen has: {} bonds.", packedBonds.size());
+            return false;
+        }
+
+        molarMass            = Predefined::get().Hydrogen.getData().weight * 2;
+        impliedHydrogenCount = 2;
+        return true;
+    }
+
+    if (packedAtoms.size() >= npos) {
+        Log(this).error("MolBin atom count: {} exceeds the maximum of: {}.", packedAtoms.size(), npos - 1);
+        return false;
+    }
+
+    atoms.reserve(packedAtoms.size());
+    for (c_size i = 0; i < packedAtoms.size(); ++i) {
+        const auto symbolIdx = packedAtoms[i].symbolIdx;
+        if (symbolIdx >= symbolTable.size() || symbolTable[symbolIdx] == nullptr) {
+            Log(this).error("MolBin atom: {} refers to an undefined symbol (index: {}).", i, symbolIdx);
+            clear();
+            return false;
+        }
+
+        atoms.emplace_back(BondedAtomBase::create(*symbolTable[symbolIdx], i, {}));
+    }
+
+    // All atoms must exist before the bonds are added, the bonds of each atom following those of the previous one.
+    size_t bondIdx = 0;
+    for (c_size i = 0; i < packedAtoms.size(); ++i) {
+        const auto bondCount = packedAtoms[i].bondCount;
+        if (bondCount > packedBonds.size() - bondIdx) {
+            Log(this).error("MolBin bonds of atom: {} exceed the bond array (size: {}).", i, packedBonds.size());
+            clear();
+            return false;
+        }
+
+        auto& atom = *atoms[i];
+        atom.bonds.reserve(bondCount);
+        for (const auto& bond : packedBonds.subspan(bondIdx, bondCount)) {
+            if (bond.type <= BondType::NONE || bond.type >= BondType::BOND_TYPE_COUNT) {
+                Log(this).error("Invalid MolBin bond type: {} on atom: {}.", underlying_cast(bond.type), i);
+                clear();
+                return false;
+            }
+            if (bond.other >= atoms.size()) {
+                Log(this).error(
+                    "MolBin bond other index: {} refers to a non-existing atom (max index: {}).",
+                    bond.other,
+                    atoms.size());
+                clear();
+                return false;
+            }
+            if (bond.other == i) {
+                Log(this).error("Self-pointing MolBin bond on atom: {}.", i);
+                clear();
+                return false;
+            }
+            if (atom.getBondTo(*atoms[bond.other]) != nullptr) {
+                Log(this).error("MolBin bond redefines an existing bond between atoms {} and {}.", i, bond.other);
+                clear();
+                return false;
+            }
+
+            atom.bonds.emplace_back(*atoms[bond.other], bond.type);
+        }
+        bondIdx += bondCount;
+    }
+
+    if (bondIdx != packedBonds.size()) {
+        Log(this).error("MolBin bond array has: {} bonds not owned by any atom.", packedBonds.size() - bondIdx);
+        clear();
+        return false;
+    }
+
+    for (const auto& atom : atoms) {
+        for (const auto& bond : atom->bonds) {
+            const auto backBond = bond.getOther().getBondTo(*atom);
+            if (backBond == nullptr || backBond->getType() != bond.getType()) {
+                Log(this).error(
+                    "MolBin bond between atoms {} and {} is missing its reverse.", atom->index, bond.getOther().index);
+                clear();
+                return false;
+            }
+        }
+    }
+
+    if (not isFullyConnected()) {
+        Log(this).error("MolBin representation isn't fully connected.");
+        clear();
+        return false;
+    }
+
+    const auto properties = countProperties();
+    if (utils::isNPos(properties)) {
+        Log(this).error("Valence of an atom was exceeded in MolBin representation.");
+        clear();
+        return false;
+    }
+    std::tie(molarMass, impliedHydrogenCount) = properties;
+
+    return true;
+}
+
 void MolecularStructure::toMolBin(std::ostream& os) const
 {
     // MolBin:
@@ -1642,7 +2036,7 @@ void MolecularStructure::toMolBin(std::ostream& os) const
 void MolecularStructure::toMolBinFile(const std::string& path) const
 {
     const auto    normPath = utils::normalizePath(path);
-    std::ofstream os(normPath);
+    std::ofstream os(normPath, std::ios::binary);
     if (not os) {
         Log<MolecularStructure>().error("Failed to open file: '{}' for writing.", normPath);
         return;
@@ -1661,89 +2055,298 @@ namespace
 
 using Edge = UndirectedEdge<c_size>;
 
-class CycleDecoder
+/// <summary>
+/// Computes a minimum cycle basis using Horton's candidate cycles: for each root of a feedback vertex set and each
+/// non-tree edge (x, y) of the shortest path tree of that root, the cycle root->...->x->y->...->root. Candidates are
+/// tried in increasing order of length and kept if they are independent of the previously kept ones, which is checked
+/// by Gaussian elimination over GF(2) with the cycles encoded as edge bitsets.
+/// </summary>
+class MinimalCycleBasisFinder
 {
 private:
-    const ::MolecularStructure& owningStructure;
-    MolecularStructure::Cycle   decodedCycle;
-    std::vector<Edge>           unboundEdges;
+    static constexpr c_size WordBits = 64;
 
-    bool add(const c_size idx);
+    struct Candidate
+    {
+        c_size length;
+        c_size treeIdx;
+        c_size idxX;
+        c_size idxY;
+        c_size edgeId;
+    };
 
-public:
-    CycleDecoder(const ::MolecularStructure& owningStructure) noexcept;
-    CycleDecoder(const CycleDecoder&) = delete;
-    CycleDecoder(CycleDecoder&&)      = default;
+    const MolecularStructure& structure;
+
+    // The 2-core of the structure (atoms lying on cycles or on paths between cycles) as an adjacency list.
+    std::vector<c_size> coreAtoms;
+    std::vector<c_size> adjacencyOffsets;
+    std::vector<c_size> adjacentAtoms;
+    std::vector<c_size> adjacentEdges;
+    c_size              edgeCount = 0;
+
+    // Shortest path trees, stored as one row of coreAtoms.size() entries for each root.
+    std::vector<c_size>    parents;
+    std::vector<c_size>    parentEdges;
+    std::vector<c_size>    distances;
+    std::vector<c_size>    branches;
+    std::vector<c_size>    queue;
+    std::vector<Candidate> candidates;
+
+    void                buildCore();
+    std::vector<c_size> findRoots() const;
+    void                addShortestPathTree(const c_size root);
 
-    bool add(const Edge edge);
+    // Edge sets are stored as rows of wordCount words.
+    void                      encode(const Candidate& candidate, uint64_t* result, const c_size wordCount) const;
+    MolecularStructure::Cycle decode(const Candidate& candidate) const;
 
-    MolecularStructure::Cycle& getDecodedCycle();
+public:
+    MinimalCycleBasisFinder(const MolecularStructure& structure) noexcept;
+    MinimalCycleBasisFinder(const MinimalCycleBasisFinder&) = delete;
+
+    std::vector<MolecularStructure::Cycle> find(const c_size cycleCount);
 };
 
-CycleDecoder::CycleDecoder(const ::MolecularStructure& owningStructure) noexcept :
-    owningStructure(owningStructure)
+MinimalCycleBasisFinder::MinimalCycleBasisFinder(const MolecularStructure& structure) noexcept :
+    structure(structure)
 {}
 
-bool CycleDecoder::add(const c_size idx)
+void MinimalCycleBasisFinder::buildCore()
 {
-    decodedCycle.emplace_back(&owningStructure.getBondedAtom(idx));
+    const auto atomCount = structure.getNonImpliedAtomCount();
 
-    size_t i = 0;
-    while (i < unboundEdges.size()) {
-        const auto edge = unboundEdges[i];
-        if (edge.getIdxA() == decodedCycle.back()->index) {
-            if (edge.getIdxB() == decodedCycle.front()->index)
-                return true;  // Cycle end
+    // Peel off the atoms outside of cycles, starting from the leaves.
+    std::vector<c_size> degrees(atomCount);
+    std::vector<c_size> leaves;
+    for (c_size i = 0; i < atomCount; ++i) {
+        degrees[i] = static_cast<c_size>(structure.getBondedAtom(i).bonds.size());
+        if (degrees[i] <= 1)
+            leaves.emplace_back(i);
+    }
 
-            decodedCycle.emplace_back(&owningStructure.getBondedAtom(edge.getIdxB()));
-            utils::swapAndPop(unboundEdges, i);
-            i = 0;
-            continue;
-        }
-        if (edge.getIdxB() == decodedCycle.back()->index) {
-            if (edge.getIdxA() == decodedCycle.front()->index)
-                return true;  // Cycle end
+    while (leaves.size()) {
+        const auto leaf = leaves.back();
+        leaves.pop_back();
+        degrees[leaf] = 0;
 
-            decodedCycle.emplace_back(&owningStructure.getBondedAtom(edge.getIdxA()));
-            utils::swapAndPop(unboundEdges, i);
-            i = 0;
+        for (const auto& b : structure.getBondedAtom(leaf).bonds)
+            if (const auto other = b.getOther().index; degrees[other] > 1 && --degrees[other] == 1)
+                leaves.emplace_back(other);
+    }
+
+    std::vector<c_size> localIndices(atomCount, MolecularStructure::npos);
+    for (c_size i = 0; i < atomCount; ++i) {
+        if (degrees[i] == 0)
             continue;
-        }
 
-        ++i;
+        localIndices[i] = static_cast<c_size>(coreAtoms.size());
+        coreAtoms.emplace_back(i);
     }
 
-    return false;
+    adjacencyOffsets.reserve(coreAtoms.size() + 1);
+    for (const auto atomIdx : coreAtoms) {
+        adjacencyOffsets.emplace_back(static_cast<c_size>(adjacentAtoms.size()));
+        for (const auto& b : structure.getBondedAtom(atomIdx).bonds)
+            if (const auto other = localIndices[b.getOther().index]; other != MolecularStructure::npos)
+                adjacentAtoms.emplace_back(other);
+    }
+    adjacencyOffsets.emplace_back(static_cast<c_size>(adjacentAtoms.size()));
+
+    // Both directions of an edge share the same id.
+    adjacentEdges.resize(adjacentAtoms.size());
+    for (c_size x = 0; x < coreAtoms.size(); ++x) {
+        for (auto i = adjacencyOffsets[x]; i < adjacencyOffsets[x + 1]; ++i) {
+            const auto y = adjacentAtoms[i];
+            if (x < y) {
+                adjacentEdges[i] = edgeCount++;
+                continue;
+            }
+
+            for (auto j = adjacencyOffsets[y]; j < adjacencyOffsets[y + 1]; ++j)
+                if (adjacentAtoms[j] == x)
+                    adjacentEdges[i] = adjacentEdges[j];
+        }
+    }
 }
 
-bool CycleDecoder::add(const Edge edge)
+std::vector<c_size> MinimalCycleBasisFinder::findRoots() const
 {
-    if (decodedCycle.empty()) {
-        // First edge
-        decodedCycle.emplace_back(&owningStructure.getBondedAtom(edge.getIdxA()));
-        decodedCycle.emplace_back(&owningStructure.getBondedAtom(edge.getIdxB()));
-        return false;
+    // Every cycle must pass through a root, so the atoms which aren't roots must form a forest. Atoms are added to
+    // the forest greedily, starting with the ones with 2 neighbors, and become roots if they would close a cycle.
+    const auto          atomCount = static_cast<c_size>(coreAtoms.size());
+    std::vector<c_size> components(atomCount, MolecularStructure::npos);
+    const auto          findComponent = [&](c_size idx) {
+        while (components[idx] != idx)
+            idx = components[idx] = components[components[idx]];
+        return idx;
+    };
+
+    std::vector<c_size> roots;
+    std::vector<c_size> neighborComponents;
+    const auto          tryAdd = [&](const c_size idx) {
+        neighborComponents.clear();
+        for (auto i = adjacencyOffsets[idx]; i < adjacencyOffsets[idx + 1]; ++i)
+            if (components[adjacentAtoms[i]] != MolecularStructure::npos)
+                neighborComponents.emplace_back(findComponent(adjacentAtoms[i]));
+
+        // Two neighbors in the same tree would close a cycle.
+        std::sort(neighborComponents.begin(), neighborComponents.end());
+        if (std::adjacent_find(neighborComponents.begin(), neighborComponents.end()) != neighborComponents.end()) {
+            roots.emplace_back(idx);
+            return;
+        }
+
+        components[idx] = idx;
+        for (const auto component : neighborComponents)
+            components[component] = idx;
+    };
+
+    for (c_size i = 0; i < atomCount; ++i)
+        if (adjacencyOffsets[i + 1] - adjacencyOffsets[i] == 2)
+            tryAdd(i);
+    for (c_size i = 0; i < atomCount; ++i)
+        if (adjacencyOffsets[i + 1] - adjacencyOffsets[i] > 2)
+            tryAdd(i);
+
+    return roots;
+}
+
+void MinimalCycleBasisFinder::addShortestPathTree(const c_size root)
+{
+    const auto atomCount = static_cast<c_size>(coreAtoms.size());
+    const auto treeIdx   = static_cast<c_size>(parents.size() / atomCount);
+    const auto rowOffset = static_cast<size_t>(treeIdx) * atomCount;
+    parents.resize(rowOffset + atomCount, MolecularStructure::npos);
+    parentEdges.resize(rowOffset + atomCount, MolecularStructure::npos);
+
+    const auto treeParents     = parents.begin() + rowOffset;
+    const auto treeParentEdges = parentEdges.begin() + rowOffset;
+
+    // The branch of an atom is the child of the root through which the atom is reached.
+    distances.assign(atomCount, MolecularStructure::npos);
+    branches.assign(atomCount, MolecularStructure::npos);
+    queue.clear();
+
+    distances[root]   = 0;
+    treeParents[root] = root;
+    queue.emplace_back(root);
+    for (c_size q = 0; q < queue.size(); ++q) {
+        const auto x = queue[q];
+        for (auto i = adjacencyOffsets[x]; i < adjacencyOffsets[x + 1]; ++i) {
+            const auto y = adjacentAtoms[i];
+            if (distances[y] != MolecularStructure::npos)
+                continue;
+
+            distances[y]       = distances[x] + 1;
+            branches[y]        = x == root ? y : branches[x];
+            treeParents[y]     = x;
+            treeParentEdges[y] = adjacentEdges[i];
+            queue.emplace_back(y);
+        }
     }
 
-    // Add continuous edge at the end
-    if (edge.getIdxA() == decodedCycle.back()->index) {
-        if (edge.getIdxB() == decodedCycle.front()->index)
-            return true;  // Cycle end
+    // Every non-tree edge closes a candidate, unless the two tree paths overlap.
+    for (c_size x = 0; x < atomCount; ++x) {
+        for (auto i = adjacencyOffsets[x]; i < adjacencyOffsets[x + 1]; ++i) {
+            const auto y    = adjacentAtoms[i];
+            const auto edge = adjacentEdges[i];
+            if (x > y || treeParentEdges[x] == edge || treeParentEdges[y] == edge || branches[x] == branches[y])
+                continue;
 
-        return add(edge.getIdxB());
+            candidates.emplace_back(distances[x] + distances[y] + 1, treeIdx, x, y, edge);
+        }
     }
-    if (edge.getIdxB() == decodedCycle.back()->index) {
-        if (edge.getIdxA() == decodedCycle.front()->index)
-            return true;  // Cycle end
+}
 
-        return add(edge.getIdxA());
+void MinimalCycleBasisFinder::encode(const Candidate& candidate, uint64_t* result, const c_size wordCount) const
+{
+    const auto rowOffset       = static_cast<size_t>(candidate.treeIdx) * coreAtoms.size();
+    const auto treeParents     = parents.begin() + rowOffset;
+    const auto treeParentEdges = parentEdges.begin() + rowOffset;
+
+    const auto set = [result](const c_size edgeId) { result[edgeId / WordBits] |= uint64_t(1) << (edgeId % WordBits); };
+
+    std::fill(result, result + wordCount, 0);
+    set(candidate.edgeId);
+    for (auto i = candidate.idxX; treeParents[i] != i; i = treeParents[i])
+        set(treeParentEdges[i]);
+    for (auto i = candidate.idxY; treeParents[i] != i; i = treeParents[i])
+        set(treeParentEdges[i]);
+}
+
+MolecularStructure::Cycle MinimalCycleBasisFinder::decode(const Candidate& candidate) const
+{
+    const auto treeParents = parents.begin() + static_cast<size_t>(candidate.treeIdx) * coreAtoms.size();
+
+    // root->...->x, followed by y->...->(child of root).
+    MolecularStructure::Cycle cycle;
+    cycle.reserve(candidate.length);
+    for (auto i = candidate.idxX;; i = treeParents[i]) {
+        cycle.emplace_back(&structure.getBondedAtom(coreAtoms[i]));
+        if (treeParents[i] == i)
+            break;
     }
+    std::reverse(cycle.begin(), cycle.end());
+
+    for (auto i = candidate.idxY; treeParents[i] != i; i = treeParents[i])
+        cycle.emplace_back(&structure.getBondedAtom(coreAtoms[i]));
 
-    unboundEdges.emplace_back(edge);
-    return false;
+    return cycle;
 }
 
-MolecularStructure::Cycle& CycleDecoder::getDecodedCycle() { return decodedCycle; }
+std::vector<MolecularStructure::Cycle> MinimalCycleBasisFinder::find(const c_size cycleCount)
+{
+    buildCore();
+    queue.reserve(coreAtoms.size());
+
+    // A minimum basis can be assembled from the candidates of any set of roots which intersects every cycle.
+    const auto roots = findRoots();
+    candidates.reserve(roots.size() * cycleCount);
+    for (const auto root : roots)
+        addShortestPathTree(root);
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.length, lhs.treeIdx, lhs.idxX, lhs.idxY) <
+               std::tie(rhs.length, rhs.treeIdx, rhs.idxX, rhs.idxY);
+    });
+
+    // Each kept cycle is stored reduced by all the previous ones, with its first set edge as pivot. Reducing a new
+    // candidate in insertion order clears all the pivots, so it is independent iff something is left.
+    const auto            wordCount = (edgeCount + WordBits - 1) / WordBits;
+    std::vector<uint64_t> reducedBasis(static_cast<size_t>(cycleCount + 1) * wordCount);
+    std::vector<c_size>   pivots;
+    pivots.reserve(cycleCount);
+
+    std::vector<MolecularStructure::Cycle> result;
+    result.reserve(cycleCount);
+
+    for (const auto& candidate : candidates) {
+        // Candidates are encoded directly in the next free row.
+        auto* const encodedCycle = reducedBasis.data() + pivots.size() * wordCount;
+        encode(candidate, encodedCycle, wordCount);
+
+        for (c_size i = 0; i < pivots.size(); ++i) {
+            if ((encodedCycle[pivots[i] / WordBits] >> (pivots[i] % WordBits) & 1) == 0)
+                continue;
+
+            const auto* const row = reducedBasis.data() + i * wordCount;
+            for (c_size w = 0; w < wordCount; ++w)
+                encodedCycle[w] ^= row[w];
+        }
+
+        const auto pivotWord = std::find_if(encodedCycle, encodedCycle + wordCount, [](const auto w) { return w != 0; });
+        if (pivotWord == encodedCycle + wordCount)
+            continue;
+
+        pivots.emplace_back(
+            static_cast<c_size>((pivotWord - encodedCycle) * WordBits + std::countr_zero(*pivotWord)));
+        result.emplace_back(decode(candidate));
+        if (result.size() == cycleCount)
+            break;
+    }
+
+    return result;
+}
 
 }  // namespace
 
@@ -1821,107 +2424,28 @@ std::vector<MolecularStructure::Cycle> MolecularStructure::getFundamentalCycleBa
 
 std::vector<MolecularStructure::Cycle> MolecularStructure::getMinimalCycleBasis() const
 {
-    auto fundamentalCycles = getFundamentalCycleBasis();
-    if (fundamentalCycles.empty())
+    const auto cycleCount = getCycleCount();
+    if (cycleCount == 0 || atoms.empty())
         return std::vector<Cycle>();
 
-    std::sort(fundamentalCycles.begin(), fundamentalCycles.end(), [](const auto& lhs, const auto& rhs) {
-        return lhs.size() < rhs.size();
-    });
+    auto result = MinimalCycleBasisFinder(*this).find(cycleCount);
+    if (result.size() != cycleCount)
+        Log(this).fatal("Found {} independent cycles instead of {}.", result.size(), cycleCount);
 
-    // Assign an index to each unique edge.
-    std::unordered_map<Edge, c_size> edgeLabels;
-    std::vector<Edge>                uniqueEdges;
-    // Skip some initial reallocations, smallest number of edges in a cycle is 3.
-    edgeLabels.reserve(fundamentalCycles.size() * 3);
-    uniqueEdges.reserve(fundamentalCycles.size() * 3);
-
-    for (const auto& cycle : fundamentalCycles) {
-        {
-            const Edge edge(cycle.front()->index, cycle.back()->index);
-            if (not edgeLabels.contains(edge)) {
-                const auto newLabel = static_cast<c_size>(edgeLabels.size());
-                edgeLabels.emplace(edge, newLabel);
-                uniqueEdges.emplace_back(edge);
-            }
-        }
-        for (size_t i = 0; i < cycle.size() - 1; ++i) {
-            const Edge edge(cycle[i]->index, cycle[i + 1]->index);
-            if (edgeLabels.contains(edge))
-                continue;
-
-            const auto newLabel = static_cast<c_size>(edgeLabels.size());
-            edgeLabels.emplace(edge, newLabel);
-            uniqueEdges.emplace_back(edge);
-        }
-    }
-
-    std::vector<Cycle> result;
-    result.reserve(fundamentalCycles.size());
-
-    // Encode each cycle C as a bitset B where B[i] = 1 if the cycle contains the i-th unique bond,
-    // then XOR it with all the previous cycles (which are smaller because of sorting) resulting in
-    // an fully independent cycle.
-    std::vector<boost::dynamic_bitset<uint32_t>> basis;
-    basis.reserve(fundamentalCycles.size());
-
-    for (const auto& cycle : fundamentalCycles) {
-        boost::dynamic_bitset<uint32_t> encodedCycle(uniqueEdges.size());
-
-        {
-            const auto edgeIdx = edgeLabels.find(Edge(cycle.front()->index, cycle.back()->index))->second;
-            encodedCycle.set(edgeIdx);
-        }
-        for (size_t i = 0; i < cycle.size() - 1; ++i) {
-            const auto edgeIdx = edgeLabels.find(Edge(cycle[i]->index, cycle[i + 1]->index))->second;
-            encodedCycle.set(edgeIdx);
-        }
-
-        for (size_t i = 0; i < basis.size(); ++i) {
-            auto xorCycle = encodedCycle ^ basis[i];
-
-            // Even if the XOR'd cycle has the same size as the initial cycle, the XOR'd one,
-            // unless equal, should be more independent towards previous cycles in the basis.
-            if (xorCycle.count() > encodedCycle.count() || xorCycle == encodedCycle)
-                continue;
-
-            encodedCycle = std::move(xorCycle);
-
-            // Loopback to ensure complete reduction. This is needed in very niche cases like:
-            // "C2CC1CC3C1C7C2CCC6CC4CC5CC3C45C67", there might be better solutions.
-            for (size_t j = 0; j < i; ++j) {
-                xorCycle = encodedCycle ^ basis[j];
-                if (xorCycle.count() > encodedCycle.count())
-                    continue;
-
-                encodedCycle = std::move(xorCycle);
-            }
-        }
-
-        if (encodedCycle.none())  // The fundamental and minimal cycle bases should always have the
-                                  // same number of cycles.
-            Log(this).fatal("Received a fully dependent cycle as a fundamental cycle.");
-
-        basis.emplace_back(std::move(encodedCycle));
-    }
-
-    // Decode the cycles.
-    for (const auto& cycle : basis) {
-        CycleDecoder decoder(*this);
-        for (size_t i = 0; i < cycle.size(); ++i) {
-            if (not cycle.test(i))
-                continue;
-            if (decoder.add(uniqueEdges[i]))
-                break;  // Cycle was closed.
-        }
+    return result;
+}
 
-        result.emplace_back(std::move(decoder.getDecodedCycle()));
-    }
+const RingInfo& MolecularStructure::getRingInfo() const
+{
+    if (const auto info = ringInfo.get())
+        return *info;
 
-    return result;
+    // The cycle basis isn't defined for empty structures.
+    auto rings = atoms.empty() ? std::vector<Cycle>() : getMinimalCycleBasis();
+    return ringInfo.set(std::make_unique<const RingInfo>(std::move(rings), static_cast<c_size>(atoms.size())));
 }
 
-ColoredTextBlock MolecularStructure::toASCII(const ASCII::PrintOptions options) const
+ColoredTextBlock MolecularStructure::toASCII(const ASCII::PrintOptions options, const ASCII::LayoutBudget& budget) const
 {
     if (isVirtualHydrogen())
         return ColoredTextBlock(ColoredString("H2", OS::BasicColor::GREY));
@@ -1944,7 +2468,7 @@ ColoredTextBlock MolecularStructure::toASCII(const ASCII::PrintOptions options)
         { Symbol("I"), OS::BasicColor::DARK_MAGENTA},
     };
 
-    auto cycles = utils::transform<ASCII::Cycle>(getMinimalCycleBasis());
+    auto cycles = utils::transform<ASCII::Cycle>(getRingInfo().getRings());
 
     // Populate nodes.
     std::vector<ASCII::Node> nodes;
@@ -1988,7 +2512,7 @@ ColoredTextBlock MolecularStructure::toASCII(const ASCII::PrintOptions options)
         }
     }
 
-    ASCII::StructurePrinter printer(std::move(nodes), std::move(cycles), std::move(edges), options);
+    ASCII::StructurePrinter printer(std::move(nodes), std::move(cycles), std::move(edges), options, budget);
     printer.print();
     return std::move(printer.getBlock());
 }
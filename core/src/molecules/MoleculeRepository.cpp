@@ -7,13 +7,93 @@
 #include "estimators/kinds/SplineEstimator.hpp"
 #include "estimators/kinds/UnitizedEstimator.hpp"
 #include "io/Log.hpp"
+#include "utils/Memory.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <mutex>
+
+//
+// Partition
+//
+
+const MoleculeData*
+MoleculeRepository::Partition::findConcrete(const MolecularStructure& structure, const size_t hash) const
+{
+    const auto [begin, end] = concreteIndex.equal_range(hash);
+    for (auto it = begin; it != end; ++it)
+        if (it->second->getStructure() == structure)
+            return it->second;
+
+    return nullptr;
+}
+
+const GenericMoleculeData*
+MoleculeRepository::Partition::findGeneric(const MolecularStructure& structure, const size_t hash) const
+{
+    const auto [begin, end] = genericIndex.equal_range(hash);
+    for (auto it = begin; it != end; ++it)
+        if (it->second->getStructure() == structure)
+            return it->second;
+
+    return nullptr;
+}
+
+const MoleculeData&
+MoleculeRepository::Partition::addConcrete(std::unique_ptr<const MoleculeData>&& molecule, const size_t hash)
+{
+    const auto& result = *concreteMolecules.emplace(molecule->id, std::move(molecule)).first->second;
+    concreteIndex.emplace(hash, &result);
+    return result;
+}
+
+const GenericMoleculeData&
+MoleculeRepository::Partition::addGeneric(std::unique_ptr<const GenericMoleculeData>&& molecule, const size_t hash)
+{
+    const auto& result = *genericMolecules.emplace(molecule->id, std::move(molecule)).first->second;
+    genericIndex.emplace(hash, &result);
+    return result;
+}
+
+size_t MoleculeRepository::Partition::getMemoryUsage() const
+{
+    auto usage = utils::getHeapUsage(concreteMolecules) +
+                 utils::getHeapUsage(genericMolecules) +
+                 utils::getHeapUsage(concreteIndex) +
+                 utils::getHeapUsage(genericIndex);
+    for (const auto& m : concreteMolecules)
+        usage += m.second->getMemoryUsage();
+    for (const auto& m : genericMolecules)
+        usage += m.second->getMemoryUsage();
+    return usage;
+}
+
+void MoleculeRepository::Partition::clear()
+{
+    concreteIndex.clear();
+    genericIndex.clear();
+    concreteMolecules.clear();
+    genericMolecules.clear();
+}
+
+//
+// MoleculeRepository
+//
 
 MoleculeRepository::MoleculeRepository(EstimatorRepository& estimators) noexcept :
     estimators(estimators)
 {}
 
+MoleculeRepository::MoleculeRepository(MoleculeRepository&& other) noexcept :
+    definitions(std::move(other.definitions)),
+    nextId(other.nextId.load()),
+    estimators(other.estimators),
+    layouts(std::move(other.layouts))
+{
+    for (size_t i = 0; i < ShardCount; ++i)
+        discovered[i].molecules = std::move(other.discovered[i].molecules);
+}
+
 bool MoleculeRepository::add(const def::Object& definition)
 {
     auto structure = def::Parser<MolecularStructure>::parse(definition.getSpecifier());
@@ -22,10 +102,20 @@ bool MoleculeRepository::add(const def::Object& definition)
             "Invalid SMILES specifier: '{}', at: {}.", definition.getSpecifier(), definition.getLocationName());
         return false;
     }
-    if (findFirstConcrete(*structure) != nullptr) {
+    const auto hash = structure->getInvariantHash();
+    if (definitions.findConcrete(*structure, hash) != nullptr) {
         Log(this).warn("Already defined molecule: '{}' skipped.", definition.getSpecifier());
         return false;
     }
+    // Discovered molecules might already be referenced by their id, so they can't be redefined.
+    {
+        const auto&       shard = getShard(hash);
+        std::shared_lock lock(shard.mutex);
+        if (shard.molecules.findConcrete(*structure, hash) != nullptr) {
+            Log(this).warn("Already discovered molecule: '{}' skipped.", definition.getSpecifier());
+            return false;
+        }
+    }
 
     const auto name = definition.getDefaultProperty(def::Molecules::Name, "?");
     const auto hp =
@@ -75,8 +165,7 @@ bool MoleculeRepository::add(const def::Object& definition)
         estimators);
 
     const auto id = getFreeId();
-    concreteMolecules.emplace(
-        id,
+    definitions.addConcrete(
         std::make_unique<MoleculeData>(
             id,
             name,
@@ -94,48 +183,92 @@ bool MoleculeRepository::add(const def::Object& definition)
             std::move(*vlh),
             std::move(*slh),
             std::move(*sol),
-            std::move(*hen)));
+            std::move(*hen)),
+        hash);
 
     definition.logUnusedWarnings();
     return true;
 }
 
-bool MoleculeRepository::contains(const MoleculeId id) const { return concreteMolecules.contains(id); }
+bool MoleculeRepository::contains(const MoleculeId id) const
+{
+    if (definitions.concreteMolecules.contains(id))
+        return true;
 
-const MoleculeData& MoleculeRepository::at(const MoleculeId id) const { return *concreteMolecules.at(id); }
+    return std::ranges::any_of(discovered, [id](const auto& shard) {
+        std::shared_lock lock(shard.mutex);
+        return shard.molecules.concreteMolecules.contains(id);
+    });
+}
 
-size_t MoleculeRepository::totalDefinitionCount() const { return concreteMolecules.size() + genericMolecules.size(); }
+const MoleculeData& MoleculeRepository::at(const MoleculeId id) const
+{
+    if (const auto it = definitions.concreteMolecules.find(id); it != definitions.concreteMolecules.end())
+        return *it->second;
+
+    for (const auto& shard : discovered) {
+        std::shared_lock lock(shard.mutex);
+        if (const auto it = shard.molecules.concreteMolecules.find(id); it != shard.molecules.concreteMolecules.end())
+            return *it->second;
+    }
+
+    Log(this).fatal("Undefined molecule id: {}.", id);
+}
+
+size_t MoleculeRepository::totalDefinitionCount() const
+{
+    auto count = definitions.concreteMolecules.size() + definitions.genericMolecules.size();
+    for (const auto& shard : discovered) {
+        std::shared_lock lock(shard.mutex);
+        count += shard.molecules.concreteMolecules.size() + shard.molecules.genericMolecules.size();
+    }
+    return count;
+}
 
 const MoleculeData* MoleculeRepository::findFirstConcrete(const MolecularStructure& structure) const
 {
-    for (const auto& m : concreteMolecules)
-        if (m.second->getStructure() == structure)
-            return m.second.get();
+    const auto hash = structure.getInvariantHash();
+    if (const auto existing = definitions.findConcrete(structure, hash))
+        return existing;
 
-    return nullptr;
+    const auto&       shard = getShard(hash);
+    std::shared_lock lock(shard.mutex);
+    return shard.molecules.findConcrete(structure, hash);
 }
 
 const GenericMoleculeData* MoleculeRepository::findFirstGeneric(const MolecularStructure& structure) const
 {
-    for (const auto& m : genericMolecules)
-        if (m.second->getStructure() == structure)
-            return m.second.get();
+    const auto hash = structure.getInvariantHash();
+    if (const auto existing = definitions.findGeneric(structure, hash))
+        return existing;
 
-    return nullptr;
+    const auto&       shard = getShard(hash);
+    std::shared_lock lock(shard.mutex);
+    return shard.molecules.findGeneric(structure, hash);
 }
 
-const MoleculeData& MoleculeRepository::findOrAddConcrete(MolecularStructure&& structure)
+const MoleculeData& MoleculeRepository::findOrAddConcrete(MolecularStructure&& structure) const
 {
     if (structure.isEmpty())
         Log(this).fatal("Tried to create a concrete molecule from an empty structure.");
     if (structure.isGeneric())
         Log(this).fatal("Tried to create a concrete molecule from a generic structure.");
 
-    const auto existing = findFirstConcrete(structure);
-    if (existing != nullptr)
+    const auto hash = structure.getInvariantHash();
+    if (const auto existing = definitions.findConcrete(structure, hash))
         return *existing;
 
-    Log(this).debug("New structure discovered: \n{}", CHG_DELAYED_EVAL(structure.toASCII().toString().toString()));
+    auto& shard = getShard(hash);
+    {
+        std::shared_lock lock(shard.mutex);
+        if (const auto existing = shard.molecules.findConcrete(structure, hash))
+            return *existing;
+    }
+
+    // Another thread might have added the same structure between the two locks.
+    std::unique_lock lock(shard.mutex);
+    if (const auto existing = shard.molecules.findConcrete(structure, hash))
+        return *existing;
 
     const auto hydro = 1.0f;
     const auto lipo  = 0.0f;
@@ -153,9 +286,8 @@ const MoleculeData& MoleculeRepository::findOrAddConcrete(MolecularStructure&& s
     auto sol = estimators.add<ConstantEstimator<Unit::NONE, Unit::CELSIUS>>(1.0f);
     auto hen = estimators.add<ConstantEstimator<Unit::TORR_MOLE_RATIO, Unit::CELSIUS>>(1000.0f);
 
-    const auto id = getFreeId();
-    const auto it = concreteMolecules.emplace(
-        id,
+    const auto  id       = getFreeId();
+    const auto& molecule = shard.molecules.addConcrete(
         std::make_unique<MoleculeData>(
             id,
             structure.toSMILES(),
@@ -173,46 +305,143 @@ const MoleculeData& MoleculeRepository::findOrAddConcrete(MolecularStructure&& s
             std::move(vlh),
             std::move(slh),
             std::move(sol),
-            std::move(hen)));
+            std::move(hen)),
+        hash);
 
-    return *it.first->second;
+    // Rendered after insertion, so that the rendering is cached.
+    Log(this).debug(
+        "New structure discovered: \n{}",
+        CHG_DELAYED_EVAL(molecule.toASCII(ASCII::PrintOptions::Default, layouts).toString().toString()));
+    return molecule;
 }
 
-const GenericMoleculeData& MoleculeRepository::findOrAdd(MolecularStructure&& structure)
+const GenericMoleculeData& MoleculeRepository::findOrAdd(MolecularStructure&& structure) const
 {
     if (structure.isEmpty())
         Log(this).fatal("Tried to create a concrete molecule from an empty structure.");
     if (structure.isConcrete())
         return findOrAddConcrete(std::move(structure));
 
-    const auto existing = findFirstGeneric(structure);
-    if (existing != nullptr)
+    const auto hash = structure.getInvariantHash();
+    if (const auto existing = definitions.findGeneric(structure, hash))
+        return *existing;
+
+    auto& shard = getShard(hash);
+    {
+        std::shared_lock lock(shard.mutex);
+        if (const auto existing = shard.molecules.findGeneric(structure, hash))
+            return *existing;
+    }
+
+    std::unique_lock lock(shard.mutex);
+    if (const auto existing = shard.molecules.findGeneric(structure, hash))
         return *existing;
 
     const auto id = getFreeId();
-    const auto it = genericMolecules.emplace(id, std::make_unique<GenericMoleculeData>(id, std::move(structure)));
-    return *it.first->second;
+    return shard.molecules.addGeneric(std::make_unique<GenericMoleculeData>(id, std::move(structure)), hash);
 }
 
-MoleculeRepository::Iterator MoleculeRepository::begin() const { return concreteMolecules.begin(); }
+const ASCIILayoutStore& MoleculeRepository::getLayoutStore() const { return layouts; }
+
+ASCIILayoutStore& MoleculeRepository::getLayoutStore() { return layouts; }
 
-MoleculeRepository::Iterator MoleculeRepository::end() const { return concreteMolecules.end(); }
+MoleculeRepository::Iterator MoleculeRepository::begin() const { return Iterator(*this, 0); }
+
+MoleculeRepository::Iterator MoleculeRepository::end() const { return Iterator(*this, ShardCount + 1); }
+
+size_t MoleculeRepository::size() const
+{
+    auto count = definitions.concreteMolecules.size();
+    for (const auto& shard : discovered) {
+        std::shared_lock lock(shard.mutex);
+        count += shard.molecules.concreteMolecules.size();
+    }
+    return count;
+}
 
-size_t MoleculeRepository::size() const { return concreteMolecules.size(); }
+size_t MoleculeRepository::getMemoryUsage() const
+{
+    auto usage = sizeof(*this) + definitions.getMemoryUsage() + layouts.getMemoryUsage();
+    for (const auto& shard : discovered) {
+        std::shared_lock lock(shard.mutex);
+        usage += shard.molecules.getMemoryUsage();
+    }
+    return usage;
+}
 
 void MoleculeRepository::clear()
 {
-    concreteMolecules.clear();
-    genericMolecules.clear();
+    for (auto& shard : discovered) {
+        std::unique_lock lock(shard.mutex);
+        shard.molecules.clear();
+    }
+    definitions.clear();
+    nextId = 0;
 }
 
 MoleculeId MoleculeRepository::getFreeId() const
 {
-    static MoleculeId id = 0;
-    while (concreteMolecules.contains(id) || genericMolecules.contains(id)) {
-        if (id == std::numeric_limits<MoleculeId>::max())
-            Log(this).fatal("Molecule id limit reached: {}.", id);
-        ++id;
-    }
+    const auto id = nextId++;
+    if (id == std::numeric_limits<MoleculeId>::max())
+        Log(this).fatal("Molecule id limit reached: {}.", id);
     return id;
 }
+
+MoleculeRepository::Shard& MoleculeRepository::getShard(const size_t hash) const
+{
+    return discovered[hash % ShardCount];
+}
+
+const MoleculeRepository::Partition& MoleculeRepository::getPartition(const size_t idx) const
+{
+    return idx == 0 ? definitions : discovered[idx - 1].molecules;
+}
+
+//
+// Iterator
+//
+
+MoleculeRepository::Iterator::Iterator(const MoleculeRepository& repository, const size_t partitionIdx) noexcept :
+    repository(&repository),
+    partitionIdx(partitionIdx)
+{
+    if (partitionIdx > ShardCount)
+        return;
+
+    it = repository.getPartition(partitionIdx).concreteMolecules.begin();
+    skipEmptyPartitions();
+}
+
+void MoleculeRepository::Iterator::skipEmptyPartitions()
+{
+    while (it == repository->getPartition(partitionIdx).concreteMolecules.end()) {
+        if (++partitionIdx > ShardCount) {
+            it = {};
+            return;
+        }
+        it = repository->getPartition(partitionIdx).concreteMolecules.begin();
+    }
+}
+
+MoleculeRepository::Iterator::reference MoleculeRepository::Iterator::operator*() const { return *it; }
+
+MoleculeRepository::Iterator::pointer MoleculeRepository::Iterator::operator->() const { return &*it; }
+
+MoleculeRepository::Iterator& MoleculeRepository::Iterator::operator++()
+{
+    ++it;
+    skipEmptyPartitions();
+    return *this;
+}
+
+MoleculeRepository::Iterator MoleculeRepository::Iterator::operator++(int)
+{
+    auto temp = *this;
+    ++*this;
+    return temp;
+}
+
+bool MoleculeRepository::Iterator::operator==(const Iterator& other) const
+{
+    return repository == other.repository && partitionIdx == other.partitionIdx && it == other.it;
+}
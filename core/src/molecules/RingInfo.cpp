@@ -0,0 +1,86 @@
+#include "molecules/RingInfo.hpp"
+
+#include "utils/Memory.hpp"
+
+#include <algorithm>
+
+//
+// RingInfo
+//
+
+RingInfo::RingInfo(std::vector<Ring>&& rings, const c_size atomCount) noexcept :
+    rings(std::move(rings)),
+    wordsPerAtom(static_cast<c_size>((this->rings.size() + WordBits - 1) / WordBits)),
+    membership(static_cast<size_t>(atomCount) * wordsPerAtom, 0)
+{
+    for (c_size r = 0; r < this->rings.size(); ++r)
+        for (const auto atom : this->rings[r])
+            membership[atom->index * wordsPerAtom + r / WordBits] |= uint64_t(1) << (r % WordBits);
+}
+
+const std::vector<RingInfo::Ring>& RingInfo::getRings() const { return rings; }
+
+c_size RingInfo::getRingCount() const { return static_cast<c_size>(rings.size()); }
+
+bool RingInfo::isRingAtom(const c_size atomIdx) const
+{
+    const auto begin = membership.begin() + atomIdx * wordsPerAtom;
+    return std::any_of(begin, begin + wordsPerAtom, [](const auto w) { return w != 0; });
+}
+
+bool RingInfo::isInRing(const c_size atomIdx, const c_size ringIdx) const
+{
+    return membership[atomIdx * wordsPerAtom + ringIdx / WordBits] & (uint64_t(1) << (ringIdx % WordBits));
+}
+
+bool RingInfo::isRingBond(const c_size idxA, const c_size idxB) const
+{
+    const auto* wordsA = membership.data() + idxA * wordsPerAtom;
+    const auto* wordsB = membership.data() + idxB * wordsPerAtom;
+    for (c_size i = 0; i < wordsPerAtom; ++i)
+        if (wordsA[i] & wordsB[i])
+            return true;
+
+    return false;
+}
+
+size_t RingInfo::getHeapUsage() const
+{
+    auto usage = utils::getHeapUsage(rings) + utils::getHeapUsage(membership);
+    for (const auto& r : rings)
+        usage += utils::getHeapUsage(r);
+    return usage;
+}
+
+//
+// RingInfoCache
+//
+
+RingInfoCache::RingInfoCache(const RingInfoCache&) noexcept {}
+
+RingInfoCache::RingInfoCache(RingInfoCache&& other) noexcept :
+    info(other.info.exchange(nullptr))
+{}
+
+RingInfoCache::~RingInfoCache() noexcept { reset(); }
+
+RingInfoCache& RingInfoCache::operator=(RingInfoCache&& other) noexcept
+{
+    if (this != &other)
+        delete info.exchange(other.info.exchange(nullptr));
+    return *this;
+}
+
+const RingInfo* RingInfoCache::get() const { return info.load(std::memory_order_acquire); }
+
+const RingInfo& RingInfoCache::set(std::unique_ptr<const RingInfo>&& value)
+{
+    const RingInfo* expected = nullptr;
+    if (info.compare_exchange_strong(expected, value.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+        return *value.release();
+
+    // Another thread cached its value first.
+    return *expected;
+}
+
+void RingInfoCache::reset() { delete info.exchange(nullptr); }
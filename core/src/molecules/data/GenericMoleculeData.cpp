@@ -8,3 +8,25 @@ GenericMoleculeData::GenericMoleculeData(const MoleculeId id, MolecularStructure
 {}
 
 const MolecularStructure& GenericMoleculeData::getStructure() const { return structure; }
+
+const ColoredTextBlock& GenericMoleculeData::toASCII(const ASCII::PrintOptions options) const
+{
+    if (const auto cached = ascii.get(options))
+        return *cached;
+
+    return ascii.set(options, structure.toASCII(options));
+}
+
+const ColoredTextBlock&
+GenericMoleculeData::toASCII(const ASCII::PrintOptions options, const ASCIILayoutStore& layouts) const
+{
+    if (const auto cached = ascii.get(options))
+        return *cached;
+
+    return ascii.set(options, layouts.render(structure, options));
+}
+
+size_t GenericMoleculeData::getMemoryUsage() const
+{
+    return sizeof(*this) + structure.getHeapUsage() + ascii.getHeapUsage();
+}
@@ -2,6 +2,7 @@
 
 #include "data/def/DataDumper.hpp"
 #include "io/Log.hpp"
+#include "utils/Memory.hpp"
 
 MoleculeData::MoleculeData(
     const MoleculeId                                                id,
@@ -45,6 +46,11 @@ MoleculeData::MoleculeData(
 
 const MolecularStructure& MoleculeData::getStructure() const { return structure; }
 
+size_t MoleculeData::getMemoryUsage() const
+{
+    return sizeof(*this) + structure.getHeapUsage() + utils::getHeapUsage(name);
+}
+
 void MoleculeData::dumpDefinition(
     std::ostream& out, const bool prettify, std::unordered_set<EstimatorId>& alreadyPrinted) const
 {
@@ -24,6 +24,11 @@ const MoleculeData& Molecule::getData() const { return data; }
 
 const MolecularStructure& Molecule::getStructure() const { return data.getStructure(); }
 
+const ColoredTextBlock& Molecule::toASCII(const ASCII::PrintOptions options) const
+{
+    return data.toASCII(options, getDataStore().molecules.getLayoutStore());
+}
+
 Polarity Molecule::getPolarity() const { return data.polarity; }
 
 Color Molecule::getColor() const { return data.color; }
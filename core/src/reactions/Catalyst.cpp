@@ -11,12 +11,12 @@ const MolecularStructure& Catalyst::getStructure() const { return reactable.getS
 
 Amount<Unit::MOLE_RATIO> Catalyst::getIdealAmount() const { return idealAmount; }
 
-std::unordered_map<c_size, c_size> Catalyst::matchWith(const Catalyst& other) const
+AtomMap Catalyst::matchWith(const Catalyst& other) const
 {
     return reactable.matchWith(other.reactable);
 }
 
-std::unordered_map<c_size, c_size> Catalyst::matchWith(const MolecularStructure& structure) const
+AtomMap Catalyst::matchWith(const MolecularStructure& structure) const
 {
     return reactable.matchWith(structure);
 }
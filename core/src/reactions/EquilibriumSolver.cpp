@@ -0,0 +1,233 @@
+#include "reactions/EquilibriumSolver.hpp"
+
+#include "structs/SystemMatrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+float_h getNorm(const std::vector<float_h>& values)
+{
+    float_h result = 0.0;
+    for (const auto v : values)
+        result += v * v;
+    return std::sqrt(result);
+}
+
+}  // namespace
+
+EquilibriumSolver::EquilibriumSolver(const float_h relativeTolerance, const float_h absoluteTolerance) noexcept :
+    relativeTolerance(relativeTolerance),
+    absoluteTolerance(absoluteTolerance)
+{}
+
+size_t EquilibriumSolver::getReactionCount() const { return forwardRates.size(); }
+
+float_h EquilibriumSolver::getRelativeTolerance() const { return relativeTolerance; }
+
+float_h EquilibriumSolver::getAbsoluteTolerance() const { return absoluteTolerance; }
+
+size_t EquilibriumSolver::addSpecies(const float_h amount)
+{
+    initialAmounts.emplace_back(amount);
+    amounts.emplace_back(amount);
+    return amounts.size() - 1;
+}
+
+void EquilibriumSolver::addReaction(
+    std::vector<Term>&& reactants, std::vector<Term>&& products, RateFunction&& forwardRate, RateFunction&& backwardRate)
+{
+    for (const auto& [species, coefficient] : reactants) {
+        termSpecies.emplace_back(species);
+        termCoefficients.emplace_back(-coefficient);
+    }
+    for (const auto& [species, coefficient] : products) {
+        termSpecies.emplace_back(species);
+        termCoefficients.emplace_back(coefficient);
+    }
+
+    forwardRates.emplace_back(std::move(forwardRate));
+    backwardRates.emplace_back(std::move(backwardRate));
+    extents.emplace_back(0.0);
+    reactantCounts.emplace_back(reactants.size());
+    termOffsets.emplace_back(termSpecies.size());
+}
+
+float_h EquilibriumSolver::getAmount(const size_t speciesIdx) const { return amounts[speciesIdx]; }
+
+float_h EquilibriumSolver::getExtent(const size_t reactionIdx) const { return extents[reactionIdx]; }
+
+void EquilibriumSolver::getAmounts(const std::vector<float_h>& extents, std::vector<float_h>& result) const
+{
+    result = initialAmounts;
+    for (size_t i = 0; i < getReactionCount(); ++i)
+        for (size_t t = termOffsets[i]; t < termOffsets[i + 1]; ++t)
+            result[termSpecies[t]] += termCoefficients[t] * extents[i];
+}
+
+float_h EquilibriumSolver::getAvailability(
+    const std::vector<float_h>& state, const size_t termBegin, const size_t termEnd) const
+{
+    auto limit = std::numeric_limits<float_h>::max();
+    for (size_t t = termBegin; t < termEnd; ++t)
+        limit = std::min(limit, state[termSpecies[t]] / std::abs(termCoefficients[t]));
+
+    return limit > 0.0 ? limit / (limit + absoluteTolerance) : 0.0;
+}
+
+void EquilibriumSolver::getRates(
+    const std::vector<float_h>& state, const size_t reactionIdx, float_h& forward, float_h& backward) const
+{
+    const auto reactantBegin = termOffsets[reactionIdx];
+    const auto productBegin  = reactantBegin + reactantCounts[reactionIdx];
+    const auto productEnd    = termOffsets[reactionIdx + 1];
+
+    float_h reactantAmount = 0.0;
+    for (size_t t = reactantBegin; t < productBegin; ++t)
+        reactantAmount += state[termSpecies[t]];
+
+    float_h productAmount = 0.0;
+    for (size_t t = productBegin; t < productEnd; ++t)
+        productAmount += state[termSpecies[t]];
+
+    forward = std::max(forwardRates[reactionIdx](reactantAmount), 0.0) *
+              getAvailability(state, reactantBegin, productBegin);
+    backward = std::max(backwardRates[reactionIdx](productAmount), 0.0) *
+               getAvailability(state, productBegin, productEnd);
+}
+
+void EquilibriumSolver::getScales(const std::vector<float_h>& state, std::vector<float_h>& result) const
+{
+    result.resize(getReactionCount());
+    for (size_t i = 0; i < getReactionCount(); ++i) {
+        float_h forward, backward;
+        getRates(state, i, forward, backward);
+        result[i] = std::max(forward, backward);
+    }
+}
+
+void EquilibriumSolver::getResiduals(
+    const std::vector<float_h>& state, const std::vector<float_h>& scales, std::vector<float_h>& result) const
+{
+    result.resize(getReactionCount());
+    for (size_t i = 0; i < getReactionCount(); ++i) {
+        if (scales[i] == 0.0) {
+            result[i] = 0.0;
+            continue;
+        }
+
+        float_h forward, backward;
+        getRates(state, i, forward, backward);
+        result[i] = (forward - backward) / scales[i];
+    }
+}
+
+float_h EquilibriumSolver::getImbalance() const
+{
+    float_h result = 0.0;
+    for (size_t i = 0; i < getReactionCount(); ++i) {
+        float_h forward, backward;
+        getRates(amounts, i, forward, backward);
+        if (const auto scale = std::max(forward, backward); scale > 0.0)
+            result = std::max(result, std::abs(forward - backward) / scale);
+    }
+    return result;
+}
+
+bool EquilibriumSolver::solve()
+{
+    static constexpr size_t MaxIterationCount = 50;
+    static constexpr size_t MaxHalvingCount   = 30;
+
+    const auto reactionCount = getReactionCount();
+    if (reactionCount == 0)
+        return true;
+
+    std::vector<float_h> scales, residuals, trialResiduals, trialExtents, trialAmounts;
+    for (size_t iteration = 0; iteration < MaxIterationCount; ++iteration) {
+        // Residuals are relative to the gross rates at the start of the iteration, so that they remain
+        // comparable while searching for the step.
+        getScales(amounts, scales);
+        getResiduals(amounts, scales, residuals);
+        const auto norm = getNorm(residuals);
+        if (norm <= relativeTolerance)
+            return true;
+
+        // The Jacobian is computed by finite differences, perturbing each extent towards the direction in
+        // which more of the limiting species is available.
+        std::vector<std::vector<float_h>> jacobian(reactionCount, std::vector<float_h>(reactionCount, 0.0));
+        for (size_t j = 0; j < reactionCount; ++j) {
+            if (scales[j] == 0.0) {
+                jacobian[j][j] = 1.0;
+                continue;
+            }
+
+            float_h reactantLimit = std::numeric_limits<float_h>::max();
+            float_h productLimit  = std::numeric_limits<float_h>::max();
+            for (size_t t = termOffsets[j]; t < termOffsets[j + 1]; ++t) {
+                auto& limit = termCoefficients[t] < 0.0 ? reactantLimit : productLimit;
+                limit       = std::min(limit, amounts[termSpecies[t]] / std::abs(termCoefficients[t]));
+            }
+
+            const auto delta = std::copysign(
+                std::max(std::max(reactantLimit, productLimit) * 1e-6, 1e-12),
+                reactantLimit >= productLimit ? 1.0 : -1.0);
+
+            trialExtents     = extents;
+            trialExtents[j] += delta;
+            getAmounts(trialExtents, trialAmounts);
+            getResiduals(trialAmounts, scales, trialResiduals);
+            for (size_t i = 0; i < reactionCount; ++i)
+                if (scales[i] != 0.0)
+                    jacobian[i][j] = (trialResiduals[i] - residuals[i]) / delta;
+        }
+
+        SystemMatrix<float_h> system;
+        for (size_t i = 0; i < reactionCount; ++i)
+            system.addRow(std::move(jacobian[i]), -residuals[i]);
+
+        const auto step = system.solve();
+        if (step.size() != reactionCount)
+            return false;
+
+        // Steps are halved until the amounts remain non-negative and the residuals decrease.
+        bool    isAccepted = false;
+        float_h stepScale  = 1.0;
+        for (size_t h = 0; h < MaxHalvingCount && not isAccepted; ++h, stepScale *= 0.5) {
+            trialExtents.resize(reactionCount);
+            for (size_t j = 0; j < reactionCount; ++j)
+                trialExtents[j] = extents[j] + stepScale * step[j];
+
+            getAmounts(trialExtents, trialAmounts);
+            if (std::any_of(trialAmounts.begin(), trialAmounts.end(), [](const auto a) { return a < 0.0; }))
+                continue;
+
+            getResiduals(trialAmounts, scales, trialResiduals);
+            isAccepted = getNorm(trialResiduals) < norm;
+        }
+
+        if (not isAccepted)
+            return false;
+
+        extents.swap(trialExtents);
+        amounts.swap(trialAmounts);
+    }
+
+    return false;
+}
+
+void EquilibriumSolver::reset()
+{
+    initialAmounts.clear();
+    amounts.clear();
+    forwardRates.clear();
+    backwardRates.clear();
+    extents.clear();
+    termOffsets.assign(1, 0);
+    reactantCounts.clear();
+    termSpecies.clear();
+    termCoefficients.clear();
+}
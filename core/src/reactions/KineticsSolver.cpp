@@ -0,0 +1,425 @@
+#include "reactions/KineticsSolver.hpp"
+
+#include "io/Log.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+KineticsSolver::KineticsSolver(const float_h relativeTolerance, const float_h absoluteTolerance) noexcept :
+    relativeTolerance(relativeTolerance),
+    absoluteTolerance(absoluteTolerance)
+{}
+
+size_t KineticsSolver::getReactionCount() const { return rates.size(); }
+
+float_h KineticsSolver::getRelativeTolerance() const { return relativeTolerance; }
+
+float_h KineticsSolver::getAbsoluteTolerance() const { return absoluteTolerance; }
+
+size_t KineticsSolver::addSpecies(const float_h amount)
+{
+    stepMatrix.isOutdated = true;
+    amounts.emplace_back(amount);
+    return amounts.size() - 1;
+}
+
+void KineticsSolver::addReaction(std::vector<Term>&& reactants, std::vector<Term>&& products, RateFunction&& rate)
+{
+    stepMatrix.isOutdated = true;
+    for (const auto& [species, coefficient] : reactants) {
+        termSpecies.emplace_back(species);
+        termCoefficients.emplace_back(-coefficient);
+    }
+    for (const auto& [species, coefficient] : products) {
+        termSpecies.emplace_back(species);
+        termCoefficients.emplace_back(coefficient);
+    }
+
+    rates.emplace_back(std::move(rate));
+    extents.emplace_back(0.0);
+    reactantCounts.emplace_back(reactants.size());
+    termOffsets.emplace_back(termSpecies.size());
+}
+
+float_h KineticsSolver::getAmount(const size_t speciesIdx) const { return amounts[speciesIdx]; }
+
+float_h KineticsSolver::getExtent(const size_t reactionIdx) const { return extents[reactionIdx]; }
+
+void KineticsSolver::getReactantAmounts(
+    const std::vector<float_h>& state,
+    const size_t                reactionIdx,
+    float_h&                    total,
+    float_h&                    limit,
+    size_t&                     limitTerm) const
+{
+    total     = 0.0;
+    limit     = std::numeric_limits<float_h>::max();
+    limitTerm = termOffsets[reactionIdx];
+    for (size_t t = termOffsets[reactionIdx]; t < termOffsets[reactionIdx] + reactantCounts[reactionIdx]; ++t) {
+        const auto amount = state[termSpecies[t]];
+        total += amount;
+
+        // Coefficients of reactants are negative.
+        if (const auto available = amount / -termCoefficients[t]; available < limit) {
+            limit     = available;
+            limitTerm = t;
+        }
+    }
+}
+
+float_h KineticsSolver::getAvailability(const float_h limit) const
+{
+    return limit > 0.0 ? limit / (limit + absoluteTolerance) : 0.0;
+}
+
+void KineticsSolver::getRates(const std::vector<float_h>& state, std::vector<float_h>& result) const
+{
+    result.resize(getReactionCount());
+    for (size_t i = 0; i < getReactionCount(); ++i) {
+        float_h total, limit;
+        size_t  limitTerm;
+        getReactantAmounts(state, i, total, limit, limitTerm);
+
+        result[i] = std::max(rates[i](total), 0.0) * getAvailability(limit);
+    }
+}
+
+void KineticsSolver::getJacobian(const std::vector<float_h>& state, Jacobian& result) const
+{
+    result.derivatives.resize(getReactionCount());
+    result.limitDerivatives.resize(getReactionCount());
+    result.limitTerms.resize(getReactionCount());
+    for (size_t i = 0; i < getReactionCount(); ++i) {
+        float_h total, limit;
+        size_t  limitTerm;
+        getReactantAmounts(state, i, total, limit, limitTerm);
+        result.limitTerms[i] = limitTerm;
+
+        if (limit <= 0.0) {
+            result.derivatives[i]      = 0.0;
+            result.limitDerivatives[i] = 0.0;
+            continue;
+        }
+
+        // Rate laws are given by estimators, which can't be differentiated analytically.
+        const auto rate       = std::max(rates[i](total), 0.0);
+        const auto delta      = std::max(total * 1e-6, 1e-12);
+        result.derivatives[i] = (std::max(rates[i](total + delta), 0.0) - rate) / delta * getAvailability(limit);
+
+        const auto limitDenominator = limit + absoluteTolerance;
+        result.limitDerivatives[i] =
+            rate * absoluteTolerance / (limitDenominator * limitDenominator) / -termCoefficients[limitTerm];
+    }
+}
+
+void KineticsSolver::toSpecies(const std::vector<float_h>& reactionValues, std::vector<float_h>& result) const
+{
+    result.assign(amounts.size(), 0.0);
+    for (size_t i = 0; i < getReactionCount(); ++i)
+        for (size_t t = termOffsets[i]; t < termOffsets[i + 1]; ++t)
+            result[termSpecies[t]] += termCoefficients[t] * reactionValues[i];
+}
+
+void KineticsSolver::toReactions(
+    const std::vector<float_h>& base,
+    const float_h               scale,
+    const Jacobian&             jacobian,
+    const std::vector<float_h>& speciesValues,
+    std::vector<float_h>&       result) const
+{
+    result.resize(getReactionCount());
+    for (size_t i = 0; i < getReactionCount(); ++i) {
+        float_h sum = 0.0;
+        for (size_t t = termOffsets[i]; t < termOffsets[i] + reactantCounts[i]; ++t)
+            sum += speciesValues[termSpecies[t]];
+        result[i] = base[i] +
+                    scale * (jacobian.derivatives[i] * sum +
+                             jacobian.limitDerivatives[i] * speciesValues[termSpecies[jacobian.limitTerms[i]]]);
+    }
+}
+
+void KineticsSolver::buildStepPattern()
+{
+    const auto speciesCount = amounts.size();
+
+    std::vector<size_t> reactionCounts(speciesCount, 0);
+    for (const auto species : termSpecies)
+        ++reactionCounts[species];
+
+    std::vector<size_t> order(speciesCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const auto lhs, const auto rhs) {
+        return reactionCounts[lhs] < reactionCounts[rhs];
+    });
+
+    auto& positions = stepMatrix.positions;
+    positions.resize(speciesCount);
+    for (size_t p = 0; p < speciesCount; ++p)
+        positions[order[p]] = p;
+
+    // Row p of J has entries in the reactant columns of every reaction in which species p takes part.
+    std::vector<std::vector<size_t>> rows(speciesCount);
+    for (size_t p = 0; p < speciesCount; ++p)
+        rows[p].emplace_back(p);
+    for (size_t i = 0; i < getReactionCount(); ++i)
+        for (size_t t = termOffsets[i]; t < termOffsets[i + 1]; ++t)
+            for (size_t r = termOffsets[i]; r < termOffsets[i] + reactantCounts[i]; ++r)
+                rows[positions[termSpecies[t]]].emplace_back(positions[termSpecies[r]]);
+
+    std::vector<bool> isInRow(speciesCount, false);
+
+    // Eliminating column k from row p adds the upper part of row k to row p, which might add new columns to
+    // eliminate, so the lower columns are visited in increasing order through a heap.
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> lowerColumns;
+    for (size_t p = 0; p < speciesCount; ++p) {
+        auto& row = rows[p];
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+
+        for (const auto column : row) {
+            isInRow[column] = true;
+            if (column < p)
+                lowerColumns.emplace(column);
+        }
+
+        while (lowerColumns.size()) {
+            const auto k = lowerColumns.top();
+            lowerColumns.pop();
+
+            for (const auto column : rows[k]) {
+                if (column <= k || isInRow[column])
+                    continue;
+
+                isInRow[column] = true;
+                row.emplace_back(column);
+                if (column < p)
+                    lowerColumns.emplace(column);
+            }
+        }
+
+        for (const auto column : row)
+            isInRow[column] = false;
+        std::sort(row.begin(), row.end());
+    }
+
+    stepMatrix.rowOffsets.assign(1, 0);
+    stepMatrix.columns.clear();
+    stepMatrix.diagonals.resize(speciesCount);
+    for (size_t p = 0; p < speciesCount; ++p) {
+        const auto diagonal     = std::lower_bound(rows[p].begin(), rows[p].end(), p) - rows[p].begin();
+        stepMatrix.diagonals[p] = stepMatrix.columns.size() + diagonal;
+        stepMatrix.columns.insert(stepMatrix.columns.end(), rows[p].begin(), rows[p].end());
+        stepMatrix.rowOffsets.emplace_back(stepMatrix.columns.size());
+    }
+    stepMatrix.values.resize(stepMatrix.columns.size());
+
+    const auto getEntry = [&](const size_t row, const size_t column) {
+        const auto begin = stepMatrix.columns.begin() + stepMatrix.rowOffsets[row];
+        const auto end   = stepMatrix.columns.begin() + stepMatrix.rowOffsets[row + 1];
+        return static_cast<size_t>(std::lower_bound(begin, end, column) - stepMatrix.columns.begin());
+    };
+
+    stepMatrix.entryOffsets.clear();
+    stepMatrix.entries.clear();
+    for (size_t i = 0; i < getReactionCount(); ++i) {
+        stepMatrix.entryOffsets.emplace_back(stepMatrix.entries.size());
+        for (size_t t = termOffsets[i]; t < termOffsets[i + 1]; ++t)
+            for (size_t r = termOffsets[i]; r < termOffsets[i] + reactantCounts[i]; ++r)
+                stepMatrix.entries.emplace_back(getEntry(positions[termSpecies[t]], positions[termSpecies[r]]));
+    }
+
+    stepMatrix.isOutdated = false;
+}
+
+bool KineticsSolver::factorizeStepMatrix(const float_h timestep, const Jacobian& jacobian)
+{
+    const auto& rowOffsets = stepMatrix.rowOffsets;
+    const auto& columns    = stepMatrix.columns;
+    const auto& diagonals  = stepMatrix.diagonals;
+    auto&       values     = stepMatrix.values;
+
+    std::fill(values.begin(), values.end(), 0.0);
+    for (const auto diagonal : diagonals)
+        values[diagonal] = 1.0;
+
+    // J = S * D, where row i of D holds the shared derivative in every reactant column of reaction i, plus
+    // the limiting derivative in the column of the limiting reactant.
+    const auto scale = -Gamma * timestep;
+    for (size_t i = 0; i < getReactionCount(); ++i) {
+        const auto derivative      = jacobian.derivatives[i];
+        const auto limitDerivative = jacobian.limitDerivatives[i];
+        if (derivative == 0.0 && limitDerivative == 0.0)
+            continue;
+
+        const auto limitIdx = jacobian.limitTerms[i] - termOffsets[i];
+        auto       entry    = stepMatrix.entries.begin() + stepMatrix.entryOffsets[i];
+        for (size_t t = termOffsets[i]; t < termOffsets[i + 1]; ++t, entry += reactantCounts[i]) {
+            const auto value = scale * termCoefficients[t];
+            for (size_t r = 0; r < reactantCounts[i]; ++r)
+                values[entry[r]] += value * derivative;
+            values[entry[limitIdx]] += value * limitDerivative;
+        }
+    }
+
+    // Row by row elimination, the pattern of each row already holding the columns of the rows it is reduced by.
+    workspace.assign(amounts.size(), 0.0);
+    for (size_t p = 0; p < amounts.size(); ++p) {
+        for (auto e = rowOffsets[p]; e < rowOffsets[p + 1]; ++e)
+            workspace[columns[e]] = values[e];
+
+        for (auto e = rowOffsets[p]; e < diagonals[p]; ++e) {
+            const auto k      = columns[e];
+            const auto factor = workspace[k] / values[diagonals[k]];
+            workspace[k]      = factor;
+            if (factor == 0.0)
+                continue;
+
+            for (auto f = diagonals[k] + 1; f < rowOffsets[k + 1]; ++f)
+                workspace[columns[f]] -= factor * values[f];
+        }
+
+        for (auto e = rowOffsets[p]; e < rowOffsets[p + 1]; ++e) {
+            values[e]             = workspace[columns[e]];
+            workspace[columns[e]] = 0.0;
+        }
+
+        const auto pivot = values[diagonals[p]];
+        if (not std::isfinite(pivot) || std::abs(pivot) < std::numeric_limits<float_h>::epsilon())
+            return false;
+    }
+
+    return true;
+}
+
+void KineticsSolver::solve(const std::vector<float_h>& rhs, std::vector<float_h>& result)
+{
+    const auto& rowOffsets = stepMatrix.rowOffsets;
+    const auto& columns    = stepMatrix.columns;
+    const auto& diagonals  = stepMatrix.diagonals;
+    const auto& values     = stepMatrix.values;
+
+    workspace.resize(amounts.size());
+    for (size_t i = 0; i < amounts.size(); ++i)
+        workspace[stepMatrix.positions[i]] = rhs[i];
+
+    // L * y = rhs
+    for (size_t p = 0; p < amounts.size(); ++p)
+        for (auto e = rowOffsets[p]; e < diagonals[p]; ++e)
+            workspace[p] -= values[e] * workspace[columns[e]];
+
+    // U * x = y
+    for (size_t p = amounts.size(); p-- > 0;) {
+        for (auto e = diagonals[p] + 1; e < rowOffsets[p + 1]; ++e)
+            workspace[p] -= values[e] * workspace[columns[e]];
+        workspace[p] /= values[diagonals[p]];
+    }
+
+    result.resize(amounts.size());
+    for (size_t i = 0; i < amounts.size(); ++i)
+        result[i] = workspace[stepMatrix.positions[i]];
+}
+
+size_t KineticsSolver::integrate(const float_h timespan)
+{
+    if (amounts.empty() || getReactionCount() == 0 || timespan <= 0.0)
+        return 0;
+
+    static constexpr size_t MaxStepCount = 10000;
+
+    if (stepMatrix.isOutdated)
+        buildStepPattern();
+
+    const auto minTimestep = timespan * 1e-6;
+    auto       timestep    = lastTimestep > 0.0 ? std::min(lastTimestep, timespan) : timespan;
+
+    Jacobian             jacobian;
+    std::vector<float_h> rates0, rates1, rhs;
+    std::vector<float_h> k1, k2, k1Extents, k2Extents, midpoint, next;
+
+    float_h time      = 0.0;
+    size_t  stepCount = 0;
+    while (timespan - time > minTimestep) {
+        if (stepCount == MaxStepCount) {
+            Log(this).warn(
+                "Step limit: {} reached after: {}s out of: {}s, the remaining time was skipped.",
+                MaxStepCount,
+                time,
+                timespan);
+            break;
+        }
+
+        timestep = std::min(timestep, timespan - time);
+
+        getRates(amounts, rates0);
+        getJacobian(amounts, jacobian);
+        if (not factorizeStepMatrix(timestep, jacobian)) {
+            timestep *= 0.5;
+            continue;
+        }
+
+        // Stage 1: (I - gamma * h * J) * k1 = f(n)
+        toSpecies(rates0, rhs);
+        solve(rhs, k1);
+        toReactions(rates0, Gamma * timestep, jacobian, k1, k1Extents);
+
+        // Stage 2: (I - gamma * h * J) * k2 = f(n + h * k1) - 2 * k1
+        midpoint.resize(amounts.size());
+        for (size_t i = 0; i < amounts.size(); ++i)
+            midpoint[i] = amounts[i] + timestep * k1[i];
+
+        getRates(midpoint, rates1);
+        for (size_t i = 0; i < getReactionCount(); ++i)
+            rates1[i] -= 2.0 * k1Extents[i];
+        toSpecies(rates1, rhs);
+        solve(rhs, k2);
+        toReactions(rates1, Gamma * timestep, jacobian, k2, k2Extents);
+
+        // The difference from the first order solution (n + h * k1) is used as the error estimate.
+        float_h error = 0.0;
+        next.resize(amounts.size());
+        for (size_t i = 0; i < amounts.size(); ++i) {
+            next[i] = amounts[i] + timestep * (1.5 * k1[i] + 0.5 * k2[i]);
+
+            const auto scale =
+                absoluteTolerance + relativeTolerance * std::max(std::abs(amounts[i]), std::abs(next[i]));
+            error = std::max(error, std::abs(0.5 * timestep * (k1[i] + k2[i])) / scale);
+
+            // Overshooting into negative amounts is always rejected.
+            if (next[i] < -absoluteTolerance)
+                error = std::max(error, 2.0);
+        }
+
+        const auto isAccepted = error <= 1.0 || timestep <= minTimestep;
+        if (isAccepted) {
+            amounts.swap(next);
+            for (size_t i = 0; i < getReactionCount(); ++i)
+                extents[i] += timestep * (1.5 * k1Extents[i] + 0.5 * k2Extents[i]);
+
+            time += timestep;
+            ++stepCount;
+        }
+
+        timestep *= std::clamp(0.9 / std::sqrt(std::max(error, 1e-10)), 0.2, 5.0);
+        timestep = std::max(timestep, minTimestep);
+        if (isAccepted)
+            lastTimestep = timestep;
+    }
+
+    return stepCount;
+}
+
+void KineticsSolver::reset()
+{
+    stepMatrix.isOutdated = true;
+    amounts.clear();
+    rates.clear();
+    extents.clear();
+    termOffsets.assign(1, 0);
+    reactantCounts.clear();
+    termSpecies.clear();
+    termCoefficients.clear();
+}
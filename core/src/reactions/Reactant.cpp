@@ -46,7 +46,9 @@ Amount<Unit::LITER> Reactant::getVolume() const
 
 Amount<Unit::GRAM_PER_MILLILITER> Reactant::getDensity() const
 {
-    return molecule.getDensityAt(getLayer().getTemperature(), container->getPressure());
+    // Reactants past a transition point keep the state of their layer until they are converted, otherwise the
+    // volume removed from the layer wouldn't match the one added to it.
+    return molecule.getDensityAt(getLayer().getTemperature(), container->getPressure(), getAggregationType(layer));
 }
 
 Amount<Unit::CELSIUS> Reactant::getMeltingPoint() const { return molecule.getMeltingPointAt(container->getPressure()); }
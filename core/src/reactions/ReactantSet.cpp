@@ -6,8 +6,14 @@
 ReactantSet::ReactantSet(const ReactantSet& other, const Ref<Mixture> newContainer) noexcept :
     container(newContainer)
 {
-    reactants.reserve(other.reactants.size());
-    add(other);
+    // Copies keep track of the reactants which weren't yet checked for reactions.
+    const auto& otherReactants = other.getReactants();
+    reactants.reserve(otherReactants.size());
+    for (const auto& [id, r] : otherReactants) {
+        auto copy  = r.mutate(newContainer);
+        copy.isNew = r.isNew;
+        reactants.emplace(id, std::move(copy));
+    }
 }
 
 ReactantSet::ReactantSet(const Ref<Mixture> container) noexcept :
@@ -28,14 +34,30 @@ ReactantSet::ReactantSet(const std::vector<Reactant>& reactants) noexcept :
         add(reactants[i].mutate(1.0_mol));
 }
 
-size_t ReactantSet::size() const { return reactants.size(); }
+void ReactantSet::detach()
+{
+    if (not sharedReactants)
+        return;
+
+    auto copy = ReactantSet(*this, container);
+    reactants = std::move(copy.reactants);
+    sharedReactants.reset();
+    owner.reset();
+}
+
+size_t ReactantSet::size() const { return getReactants().size(); }
 
-void ReactantSet::reserve(const size_t size) { reactants.reserve(size); }
+void ReactantSet::reserve(const size_t size)
+{
+    detach();
+    reactants.reserve(size);
+}
 
-bool ReactantSet::contains(const ReactantId& reactantId) const { return reactants.contains(reactantId); }
+bool ReactantSet::contains(const ReactantId& reactantId) const { return getReactants().contains(reactantId); }
 
-void ReactantSet::add(const Reactant& reactant)
+bool ReactantSet::add(const Reactant& reactant)
 {
+    detach();
     const auto& temp = reactants.find(reactant.getId());
     if (temp != reactants.end()) {
         auto& currentAmount = temp->second.amount;
@@ -50,28 +72,30 @@ void ReactantSet::add(const Reactant& reactant)
         // else
         currentAmount += reactant.amount;
 
-        return;
+        return true;
     }
 
     if (reactant.amount < 0.0) {
         Log(this).error("Tried to add a negative amount of {}.", reactant.molecule.getStructure().toSMILES());
-        return;
+        return false;
     }
     reactants.emplace(std::make_pair(reactant.getId(), reactant.mutate(container)));
+    return true;
 }
 
 void ReactantSet::add(const ReactantSet& other)
 {
-    for (const auto& [_, r] : other.reactants)
+    for (const auto& [_, r] : other.getReactants())
         add(r);
 }
 
-const Reactant& ReactantSet::any() const { return reactants.begin()->second; }
+const Reactant& ReactantSet::any() const { return getReactants().begin()->second; }
 
 Amount<Unit::MOLE> ReactantSet::getAmountOf(const ReactantId& reactantId) const
 {
-    const auto it = reactants.find(reactantId);
-    return it == reactants.end() ? Amount<Unit::MOLE>(0.0) : it->second.amount;
+    const auto& map = getReactants();
+    const auto  it  = map.find(reactantId);
+    return it == map.end() ? Amount<Unit::MOLE>(0.0) : it->second.amount;
 }
 
 Amount<Unit::MOLE> ReactantSet::getAmountOf(const ReactantSet& reactantSet) const
@@ -85,29 +109,48 @@ Amount<Unit::MOLE> ReactantSet::getAmountOf(const ReactantSet& reactantSet) cons
 Amount<Unit::MOLE> ReactantSet::getAmountOf(const Catalyst& catalyst) const
 {
     auto s = 0.0_mol;
-    for (const auto& [_, r] : reactants)
+    for (const auto& [_, r] : getReactants())
         if (catalyst.matchesWith(r.molecule.getStructure()))
             s += r.amount;
     return s;
 }
 
-const std::unordered_map<ReactantId, Reactant>& ReactantSet::getReactants() const { return reactants; }
+const std::unordered_map<ReactantId, Reactant>& ReactantSet::getReactants() const
+{
+    return sharedReactants ? *sharedReactants : reactants;
+}
 
-ReactantSet::iterator ReactantSet::erase(const ReactantSet::iterator it) { return reactants.erase(it); }
+ReactantSet::iterator ReactantSet::erase(const ReactantSet::iterator it)
+{
+    detach();
+    return reactants.erase(it);
+}
 
-void ReactantSet::erase(bool (*predicate)(const ReactantSet::pairT&)) { std::erase_if(reactants, predicate); }
+void ReactantSet::erase(bool (*predicate)(const ReactantSet::pairT&))
+{
+    detach();
+    std::erase_if(reactants, predicate);
+}
 
-ReactantSet::const_iterator ReactantSet::begin() const { return reactants.cbegin(); }
+ReactantSet::const_iterator ReactantSet::begin() const { return getReactants().cbegin(); }
 
-ReactantSet::iterator ReactantSet::begin() { return reactants.begin(); }
+ReactantSet::iterator ReactantSet::begin()
+{
+    detach();
+    return reactants.begin();
+}
 
-ReactantSet::const_iterator ReactantSet::end() const { return reactants.cend(); }
+ReactantSet::const_iterator ReactantSet::end() const { return getReactants().cend(); }
 
-ReactantSet::iterator ReactantSet::end() { return reactants.end(); }
+ReactantSet::iterator ReactantSet::end()
+{
+    detach();
+    return reactants.end();
+}
 
 bool ReactantSet::equals(const ReactantSet& other, const Amount<>::StorageType epsilon) const
 {
-    for (const auto& [_, r] : reactants)
+    for (const auto& [_, r] : getReactants())
         if (r.amount.equals(other.getAmountOf(r), epsilon) == false)
             return false;
     return true;
@@ -115,7 +158,7 @@ bool ReactantSet::equals(const ReactantSet& other, const Amount<>::StorageType e
 
 bool ReactantSet::operator==(const ReactantSet& other) const
 {
-    for (const auto& [_, r] : reactants)
+    for (const auto& [_, r] : getReactants())
         if (r.amount != other.getAmountOf(r))
             return false;
     return true;
@@ -123,10 +166,38 @@ bool ReactantSet::operator==(const ReactantSet& other) const
 
 bool ReactantSet::operator!=(const ReactantSet& other) const
 {
-    for (const auto& [_, r] : reactants)
+    for (const auto& [_, r] : getReactants())
         if (r.amount != other.getAmountOf(r))
             return true;
     return false;
 }
 
-ReactantSet ReactantSet::makeCopy(const Ref<Mixture> newContainer) const { return ReactantSet(*this, newContainer); }
+ReactantSet ReactantSet::makeCopy(const Ref<Mixture> newContainer) const
+{
+    return owner ? share(newContainer, owner) : ReactantSet(*this, newContainer);
+}
+
+bool ReactantSet::isShared() const { return sharedReactants != nullptr; }
+
+void ReactantSet::makeShareable(const Ref<Mixture> newContainer)
+{
+    detach();
+    container = newContainer;
+    for (auto& [_, r] : reactants)
+        r.container = newContainer;
+
+    // Moving the map doesn't move its nodes, so references to the reactants remain valid.
+    sharedReactants = std::make_shared<const Map>(std::move(reactants));
+    reactants.clear();
+}
+
+ReactantSet ReactantSet::share(const Ref<Mixture> newContainer, const std::shared_ptr<const Mixture>& owner) const
+{
+    if (not sharedReactants)
+        return ReactantSet(*this, newContainer);
+
+    auto result            = ReactantSet(newContainer);
+    result.sharedReactants = sharedReactants;
+    result.owner           = this->owner ? this->owner : owner;
+    return result;
+}
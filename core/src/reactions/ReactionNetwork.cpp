@@ -2,6 +2,7 @@
 
 #include "global/Charset.hpp"
 #include "io/Log.hpp"
+#include "utils/Memory.hpp"
 
 ReactionNetwork::ReactionNode::ReactionNode(ReactionData& data) noexcept :
     data(data)
@@ -209,6 +210,8 @@ std::string ReactionNetwork::print() const
     return block.toString();
 }
 
+size_t ReactionNetwork::getHeapUsage() const { return graph.getHeapUsage() + utils::getHeapUsage(topLayer); }
+
 void ReactionNetwork::clear()
 {
     graph.clear();
@@ -5,6 +5,7 @@
 #include "io/Log.hpp"
 #include "molecules/kinds/Molecule.hpp"
 #include "reactions/ReactionSpecifier.hpp"
+#include "utils/Memory.hpp"
 
 #include <fstream>
 
@@ -164,6 +165,14 @@ const ReactionData& ReactionRepository::at(const ReactionId id) const { return *
 
 size_t ReactionRepository::totalDefinitionCount() const { return reactions.size(); }
 
+size_t ReactionRepository::getMemoryUsage() const
+{
+    auto usage = sizeof(*this) + utils::getHeapUsage(reactions) + network.getHeapUsage();
+    for (const auto& r : reactions)
+        usage += r.second->getMemoryUsage();
+    return usage;
+}
+
 ReactionRepository::Iterator ReactionRepository::begin() const { return reactions.begin(); }
 
 ReactionRepository::Iterator ReactionRepository::end() const { return reactions.end(); }
@@ -10,17 +10,22 @@ MoleculeId StructureRef::getId() const { return data.id; }
 
 const MolecularStructure& StructureRef::getStructure() const { return data.getStructure(); }
 
-std::unordered_map<c_size, c_size> StructureRef::matchWith(const MolecularStructure& structure) const
+const ColoredTextBlock& StructureRef::toASCII(const ASCII::PrintOptions options) const
+{
+    return data.toASCII(options, getDataStore().molecules.getLayoutStore());
+}
+
+AtomMap StructureRef::matchWith(const MolecularStructure& structure) const
 {
     const auto& thisStructure = getStructure();
-    const auto  map           = structure.mapTo(thisStructure);
+    auto        map           = structure.mapTo(thisStructure);
     if (map.size() == thisStructure.getNonImpliedAtomCount())
         return map;
 
-    return std::unordered_map<c_size, c_size>();
+    return AtomMap();
 }
 
-std::unordered_map<c_size, c_size> StructureRef::matchWith(const StructureRef& other) const
+AtomMap StructureRef::matchWith(const StructureRef& other) const
 {
     return this->matchWith(other.getStructure());
 }
@@ -7,6 +7,7 @@
 #include "structs/SystemMatrix.hpp"
 #include "utils/Hash.hpp"
 #include "utils/Math.hpp"
+#include "utils/Memory.hpp"
 
 ReactionData::ReactionData(
     const ReactionId                                     id,
@@ -54,47 +55,37 @@ bool ReactionData::balance(
     if (reactants.size() == 0 || products.size() == 0)
         return false;
 
-    SystemMatrix<float_s>              system;
-    const size_t                       syslen = reactants.size() + products.size() - 1;
-    std::unordered_map<Symbol, size_t> sysmap;
+    SystemMatrix<float_s> system;
+    const size_t          syslen = reactants.size() + products.size() - 1;
+
+    // Each element is a row of the system, indexed by symbol id.
+    std::vector<size_t> rows(Symbol::getInternedCount(), npos);
+    size_t              rowCount = 0;
+    const auto          getRow   = [&](const Symbol& symbol) -> std::vector<float_s>& {
+        auto& row = rows[symbol.getId()];
+        if (row == npos) {
+            row = rowCount++;
+            system.addNullRow(syslen);
+        }
+        return system[row];
+    };
 
     for (size_t i = 0; i < reactants.size(); ++i) {
         const auto map = reactants[i].first.getStructure().getComponentCountMap();
-        for (const auto& c : map) {
-            if (sysmap.contains(c.first) == false) {
-                sysmap.emplace(c.first, sysmap.size());
-                system.addNullRow(syslen);
-                system.back()[i] = static_cast<float_s>(c.second);
-            }
-            else
-                system[sysmap[c.first]][i] = static_cast<float_s>(c.second);
-        }
+        for (const auto& [symbol, count] : map)
+            getRow(symbol)[i] = static_cast<float_s>(count);
     }
 
     // the "1st product" rule: lock the coefficient to 1 and apply to system
     {
         const auto map = products[0].first.getStructure().getComponentCountMap();
-        for (const auto& c : map) {
-            if (sysmap.contains(c.first) == false) {
-                sysmap.emplace(c.first, sysmap.size());
-                system.addNullRow(syslen);
-                system.back().back() = static_cast<float_s>(c.second);
-            }
-            else
-                system[sysmap[c.first]].back() = static_cast<float_s>(c.second);
-        }
+        for (const auto& [symbol, count] : map)
+            getRow(symbol).back() = static_cast<float_s>(count);
     }
     for (size_t i = 1; i < products.size(); ++i) {
         const auto map = products[i].first.getStructure().getComponentCountMap();
-        for (const auto& c : map) {
-            if (sysmap.contains(c.first) == false) {
-                sysmap.emplace(c.first, sysmap.size());
-                system.addNullRow(syslen);
-                system.back()[reactants.size() + i - 1] = -1 * static_cast<float_s>(c.second);
-            }
-            else
-                system[sysmap[c.first]][reactants.size() + i - 1] = -1 * static_cast<float_s>(c.second);
-        }
+        for (const auto& [symbol, count] : map)
+            getRow(symbol)[reactants.size() + i - 1] = -1 * static_cast<float_s>(count);
     }
 
     // TODO: The most complex product should be fixed, not the first.
@@ -126,11 +117,11 @@ bool ReactionData::mapReactantsToProducts()
         if (reactants[i].getStructure().isVirtualHydrogen())
             continue;
 
-        std::pair<std::unordered_map<c_size, c_size>, uint8_t> maxMap;
-        size_t                                                 maxIdxJ = 0;
+        std::pair<AtomMap, uint8_t> maxMap;
+        size_t                      maxIdxJ = 0;
         for (size_t j = 0; j < products.size(); ++j) {
             const auto map = reactants[i].getStructure().maximalMapTo(
-                products[j].getStructure(), reactantIgnore[i], productIgnore[j]);
+                products[j].getStructure(), reactantIgnore[i], productIgnore[j], MappingSearchBudget);
             if (map.first.size() > maxMap.first.size() ||
                 (map.first.size() == maxMap.first.size() && map.second > maxMap.second)) {
                 maxMap  = map;
@@ -141,13 +132,13 @@ bool ReactionData::mapReactantsToProducts()
         if (maxMap.first.size() == 0)
             return false;
 
-        for (const auto& p : maxMap.first) {
-            reactantIgnore[i].insert(p.first);
-            productIgnore[maxIdxJ].insert(p.second);
+        for (const auto& [reactantIdx, productIdx] : maxMap.first) {
+            reactantIgnore[i].insert(reactantIdx);
+            productIgnore[maxIdxJ].insert(productIdx);
 
             // only save radical atoms
-            if (reactants[i].getStructure().getAtom(p.first).isRadical())
-                componentMapping.emplace(std::make_pair(std::make_pair(i, p.first), std::make_pair(maxIdxJ, p.second)));
+            if (reactants[i].getStructure().getAtom(reactantIdx).isRadical())
+                componentMapping.emplace_back(std::make_pair(i, reactantIdx), std::make_pair(maxIdxJ, productIdx));
         }
 
         if (reactants[i].getStructure().getNonImpliedAtomCount() != reactantIgnore[i].size())
@@ -180,14 +171,13 @@ bool ReactionData::hasAsReactant(const MolecularStructure& structure) const
 
 bool ReactionData::hasAsReactant(const Molecule& molecule) const { return hasAsReactant(molecule.getStructure()); }
 
-std::vector<std::unordered_map<c_size, c_size>>
-ReactionData::generateConcreteReactantMatches(const std::vector<Reactant>& molecules) const
+std::vector<AtomMap> ReactionData::generateConcreteReactantMatches(const std::vector<Reactant>& molecules) const
 {
     if (reactants.size() != molecules.size())
         return {};
 
     // find the molecule match for each reactant
-    std::vector<std::unordered_map<c_size, c_size>> matches;
+    std::vector<AtomMap> matches;
     matches.reserve(reactants.size());
     for (size_t i = 0; i < reactants.size(); ++i) {
         if (reactants[i].getStructure().isVirtualHydrogen() &&
@@ -196,30 +186,29 @@ ReactionData::generateConcreteReactantMatches(const std::vector<Reactant>& molec
             continue;
         }
 
-        matches.emplace_back(utils::reverseMap(reactants[i].matchWith(molecules[i].molecule.getStructure())));
+        matches.emplace_back(reactants[i].matchWith(molecules[i].molecule.getStructure()).reversed());
         if (matches.back().empty())
             return {};
     }
     return matches;
 }
 
-std::pair<size_t, std::unordered_map<c_size, c_size>>
-ReactionData::generateRetrosynthProductMatches(const StructureRef& targetProduct) const
+std::pair<size_t, AtomMap> ReactionData::generateRetrosynthProductMatches(const StructureRef& targetProduct) const
 {
     for (size_t i = 0; i < products.size(); ++i) {
         if (products[i].getStructure().isVirtualHydrogen() && targetProduct.getStructure().isVirtualHydrogen())
-            return std::make_pair(i, std::unordered_map<c_size, c_size>());
+            return std::make_pair(i, AtomMap());
 
-        auto match = utils::reverseMap(products[i].matchWith(targetProduct));
+        auto match = products[i].matchWith(targetProduct).reversed();
         if (match.size())
             return std::make_pair(i, std::move(match));
     }
 
-    return std::make_pair(npos, std::unordered_map<c_size, c_size>());
+    return std::make_pair(npos, AtomMap());
 }
 
-std::vector<Molecule> ReactionData::generateConcreteProducts(
-    const std::vector<Reactant>& molecules, const std::vector<std::unordered_map<c_size, c_size>>& matches) const
+std::vector<Molecule>
+ReactionData::generateConcreteProducts(const std::vector<Reactant>& molecules, const std::vector<AtomMap>& matches) const
 {
     if (matches.size() != reactants.size())
         return std::vector<Molecule>();
@@ -230,17 +219,24 @@ std::vector<Molecule> ReactionData::generateConcreteProducts(
     for (size_t i = 0; i < products.size(); ++i)
         concreteProducts.emplace_back(products[i].getStructure().createCopy());
 
-    for (const auto& p : componentMapping) {
-        std::unordered_map<c_size, c_size> tempMap = {
-            {matches[p.first.first].at(p.first.second), p.second.second}
+    // The matched atoms of each molecule, which aren't copied into the products.
+    std::vector<AtomMap> matchedAtoms;
+    matchedAtoms.reserve(matches.size());
+    for (const auto& match : matches)
+        matchedAtoms.emplace_back(match.reversed());
+
+    for (const auto& [reactant, product] : componentMapping) {
+        const auto moleculeIdx = matches[reactant.first].at(reactant.second);
+        AtomMap    tempMap     = {
+            {moleculeIdx, product.second}
         };
         MolecularStructure::copyBranch(
-            concreteProducts[p.second.first],
-            molecules[p.first.first].molecule.getStructure(),
-            matches[p.first.first].at(p.first.second),
+            concreteProducts[product.first],
+            molecules[reactant.first].molecule.getStructure(),
+            moleculeIdx,
             tempMap,
             false,
-            utils::extractUniqueValues(matches[p.first.first]));
+            matchedAtoms[reactant.first]);
     }
 
     // canonicalize
@@ -259,8 +255,8 @@ std::vector<Molecule> ReactionData::generateConcreteProducts(
     return result;
 }
 
-RetrosynthReaction ReactionData::generateRetrosynthReaction(
-    const StructureRef& targetProduct, const std::pair<size_t, std::unordered_map<c_size, c_size>>& match) const
+RetrosynthReaction
+ReactionData::generateRetrosynthReaction(const StructureRef& targetProduct, const std::pair<size_t, AtomMap>& match) const
 {
     // build concrete products
     std::vector<MolecularStructure> substReactants;
@@ -268,19 +264,19 @@ RetrosynthReaction ReactionData::generateRetrosynthReaction(
     for (size_t i = 0; i < reactants.size(); ++i)
         substReactants.emplace_back(reactants[i].getStructure().createCopy());
 
-    const auto targetMatchedComponents = utils::extractUniqueValues(match.second);
-    const auto reversedMapping         = utils::reverseMap(componentMapping);
-    for (const auto& p : reversedMapping) {
-        if (p.first.first != match.first)
+    const auto targetMatchedComponents = match.second.reversed();
+    for (const auto& [reactant, product] : componentMapping) {
+        if (product.first != match.first)
             continue;
 
-        std::unordered_map<c_size, c_size> tempMap = {
-            {match.second.at(p.first.second), p.second.second}
+        const auto targetIdx = match.second.at(product.second);
+        AtomMap    tempMap   = {
+            {targetIdx, reactant.second}
         };
         MolecularStructure::copyBranch(
-            substReactants[p.second.first],
+            substReactants[reactant.first],
             targetProduct.getStructure(),
-            match.second.at(p.first.second),
+            targetIdx,
             tempMap,
             false,
             targetMatchedComponents);
@@ -312,6 +308,13 @@ const std::vector<StructureRef>& ReactionData::getProducts() const { return prod
 
 const ImmutableSet<Catalyst>& ReactionData::getCatalysts() const { return catalysts; }
 
+size_t ReactionData::getMemoryUsage() const
+{
+    return sizeof(*this) + utils::getHeapUsage(name) + utils::getHeapUsage(reactants) +
+           utils::getHeapUsage(products) + utils::getHeapUsage(catalysts.getContent()) +
+           utils::getHeapUsage(componentMapping);
+}
+
 Amount<Unit::MOLE_PER_SECOND>
 ReactionData::getSpeedAt(const Amount<Unit::CELSIUS> temperature, const Amount<Unit::MOLE_RATIO> concentration) const
 {
@@ -29,7 +29,7 @@ void RetrosynthReaction::print(std::ostream& out) const
         for (auto s = structures.begin(); s != structures.end(); ++s, ++i) {
             if (s->second > 1)
                 buffer.appendRight(std::to_string(s->second) + "x ");
-            buffer.appendRight(s->first.getStructure().toASCII());
+            buffer.appendRight(s->first.toASCII());
             if (i != last)
                 buffer.appendRight(" + ");
         }
@@ -1,9 +1,25 @@
 #include "utils/Bin.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <iomanip>
 #include <sstream>
 
+std::optional<std::string> bin::parseChars(std::istream& is, const size_t size)
+{
+    constexpr size_t chunkSize = 4096;
+
+    std::string result;
+    while (result.size() < size) {
+        const auto offset = result.size();
+        result.resize(offset + std::min(chunkSize, size - offset));
+        if (not is.read(result.data() + offset, static_cast<std::streamsize>(result.size() - offset)))
+            return std::nullopt;
+    }
+
+    return result;
+}
+
 std::string utils::toBin(const std::string& str, const char byteDelim, const char octetDelim)
 {
     if (str.empty())
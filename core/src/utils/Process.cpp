@@ -10,6 +10,8 @@
 
 #if defined(CHG_BUILD_WINDOWS)
     #include <Windows.h>
+    // Must be included after Windows.h.
+    #include <Psapi.h>
 #elif defined(CHG_BUILD_LINUX)
     #include <sched.h>
     #include <sys/resource.h>
@@ -179,6 +181,27 @@ void OS::setCurrentProcessPriority(const OS::ProcessPriority priority)
     Log().debug("Set process priority: {}.", underlying_cast(priority));
 }
 
+size_t OS::getCurrentProcessMemoryUsage()
+{
+#ifdef CHG_BUILD_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters;
+    if (not GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        Log().fatal("Failed to get process memory information (error code: {}).", GetLastError());
+
+    return static_cast<size_t>(counters.WorkingSetSize);
+
+#else
+    // Reads the resident page count, which is the second value in statm:
+    // '<SIZE> <RESIDENT> <SHARED> ...'
+    std::ifstream file("/proc/self/statm");
+    size_t        totalPages = 0, residentPages = 0;
+    if (not(file >> totalPages >> residentPages))
+        Log().fatal("Failed to read process memory information.");
+
+    return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
 OS::ProcessorAffinityMask OS::getAvailableProcessorMask()
 {
 #ifdef CHG_BUILD_WINDOWS
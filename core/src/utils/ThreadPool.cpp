@@ -0,0 +1,105 @@
+#include "utils/ThreadPool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(const size_t threadCount) noexcept
+{
+    const auto count = threadCount ? threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+
+    queues.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        queues.emplace_back(std::make_unique<WorkerQueue>());
+
+    workers.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        workers.emplace_back(&ThreadPool::runWorker, this, i);
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+    wait();
+
+    {
+        std::lock_guard lock(idleMutex);
+        stopping = true;
+    }
+    idleCondition.notify_all();
+
+    for (auto& w : workers)
+        w.join();
+}
+
+size_t ThreadPool::getThreadCount() const { return workers.size(); }
+
+void ThreadPool::submit(Task&& task)
+{
+    ++pendingCount;
+
+    auto& queue = *queues[nextQueue++ % queues.size()];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.emplace_back(std::move(task));
+    }
+    {
+        std::lock_guard lock(idleMutex);
+        ++queuedCount;
+    }
+    idleCondition.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock lock(doneMutex);
+    doneCondition.wait(lock, [this]() { return pendingCount == 0; });
+}
+
+bool ThreadPool::tryPop(const size_t workerIdx, Task& task)
+{
+    auto&           queue = *queues[workerIdx];
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::trySteal(const size_t workerIdx, Task& task)
+{
+    for (size_t i = 1; i < queues.size(); ++i) {
+        auto&           queue = *queues[(workerIdx + i) % queues.size()];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::runWorker(const size_t workerIdx)
+{
+    Task task;
+    while (true) {
+        if (tryPop(workerIdx, task) || trySteal(workerIdx, task)) {
+            --queuedCount;
+            task();
+            task = nullptr;
+
+            if (--pendingCount == 0) {
+                std::lock_guard lock(doneMutex);
+                doneCondition.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock lock(idleMutex);
+        idleCondition.wait(lock, [this]() { return stopping || queuedCount > 0; });
+        if (stopping && queuedCount == 0)
+            return;
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "molecules/MolBinBatch.hpp"
+
+#include <future>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Converts streamed SMILES, one per line or one per CSV row, into canonical SMILES, molar masses, formulas and
+/// an optional MolBin batch. Lines are parsed in chunks by a thread pool and written in input order, the number
+/// of chunks in flight being bounded so that the reader can't run ahead of the writer.
+/// CSV rows have the format: line, input, smiles, molar_mass_g/mol, formula, molbin, the input being quoted.
+/// Inputs which fail to parse or whose conversion throws are written with the remaining fields left empty. The molbin
+/// field holds the index of the structure in the MolBin batch, if any.
+/// </summary>
+class SmilesConverter
+{
+private:
+    class Chunk
+    {
+    public:
+        size_t                                         firstLine = 0;
+        std::vector<std::string>                       inputs;
+        std::vector<std::string>                       rows;
+        std::vector<std::optional<MolecularStructure>> structures;
+        std::promise<void>                             done;
+    };
+
+    const std::optional<size_t> column;
+    const char                  delimiter;
+    const size_t                jobCount;
+
+    size_t convertedCount = 0;
+    size_t failedCount    = 0;
+
+    std::string getField(const std::string& line) const;
+    void        convert(Chunk& chunk) const;
+    void        write(Chunk& chunk, std::ostream& os, MolBinBatchWriter* molBin);
+
+public:
+    /// <summary>
+    /// If a column is given, lines are split into CSV fields and the SMILES are read from that column.
+    /// If the job count is 0, all the cores are used.
+    /// </summary>
+    SmilesConverter(const std::optional<size_t> column, const char delimiter, const size_t jobCount) noexcept;
+    SmilesConverter(const SmilesConverter&) = delete;
+
+    /// <summary>
+    /// Converts all the lines of the input stream. If a writer is given, every converted structure is added to it.
+    /// </summary>
+    bool run(std::istream& is, std::ostream& os, MolBinBatchWriter* molBin, const bool skipHeader);
+
+    size_t getConvertedCount() const;
+    size_t getFailedCount() const;
+
+    static constexpr size_t ChunkSize = 256;
+};
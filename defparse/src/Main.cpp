@@ -1,18 +1,103 @@
+#include "SmilesConverter.hpp"
 #include "data/DataStore.hpp"
 #include "io/Log.hpp"
 #include "utils/Path.hpp"
 
+#include <chrono>
 #include <cxxopts.hpp>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+
+void createParentDir(const std::string& path)
+{
+    const auto dirName = utils::extractDirName(path);
+    if (dirName.size())
+        utils::createDir(dirName);
+}
+
+int runConversion(
+    const std::string&                inputFile,
+    const std::string&                outputFile,
+    const std::optional<std::string>& molBinFile,
+    const std::optional<size_t>       column,
+    const char                        delimiter,
+    const bool                        skipHeader,
+    const size_t                      jobCount)
+{
+    // SMILES can be piped in, in order to avoid temporary files when preprocessing catalogs.
+    std::ifstream inputStream;
+    if (inputFile != "-") {
+        inputStream.open(inputFile);
+        if (not inputStream) {
+            Log().fatal("Failed to open file: '{}' for reading.", inputFile);
+            return 1;
+        }
+    }
+    auto& is = inputFile != "-" ? static_cast<std::istream&>(inputStream) : std::cin;
+
+    createParentDir(outputFile);
+    std::ofstream os(outputFile);
+    if (not os) {
+        Log().fatal("Failed to open file: '{}' for writing.", outputFile);
+        return 1;
+    }
+
+    std::ofstream                    molBinStream;
+    std::optional<MolBinBatchWriter> molBin;
+    if (molBinFile) {
+        createParentDir(*molBinFile);
+        molBinStream.open(*molBinFile, std::ios::binary);
+        molBin.emplace(molBinStream);
+        if (not molBin->isValid()) {
+            Log().fatal("Failed to open file: '{}' for writing.", *molBinFile);
+            return 1;
+        }
+    }
+
+    SmilesConverter converter(column, delimiter, jobCount);
+
+    const auto start   = std::chrono::steady_clock::now();
+    const auto success = converter.run(is, os, molBin ? &*molBin : nullptr, skipHeader);
+    if (not success || (molBin && not molBin->finish()))
+        return 1;
+    const auto wallTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+    const auto count = converter.getConvertedCount() + converter.getFailedCount();
+    Log().success(
+        "Converted {} of {} SMILES, {:.3f}s wall time: {:.0f} SMILES per second.",
+        converter.getConvertedCount(),
+        count,
+        wallTime,
+        wallTime > 0.0f ? count / wallTime : std::numeric_limits<float>::infinity());
+
+    Log().info("Dumped output to file: '{}'.", outputFile);
+    if (molBinFile)
+        Log().info("Dumped MolBin batch to file: '{}'.", *molBinFile);
+    return 0;
+}
+
+}  // namespace
 
 int main(int argc, char* argv[])
 {
     try {
-        cxxopts::Options options(argv[0], "Application for parsing and formatting .cdef files.");
+        cxxopts::Options options(argv[0], "Application for parsing and formatting .cdef files and converting SMILES.");
         // clang-format off
         options.add_options()
             ("input", "Input file", cxxopts::value<std::string>())
             ("o,output", "Output file", cxxopts::value<std::string>())
             ("p,pretty", "Prettifies the output")
+            ("smiles", "Converts the SMILES from the given file (- for stdin) to the output CSV file", cxxopts::value<std::string>())
+            ("column", "Reads the SMILES from the given 0-based CSV column", cxxopts::value<size_t>())
+            ("delimiter", "CSV delimiter", cxxopts::value<char>()->default_value(","))
+            ("skip-header", "Skips the first line of the SMILES file")
+            ("molbin", "Also writes the converted structures to the given MolBin batch file", cxxopts::value<std::string>())
+            ("j,jobs", "Number of conversion threads, 0 for all cores", cxxopts::value<size_t>()->default_value("0"))
+            ("ascii-cache", "Reuses and updates the ASCII renderings stored in the given file", cxxopts::value<std::string>())
             ("log", "Sets logging level", cxxopts::value<std::string>())
             ("h,help", "Print usage information");
         // clang-format on
@@ -39,21 +124,47 @@ int main(int argc, char* argv[])
 
         DataStore dataStore;
         Accessor<>::setDataStore(dataStore);
+        auto& layouts = dataStore.molecules.getLayoutStore();
+        if (args.count("ascii-cache"))
+            layouts.open(args["ascii-cache"].as<std::string>());
+
         const auto inputFile = args["input"].as<std::string>();
-        if (not dataStore.load(inputFile)) {
+        const auto loaded    = dataStore.load(inputFile);
+        // Structures are only rendered while loading the definitions.
+        layouts.flush();
+        if (not loaded) {
             Log().fatal("Failed to load file: '{}'.", inputFile);
             return 1;
         }
 
+        if (args.count("smiles")) {
+            if (not args.count("output")) {
+                Log().fatal("SMILES conversions require an output file.");
+                return 1;
+            }
+
+            // Structures are parsed concurrently, so no definitions can be added anymore.
+            dataStore.freeze();
+
+            const auto smilesFile = args["smiles"].as<std::string>();
+            return runConversion(
+                smilesFile == "-" ? smilesFile : utils::normalizePath(smilesFile),
+                utils::normalizePath(args["output"].as<std::string>()),
+                args.count("molbin") ? std::optional(utils::normalizePath(args["molbin"].as<std::string>()))
+                                     : std::nullopt,
+                args.count("column") ? std::optional(args["column"].as<size_t>()) : std::nullopt,
+                args["delimiter"].as<char>(),
+                args["skip-header"].as<bool>(),
+                args["jobs"].as<size_t>());
+        }
+
         if (not args.count("output")) {
             Log().info("No output file was specified, dump skipped.");
             return 0;
         }
 
         const auto outputFile = utils::normalizePath(args["output"].as<std::string>());
-        const auto dirName    = utils::extractDirName(outputFile);
-        if (dirName.size())
-            utils::createDir(dirName);
+        createParentDir(outputFile);
 
         const auto prettify = args["pretty"].as<bool>();
         dataStore.dump(outputFile, prettify);
@@ -0,0 +1,236 @@
+#include "SmilesConverter.hpp"
+
+#include "io/Log.hpp"
+#include "utils/String.hpp"
+#include "utils/ThreadPool.hpp"
+
+#include <deque>
+#include <format>
+#include <memory>
+
+namespace
+{
+
+std::string getFormula(const MolecularStructure& structure)
+{
+    std::string result;
+    for (const auto& [symbol, count] : structure.getComponentCountMap()) {
+        result += symbol.str();
+        if (count != 1)
+            result += std::to_string(count);
+    }
+    return result;
+}
+
+/// <summary>
+/// Returns the unquoted CSV field at the given index, or an empty string if the row is shorter.
+/// Fields may be enclosed in double quotes, in which case delimiters are ignored and "" stands for a quote.
+/// </summary>
+std::string getCSVField(const std::string& line, const char delimiter, const size_t column)
+{
+    std::string field;
+    size_t      fieldIdx = 0;
+    bool        quoted   = false;
+
+    for (size_t i = 0; i < line.size(); ++i) {
+        const auto c = line[i];
+        if (c == '"') {
+            if (quoted && i + 1 < line.size() && line[i + 1] == '"') {
+                if (fieldIdx == column)
+                    field += '"';
+                ++i;
+            }
+            else
+                quoted = not quoted;
+        }
+        else if (c == delimiter && not quoted) {
+            if (fieldIdx == column)
+                break;
+            ++fieldIdx;
+        }
+        else if (fieldIdx == column)
+            field += c;
+    }
+
+    return fieldIdx == column ? field : "";
+}
+
+std::string quoteCSVField(const std::string& field)
+{
+    std::string result = "\"";
+    for (const auto c : field) {
+        if (c == '"')
+            result += '"';
+        result += c;
+    }
+    return result += '"';
+}
+
+}  // namespace
+
+SmilesConverter::SmilesConverter(
+    const std::optional<size_t> column, const char delimiter, const size_t jobCount) noexcept :
+    column(column),
+    delimiter(delimiter),
+    jobCount(jobCount)
+{}
+
+std::string SmilesConverter::getField(const std::string& line) const
+{
+    if (not column)
+        return utils::strip(line);
+
+    return utils::strip(getCSVField(line, delimiter, *column));
+}
+
+void SmilesConverter::convert(Chunk& chunk) const
+{
+    chunk.rows.reserve(chunk.inputs.size());
+    chunk.structures.reserve(chunk.inputs.size());
+
+    for (size_t i = 0; i < chunk.inputs.size(); ++i) {
+        const auto input = getField(chunk.inputs[i]);
+
+        // A line which can't be converted is written as failed, without affecting the rest of the chunk.
+        std::optional<MolecularStructure> structure;
+        std::string                       row;
+        try {
+            structure = input.empty() ? std::nullopt : MolecularStructure::fromSMILES(input);
+            if (structure)
+                row = std::format(
+                    "{},{},{},{:.3f},{},",
+                    chunk.firstLine + i,
+                    quoteCSVField(input),
+                    structure->toSMILES(),
+                    structure->getMolarMass().asStd(),
+                    getFormula(*structure));
+        }
+        catch (const std::exception& e) {
+            Log(this).error("Failed to convert line: {}, with error: {}.", chunk.firstLine + i, e.what());
+            structure.reset();
+        }
+
+        if (not structure)
+            row = std::format("{},{},,,,", chunk.firstLine + i, quoteCSVField(input));
+
+        chunk.rows.emplace_back(std::move(row));
+        chunk.structures.emplace_back(std::move(structure));
+    }
+
+    // The inputs aren't needed anymore and may be large.
+    chunk.inputs = {};
+}
+
+void SmilesConverter::write(Chunk& chunk, std::ostream& os, MolBinBatchWriter* molBin)
+{
+    for (size_t i = 0; i < chunk.rows.size(); ++i) {
+        os << chunk.rows[i];
+
+        const auto& structure = chunk.structures[i];
+        if (not structure) {
+            ++failedCount;
+            os << '\n';
+            continue;
+        }
+
+        ++convertedCount;
+        if (molBin && molBin->add(*structure))
+            os << molBin->size() - 1;
+        os << '\n';
+    }
+}
+
+bool SmilesConverter::run(std::istream& is, std::ostream& os, MolBinBatchWriter* molBin, const bool skipHeader)
+{
+    os << "line,input,smiles,molar_mass_g/mol,formula,molbin\n";
+
+    size_t      lineCount = 0;
+    std::string line;
+    if (skipHeader && std::getline(is, line))
+        ++lineCount;
+
+    ThreadPool pool(jobCount);
+    Log(this).info("Converting SMILES on {} threads.", pool.getThreadCount());
+
+    // Completed chunks are written in input order. Bounding the number of pending chunks keeps the memory usage
+    // constant and blocks the reader whenever the oldest chunk is still being converted.
+    const auto maxPendingCount = pool.getThreadCount() * 4;
+
+    std::deque<std::pair<std::shared_ptr<Chunk>, std::future<void>>> pending;
+
+    const auto writeOldest = [&]() {
+        auto& [chunk, future] = pending.front();
+
+        std::optional<std::string> error;
+        try {
+            future.get();
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+        }
+        catch (...) {
+            error = "unknown error";
+        }
+
+        // Chunks which failed as a whole are written as failed lines, so the reader can carry on.
+        if (error) {
+            const auto chunkLineCount = chunk->inputs.size();
+            Log(this).error(
+                "Failed to convert lines: {} to {}, with error: {}.",
+                chunk->firstLine,
+                chunk->firstLine + chunkLineCount - 1,
+                *error);
+
+            chunk->rows.clear();
+            chunk->structures.clear();
+            for (size_t i = 0; i < chunkLineCount; ++i) {
+                chunk->rows.emplace_back(std::format("{},,,,,", chunk->firstLine + i));
+                chunk->structures.emplace_back();
+            }
+        }
+
+        write(*chunk, os, molBin);
+        pending.pop_front();
+    };
+
+    while (is) {
+        auto chunk       = std::make_shared<Chunk>();
+        chunk->firstLine = lineCount + 1;
+        chunk->inputs.reserve(ChunkSize);
+        while (chunk->inputs.size() < ChunkSize && std::getline(is, line))
+            chunk->inputs.emplace_back(std::move(line));
+
+        if (chunk->inputs.empty())
+            break;
+        lineCount += chunk->inputs.size();
+
+        auto future = chunk->done.get_future();
+        pool.submit([this, chunk]() {
+            // The reader waits on every chunk, so the promise must be satisfied even if the conversion throws.
+            try {
+                convert(*chunk);
+                chunk->done.set_value();
+            }
+            catch (...) {
+                chunk->done.set_exception(std::current_exception());
+            }
+        });
+        pending.emplace_back(std::move(chunk), std::move(future));
+
+        if (pending.size() >= maxPendingCount)
+            writeOldest();
+    }
+
+    while (not pending.empty())
+        writeOldest();
+
+    if (not os) {
+        Log(this).error("Failed to write the converted SMILES.");
+        return false;
+    }
+    return true;
+}
+
+size_t SmilesConverter::getConvertedCount() const { return convertedCount; }
+
+size_t SmilesConverter::getFailedCount() const { return failedCount; }
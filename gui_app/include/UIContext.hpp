@@ -7,12 +7,14 @@
 #include "helpers/DragNDropHelper.hpp"
 #include "io/Input.hpp"
 #include "labware/Lab.hpp"
+#include "labware/LabRecorder.hpp"
 #include "labware/kinds/Adaptor.hpp"
 #include "labware/kinds/Condenser.hpp"
 #include "labware/kinds/Flask.hpp"
 #include "labware/kinds/Heatsource.hpp"
 
 #include <SFML/Graphics.hpp>
+#include <fstream>
 
 class UIContext
 {
@@ -20,6 +22,8 @@ private:
     sf::RenderWindow window = sf::RenderWindow(sf::VideoMode(sf::Vector2u(1'800, 1'000)), "Chemgine");
     Lab              lab;
 
+    std::optional<std::string> recordingPath;
+
     sf::Font font;
 
     bool                drawPropertyPane = false;
@@ -40,6 +44,10 @@ private:
     };
 
 public:
+    UIContext(std::optional<std::string>&& recordingPath = std::nullopt) noexcept :
+        recordingPath(std::move(recordingPath))
+    {}
+
     void run()
     {
         if (not font.openFromFile("./fonts/font.ttf"))
@@ -83,6 +91,20 @@ public:
         for (size_t i = 0; i < lab.getSystemCount(); ++i)
             lab.getSystem(i).move(sf::Vector2f(100.0f + 85.0f * static_cast<float>(i), 100.0f));
 
+        // All of the inputs changing the lab go through the recorder, so that the session can be replayed.
+        std::ofstream              recordingStream;
+        std::optional<LabRecorder> recorder;
+        if (recordingPath) {
+            recordingStream.open(*recordingPath, std::ios::binary);
+            if (not recordingStream)
+                Log(this).fatal("Failed to open file: '{}' for writing.", *recordingPath);
+
+            recorder.emplace(lab, recordingStream);
+            Log(this).info("Recording inputs to: '{}'.", *recordingPath);
+        }
+        else
+            recorder.emplace(lab);
+
         // Vapour vapour(50, sf::Vector2f(500.0f, 500.0f), sf::Color(255, 255, 255, 10), 0.0_o,
         // 0.7f, 0.5f);
 
@@ -97,11 +119,10 @@ public:
                 const auto mousePos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
                 if (event->is<sf::Event::MouseMoved>()) {
                     if (inHand.isSet()) {
-                        const auto delta     = dndHelper.getDelta(mousePos);
-                        auto&      inHandSys = lab.getSystem(inHand.idx);
-                        inHandSys.move(delta);
+                        const auto delta = dndHelper.getDelta(mousePos);
+                        recorder->move(inHand.idx, delta);
                         if (lab.anyIntersects(inHand.idx) != Lab::npos) {
-                            inHandSys.move(-delta);
+                            recorder->move(inHand.idx, -delta);
                             sf::Mouse::setPosition(static_cast<sf::Vector2i>(mousePos - delta), window);
                         }
                         dndHelper.resetOrigin(mousePos);
@@ -117,9 +138,7 @@ public:
                     else if (buttonPressEvent->button == sf::Mouse::Button::Right) {
                         if (inputMolecule) {
                             if (const auto [sys, comp] = lab.getSystemComponentAt(mousePos); sys != Lab::npos) {
-                                auto& component = lab.getSystem(sys).getComponent(comp);
-                                if (auto container = component.cast<BaseContainerComponent>()) {
-                                    container->add(inputMolecule->first, inputMolecule->second);
+                                if (recorder->add(sys, comp, inputMolecule->first, inputMolecule->second)) {
                                     Log(this).info(
                                         "Added {} of {}.",
                                         inputMolecule->second.toString(),
@@ -132,14 +151,14 @@ public:
                 else if (const auto buttonReleaseEvent = event->getIf<sf::Event::MouseButtonReleased>()) {
                     if (buttonReleaseEvent->button == sf::Mouse::Button::Left) {
                         if (inHand.isSet()) {
-                            callRemoveEmptySystems |= lab.tryConnect(inHand.idx, 1600.f);
+                            callRemoveEmptySystems |= recorder->tryConnect(inHand.idx, 1600.f);
 
                             inHand.unset();
                             dndHelper.end();
                         }
                     }
                     else if (buttonReleaseEvent->button == sf::Mouse::Button::Right) {
-                        lab.tryDisconnect(mousePos);
+                        recorder->tryDisconnect(mousePos);
                     }
                 }
                 else if (const auto wheelScrollEvent = event->getIf<sf::Event::MouseWheelScrolled>()) {
@@ -148,10 +167,11 @@ public:
                         timeMultiplier  = std::max(timeMultiplier, 0.05f);
                         timeMultiplier  = std::min(timeMultiplier, 50.0f);
 
+                        recorder->setTimeMultiplier(timeMultiplier);
                         textTimeMult.setString("x" + std::to_string(timeMultiplier).substr(0, 4));
                     }
                     else if (inHand.isSet())
-                        lab.getSystem(inHand.idx).rotate(wheelScrollEvent->delta * 2.0f);
+                        recorder->rotate(inHand.idx, wheelScrollEvent->delta * 2.0f);
                 }
                 else if (const auto keyPressEvent = event->getIf<sf::Event::KeyPressed>()) {
                     if (keyPressEvent->code == sf::Keyboard::Key::LControl) {
@@ -197,7 +217,7 @@ public:
             }
 
             if (callRemoveEmptySystems) {
-                lab.removeEmptySystems();
+                recorder->removeEmptySystems();
                 callRemoveEmptySystems = false;
             }
 
@@ -212,7 +232,7 @@ public:
 
             cTime = tickClock.getElapsedTime();
             if (const auto timespan = (cTime - lastLabTick).asSeconds(); timespan >= 0.05) {
-                lab.tick(timespan * timeMultiplier);
+                recorder->tick(timespan);
                 lastLabTick = cTime;
             }
 
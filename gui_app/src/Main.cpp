@@ -2,7 +2,7 @@
 #include "data/DataStore.hpp"
 #include "utils/Bin.hpp"
 
-int main()
+int main(int argc, char* argv[])
 {
     LogBase::settings().logLevel = LogType::INFO;
 
@@ -42,7 +42,12 @@ int main()
         std::cout << "-------------------------\n\n";
     }
 
-    UIContext uiContext;
+    // The inputs of the session can be recorded using: --record <path>, and replayed headlessly by simrun.
+    std::optional<std::string> recordingPath;
+    if (argc == 3 && std::string_view(argv[1]) == "--record")
+        recordingPath.emplace(argv[2]);
+
+    UIContext uiContext(std::move(recordingPath));
     uiContext.run();
 
     return 0;
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "StateSnapshot.hpp"
+
+#include <fstream>
+#include <mutex>
+
+/// <summary>
+/// Streams the snapshots of many simulation runs to a single binary file in columnar form.
+/// The header holds the magic "CHGCOLS", a version byte, the length-prefixed container names and the
+/// column descriptors (length-prefixed name and a type byte: 0 for uint32_t, 1 for float_s).
+/// It is followed by blocks, each starting with the uint32_t row count and then holding the values of
+/// every column contiguously, in header order. Rows have the format:
+/// run, time_s, container, temperature_C, pressure_torr, moles_mol, mass_g, volume_L.
+/// Blocks are written atomically, so writes can be shared by multiple threads.
+/// </summary>
+class ColumnarWriter
+{
+public:
+    /// <summary>
+    /// The rows of a single write, stored by column.
+    /// </summary>
+    class Block
+    {
+    private:
+        std::vector<uint32_t> runs;
+        std::vector<float_s>  times;
+        std::vector<uint32_t> containers;
+        std::vector<float_s>  temperatures;
+        std::vector<float_s>  pressures;
+        std::vector<float_s>  moles;
+        std::vector<float_s>  masses;
+        std::vector<float_s>  volumes;
+
+    public:
+        size_t size() const;
+        bool   empty() const;
+
+        void add(const uint32_t run, const StateSnapshot& snapshot);
+        void clear();
+
+        friend class ColumnarWriter;
+    };
+
+private:
+    std::ofstream out;
+    std::mutex    mutex;
+
+    void writeHeader(const std::vector<std::string>& names);
+
+public:
+    ColumnarWriter(const std::string& path, const std::vector<std::string>& names) noexcept;
+    ColumnarWriter(const ColumnarWriter&) = delete;
+
+    bool isOpen() const;
+
+    void write(const Block& block);
+
+    static constexpr uint8_t Version = 1;
+};
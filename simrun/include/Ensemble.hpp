@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Scenario.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+enum class EnsembleMode : uint8_t
+{
+    GRID,
+    LIST
+};
+
+/// <summary>
+/// A set of scenario variations loaded from a sweep file. Sweep files use the .cdef syntax, each entry
+/// varying one property of one scenario entry:
+///     _: vary { entry: atmosphere, property: temperature, values: { 10_C, 20_C, 30_C } };
+///     _: vary { entry: plate, property: power, values: { 100_W, 300_W } };
+/// In grid mode every combination of values is a separate case, the last variation changing fastest.
+/// In list mode all the variations must have the same number of values and case i uses the i-th values.
+/// </summary>
+class Ensemble
+{
+public:
+    struct Variation
+    {
+        std::string              entry;
+        std::string              property;
+        std::vector<std::string> values;
+    };
+
+private:
+    EnsembleMode           mode = EnsembleMode::GRID;
+    std::vector<Variation> variations;
+
+    bool addVariation(const def::Object& definition);
+
+public:
+    bool load(const std::string& path, const EnsembleMode mode);
+
+    EnsembleMode                  getMode() const;
+    const std::vector<Variation>& getVariations() const;
+
+    size_t getCaseCount() const;
+
+    /// <summary>
+    /// Returns the value index used by each variation in the given case.
+    /// </summary>
+    std::vector<size_t> getValueIndices(const size_t caseIdx) const;
+
+    /// <summary>
+    /// Returns the scenario overrides of the given case.
+    /// </summary>
+    std::vector<Scenario::Override> getOverrides(const size_t caseIdx) const;
+
+    static std::optional<EnsembleMode> parseMode(const std::string& str);
+};
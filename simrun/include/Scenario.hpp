@@ -0,0 +1,73 @@
+#pragma once
+
+#include "data/def/Object.hpp"
+#include "labware/Lab.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// A lab setup loaded from a scenario file. Scenario files use the .cdef syntax, all entries being
+/// auto-typed definitions whose specifier selects the entry kind:
+///     _: atmosphere { temperature: 25_C, pressure: 760_torr, volume: 10000_L, content: { N#N: 78_mol } };
+///     _<flask>: labware { id: 201, content: { CC(=O)O: 4_mol, O: 10_mol } };
+///     _<plate>: labware { id: 401, power: 300_W };
+///     _: connect { destination: flask, destination_port: 1, source: plate, source_port: 0 };
+/// The atmosphere entry is optional and the default atmosphere is used when missing.
+/// Besides content, labware entries accept a heat source power, a reactor tick mode (TickMode bitmask),
+/// a kinetics_tolerance, which enables the implicit kinetics integrator with the given relative tolerance, and
+/// an equilibrium_threshold, which enables fast-forwarding reversible reactions once their relative net rate
+/// drops below the given threshold.
+/// </summary>
+class Scenario
+{
+public:
+    struct NamedComponent
+    {
+        std::string           name;
+        LabwareComponentBase& component;
+    };
+
+    /// <summary>
+    /// Replaces the value of a property of the entry with the given name, before the scenario is built.
+    /// The atmosphere entry is named "atmosphere" while labware entries use their identifiers.
+    /// </summary>
+    struct Override
+    {
+        std::string entry;
+        std::string property;
+        std::string value;
+    };
+
+private:
+    std::optional<Lab>          lab;
+    std::vector<NamedComponent> components;
+
+    bool loadAtmosphere(const def::Object* definition);
+    bool addLabware(const def::Object& definition);
+    bool addConnection(const def::Object& definition);
+
+    LabwareComponentBase* findComponent(const std::string& name) const;
+
+    static std::string getEntryName(const def::Object& definition);
+
+public:
+    Scenario() = default;
+    Scenario(const Scenario&) = delete;
+    Scenario(Scenario&&)      = delete;
+
+    /// <summary>
+    /// Loads the scenario from the given file. The labware and molecules are resolved using the active
+    /// DataStore.
+    /// </summary>
+    bool load(const std::string& path, const std::vector<Override>& overrides = {});
+
+    Lab&       getLab();
+    const Lab& getLab() const;
+
+    /// <summary>
+    /// Returns the named components, in the order they were defined.
+    /// </summary>
+    const std::vector<NamedComponent>& getComponents() const;
+};
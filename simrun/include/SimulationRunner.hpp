@@ -0,0 +1,35 @@
+#pragma once
+
+#include "StateSnapshot.hpp"
+#include "TimestepController.hpp"
+
+#include <functional>
+
+/// <summary>
+/// Ticks the lab of a scenario for a fixed simulated duration.
+/// Snapshots are passed to the given callback at t=0 and then once every snapshot interval.
+/// </summary>
+class SimulationRunner
+{
+public:
+    using SnapshotCallback = std::function<void(const StateSnapshot&)>;
+
+private:
+    Scenario&                  scenario;
+    TimestepController         controller;
+    const Amount<Unit::SECOND> duration;
+    const Amount<Unit::SECOND> snapshotInterval;
+
+public:
+    SimulationRunner(
+        Scenario&                  scenario,
+        const TimestepController&  controller,
+        const Amount<Unit::SECOND> duration,
+        const Amount<Unit::SECOND> snapshotInterval) noexcept;
+
+    /// <summary>
+    /// Runs the simulation and returns the number of ticks. If no callback is given, snapshots are only
+    /// captured when needed by an adaptive controller.
+    /// </summary>
+    size_t run(const SnapshotCallback& onSnapshot = nullptr);
+};
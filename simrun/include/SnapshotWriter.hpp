@@ -0,0 +1,42 @@
+#pragma once
+
+#include "StateSnapshot.hpp"
+
+#include <fstream>
+#include <optional>
+
+enum class SnapshotFormat : uint8_t
+{
+    CSV,
+    BINARY
+};
+
+/// <summary>
+/// Writes state snapshots to a file, one row per observed container.
+/// CSV rows have the format: time_s, container, temperature_C, pressure_torr, moles_mol, mass_g, volume_L.
+/// The binary format starts with a header holding the magic "CHGSNAP", a version byte, the container
+/// count and the length-prefixed container names, followed by one record per snapshot holding the time
+/// and the 5 values of each container, in the CSV order, as host-endian float_s.
+/// The temperature of empty containers is left empty in CSV and written as Amount::Unknown in binary.
+/// </summary>
+class SnapshotWriter
+{
+private:
+    const SnapshotFormat           format;
+    const std::vector<std::string> names;
+    std::ofstream                  out;
+
+    void writeHeader();
+
+public:
+    SnapshotWriter(const std::string& path, const SnapshotFormat format, std::vector<std::string>&& names) noexcept;
+    SnapshotWriter(const SnapshotWriter&) = delete;
+
+    bool isOpen() const;
+
+    void write(const StateSnapshot& snapshot);
+
+    static std::optional<SnapshotFormat> parseFormat(const std::string& str);
+
+    static constexpr uint8_t Version = 1;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Scenario.hpp"
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Summary of the observable state of a single container.
+/// </summary>
+class ContainerState
+{
+public:
+    Amount<Unit::CELSIUS> temperature = Amount<Unit::CELSIUS>::Unknown;
+    Amount<Unit::TORR>    pressure    = 0.0_torr;
+    Amount<Unit::MOLE>    moles       = 0.0_mol;
+    Amount<Unit::GRAM>    mass        = 0.0_g;
+    Amount<Unit::LITER>   volume      = 0.0_L;
+
+    /// <summary>
+    /// Returns the largest relative change between the temperature, pressure and amount of the two states.
+    /// </summary>
+    float_s getRelativeChange(const ContainerState& other) const;
+
+    /// <summary>
+    /// Captures the state of the given mixture. The temperature is the mole-weighted average of its layers.
+    /// </summary>
+    static ContainerState capture(const Mixture& mixture);
+};
+
+/// <summary>
+/// The state of all the observed containers of a scenario at a given point in time.
+/// The atmosphere is always observed first, followed by the named container components in definition order.
+/// </summary>
+class StateSnapshot
+{
+public:
+    Amount<Unit::SECOND>        time = 0.0_s;
+    std::vector<ContainerState> containers;
+
+    /// <summary>
+    /// Returns the largest relative change between any of the containers of the two snapshots.
+    /// </summary>
+    float_s getRelativeChange(const StateSnapshot& other) const;
+
+    static StateSnapshot capture(const Scenario& scenario, const Amount<Unit::SECOND> time);
+
+    /// <summary>
+    /// Returns the names of the containers observed by capture(), in the same order.
+    /// </summary>
+    static std::vector<std::string> getObservedNames(const Scenario& scenario);
+};
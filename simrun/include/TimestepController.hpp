@@ -0,0 +1,39 @@
+#pragma once
+
+#include "data/values/Amount.hpp"
+
+/// <summary>
+/// Chooses the timespan of each simulation tick. Fixed controllers always return the same timespan.
+/// Adaptive controllers scale the timespan after every tick so that the largest relative change of the
+/// observed state stays close to the given tolerance, within the [min, max] bounds. Ticks are never
+/// rejected, so the tolerance is a target and not a hard bound.
+/// </summary>
+class TimestepController
+{
+private:
+    Amount<Unit::SECOND>       timespan;
+    const Amount<Unit::SECOND> minTimespan;
+    const Amount<Unit::SECOND> maxTimespan;
+    const float_s              tolerance;
+
+    TimestepController(
+        const Amount<Unit::SECOND> timespan,
+        const Amount<Unit::SECOND> minTimespan,
+        const Amount<Unit::SECOND> maxTimespan,
+        const float_s              tolerance) noexcept;
+
+public:
+    bool isAdaptive() const;
+
+    Amount<Unit::SECOND> getTimespan() const;
+
+    /// <summary>
+    /// Updates the timespan of the next tick given the relative state change caused by the last one.
+    /// Has no effect on fixed controllers.
+    /// </summary>
+    void update(const float_s relativeChange);
+
+    static TimestepController createFixed(const Amount<Unit::SECOND> timespan);
+    static TimestepController createAdaptive(
+        const Amount<Unit::SECOND> minTimespan, const Amount<Unit::SECOND> maxTimespan, const float_s tolerance);
+};
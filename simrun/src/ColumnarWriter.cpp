@@ -0,0 +1,124 @@
+#include "ColumnarWriter.hpp"
+
+#include "io/Log.hpp"
+#include "utils/Bin.hpp"
+
+#include <string_view>
+
+namespace
+{
+
+constexpr std::string_view Magic = "CHGCOLS";
+
+enum class ColumnType : uint8_t
+{
+    UINT32,
+    FLOAT
+};
+
+template <typename T>
+void writeColumn(std::ofstream& out, const std::vector<T>& column)
+{
+    out.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(column.size() * sizeof(T)));
+}
+
+}  // namespace
+
+//
+// Block
+//
+
+size_t ColumnarWriter::Block::size() const { return runs.size(); }
+
+bool ColumnarWriter::Block::empty() const { return runs.empty(); }
+
+void ColumnarWriter::Block::add(const uint32_t run, const StateSnapshot& snapshot)
+{
+    for (size_t i = 0; i < snapshot.containers.size(); ++i) {
+        const auto& c = snapshot.containers[i];
+        runs.emplace_back(run);
+        times.emplace_back(snapshot.time.asStd());
+        containers.emplace_back(static_cast<uint32_t>(i));
+        temperatures.emplace_back(c.temperature.asStd());
+        pressures.emplace_back(c.pressure.asStd());
+        moles.emplace_back(c.moles.asStd());
+        masses.emplace_back(c.mass.asStd());
+        volumes.emplace_back(c.volume.asStd());
+    }
+}
+
+void ColumnarWriter::Block::clear()
+{
+    runs.clear();
+    times.clear();
+    containers.clear();
+    temperatures.clear();
+    pressures.clear();
+    moles.clear();
+    masses.clear();
+    volumes.clear();
+}
+
+//
+// ColumnarWriter
+//
+
+ColumnarWriter::ColumnarWriter(const std::string& path, const std::vector<std::string>& names) noexcept :
+    out(path, std::ios::out | std::ios::binary)
+{
+    if (not out.is_open()) {
+        Log(this).error("Failed to open file: '{}' for writing.", path);
+        return;
+    }
+
+    writeHeader(names);
+}
+
+bool ColumnarWriter::isOpen() const { return out.is_open(); }
+
+void ColumnarWriter::writeHeader(const std::vector<std::string>& names)
+{
+    static const std::vector<std::pair<std::string_view, ColumnType>> columns = {
+        {"run", ColumnType::UINT32},
+        {"time_s", ColumnType::FLOAT},
+        {"container", ColumnType::UINT32},
+        {"temperature_C", ColumnType::FLOAT},
+        {"pressure_torr", ColumnType::FLOAT},
+        {"moles_mol", ColumnType::FLOAT},
+        {"mass_g", ColumnType::FLOAT},
+        {"volume_L", ColumnType::FLOAT},
+    };
+
+    out.write(Magic.data(), Magic.size());
+    bin::print(out, Version);
+
+    bin::print(out, static_cast<uint32_t>(names.size()));
+    for (const auto& name : names) {
+        bin::print(out, static_cast<uint16_t>(name.size()));
+        out.write(name.data(), name.size());
+    }
+
+    bin::print(out, static_cast<uint8_t>(columns.size()));
+    for (const auto& [name, type] : columns) {
+        bin::print(out, static_cast<uint16_t>(name.size()));
+        out.write(name.data(), name.size());
+        bin::print(out, type);
+    }
+}
+
+void ColumnarWriter::write(const Block& block)
+{
+    if (block.empty())
+        return;
+
+    std::lock_guard lock(mutex);
+    bin::print(out, static_cast<uint32_t>(block.size()));
+    writeColumn(out, block.runs);
+    writeColumn(out, block.times);
+    writeColumn(out, block.containers);
+    writeColumn(out, block.temperatures);
+    writeColumn(out, block.pressures);
+    writeColumn(out, block.moles);
+    writeColumn(out, block.masses);
+    writeColumn(out, block.volumes);
+}
@@ -0,0 +1,151 @@
+#include "Ensemble.hpp"
+
+#include "data/FileStore.hpp"
+#include "data/OutlineDefRepository.hpp"
+#include "data/def/FileParser.hpp"
+#include "data/def/Parsers.hpp"
+#include "io/Log.hpp"
+
+namespace
+{
+
+constexpr std::string_view Vary = "vary";
+
+namespace Keys
+{
+
+constexpr std::string_view Entry    = "entry";
+constexpr std::string_view Property = "property";
+constexpr std::string_view Values   = "values";
+
+}  // namespace Keys
+
+}  // namespace
+
+bool Ensemble::addVariation(const def::Object& definition)
+{
+    auto entry    = definition.getProperty(Keys::Entry);
+    auto property = definition.getProperty(Keys::Property);
+    auto values   = definition.getProperty(Keys::Values, def::parse<std::vector<std::string>>);
+    if (not entry || not property || not values)
+        return false;
+
+    if (values->empty()) {
+        Log(this).error("Variation without values, at: {}.", definition.getLocationName());
+        return false;
+    }
+
+    variations.emplace_back(std::move(*entry), std::move(*property), std::move(*values));
+    return true;
+}
+
+bool Ensemble::load(const std::string& path, const EnsembleMode mode)
+{
+    if (variations.size()) {
+        Log(this).error("Ensemble already loaded.");
+        return false;
+    }
+
+    FileStore            fileStore;
+    OutlineDefRepository outlineDefinitions;
+    def::FileParser      parser(path, fileStore, outlineDefinitions);
+    if (not parser.isOpen())
+        return false;
+
+    this->mode   = mode;
+    bool success = true;
+    while (true) {
+        const auto entry = parser.nextDefinition();
+        if (not parser.isOpen())
+            break;
+
+        if (not entry) {
+            Log(this).error("Parsing aborted due to invalid definition.");
+            success = false;
+            continue;
+        }
+
+        if (entry->getType() != def::DefinitionType::AUTO || entry->getSpecifier() != Vary) {
+            Log(this).error("Sweep entries must be auto-typed '{}' entries, at: {}.", Vary, entry->getLocationName());
+            success = false;
+            continue;
+        }
+
+        success &= addVariation(*entry);
+        entry->logUnusedWarnings();
+    }
+
+    if (variations.empty()) {
+        Log(this).error("No variations defined in: '{}'.", path);
+        return false;
+    }
+
+    if (mode == EnsembleMode::LIST) {
+        for (const auto& v : variations) {
+            if (v.values.size() == variations.front().values.size())
+                continue;
+
+            Log(this).error(
+                "List sweeps require the same value count for every variation, but: '{}.{}' has {} values instead "
+                "of {}.",
+                v.entry,
+                v.property,
+                v.values.size(),
+                variations.front().values.size());
+            return false;
+        }
+    }
+
+    return success;
+}
+
+EnsembleMode Ensemble::getMode() const { return mode; }
+
+const std::vector<Ensemble::Variation>& Ensemble::getVariations() const { return variations; }
+
+size_t Ensemble::getCaseCount() const
+{
+    if (variations.empty())
+        return 0;
+    if (mode == EnsembleMode::LIST)
+        return variations.front().values.size();
+
+    size_t count = 1;
+    for (const auto& v : variations)
+        count *= v.values.size();
+    return count;
+}
+
+std::vector<size_t> Ensemble::getValueIndices(const size_t caseIdx) const
+{
+    std::vector<size_t> indices(variations.size(), caseIdx);
+    if (mode == EnsembleMode::LIST)
+        return indices;
+
+    auto remainder = caseIdx;
+    for (size_t i = variations.size(); i-- > 0;) {
+        indices[i] = remainder % variations[i].values.size();
+        remainder /= variations[i].values.size();
+    }
+    return indices;
+}
+
+std::vector<Scenario::Override> Ensemble::getOverrides(const size_t caseIdx) const
+{
+    const auto indices = getValueIndices(caseIdx);
+
+    std::vector<Scenario::Override> overrides;
+    overrides.reserve(variations.size());
+    for (size_t i = 0; i < variations.size(); ++i)
+        overrides.emplace_back(variations[i].entry, variations[i].property, variations[i].values[indices[i]]);
+    return overrides;
+}
+
+std::optional<EnsembleMode> Ensemble::parseMode(const std::string& str)
+{
+    if (str == "grid")
+        return EnsembleMode::GRID;
+    if (str == "list")
+        return EnsembleMode::LIST;
+    return std::nullopt;
+}
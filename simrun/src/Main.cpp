@@ -0,0 +1,374 @@
+#include "ColumnarWriter.hpp"
+#include "Ensemble.hpp"
+#include "SimulationRunner.hpp"
+#include "SnapshotWriter.hpp"
+#include "data/DataStore.hpp"
+#include "io/Log.hpp"
+#include "labware/LabRecorder.hpp"
+#include "utils/Path.hpp"
+#include "utils/ThreadPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cxxopts.hpp>
+#include <fstream>
+
+namespace
+{
+
+float_s getWallTime(const std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::duration<float_s>>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+void createParentDir(const std::string& path)
+{
+    const auto dirName = utils::extractDirName(path);
+    if (dirName.size())
+        utils::createDir(dirName);
+}
+
+int runSingle(
+    const std::string&                scenarioFile,
+    const TimestepController&         controller,
+    const Amount<Unit::SECOND>        duration,
+    const Amount<Unit::SECOND>        snapshotInterval,
+    const std::optional<std::string>& outputFile,
+    const SnapshotFormat              format,
+    const std::optional<std::string>& warmStartFile,
+    const std::optional<std::string>& checkpointFile)
+{
+    Scenario scenario;
+    if (not scenario.load(scenarioFile)) {
+        Log().fatal("Failed to load scenario: '{}'.", scenarioFile);
+        return 1;
+    }
+
+    // Checkpoints written by runs of the same scenario hold the same labware, in which case only the states of
+    // the components are replaced.
+    if (warmStartFile && not scenario.getLab().loadCheckpointFile(*warmStartFile)) {
+        Log().fatal("Failed to load checkpoint: '{}'.", *warmStartFile);
+        return 1;
+    }
+
+    std::optional<SnapshotWriter> writer;
+    if (outputFile) {
+        createParentDir(*outputFile);
+        writer.emplace(*outputFile, format, StateSnapshot::getObservedNames(scenario));
+        if (not writer->isOpen())
+            return 1;
+    }
+    else
+        Log().info("No output file was specified, snapshots skipped.");
+
+    SimulationRunner runner(scenario, controller, duration, snapshotInterval);
+
+    const auto start     = std::chrono::steady_clock::now();
+    const auto tickCount = writer ? runner.run([&](const auto& snapshot) { writer->write(snapshot); }) : runner.run();
+    const auto wallTime  = getWallTime(start);
+
+    Log().success(
+        "Simulated {}s in {} ticks, {:.3f}s wall time: {:.2f} simulated seconds per wall second.",
+        duration.asStd(),
+        tickCount,
+        wallTime,
+        wallTime > 0.0f ? duration.asStd() / wallTime : std::numeric_limits<float_s>::infinity());
+
+    if (checkpointFile) {
+        createParentDir(*checkpointFile);
+        if (not scenario.getLab().toCheckpointFile(*checkpointFile))
+            return 1;
+        Log().info("Checkpoint written to: '{}'.", *checkpointFile);
+    }
+    return 0;
+}
+
+int runReplay(const std::string& recordingFile, const std::optional<std::string>& checkpointFile)
+{
+    std::ifstream is(recordingFile, std::ios::binary);
+    if (not is) {
+        Log().fatal("Failed to open file: '{}' for reading.", recordingFile);
+        return 1;
+    }
+
+    Lab         lab;
+    LabReplayer replayer(is, lab);
+    if (not replayer.isValid()) {
+        Log().fatal("Failed to load recording: '{}'.", recordingFile);
+        return 1;
+    }
+
+    const auto start    = std::chrono::steady_clock::now();
+    const auto success  = replayer.replay();
+    const auto wallTime = getWallTime(start);
+
+    Log().success(
+        "Replayed {} ticks, {:.3f}s wall time: {:.2f} ticks per second.",
+        replayer.getTickCount(),
+        wallTime,
+        wallTime > 0.0f ? replayer.getTickCount() / wallTime : std::numeric_limits<float_s>::infinity());
+
+    if (not success) {
+        Log().fatal("Failed to replay recording: '{}'.", recordingFile);
+        return 1;
+    }
+
+    if (checkpointFile) {
+        createParentDir(*checkpointFile);
+        if (not lab.toCheckpointFile(*checkpointFile))
+            return 1;
+        Log().info("Checkpoint written to: '{}'.", *checkpointFile);
+    }
+    return 0;
+}
+
+bool writeRunsTable(const std::string& path, const Ensemble& ensemble)
+{
+    std::ofstream out(path);
+    if (not out.is_open()) {
+        Log().error("Failed to open file: '{}' for writing.", path);
+        return false;
+    }
+
+    const auto& variations = ensemble.getVariations();
+    out << "run";
+    for (const auto& v : variations)
+        out << ',' << v.entry << '.' << v.property;
+    out << '\n';
+
+    // Values are quoted since they might be maps or lists holding commas.
+    for (size_t i = 0; i < ensemble.getCaseCount(); ++i) {
+        out << i;
+        const auto indices = ensemble.getValueIndices(i);
+        for (size_t j = 0; j < variations.size(); ++j)
+            out << ",\"" << variations[j].values[indices[j]] << '"';
+        out << '\n';
+    }
+
+    return true;
+}
+
+int runEnsemble(
+    const std::string&         scenarioFile,
+    const Ensemble&            ensemble,
+    const TimestepController&  controller,
+    const Amount<Unit::SECOND> duration,
+    const Amount<Unit::SECOND> snapshotInterval,
+    const std::string&         outputFile,
+    const size_t               jobCount)
+{
+    // The base scenario is loaded once in order to validate it and to resolve the observed container names.
+    Scenario base;
+    if (not base.load(scenarioFile)) {
+        Log().fatal("Failed to load scenario: '{}'.", scenarioFile);
+        return 1;
+    }
+
+    createParentDir(outputFile);
+    if (not writeRunsTable(outputFile + ".runs.csv", ensemble))
+        return 1;
+
+    ColumnarWriter writer(outputFile, StateSnapshot::getObservedNames(base));
+    if (not writer.isOpen())
+        return 1;
+
+    const auto          caseCount = ensemble.getCaseCount();
+    std::atomic<size_t> tickCount = 0;
+    std::atomic<size_t> failCount = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(jobCount);
+        Log().info("Running {} cases on {} threads.", caseCount, pool.getThreadCount());
+
+        for (size_t i = 0; i < caseCount; ++i) {
+            pool.submit([&, i]() {
+                // Labware and mixtures are mutable, so each run parses its own scenario. The data store is frozen
+                // and molecules discovered during the runs are shared through its concurrent overlay.
+                Scenario scenario;
+                if (not scenario.load(scenarioFile, ensemble.getOverrides(i))) {
+                    Log().error("Failed to load scenario case: {}.", i);
+                    ++failCount;
+                    return;
+                }
+
+                ColumnarWriter::Block block;
+                SimulationRunner      runner(scenario, controller, duration, snapshotInterval);
+                tickCount += runner.run([&](const auto& snapshot) { block.add(static_cast<uint32_t>(i), snapshot); });
+                writer.write(block);
+            });
+        }
+        pool.wait();
+    }
+    const auto wallTime = getWallTime(start);
+
+    const auto runCount = caseCount - failCount;
+    Log().success(
+        "Simulated {} runs of {}s in {} ticks, {:.3f}s wall time: {:.2f} runs per second, {:.2f} simulated seconds "
+        "per wall second.",
+        runCount,
+        duration.asStd(),
+        tickCount.load(),
+        wallTime,
+        wallTime > 0.0f ? runCount / wallTime : std::numeric_limits<float_s>::infinity(),
+        wallTime > 0.0f ? runCount * duration.asStd() / wallTime : std::numeric_limits<float_s>::infinity());
+
+    if (failCount) {
+        Log().error("{} of {} cases failed.", failCount.load(), caseCount);
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        cxxopts::Options options(argv[0], "Application for running headless lab simulations.");
+        // clang-format off
+        options.add_options()
+            ("defs", "Definitions file", cxxopts::value<std::string>())
+            ("scenario", "Scenario file", cxxopts::value<std::string>())
+            ("t,time", "Simulated duration in seconds", cxxopts::value<float_s>()->default_value("60"))
+            ("dt", "Fixed tick timespan in seconds", cxxopts::value<float_s>()->default_value("0.05"))
+            ("adaptive", "Uses an adaptive tick timespan with the given relative tolerance", cxxopts::value<float_s>())
+            ("min-dt", "Minimum adaptive tick timespan in seconds", cxxopts::value<float_s>()->default_value("0.001"))
+            ("max-dt", "Maximum adaptive tick timespan in seconds", cxxopts::value<float_s>()->default_value("1"))
+            ("o,output", "Snapshot output file, ensembles always use the columnar binary format", cxxopts::value<std::string>())
+            ("f,format", "Snapshot format: csv or bin", cxxopts::value<std::string>()->default_value("csv"))
+            ("s,snapshot", "Simulated interval between snapshots in seconds", cxxopts::value<float_s>()->default_value("1"))
+            ("warm-start", "Starts from the lab state stored in the given checkpoint file", cxxopts::value<std::string>())
+            ("checkpoint", "Writes the final lab state to the given checkpoint file", cxxopts::value<std::string>())
+            ("replay", "Replays the inputs from the given recording instead of running a scenario", cxxopts::value<std::string>())
+            ("sweep", "Runs an ensemble over the variations from the given sweep file", cxxopts::value<std::string>())
+            ("sweep-mode", "Sweep combination mode: grid or list", cxxopts::value<std::string>()->default_value("grid"))
+            ("j,jobs", "Number of ensemble worker threads, 0 for all cores", cxxopts::value<size_t>()->default_value("0"))
+            ("ascii-cache", "Reuses and updates the ASCII renderings stored in the given file", cxxopts::value<std::string>())
+            ("log", "Sets logging level", cxxopts::value<std::string>())
+            ("h,help", "Print usage information");
+        // clang-format on
+        options.parse_positional({"defs", "scenario"});
+
+        const auto args = options.parse(argc, argv);
+        if (argc == 1 || args.count("help")) {
+            std::cout << options.help() << '\n';
+            return 0;
+        }
+
+        const auto logLevelStr = args.count("log") ? args["log"].as<std::string>() : "INFO";
+        if (const auto logLevel = LogBase::parseLogType(logLevelStr))
+            LogBase::settings().logLevel = *logLevel;
+        else {
+            Log().fatal("Failed to parse log level: '{}'.", logLevelStr);
+            return 1;
+        }
+
+        if (not args.count("defs") || (not args.count("scenario") && not args.count("replay"))) {
+            Log().fatal("Missing definitions or scenario file.");
+            return 1;
+        }
+
+        const Amount<Unit::SECOND> duration         = args["time"].as<float_s>();
+        const Amount<Unit::SECOND> snapshotInterval = args["snapshot"].as<float_s>();
+        if (duration <= 0.0_s || snapshotInterval <= 0.0_s) {
+            Log().fatal("The simulated duration and snapshot interval must be positive.");
+            return 1;
+        }
+
+        auto controller = [&]() {
+            if (not args.count("adaptive"))
+                return TimestepController::createFixed(args["dt"].as<float_s>());
+
+            return TimestepController::createAdaptive(
+                args["min-dt"].as<float_s>(), args["max-dt"].as<float_s>(), args["adaptive"].as<float_s>());
+        }();
+        if (controller.getTimespan() <= 0.0_s) {
+            Log().fatal("The tick timespan must be positive.");
+            return 1;
+        }
+
+        const auto format = SnapshotWriter::parseFormat(args["format"].as<std::string>());
+        if (not format) {
+            Log().fatal("Unknown snapshot format: '{}'.", args["format"].as<std::string>());
+            return 1;
+        }
+
+        DataStore dataStore;
+        Accessor<>::setDataStore(dataStore);
+        auto& layouts = dataStore.molecules.getLayoutStore();
+        if (args.count("ascii-cache"))
+            layouts.open(args["ascii-cache"].as<std::string>());
+
+        const auto defsFile = args["defs"].as<std::string>();
+        if (not dataStore.load(defsFile)) {
+            Log().fatal("Failed to load file: '{}'.", defsFile);
+            return 1;
+        }
+        dataStore.freeze();
+
+        const auto getOptionalPath = [&](const std::string& option) {
+            return args.count(option) ? std::optional(utils::normalizePath(args[option].as<std::string>()))
+                                      : std::nullopt;
+        };
+
+        // Renderings stored by failed runs are still valid, so the layouts are saved regardless of the outcome.
+        const auto result = [&]() {
+            // Recordings hold their initial lab state and tick timespans, so no scenario or timing options are used.
+            if (args.count("replay")) {
+                if (args.count("sweep") || args.count("warm-start")) {
+                    Log().fatal("Replays can't be combined with sweeps or warm starts.");
+                    return 1;
+                }
+
+                return runReplay(*getOptionalPath("replay"), getOptionalPath("checkpoint"));
+            }
+
+            const auto scenarioFile = args["scenario"].as<std::string>();
+            const auto outputFile   = getOptionalPath("output");
+
+            if (not args.count("sweep"))
+                return runSingle(
+                    scenarioFile,
+                    controller,
+                    duration,
+                    snapshotInterval,
+                    outputFile,
+                    *format,
+                    getOptionalPath("warm-start"),
+                    getOptionalPath("checkpoint"));
+
+            if (args.count("warm-start") || args.count("checkpoint")) {
+                Log().fatal("Checkpoints are only supported by single runs.");
+                return 1;
+            }
+
+            const auto mode = Ensemble::parseMode(args["sweep-mode"].as<std::string>());
+            if (not mode) {
+                Log().fatal("Unknown sweep mode: '{}'.", args["sweep-mode"].as<std::string>());
+                return 1;
+            }
+            if (not outputFile) {
+                Log().fatal("Ensemble runs require an output file.");
+                return 1;
+            }
+
+            Ensemble   ensemble;
+            const auto sweepFile = args["sweep"].as<std::string>();
+            if (not ensemble.load(sweepFile, *mode)) {
+                Log().fatal("Failed to load sweep: '{}'.", sweepFile);
+                return 1;
+            }
+
+            return runEnsemble(
+                scenarioFile, ensemble, controller, duration, snapshotInterval, *outputFile, args["jobs"].as<size_t>());
+        }();
+
+        layouts.flush();
+        return result;
+    } catch (const cxxopts::exceptions::exception& e) {
+        Log().fatal("Option parsing failed.\n{}", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,296 @@
+#include "Scenario.hpp"
+
+#include "data/Accessor.hpp"
+#include "data/DataStore.hpp"
+#include "data/FileStore.hpp"
+#include "data/OutlineDefRepository.hpp"
+#include "data/def/FileParser.hpp"
+#include "labware/kinds/Heatsource.hpp"
+#include "mixtures/kinds/DumpContainer.hpp"
+#include "mixtures/kinds/Reactor.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+namespace Entries
+{
+
+constexpr std::string_view Atmosphere = "atmosphere";
+constexpr std::string_view Labware    = "labware";
+constexpr std::string_view Connect    = "connect";
+
+}  // namespace Entries
+
+namespace Keys
+{
+
+constexpr std::string_view Temperature     = "temperature";
+constexpr std::string_view Pressure        = "pressure";
+constexpr std::string_view Volume          = "volume";
+constexpr std::string_view Content         = "content";
+constexpr std::string_view Id              = "id";
+constexpr std::string_view Destination     = "destination";
+constexpr std::string_view DestinationPort = "destination_port";
+constexpr std::string_view Source          = "source";
+constexpr std::string_view SourcePort      = "source_port";
+constexpr std::string_view Power           = "power";
+constexpr std::string_view TickMode        = "tick_mode";
+constexpr std::string_view KineticsTol     = "kinetics_tolerance";
+constexpr std::string_view EquilibriumTh   = "equilibrium_threshold";
+
+}  // namespace Keys
+
+using ContentMap = std::unordered_map<std::string, Amount<Unit::MOLE>>;
+
+}  // namespace
+
+bool Scenario::loadAtmosphere(const def::Object* definition)
+{
+    if (definition == nullptr) {
+        lab.emplace();
+        return true;
+    }
+
+    const auto temperature = definition->getProperty(Keys::Temperature, def::parse<Amount<Unit::CELSIUS>>);
+    const auto pressure    = definition->getProperty(Keys::Pressure, def::parse<Amount<Unit::TORR>>);
+    const auto volume =
+        definition->getDefaultProperty(Keys::Volume, 10000.0_L, def::parse<Amount<Unit::LITER>>);
+    const auto content = definition->getOptionalProperty(Keys::Content, def::parse<ContentMap>);
+    if (not temperature || not pressure) {
+        Log(this).error("Incomplete atmosphere definition, at: {}.", definition->getLocationName());
+        return false;
+    }
+
+    const auto initializer = [&]() {
+        if (not content)
+            return Atmosphere::createDefaultAtmosphere()->getContentInitializer();
+
+        ContentInitializer result;
+        for (const auto& [smiles, amount] : *content)
+            result.add(Molecule(smiles), amount);
+        return result;
+    }();
+
+    lab.emplace(std::make_unique<Atmosphere>(
+        *temperature, *pressure, initializer, volume, DumpContainer::GlobalDumpContainer));
+    return true;
+}
+
+bool Scenario::addLabware(const def::Object& definition)
+{
+    const auto name = getEntryName(definition);
+    if (name.empty()) {
+        Log(this).error("Labware entry without a name, at: {}.", definition.getLocationName());
+        return false;
+    }
+    if (findComponent(name)) {
+        Log(this).error("Duplicate labware name: '{}', at: {}.", name, definition.getLocationName());
+        return false;
+    }
+
+    const auto id = definition.getProperty(Keys::Id, def::parse<LabwareId>);
+    if (not id)
+        return false;
+
+    const auto& labware = Accessor<>::getDataStore().labware;
+    if (not labware.contains(*id)) {
+        Log(this).error("Undefined labware id: {}, at: {}.", *id, definition.getLocationName());
+        return false;
+    }
+
+    const auto component = lab->addComponent(*id);
+    if (not component) {
+        Log(this).error("Unsupported labware type for id: {}, at: {}.", *id, definition.getLocationName());
+        return false;
+    }
+
+    if (const auto power = definition.getOptionalProperty(Keys::Power, def::parse<Amount<Unit::WATT>>)) {
+        if (not component->isHeatsource()) {
+            Log(this).error("Labware: '{}' has no power output, at: {}.", name, definition.getLocationName());
+            return false;
+        }
+
+        component->as<Heatsource&>().setPowerOutput(*power);
+    }
+
+    if (const auto content = definition.getOptionalProperty(Keys::Content, def::parse<ContentMap>)) {
+        if (not component->isContainer()) {
+            Log(this).error("Labware: '{}' cannot hold content, at: {}.", name, definition.getLocationName());
+            return false;
+        }
+
+        auto& container = component->as<BaseContainerComponent&>();
+        for (const auto& [smiles, amount] : *content)
+            container.add(Molecule(smiles), amount);
+    }
+
+    const auto tickMode  = definition.getOptionalProperty(Keys::TickMode, def::parseEnum<TickMode>);
+    const auto tolerance = definition.getOptionalProperty(Keys::KineticsTol, def::parse<float_h>);
+    const auto threshold = definition.getOptionalProperty(Keys::EquilibriumTh, def::parse<float_h>);
+    if (tickMode || tolerance || threshold) {
+        auto* reactor = component->isContainer()
+                            ? dynamic_cast<Reactor*>(&component->as<BaseContainerComponent&>().getContent())
+                            : nullptr;
+        if (reactor == nullptr) {
+            Log(this).error("Labware: '{}' has no reactor, at: {}.", name, definition.getLocationName());
+            return false;
+        }
+
+        if (tickMode)
+            reactor->setTickMode(*tickMode);
+        if (tolerance)
+            reactor->enableImplicitKinetics(*tolerance);
+        if (threshold)
+            reactor->enableEquilibriumSolver(*threshold);
+    }
+
+    components.emplace_back(name, *component);
+    return true;
+}
+
+bool Scenario::addConnection(const def::Object& definition)
+{
+    const auto destinationName = definition.getProperty(Keys::Destination);
+    const auto destinationPort = definition.getProperty(Keys::DestinationPort, def::parse<uint8_t>);
+    const auto sourceName      = definition.getProperty(Keys::Source);
+    const auto sourcePort      = definition.getProperty(Keys::SourcePort, def::parse<uint8_t>);
+    if (not destinationName || not destinationPort || not sourceName || not sourcePort)
+        return false;
+
+    auto* destination = findComponent(*destinationName);
+    auto* source      = findComponent(*sourceName);
+    if (destination == nullptr || source == nullptr) {
+        Log(this).error(
+            "Connection between undefined labware: '{}' and '{}', at: {}.",
+            *destinationName,
+            *sourceName,
+            definition.getLocationName());
+        return false;
+    }
+
+    if (not lab->tryConnect(*destination, *destinationPort, *source, *sourcePort)) {
+        Log(this).error(
+            "Failed to connect: '{}:{}' to '{}:{}', at: {}.",
+            *sourceName,
+            *sourcePort,
+            *destinationName,
+            *destinationPort,
+            definition.getLocationName());
+        return false;
+    }
+
+    return true;
+}
+
+LabwareComponentBase* Scenario::findComponent(const std::string& name) const
+{
+    const auto it = std::ranges::find_if(components, [&](const auto& c) { return c.name == name; });
+    return it != components.end() ? &it->component : nullptr;
+}
+
+std::string Scenario::getEntryName(const def::Object& definition)
+{
+    // Identifiers are qualified by the file name, only the local part is used for lookups.
+    const auto& identifier = definition.getIdentifier();
+    return definition.getSpecifier() == Entries::Atmosphere ? std::string(Entries::Atmosphere)
+                                                             : identifier.substr(identifier.rfind('@') + 1);
+}
+
+bool Scenario::load(const std::string& path, const std::vector<Override>& overrides)
+{
+    if (lab) {
+        Log(this).error("Scenario already loaded.");
+        return false;
+    }
+
+    FileStore            fileStore;
+    OutlineDefRepository outlineDefinitions;
+    def::FileParser      parser(path, fileStore, outlineDefinitions);
+    if (not parser.isOpen())
+        return false;
+
+    // Entries are collected first since the atmosphere must exist before any labware is created and
+    // labware must exist before being connected.
+    std::vector<def::Object> entries;
+    bool                     success = true;
+    while (true) {
+        auto entry = parser.nextDefinition();
+        if (not parser.isOpen())
+            break;
+
+        if (not entry) {
+            Log(this).error("Parsing aborted due to invalid definition.");
+            success = false;
+            continue;
+        }
+
+        if (entry->getType() != def::DefinitionType::AUTO) {
+            Log(this).error("Scenario entries must be auto-typed, at: {}.", entry->getLocationName());
+            success = false;
+            continue;
+        }
+
+        const auto& kind = entry->getSpecifier();
+        if (kind != Entries::Atmosphere && kind != Entries::Labware && kind != Entries::Connect) {
+            Log(this).error("Unknown scenario entry: '{}', at: {}.", kind, entry->getLocationName());
+            success = false;
+            continue;
+        }
+
+        entries.emplace_back(std::move(*entry));
+    }
+
+    if (not success)
+        return false;
+
+    for (const auto& o : overrides) {
+        const auto it = std::ranges::find_if(entries, [&](const auto& e) {
+            return e.getSpecifier() != Entries::Connect && getEntryName(e) == o.entry;
+        });
+        if (it == entries.end()) {
+            Log(this).error("Override target entry: '{}' not found in: '{}'.", o.entry, path);
+            return false;
+        }
+
+        it->setProperty(o.property, utils::copy(o.value));
+    }
+
+    const def::Object* atmosphere = nullptr;
+    for (const auto& e : entries) {
+        if (e.getSpecifier() != Entries::Atmosphere)
+            continue;
+
+        if (atmosphere) {
+            Log(this).error("Duplicate atmosphere definition, at: {}.", e.getLocationName());
+            return false;
+        }
+        atmosphere = &e;
+    }
+
+    if (not loadAtmosphere(atmosphere))
+        return false;
+
+    for (const auto& e : entries)
+        if (e.getSpecifier() == Entries::Labware)
+            success &= addLabware(e);
+
+    if (not success)
+        return false;
+
+    for (const auto& e : entries)
+        if (e.getSpecifier() == Entries::Connect)
+            success &= addConnection(e);
+
+    for (const auto& e : entries)
+        e.logUnusedWarnings();
+
+    return success;
+}
+
+Lab& Scenario::getLab() { return *lab; }
+
+const Lab& Scenario::getLab() const { return *lab; }
+
+const std::vector<Scenario::NamedComponent>& Scenario::getComponents() const { return components; }
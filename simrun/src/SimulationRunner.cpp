@@ -0,0 +1,51 @@
+#include "SimulationRunner.hpp"
+
+#include <algorithm>
+
+SimulationRunner::SimulationRunner(
+    Scenario&                  scenario,
+    const TimestepController&  controller,
+    const Amount<Unit::SECOND> duration,
+    const Amount<Unit::SECOND> snapshotInterval) noexcept :
+    scenario(scenario),
+    controller(controller),
+    duration(duration),
+    snapshotInterval(snapshotInterval)
+{}
+
+size_t SimulationRunner::run(const SnapshotCallback& onSnapshot)
+{
+    auto&                lab          = scenario.getLab();
+    auto                 lastSnapshot = StateSnapshot::capture(scenario, 0.0_s);
+    Amount<Unit::SECOND> time         = 0.0_s;
+    Amount<Unit::SECOND> nextSnapshot = snapshotInterval;
+    size_t               tickCount    = 0;
+
+    if (onSnapshot)
+        onSnapshot(lastSnapshot);
+
+    while (time < duration) {
+        const auto timespan = std::min(controller.getTimespan().asStd(), (duration - time).asStd());
+        lab.tick(timespan);
+        time += timespan;
+        ++tickCount;
+
+        const bool takeSnapshot = onSnapshot && time >= nextSnapshot;
+        if (not takeSnapshot && not controller.isAdaptive())
+            continue;
+
+        auto snapshot = StateSnapshot::capture(scenario, time);
+        if (controller.isAdaptive())
+            controller.update(snapshot.getRelativeChange(lastSnapshot));
+
+        if (takeSnapshot) {
+            onSnapshot(snapshot);
+            while (nextSnapshot <= time)
+                nextSnapshot += snapshotInterval;
+        }
+
+        lastSnapshot = std::move(snapshot);
+    }
+
+    return tickCount;
+}
@@ -0,0 +1,90 @@
+#include "SnapshotWriter.hpp"
+
+#include "io/Log.hpp"
+#include "utils/Bin.hpp"
+
+#include <string_view>
+
+namespace
+{
+
+constexpr std::string_view Magic = "CHGSNAP";
+
+}  // namespace
+
+SnapshotWriter::SnapshotWriter(
+    const std::string& path, const SnapshotFormat format, std::vector<std::string>&& names) noexcept :
+    format(format),
+    names(std::move(names)),
+    out(path, format == SnapshotFormat::BINARY ? std::ios::out | std::ios::binary : std::ios::out)
+{
+    if (not out.is_open()) {
+        Log(this).error("Failed to open file: '{}' for writing.", path);
+        return;
+    }
+
+    writeHeader();
+}
+
+bool SnapshotWriter::isOpen() const { return out.is_open(); }
+
+void SnapshotWriter::writeHeader()
+{
+    if (format == SnapshotFormat::CSV) {
+        out << "time_s,container,temperature_C,pressure_torr,moles_mol,mass_g,volume_L\n";
+        return;
+    }
+
+    out.write(Magic.data(), Magic.size());
+    bin::print(out, Version);
+    bin::print(out, static_cast<uint32_t>(names.size()));
+    for (const auto& name : names) {
+        bin::print(out, static_cast<uint16_t>(name.size()));
+        out.write(name.data(), name.size());
+    }
+}
+
+void SnapshotWriter::write(const StateSnapshot& snapshot)
+{
+    if (snapshot.containers.size() != names.size()) {
+        Log(this).error(
+            "Snapshot container count: {} doesn't match the expected count: {}.",
+            snapshot.containers.size(),
+            names.size());
+        return;
+    }
+
+    if (format == SnapshotFormat::CSV) {
+        for (size_t i = 0; i < names.size(); ++i) {
+            const auto& c = snapshot.containers[i];
+            out << std::format(
+                "{},{},{},{},{},{},{}\n",
+                snapshot.time.asStd(),
+                names[i],
+                c.temperature.isUnknown() ? std::string() : std::format("{}", c.temperature.asStd()),
+                c.pressure.asStd(),
+                c.moles.asStd(),
+                c.mass.asStd(),
+                c.volume.asStd());
+        }
+        return;
+    }
+
+    bin::print(out, snapshot.time.asStd());
+    for (const auto& c : snapshot.containers) {
+        bin::print(out, c.temperature.asStd());
+        bin::print(out, c.pressure.asStd());
+        bin::print(out, c.moles.asStd());
+        bin::print(out, c.mass.asStd());
+        bin::print(out, c.volume.asStd());
+    }
+}
+
+std::optional<SnapshotFormat> SnapshotWriter::parseFormat(const std::string& str)
+{
+    if (str == "csv")
+        return SnapshotFormat::CSV;
+    if (str == "bin")
+        return SnapshotFormat::BINARY;
+    return std::nullopt;
+}
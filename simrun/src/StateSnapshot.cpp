@@ -0,0 +1,99 @@
+#include "StateSnapshot.hpp"
+
+#include "labware/kinds/BaseContainerComponent.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+float_s getRelativeChange(const float_s a, const float_s b)
+{
+    const auto scale = std::max(std::abs(a), std::abs(b));
+    return scale > std::numeric_limits<float_s>::epsilon() ? std::abs(a - b) / scale : 0.0f;
+}
+
+}  // namespace
+
+//
+// ContainerState
+//
+
+float_s ContainerState::getRelativeChange(const ContainerState& other) const
+{
+    auto change = std::max(
+        ::getRelativeChange(pressure.asStd(), other.pressure.asStd()),
+        ::getRelativeChange(moles.asStd(), other.moles.asStd()));
+
+    // Temperatures are compared on an absolute scale, since a relative change in Celsius is meaningless.
+    if (not temperature.isUnknown() && not other.temperature.isUnknown())
+        change = std::max(
+            change,
+            ::getRelativeChange(
+                Amount<Unit::KELVIN>(temperature).asStd(), Amount<Unit::KELVIN>(other.temperature).asStd()));
+
+    return change;
+}
+
+ContainerState ContainerState::capture(const Mixture& mixture)
+{
+    ContainerState state;
+    state.pressure = mixture.getPressure();
+    state.moles    = mixture.getTotalMoles();
+    state.mass     = mixture.getTotalMass();
+    state.volume   = mixture.getTotalVolume();
+
+    // Only layers holding reactants are guaranteed to exist.
+    float_s weightedSum = 0.0f;
+    float_s totalMoles  = 0.0f;
+    for (const auto& [_, reactant] : mixture.getContent()) {
+        weightedSum += mixture.getLayerTemperature(reactant.layer).asStd() * reactant.amount.asStd();
+        totalMoles  += reactant.amount.asStd();
+    }
+
+    if (totalMoles > 0.0f)
+        state.temperature = weightedSum / totalMoles;
+
+    return state;
+}
+
+//
+// StateSnapshot
+//
+
+float_s StateSnapshot::getRelativeChange(const StateSnapshot& other) const
+{
+    float_s change = 0.0f;
+    for (size_t i = 0; i < std::min(containers.size(), other.containers.size()); ++i)
+        change = std::max(change, containers[i].getRelativeChange(other.containers[i]));
+    return change;
+}
+
+StateSnapshot StateSnapshot::capture(const Scenario& scenario, const Amount<Unit::SECOND> time)
+{
+    StateSnapshot snapshot;
+    snapshot.time = time;
+    snapshot.containers.reserve(scenario.getComponents().size() + 1);
+
+    snapshot.containers.emplace_back(ContainerState::capture(scenario.getLab().getAtmosphere()));
+    for (const auto& [_, component] : scenario.getComponents())
+        if (component.isContainer())
+            snapshot.containers.emplace_back(
+                ContainerState::capture(component.as<BaseContainerComponent&>().getContent()));
+
+    return snapshot;
+}
+
+std::vector<std::string> StateSnapshot::getObservedNames(const Scenario& scenario)
+{
+    std::vector<std::string> names;
+    names.reserve(scenario.getComponents().size() + 1);
+
+    names.emplace_back("atmosphere");
+    for (const auto& [name, component] : scenario.getComponents())
+        if (component.isContainer())
+            names.emplace_back(name);
+
+    return names;
+}
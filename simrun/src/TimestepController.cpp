@@ -0,0 +1,45 @@
+#include "TimestepController.hpp"
+
+#include <algorithm>
+
+TimestepController::TimestepController(
+    const Amount<Unit::SECOND> timespan,
+    const Amount<Unit::SECOND> minTimespan,
+    const Amount<Unit::SECOND> maxTimespan,
+    const float_s              tolerance) noexcept :
+    timespan(timespan),
+    minTimespan(minTimespan),
+    maxTimespan(maxTimespan),
+    tolerance(tolerance)
+{}
+
+bool TimestepController::isAdaptive() const { return tolerance > 0.0f; }
+
+Amount<Unit::SECOND> TimestepController::getTimespan() const { return timespan; }
+
+void TimestepController::update(const float_s relativeChange)
+{
+    if (not isAdaptive())
+        return;
+
+    // The growth is limited so a single quiet tick can't jump over fast transients, while the shrink is
+    // stronger in order to react quickly once the state starts changing.
+    constexpr float_s Safety    = 0.9f;
+    constexpr float_s MinFactor = 0.2f;
+    constexpr float_s MaxFactor = 2.0f;
+
+    const auto factor =
+        relativeChange > 0.0f ? std::clamp(Safety * tolerance / relativeChange, MinFactor, MaxFactor) : MaxFactor;
+    timespan = std::clamp(timespan.asStd() * factor, minTimespan.asStd(), maxTimespan.asStd());
+}
+
+TimestepController TimestepController::createFixed(const Amount<Unit::SECOND> timespan)
+{
+    return TimestepController(timespan, timespan, timespan, 0.0f);
+}
+
+TimestepController TimestepController::createAdaptive(
+    const Amount<Unit::SECOND> minTimespan, const Amount<Unit::SECOND> maxTimespan, const float_s tolerance)
+{
+    return TimestepController(minTimespan, minTimespan, maxTimespan, tolerance);
+}
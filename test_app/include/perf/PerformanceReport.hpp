@@ -12,6 +12,7 @@ class PerformanceReport
 private:
     std::string                         timestamp = "";
     std::map<std::string, TimingResult> timeTable;
+    std::map<std::string, size_t>       memoryTable;
 
 public:
     PerformanceReport()                         = default;
@@ -21,6 +22,7 @@ public:
     static std::optional<PerformanceReport> fromFile(const std::string& path);
 
     void add(const std::string& key, const TimingResult& time);
+    void addMemory(const std::string& key, const size_t bytes);
     void merge(PerformanceReport&& other);
     void setTimestamp();
 
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "global/SizeTypedefs.hpp"
+#include "mixtures/ContentInitializer.hpp"
+#include "molecules/MolecularStructure.hpp"
+#include "reactions/data/ReactionData.hpp"
+
+#include <random>
+#include <string>
+
+/// <summary>
+/// Generates deterministic synthetic workloads (structures, reaction libraries, reactor contents)
+/// used by the scaling benchmarks. The same seed always yields the same workload.
+/// </summary>
+class WorkloadGenerator
+{
+private:
+    std::mt19937 engine;
+
+    size_t     getRandomIndex(const size_t size);
+    float_s    getRandomRatio();
+    std::string generateBackbone(const uint8_t length);
+
+public:
+    WorkloadGenerator(const uint32_t seed = 0) noexcept;
+    WorkloadGenerator(const WorkloadGenerator&) = default;
+    WorkloadGenerator(WorkloadGenerator&&)      = default;
+
+    /// <summary>
+    /// Generates a random, valence-correct SMILES containing exactly atomCount non-hydrogen atoms,
+    /// at most ringCount ring closures and approximately heteroatomRatio N/O/S atoms.
+    /// Ring closures are kept short so that the number of simultaneously open labels stays within
+    /// the two-digit range supported by the parser.
+    /// </summary>
+    std::string generateSMILES(const c_size atomCount, const c_size ringCount, const float_s heteroatomRatio);
+
+    /// <summary>
+    /// Same as generateSMILES, but returns the parsed structure.
+    /// Requires a DataStore with atom definitions to be set.
+    /// </summary>
+    MolecularStructure
+    generateStructure(const c_size atomCount, const c_size ringCount, const float_s heteroatomRatio);
+
+    /// <summary>
+    /// Generates a definition file text containing reactionCount distinct, balanced, generic substitution
+    /// reactions (RC..X + Y -> RC..Y + X), with ids starting at firstId. Estimators are defined inline so the
+    /// resulting file only depends on the radical definitions.
+    /// </summary>
+    std::string generateReactionLibrary(const size_t reactionCount, const ReactionId firstId);
+    bool writeReactionLibrary(const std::string& path, const size_t reactionCount, const ReactionId firstId);
+
+    /// <summary>
+    /// Generates reactor content with speciesCount distinct random molecules (at most one ring each),
+    /// sharing the given total amount. Molecule sizes grow with speciesCount in order to avoid running out
+    /// of isomers.
+    /// Requires a DataStore with atom definitions to be set.
+    /// </summary>
+    ContentInitializer generateContent(const size_t speciesCount, const Amount<Unit::MOLE> totalAmount);
+};
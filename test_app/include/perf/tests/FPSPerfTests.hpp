@@ -2,9 +2,12 @@
 
 #include "data/DataStore.hpp"
 #include "labware/Lab.hpp"
+#include "labware/LabRecorder.hpp"
 #include "mixtures/kinds/Reactor.hpp"
 #include "perf/PerfTest.hpp"
 
+#include <sstream>
+
 class FPSPerfTestBase : public TimedTest
 {
 protected:
@@ -55,6 +58,29 @@ public:
     void task() override final;
 };
 
+/// <summary>
+/// Replays a scripted session, so that every run measures the exact same ticks, independently of real time.
+/// The session is only recorded by setup(), once the test is run, and the replay is restarted when it ends.
+/// </summary>
+class LabReplayPerfTest : public TimedTest
+{
+private:
+    std::string                recording;
+    std::istringstream         stream;
+    Lab                        lab;
+    std::optional<LabReplayer> replayer;
+
+    void record();
+    void restart();
+
+public:
+    LabReplayPerfTest(std::string&& name, const std::variant<size_t, std::chrono::nanoseconds> limit) noexcept;
+
+    void setup() override final;
+    void preTask() override final;
+    void task() override final;
+};
+
 class FPSPerfTests : public PerfTestGroup
 {
 private:
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "data/DataStore.hpp"
+#include "perf/PerfTest.hpp"
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Loads the given definition files into a fresh DataStore and records the process resident memory
+/// growth together with the per-repository memory accounting. The load time is reported as timing.
+/// </summary>
+class MemoryFootprintPerfTest : public PerfTest
+{
+private:
+    const std::vector<std::string> paths;
+    DataStore                      dataStore;
+
+public:
+    MemoryFootprintPerfTest(std::string&& name, std::vector<std::string>&& paths) noexcept;
+
+    size_t                   getTestCount() const override final;
+    std::chrono::nanoseconds getEstimatedRunTime() const override final;
+
+    TimingResult run(PerformanceReport& report) override final;
+};
+
+class MemoryPerfTests : public PerfTestGroup
+{
+public:
+    MemoryPerfTests(
+        std::string&&      name,
+        const std::regex&  filter,
+        const std::string& defModulePath,
+        const std::string& radicalsPath) noexcept;
+};
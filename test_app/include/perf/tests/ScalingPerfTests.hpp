@@ -0,0 +1,149 @@
+#pragma once
+
+#include "data/DataStore.hpp"
+#include "mixtures/kinds/DumpContainer.hpp"
+#include "mixtures/ReactorBatch.hpp"
+#include "mixtures/kinds/Reactor.hpp"
+#include "perf/PerfTest.hpp"
+
+#include <optional>
+
+class ReactionLibrarySetup : public TestSetup
+{
+private:
+    const std::string path;
+    const size_t      reactionCount;
+    const uint32_t    seed;
+
+public:
+    ReactionLibrarySetup(std::string&& path, const size_t reactionCount, const uint32_t seed) noexcept;
+
+    void run() override final;
+};
+
+class ScalingSMILESPerfTest : public TimedTest
+{
+private:
+    volatile bool     dontOptimize = true;
+    const std::string smiles;
+
+public:
+    ScalingSMILESPerfTest(
+        const std::string&                                   name,
+        const std::variant<size_t, std::chrono::nanoseconds> limit,
+        const c_size                                         atomCount,
+        const uint32_t                                       seed) noexcept;
+
+    void task() override final;
+};
+
+class ScalingMinimalCyclePerfTest : public TimedTest
+{
+private:
+    volatile bool                     dontOptimize = true;
+    const std::string                 smiles;
+    std::optional<MolecularStructure> target;
+
+public:
+    ScalingMinimalCyclePerfTest(
+        const std::string&                                   name,
+        const std::variant<size_t, std::chrono::nanoseconds> limit,
+        const c_size                                         atomCount,
+        const uint32_t                                       seed) noexcept;
+
+    void setup() override final;
+    void task() override final;
+    void cleanup() override final;
+};
+
+class ScalingReactionLoadPerfTest : public TimedTest
+{
+private:
+    const std::string radicalsPath;
+    const std::string libraryPath;
+    DataStore         dataStore;
+
+public:
+    ScalingReactionLoadPerfTest(
+        const std::string&                                   name,
+        const std::variant<size_t, std::chrono::nanoseconds> limit,
+        const size_t                                         reactionCount,
+        std::string&&                                        radicalsPath,
+        std::string&&                                        libraryPath) noexcept;
+
+    void setup() override final;
+    void preTask() override final;
+    void task() override final;
+    void postTask() override final;
+    void cleanup() override final;
+};
+
+class ScalingReactorPerfTest : public TimedTest
+{
+private:
+    const size_t   speciesCount;
+    const uint32_t seed;
+
+    DumpContainer               dump;
+    std::unique_ptr<Atmosphere> atmosphere;
+    std::optional<Reactor>      reactor;
+
+    // Ticks are fixed in order to keep the simulated workload independent of the measured time.
+    static constexpr Amount<Unit::SECOND> TickTimespan = 1.0f / 60.0f;
+
+public:
+    ScalingReactorPerfTest(
+        const std::string&                                   name,
+        const std::variant<size_t, std::chrono::nanoseconds> limit,
+        const size_t                                         speciesCount,
+        const uint32_t                                       seed) noexcept;
+
+    // Reactor content is generated lazily, since creating thousands of molecules is expensive
+    // and should not be paid by filtered out tests.
+    void setup() override final;
+    void task() override final;
+    void postTask() override final;
+    void cleanup() override final;
+};
+
+/// <summary>
+/// Ticks N replicas of the same reactor, either together through a ReactorBatch or each on its own.
+/// </summary>
+class ScalingReactorBatchPerfTest : public TimedTest
+{
+private:
+    const size_t replicaCount;
+    const bool   isBatched;
+
+    DumpContainer               dump;
+    std::unique_ptr<Atmosphere> atmosphere;
+    std::optional<ReactorBatch> batch;
+    std::vector<Reactor>        replicas;
+
+    static constexpr Amount<Unit::SECOND> TickTimespan = 1.0f / 60.0f;
+
+public:
+    ScalingReactorBatchPerfTest(
+        const std::string&                                   name,
+        const std::variant<size_t, std::chrono::nanoseconds> limit,
+        const size_t                                         replicaCount,
+        const bool                                           isBatched) noexcept;
+
+    void setup() override final;
+    void task() override final;
+    void postTask() override final;
+    void cleanup() override final;
+};
+
+class ScalingPerfTests : public PerfTestGroup
+{
+private:
+    DataStore dataStore;
+
+public:
+    ScalingPerfTests(
+        std::string&&      name,
+        const std::regex&  filter,
+        const std::string& defModulePath,
+        const std::string& radicalsPath) noexcept;
+};
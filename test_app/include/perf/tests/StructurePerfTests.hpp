@@ -79,10 +79,37 @@ public:
     void task() override final;
 };
 
+/// <summary>
+/// Runs the depth-first maximal mapping which preceded the branch-and-bound search, as a baseline for it.
+/// </summary>
+class StructureBaselineMaximalAtomMapPerfTest : public StructureComparePerfTestBase
+{
+public:
+    using StructureComparePerfTestBase::StructureComparePerfTestBase;
+
+    void task() override final;
+};
+
+class StructureBudgetedMaximalAtomMapPerfTest : public StructureComparePerfTestBase
+{
+private:
+    const MappingBudget budget;
+
+public:
+    StructureBudgetedMaximalAtomMapPerfTest(
+        const std::string&                                   name,
+        const std::variant<size_t, std::chrono::nanoseconds> limit,
+        const std::string&                                   targetSmiles,
+        const std::string&                                   patternSmiles,
+        const size_t                                         nodeCount) noexcept;
+
+    void task() override final;
+};
+
 class StructureSubstitutionPerfTest : public StructureComparePerfTestBase
 {
 private:
-    const std::unordered_map<c_size, c_size> atomMap;
+    const AtomMap atomMap;
 
 public:
     StructureSubstitutionPerfTest(
@@ -64,6 +64,23 @@ public:
     bool run() override final;
 };
 
+class DefFreezeUnitTest : public UnitTest
+{
+private:
+    DataStore&                     dataStore;
+    const std::vector<std::string> discoveredSmiles;
+    const size_t                   taskCount;
+
+public:
+    DefFreezeUnitTest(
+        std::string&&              name,
+        DataStore&                 dataStore,
+        std::vector<std::string>&& discoveredSmiles,
+        const size_t               taskCount) noexcept;
+
+    bool run() override final;
+};
+
 class DefUnitTests : public UnitTestGroup
 {
 private:
@@ -81,6 +81,176 @@ public:
     bool run() override final;
 };
 
+class TemporaryStateUnitTest : public ReactorUnitTest
+{
+private:
+    const float_h              threshold       = 1e-6;
+    const float_h              volumeTolerance = 0.05;
+    const uint32_t             ticks           = 4;
+    const Amount<Unit::SECOND> tickTimespan    = 1.0_s;
+    const Amount<Unit::JOULE>  energy          = 30000.0_J;
+    const Molecule             solute;
+
+public:
+    /// <summary>
+    /// Heats the polar layer past the boiling point of the given solute, which must boil before the solvent.
+    /// </summary>
+    TemporaryStateUnitTest(
+        std::string&&             name,
+        const Amount<Unit::LITER> maxVolume,
+        const ContentInitializer& content,
+        const Molecule&           solute) noexcept;
+
+    bool run() override final;
+};
+
+class RejectedReactantUnitTest : public ReactorUnitTest
+{
+private:
+    const Molecule absent;
+
+public:
+    /// <summary>
+    /// Removes the given molecule, which must not be in the content, from the polar layer of the reactor.
+    /// </summary>
+    RejectedReactantUnitTest(
+        std::string&&             name,
+        const Amount<Unit::LITER> maxVolume,
+        const ContentInitializer& content,
+        const Molecule&           absent) noexcept;
+
+    bool run() override final;
+};
+
+class ImplicitKineticsUnitTest : public ReactorUnitTest
+{
+private:
+    const float_h              threshold         = 5e-2;
+    const uint32_t             referenceTicks    = 1280;
+    const Amount<Unit::SECOND> referenceTimespan = 0.05_s;
+    const uint32_t             implicitTicks     = 16;
+    const Amount<Unit::SECOND> implicitTimespan  = 4.0_s;
+
+public:
+    using ReactorUnitTest::ReactorUnitTest;
+
+    bool run() override final;
+};
+
+class EquilibriumUnitTest : public UnitTest
+{
+private:
+    const float_h threshold        = 1e-3;
+    const float_h kineticsTimespan = 1000.0;
+    const float_h forwardConstant  = 0.8;
+    const float_h backwardConstant = 0.2;
+
+public:
+    using UnitTest::UnitTest;
+
+    bool run() override final;
+};
+
+class SteadyStateUnitTest : public ReactorUnitTest
+{
+private:
+    const uint32_t             maxSettleTicks = 256;
+    const uint32_t             steadyTicks    = 64;
+    const Amount<Unit::SECOND> tickTimespan   = 1.0_s;
+    const Amount<Unit::JOULE>  energyStep     = 1000.0_J;
+
+public:
+    using ReactorUnitTest::ReactorUnitTest;
+
+    bool run() override final;
+};
+
+class SleepUnitTest : public ReactorUnitTest
+{
+private:
+    const uint32_t             maxSettleTicks = 256;
+    const Amount<Unit::SECOND> tickTimespan   = 1.0_s;
+
+public:
+    using ReactorUnitTest::ReactorUnitTest;
+
+    bool run() override final;
+};
+
+class TickModeUnitTest : public ReactorUnitTest
+{
+private:
+    const float_h              threshold     = 1e-4;
+    const uint32_t             disabledTicks = 32;
+    const Amount<Unit::SECOND> tickTimespan  = 1.0_s;
+
+public:
+    using ReactorUnitTest::ReactorUnitTest;
+
+    bool run() override final;
+};
+
+class TransactionUnitTest : public ReactorUnitTest
+{
+public:
+    using ReactorUnitTest::ReactorUnitTest;
+
+    bool run() override final;
+};
+
+class SnapshotUnitTest : public ReactorUnitTest
+{
+private:
+    const float_h              threshold    = 1e-4;
+    const uint32_t             ticks        = 64;
+    const Amount<Unit::SECOND> tickTimespan = 1.0_s;
+
+public:
+    using ReactorUnitTest::ReactorUnitTest;
+
+    bool run() override final;
+};
+
+class CheckpointUnitTest : public ReactorUnitTest
+{
+private:
+    const float_h              threshold    = 1e-4;
+    const uint32_t             ticks        = 64;
+    const Amount<Unit::SECOND> tickTimespan = 1.0_s;
+
+public:
+    using ReactorUnitTest::ReactorUnitTest;
+
+    bool run() override final;
+};
+
+class ReplayUnitTest : public UnitTest
+{
+private:
+    const float_h              threshold    = 1e-4;
+    const uint32_t             ticks        = 64;
+    const Amount<Unit::SECOND> tickTimespan = 1.0_s;
+
+public:
+    using UnitTest::UnitTest;
+
+    bool run() override final;
+};
+
+class BatchUnitTest : public ReactorUnitTest
+{
+private:
+    const float_h              threshold    = 1e-4;
+    const uint32_t             ticks        = 64;
+    const Amount<Unit::SECOND> tickTimespan = 1.0_s;
+    const size_t               replicaCount = 8;
+
+public:
+    using ReactorUnitTest::ReactorUnitTest;
+
+    bool run() override final;
+};
+
 class IncompatibleForwardingUnitTest : public ReactorUnitTest
 {
 private:
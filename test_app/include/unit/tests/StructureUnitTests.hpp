@@ -54,16 +54,21 @@ public:
 class StructureMaximalAtomMapUnitTest : public UnitTest
 {
 private:
-    const size_t             expectedSize;
-    const MolecularStructure target;
-    const MolecularStructure pattern;
+    const size_t                 expectedSize;
+    const std::optional<AtomMap> expectedMap;
+    const MolecularStructure     target;
+    const MolecularStructure     pattern;
 
 public:
+    /// <summary>
+    /// If an expected map is given, the chosen mapping must match it exactly (indices are canonical).
+    /// </summary>
     StructureMaximalAtomMapUnitTest(
-        const std::string& name,
-        const std::string& targetSmiles,
-        const std::string& patternSmiles,
-        const size_t       expectedSize) noexcept;
+        const std::string&            name,
+        const std::string&            targetSmiles,
+        const std::string&            patternSmiles,
+        const size_t                  expectedSize,
+        const std::optional<AtomMap>& expectedMap = std::nullopt) noexcept;
 
     bool run() override final;
 };
@@ -119,15 +124,38 @@ public:
     bool run() override final;
 };
 
+/// <summary>
+/// Checks the exact cycles of the minimal basis, each given as atom indices. The order of the cycles and of their
+/// atoms is ignored.
+/// </summary>
+class MinimalCycleBasisUnitTest : public UnitTest
+{
+private:
+    std::vector<std::vector<c_size>> expectedCycles;
+    const MolecularStructure         molecule;
+
+public:
+    MinimalCycleBasisUnitTest(
+        const std::string&                 name,
+        const std::string&                 moleculeSmiles,
+        std::vector<std::vector<c_size>>&& expectedCycles) noexcept;
+
+    bool run() override final;
+};
+
 class ASCIIPrintUnitTest : public UnitTest
 {
 private:
-    const bool               allowLinearCycleExpansion;
-    const MolecularStructure molecule;
+    const bool                allowLinearCycleExpansion;
+    const ASCII::LayoutBudget budget;
+    const MolecularStructure  molecule;
 
 public:
     ASCIIPrintUnitTest(
-        const std::string& name, const std::string& moleculeSmiles, const bool allowLinearCycleExpansion) noexcept;
+        const std::string&         name,
+        const std::string&         moleculeSmiles,
+        const bool                 allowLinearCycleExpansion,
+        const ASCII::LayoutBudget& budget = ASCII::LayoutBudget()) noexcept;
 
     bool run() override final;
 };
@@ -143,6 +171,43 @@ public:
     bool run() override final;
 };
 
+/// <summary>
+/// Checks that parsing unknown symbols from untrusted input doesn't intern them.
+/// </summary>
+class UntrustedSymbolUnitTest : public UnitTest
+{
+private:
+    const std::string ascii;
+    const std::string molBin;
+
+public:
+    UntrustedSymbolUnitTest(const std::string& name, const std::string& ascii, const std::string& molBin) noexcept;
+
+    bool run() override final;
+};
+
+class MolBinBatchUnitTest : public UnitTest
+{
+private:
+    std::vector<MolecularStructure> molecules;
+
+public:
+    MolBinBatchUnitTest(const std::string& name, const std::vector<std::string>& moleculesSmiles) noexcept;
+
+    bool run() override final;
+};
+
+class ASCIILayoutStoreUnitTest : public UnitTest
+{
+private:
+    const MolecularStructure molecule;
+
+public:
+    ASCIILayoutStoreUnitTest(const std::string& name, const std::string& moleculeSmiles) noexcept;
+
+    bool run() override final;
+};
+
 class StructureUnitTests : public UnitTestGroup
 {
 private:
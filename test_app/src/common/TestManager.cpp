@@ -4,6 +4,8 @@
 #include "perf/tests/DefPerfTests.hpp"
 #include "perf/tests/EstimatorPerfTests.hpp"
 #include "perf/tests/FPSPerfTests.hpp"
+#include "perf/tests/MemoryPerfTests.hpp"
+#include "perf/tests/ScalingPerfTests.hpp"
 #include "perf/tests/StructurePerfTests.hpp"
 #include "unit/tests/DefUnitTests.hpp"
 #include "unit/tests/EstimatorUnitTests.hpp"
@@ -33,6 +35,8 @@ PerfTests::PerfTests(const std::regex& filter) noexcept :
     registerTest<StructurePerfTests>("Structure", "./data/builtin/radicals.cdef");
     registerTest<DefPerfTests>("def", "./data/builtin/radicals.cdef");
     registerTest<FPSPerfTests>("FPS", "./data/builtin.cdef");
+    registerTest<ScalingPerfTests>("Scaling", "./data/builtin.cdef", "./data/builtin/radicals.cdef");
+    registerTest<MemoryPerfTests>("Memory", "./data/builtin.cdef", "./data/builtin/radicals.cdef");
 }
 
 TimingResult PerfTests::run(PerformanceReport& report)
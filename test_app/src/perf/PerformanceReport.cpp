@@ -25,11 +25,24 @@ void PerformanceReport::add(const std::string& key, const TimingResult& time)
     timeTable.emplace(key, time);
 }
 
+void PerformanceReport::addMemory(const std::string& key, const size_t bytes)
+{
+    auto it = memoryTable.find(key);
+    if (it != memoryTable.end())
+        Log(this).fatal("Report already contains a memory entry for: '{}'", key);
+
+    memoryTable.emplace(key, bytes);
+}
+
 void PerformanceReport::merge(PerformanceReport&& other)
 {
     this->timeTable.merge(std::move(other.timeTable));
     for (const auto& [k, t] : other.timeTable)
         this->timeTable.at(k) += t;
+
+    // Memory figures are not cumulative, the most recent ones are kept.
+    for (const auto& [k, m] : other.memoryTable)
+        this->memoryTable.insert_or_assign(k, m);
 }
 
 void PerformanceReport::setTimestamp()
@@ -42,6 +55,7 @@ void PerformanceReport::clear()
 {
     timestamp = "";
     timeTable.clear();
+    memoryTable.clear();
 }
 
 bool PerformanceReport::load(const std::string& path)
@@ -59,14 +73,19 @@ bool PerformanceReport::load(const std::string& path)
 
     std::string line;
     while (std::getline(file, line)) {
-        const auto pair = def::parse<std::pair<std::string, std::pair<int64_t, int64_t>>>(line);
-        if (not pair) {
-            Log(this).error("Invalid report line: '{}' in file: '{}'.", line, path);
+        if (const auto time = def::parse<std::pair<std::string, std::pair<int64_t, int64_t>>>(line)) {
+            add(time->first,
+                TimingResult(
+                    std::chrono::nanoseconds(time->second.first), std::chrono::nanoseconds(time->second.second)));
+            continue;
+        }
+
+        if (const auto memory = def::parse<std::pair<std::string, uint64_t>>(line)) {
+            addMemory(memory->first, static_cast<size_t>(memory->second));
             continue;
         }
 
-        add(pair->first,
-            TimingResult(std::chrono::nanoseconds(pair->second.first), std::chrono::nanoseconds(pair->second.second)));
+        Log(this).error("Invalid report line: '{}' in file: '{}'.", line, path);
     }
 
     file.close();
@@ -78,6 +97,8 @@ void PerformanceReport::dump(std::ostream& out) const
     out << timestamp << '\n';
     for (const auto& [k, t] : timeTable)
         out << def::print(std::pair(k, std::pair(t.averageTime.count(), t.medianTime.count()))) << '\n';
+    for (const auto& [k, m] : memoryTable)
+        out << def::print(std::pair(k, static_cast<uint64_t>(m))) << '\n';
 }
 
 void PerformanceReport::dump(const std::string& path) const
@@ -154,5 +175,45 @@ ColoredStringTable PerformanceReport::compare(const PerformanceReport& other) co
         }
     }
 
+    // Memory figures are deterministic, so a plain relative change is used.
+    const auto formatKiB = [](const float_h bytes) { return std::format("{:.2f}", bytes / 1024.0) + "KiB"; };
+
+    for (const auto& [k, m] : this->memoryTable) {
+        const auto oth = other.memoryTable.find(k);
+        if (oth == other.memoryTable.end()) {
+            const ColoredString name(k, OS::BasicColor::DARK_GREY);
+            const ColoredString thisMemoryStr(formatKiB(static_cast<float_h>(m)), OS::BasicColor::DARK_GREY);
+
+            table.addEntry({name, missing, thisMemoryStr, missing, missing});
+            continue;
+        }
+
+        const auto thisMemory  = static_cast<float_h>(m);
+        const auto otherMemory = static_cast<float_h>(oth->second);
+        const auto change =
+            (thisMemory - otherMemory) / std::max(otherMemory, std::numeric_limits<float_h>::min()) * 100.0;
+
+        const auto          color = change <= -5.0f ? OS::BasicColor::GREEN
+                                    : change < 1.0f ? OS::BasicColor::DARK_GREY
+                                    : change < 5.0f ? OS::BasicColor::DARK_YELLOW
+                                                    : OS::BasicColor::RED;
+        const ColoredString name(k, color);
+        const ColoredString otherMemoryStr(formatKiB(otherMemory), color);
+        const ColoredString thisMemoryStr(formatKiB(thisMemory), color);
+        const ColoredString diffStr(formatKiB(thisMemory - otherMemory), color);
+        const ColoredString changeStr(std::format("{:+.2f}", change) + '%', color);
+
+        table.addEntry({name, otherMemoryStr, thisMemoryStr, diffStr, changeStr});
+    }
+
+    for (const auto& [k, m] : other.memoryTable) {
+        if (not this->memoryTable.contains(k)) {
+            const ColoredString name(k, OS::BasicColor::DARK_GREY);
+            const ColoredString otherMemoryStr(formatKiB(static_cast<float_h>(m)), OS::BasicColor::DARK_GREY);
+
+            table.addEntry({name, otherMemoryStr, missing, missing, missing});
+        }
+    }
+
     return table;
 }
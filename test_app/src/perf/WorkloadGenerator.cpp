@@ -0,0 +1,291 @@
+#include "perf/WorkloadGenerator.hpp"
+
+#include "io/Log.hpp"
+
+#include <array>
+#include <fstream>
+#include <unordered_set>
+
+WorkloadGenerator::WorkloadGenerator(const uint32_t seed) noexcept :
+    engine(seed)
+{}
+
+size_t WorkloadGenerator::getRandomIndex(const size_t size)
+{
+    return std::uniform_int_distribution<size_t>(0, size - 1)(engine);
+}
+
+float_s WorkloadGenerator::getRandomRatio() { return std::uniform_real_distribution<float_s>(0.0f, 1.0f)(engine); }
+
+namespace
+{
+
+struct GeneratedAtom
+{
+    const char*         symbol;
+    uint8_t             maxDegree;
+    uint8_t             degree = 0;
+    std::vector<c_size> children;
+    std::vector<c_size> closures;
+};
+
+struct ElementChoice
+{
+    const char* symbol;
+    uint8_t     maxDegree;
+};
+
+constexpr ElementChoice Carbon = {"C", 4};
+
+constexpr std::array<ElementChoice, 3> Heteroatoms = {
+    ElementChoice{"N", 3},
+    ElementChoice{"O", 2},
+    ElementChoice{"S", 2},
+};
+
+// Sulfur is left out since its multiple valences prevent balancing.
+constexpr std::array<const char*, 6> LeavingGroups = {"F", "Cl", "Br", "I", "O", "N"};
+
+void appendRingLabel(std::string& smiles, const uint8_t label)
+{
+    if (label < 10) {
+        smiles += static_cast<char>('0' + label);
+        return;
+    }
+
+    smiles += '%';
+    smiles += static_cast<char>('0' + label / 10);
+    smiles += static_cast<char>('0' + label % 10);
+}
+
+}  // namespace
+
+std::string
+WorkloadGenerator::generateSMILES(const c_size atomCount, const c_size ringCount, const float_s heteroatomRatio)
+{
+    if (atomCount == 0)
+        return "";
+
+    std::vector<GeneratedAtom> atoms;
+    atoms.reserve(atomCount);
+
+    const auto pickElement = [&]() {
+        return getRandomRatio() < heteroatomRatio ? Heteroatoms[getRandomIndex(Heteroatoms.size())] : Carbon;
+    };
+
+    // Build a random spanning tree. Parents are picked from a small window of recently added atoms, which
+    // yields branched chains instead of star-like or purely linear shapes.
+    {
+        const auto first = pickElement();
+        atoms.emplace_back(first.symbol, first.maxDegree);
+    }
+    for (c_size i = 1; i < atomCount; ++i) {
+        const auto element = pickElement();
+
+        const auto   windowBegin = static_cast<c_size>(i > 4 ? i - 4 : 0);
+        c_size       parent      = windowBegin + static_cast<c_size>(getRandomIndex(i - windowBegin));
+        // The previously added atom is a leaf, so it always has a free valence.
+        if (atoms[parent].degree >= atoms[parent].maxDegree)
+            parent = i - 1;
+
+        atoms.emplace_back(element.symbol, element.maxDegree);
+        atoms[parent].children.emplace_back(i);
+        ++atoms[parent].degree;
+        ++atoms[i].degree;
+    }
+
+    // Compute the order in which atoms are emitted.
+    std::vector<c_size> order;
+    order.reserve(atomCount);
+    {
+        std::vector<c_size> stack = {0};
+        while (not stack.empty()) {
+            const auto idx = stack.back();
+            stack.pop_back();
+
+            order.emplace_back(idx);
+            for (auto it = atoms[idx].children.rbegin(); it != atoms[idx].children.rend(); ++it)
+                stack.emplace_back(*it);
+        }
+    }
+
+    // Add short ring closures between atoms which are close in emission order.
+    std::vector<std::pair<c_size, c_size>> closures;
+    const auto areBonded = [&](const c_size a, const c_size b) {
+        if (std::ranges::find(atoms[a].children, b) != atoms[a].children.end() ||
+            std::ranges::find(atoms[b].children, a) != atoms[b].children.end())
+            return true;
+
+        for (const auto c : atoms[a].closures)
+            if (closures[c].first == b || closures[c].second == b)
+                return true;
+        return false;
+    };
+
+    for (size_t attempt = 0; attempt < static_cast<size_t>(ringCount) * 8 && closures.size() < ringCount; ++attempt) {
+        const auto fromPos = getRandomIndex(atomCount);
+        const auto toPos   = fromPos + 2 + getRandomIndex(7);
+        if (toPos >= atomCount)
+            continue;
+
+        const auto from = order[fromPos];
+        const auto to   = order[toPos];
+        if (atoms[from].degree >= atoms[from].maxDegree || atoms[to].degree >= atoms[to].maxDegree ||
+            areBonded(from, to))
+            continue;
+
+        atoms[from].closures.emplace_back(static_cast<c_size>(closures.size()));
+        atoms[to].closures.emplace_back(static_cast<c_size>(closures.size()));
+        ++atoms[from].degree;
+        ++atoms[to].degree;
+        closures.emplace_back(from, to);
+    }
+
+    // Emit the SMILES iteratively, since generated chains can be thousands of atoms deep.
+    constexpr int32_t BranchBegin = -1;
+    constexpr int32_t BranchEnd   = -2;
+
+    std::string smiles;
+    smiles.reserve(static_cast<size_t>(atomCount) * 3);
+
+    std::vector<uint8_t> closureLabels(closures.size(), 0);
+    std::array<bool, 100> usedLabels = {};
+
+    std::vector<int32_t> stack = {0};
+    while (not stack.empty()) {
+        const auto action = stack.back();
+        stack.pop_back();
+
+        if (action == BranchBegin) {
+            smiles += '(';
+            continue;
+        }
+        if (action == BranchEnd) {
+            smiles += ')';
+            continue;
+        }
+
+        const auto& atom  = atoms[action];
+        smiles           += atom.symbol;
+
+        for (const auto c : atom.closures) {
+            if (closureLabels[c] != 0) {
+                appendRingLabel(smiles, closureLabels[c]);
+                usedLabels[closureLabels[c]] = false;
+                continue;
+            }
+
+            // Closures span at most 8 emitted atoms, so free labels are always available.
+            uint8_t label = 1;
+            while (usedLabels[label])
+                ++label;
+
+            usedLabels[label] = true;
+            closureLabels[c]  = label;
+            appendRingLabel(smiles, label);
+        }
+
+        // The last child continues the main chain, all the others are emitted as branches.
+        const auto& children = atom.children;
+        if (children.empty())
+            continue;
+
+        stack.emplace_back(children.back());
+        for (size_t i = children.size() - 1; i-- > 0;) {
+            stack.emplace_back(BranchEnd);
+            stack.emplace_back(children[i]);
+            stack.emplace_back(BranchBegin);
+        }
+    }
+
+    return smiles;
+}
+
+MolecularStructure
+WorkloadGenerator::generateStructure(const c_size atomCount, const c_size ringCount, const float_s heteroatomRatio)
+{
+    return MolecularStructure(generateSMILES(atomCount, ringCount, heteroatomRatio));
+}
+
+std::string WorkloadGenerator::generateBackbone(const uint8_t length)
+{
+    std::string backbone;
+    backbone.reserve(length * 4);
+    for (uint8_t i = 0; i < length; ++i) {
+        backbone += 'C';
+        if (getRandomRatio() < 0.25f)
+            backbone += "(C)";
+    }
+    return backbone;
+}
+
+std::string WorkloadGenerator::generateReactionLibrary(const size_t reactionCount, const ReactionId firstId)
+{
+    std::unordered_set<std::string> specifiers;
+    specifiers.reserve(reactionCount);
+
+    std::string library = ":.\n    Generated Synthetic Reaction Library.\n.:\n\n";
+    library.reserve(reactionCount * 256);
+
+    while (specifiers.size() < reactionCount) {
+        const auto  length  = static_cast<uint8_t>(1 + getRandomIndex(12));
+        const auto  chain   = 'R' + generateBackbone(length);
+        const auto* leaving = LeavingGroups[getRandomIndex(LeavingGroups.size())];
+        const auto* entering = LeavingGroups[getRandomIndex(LeavingGroups.size())];
+        if (leaving == entering)
+            continue;
+
+        auto specifier = std::format("{}{} + {} -> {}{} + {}", chain, leaving, entering, chain, entering, leaving);
+        if (specifiers.contains(specifier))
+            continue;
+
+        const auto id = static_cast<ReactionId>(firstId + specifiers.size());
+        library += std::format(
+            "_react: {} {{\n"
+            "    id:      {},\n"
+            "    name:    synthetic_{},\n"
+            "    speed_t: _: C -> mol/s {{ values: {{ -INF : 0.0, 0.0 : {:.4f}, 100.0 : {:.4f} }} }},\n"
+            "    speed_c: _: mol/mol -> 1 {{ values: {{ 0.0 : 0.0, 1.0 : 1.0 }} }},\n"
+            "    energy:  {:.1f}_J/mol,\n"
+            "}};\n\n",
+            specifier,
+            id,
+            id,
+            0.1f * getRandomRatio(),
+            1.0f + 10.0f * getRandomRatio(),
+            -1000.0f + 2000.0f * getRandomRatio());
+
+        specifiers.emplace(std::move(specifier));
+    }
+
+    return library;
+}
+
+bool WorkloadGenerator::writeReactionLibrary(
+    const std::string& path, const size_t reactionCount, const ReactionId firstId)
+{
+    std::ofstream out(path);
+    if (not out.is_open()) {
+        Log(this).error("Failed to open file: '{}' for writing.", path);
+        return false;
+    }
+
+    out << generateReactionLibrary(reactionCount, firstId);
+    return true;
+}
+
+ContentInitializer WorkloadGenerator::generateContent(const size_t speciesCount, const Amount<Unit::MOLE> totalAmount)
+{
+    ContentInitializer content;
+    const auto         amount = totalAmount / static_cast<float_s>(std::max(speciesCount, size_t(1)));
+
+    // Small molecules have a limited number of isomers, so the size range grows with the species count.
+    const auto maxAtomCount = static_cast<c_size>(std::max(size_t(12), speciesCount / 100));
+    while (content.size() < speciesCount) {
+        const auto atomCount = static_cast<c_size>(1 + getRandomIndex(maxAtomCount));
+        const auto ringCount = static_cast<c_size>(atomCount > 2 && getRandomRatio() < 0.3f ? 1 : 0);
+        content.add(Molecule(generateSMILES(atomCount, ringCount, 0.25f)), amount);
+    }
+
+    return content;
+}
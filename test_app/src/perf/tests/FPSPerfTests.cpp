@@ -58,6 +58,61 @@ LabFPSPerfTest::LabFPSPerfTest(
 
 void LabFPSPerfTest::task() { lab.tick(nextTickTimespan); }
 
+LabReplayPerfTest::LabReplayPerfTest(
+    std::string&& name, const std::variant<size_t, std::chrono::nanoseconds> limit) noexcept :
+    TimedTest(std::move(name), limit)
+{}
+
+void LabReplayPerfTest::record()
+{
+    Lab replayLab;
+    replayLab.add<Flask>(201);
+    replayLab.add<Adaptor>(301);
+    replayLab.add<Condenser>(501);
+    replayLab.add<Flask>(201);
+
+    std::ostringstream os;
+    LabRecorder        recorder(replayLab, os);
+    recorder.add(0, 0, Molecule("CC(=O)O"), 4.0_mol);
+    for (size_t i = 0; i < 200; ++i) {
+        if (i == 50)
+            recorder.add(0, 0, Molecule("CCO"), 4.0_mol);
+        else if (i == 100)
+            recorder.setTimeMultiplier(10.0f);
+        else if (i % 10 == 0)
+            recorder.addEnergy(0, 0, 5000.0_J);
+
+        recorder.tick(1.0_s / 60.0f);
+    }
+
+    recording = os.str();
+}
+
+void LabReplayPerfTest::restart()
+{
+    // The reader of the previous replay refers to the stream, so it's destroyed first.
+    replayer.reset();
+    stream.clear();
+    stream.str(recording);
+    replayer.emplace(stream, lab);
+}
+
+void LabReplayPerfTest::setup()
+{
+    // The session is recorded once, its replays being independent of the time taken by each tick.
+    if (recording.empty())
+        record();
+    restart();
+}
+
+void LabReplayPerfTest::preTask()
+{
+    if (replayer->isAtEnd())
+        restart();
+}
+
+void LabReplayPerfTest::task() { replayer->replayTick(); }
+
 FPSPerfTests::FPSPerfTests(std::string&& name, const std::regex& filter, const std::string& defModulePath) noexcept :
     PerfTestGroup(std::move(name), filter)
 {
@@ -81,5 +136,14 @@ FPSPerfTests::FPSPerfTests(std::string&& name, const std::regex& filter, const s
 
     registerTest<LabFPSPerfTest>("lab_default", std::chrono::seconds(30), std::move(lab));
 
+    // Quiescent flasks go to sleep, so idle labs should cost almost nothing per tick.
+    Lab idleLab;
+    for (size_t i = 0; i < 100; ++i)
+        idleLab.add<Flask>(201).add(Molecule("O"), 2.0_mol);
+
+    registerTest<LabFPSPerfTest>("lab_idle", std::chrono::seconds(30), std::move(idleLab));
+
+    registerTest<LabReplayPerfTest>("lab_replay", std::chrono::seconds(30));
+
     registerTest<PerfTestSetup<AccessorTestCleanup>>("cleanup");
 }
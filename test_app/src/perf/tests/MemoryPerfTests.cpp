@@ -0,0 +1,89 @@
+#include "perf/tests/MemoryPerfTests.hpp"
+
+#include "io/Log.hpp"
+#include "perf/PerformanceReport.hpp"
+#include "perf/tests/ScalingPerfTests.hpp"
+#include "utils/Process.hpp"
+#include "utils/STL.hpp"
+
+//
+// MemoryFootprintPerfTest
+//
+
+MemoryFootprintPerfTest::MemoryFootprintPerfTest(std::string&& name, std::vector<std::string>&& paths) noexcept :
+    PerfTest(std::move(name)),
+    paths(std::move(paths))
+{}
+
+size_t MemoryFootprintPerfTest::getTestCount() const { return 1; }
+
+std::chrono::nanoseconds MemoryFootprintPerfTest::getEstimatedRunTime() const { return std::chrono::seconds(1); }
+
+TimingResult MemoryFootprintPerfTest::run(PerformanceReport& report)
+{
+    // The store is only released together with the test, since memory freed by a previous test could
+    // be reused by the allocator and hide the resident growth of the following ones.
+    Accessor<>::setDataStore(dataStore);
+    LogBase::hide();
+
+    const auto rssBefore = OS::getCurrentProcessMemoryUsage();
+    const auto start     = std::chrono::high_resolution_clock::now();
+
+    for (const auto& path : paths)
+        if (not dataStore.load(path))
+            Log(this).error("Failed to load: '{}'.", path);
+
+    const auto time     = std::chrono::high_resolution_clock::now() - start;
+    const auto rssAfter = OS::getCurrentProcessMemoryUsage();
+
+    LogBase::unhide();
+
+    const auto& name = getName();
+    report.addMemory(name + ".rss", rssAfter > rssBefore ? rssAfter - rssBefore : 0);
+    report.addMemory(name + ".total", dataStore.getMemoryUsage());
+    report.addMemory(name + ".files", dataStore.fileStore.getMemoryUsage());
+    report.addMemory(name + ".outline", dataStore.outlineDefinitions.getMemoryUsage());
+    report.addMemory(name + ".atoms", dataStore.atoms.getMemoryUsage());
+    report.addMemory(name + ".estimators", dataStore.estimators.getMemoryUsage());
+    report.addMemory(name + ".molecules", dataStore.molecules.getMemoryUsage());
+    report.addMemory(name + ".reactions", dataStore.reactions.getMemoryUsage());
+    report.addMemory(name + ".labware", dataStore.labware.getMemoryUsage());
+
+    Log(this).info(
+        "\r{}: {} definitions, {}KiB accounted, {}KiB resident.",
+        name,
+        dataStore.totalDefinitionCount(),
+        dataStore.getMemoryUsage() / 1024,
+        (rssAfter > rssBefore ? rssAfter - rssBefore : 0) / 1024);
+
+    Accessor<>::unsetDataStore();
+
+    const TimingResult result(time, time);
+    report.add(name, result);
+    return result;
+}
+
+//
+// MemoryPerfTests
+//
+
+MemoryPerfTests::MemoryPerfTests(
+    std::string&&      name,
+    const std::regex&  filter,
+    const std::string& defModulePath,
+    const std::string& radicalsPath) noexcept :
+    PerfTestGroup(std::move(name), filter)
+{
+    registerTest<MemoryFootprintPerfTest>("radicals", std::vector<std::string>{radicalsPath});
+
+    registerTest<MemoryFootprintPerfTest>("builtin", std::vector<std::string>{defModulePath});
+
+    registerTest<PerfTestSetup<CreateDirTestSetup>>("setup", "./temp");
+    for (const size_t reactionCount : {100, 1'000, 10'000}) {
+        auto path = "./temp/reactions_" + std::to_string(reactionCount) + ".cdef";
+        registerTest<PerfTestSetup<ReactionLibrarySetup>>("setup", utils::copy(path), reactionCount, 5);
+        registerTest<MemoryFootprintPerfTest>(
+            "reactions_" + std::to_string(reactionCount), std::vector<std::string>{radicalsPath, std::move(path)});
+    }
+    registerTest<PerfTestSetup<RemoveDirTestSetup>>("cleanup", "./temp");
+}
@@ -0,0 +1,246 @@
+#include "perf/tests/ScalingPerfTests.hpp"
+
+#include "io/Log.hpp"
+#include "perf/WorkloadGenerator.hpp"
+
+//
+// ReactionLibrarySetup
+//
+
+ReactionLibrarySetup::ReactionLibrarySetup(std::string&& path, const size_t reactionCount, const uint32_t seed) noexcept
+    :
+    path(std::move(path)),
+    reactionCount(reactionCount),
+    seed(seed)
+{}
+
+void ReactionLibrarySetup::run()
+{
+    // Ids are chosen so they don't collide with the built-in reactions.
+    if (not WorkloadGenerator(seed).writeReactionLibrary(path, reactionCount, 1000))
+        Log(this).error("Failed to generate reaction library: '{}' during setup.", path);
+}
+
+//
+// ScalingSMILESPerfTest
+//
+
+ScalingSMILESPerfTest::ScalingSMILESPerfTest(
+    const std::string&                                   name,
+    const std::variant<size_t, std::chrono::nanoseconds> limit,
+    const c_size                                         atomCount,
+    const uint32_t                                       seed) noexcept :
+    TimedTest(name + '_' + std::to_string(atomCount), limit),
+    smiles(WorkloadGenerator(seed).generateSMILES(atomCount, atomCount / 10, 0.2f))
+{}
+
+void ScalingSMILESPerfTest::task() { dontOptimize = MolecularStructure::fromSMILES(smiles)->isEmpty(); }
+
+//
+// ScalingMinimalCyclePerfTest
+//
+
+ScalingMinimalCyclePerfTest::ScalingMinimalCyclePerfTest(
+    const std::string&                                   name,
+    const std::variant<size_t, std::chrono::nanoseconds> limit,
+    const c_size                                         atomCount,
+    const uint32_t                                       seed) noexcept :
+    TimedTest(name + '_' + std::to_string(atomCount), limit),
+    smiles(WorkloadGenerator(seed).generateSMILES(atomCount, atomCount / 10, 0.2f))
+{}
+
+void ScalingMinimalCyclePerfTest::setup() { target.emplace(smiles); }
+
+void ScalingMinimalCyclePerfTest::task() { dontOptimize = static_cast<bool>(target->getMinimalCycleBasis().size()); }
+
+void ScalingMinimalCyclePerfTest::cleanup() { target.reset(); }
+
+//
+// ScalingReactionLoadPerfTest
+//
+
+ScalingReactionLoadPerfTest::ScalingReactionLoadPerfTest(
+    const std::string&                                   name,
+    const std::variant<size_t, std::chrono::nanoseconds> limit,
+    const size_t                                         reactionCount,
+    std::string&&                                        radicalsPath,
+    std::string&&                                        libraryPath) noexcept :
+    TimedTest(name + '_' + std::to_string(reactionCount), limit),
+    radicalsPath(std::move(radicalsPath)),
+    libraryPath(std::move(libraryPath))
+{}
+
+void ScalingReactionLoadPerfTest::setup()
+{
+    Accessor<>::setDataStore(dataStore);
+    if (not dataStore.load(radicalsPath))
+        Log(this).error("Failed to load: '{}' during setup.", radicalsPath);
+}
+
+void ScalingReactionLoadPerfTest::preTask() { Accessor<>::setDataStore(dataStore); }
+
+void ScalingReactionLoadPerfTest::task() { dataStore.load(libraryPath); }
+
+void ScalingReactionLoadPerfTest::postTask()
+{
+    // Only the reaction library is reloaded, atom and radical definitions are kept.
+    dataStore.reactions.clear();
+    dataStore.molecules.clear();
+    dataStore.estimators.clear();
+    dataStore.fileStore.clear();
+}
+
+void ScalingReactionLoadPerfTest::cleanup()
+{
+    dataStore.clear();
+    Accessor<>::unsetDataStore();
+}
+
+//
+// ScalingReactorPerfTest
+//
+
+ScalingReactorPerfTest::ScalingReactorPerfTest(
+    const std::string&                                   name,
+    const std::variant<size_t, std::chrono::nanoseconds> limit,
+    const size_t                                         speciesCount,
+    const uint32_t                                       seed) noexcept :
+    TimedTest(name + '_' + std::to_string(speciesCount), limit),
+    speciesCount(speciesCount),
+    seed(seed)
+{}
+
+void ScalingReactorPerfTest::setup()
+{
+    atmosphere = Atmosphere::createDefaultAtmosphere();
+    atmosphere->setOverflowTarget(dump);
+    reactor.emplace(*atmosphere, 100.0_L);
+
+    const auto content = WorkloadGenerator(seed).generateContent(speciesCount, 10.0_mol);
+    for (const auto& m : content)
+        reactor->add(m.first, m.second);
+}
+
+void ScalingReactorPerfTest::task() { reactor->tick(TickTimespan); }
+
+void ScalingReactorPerfTest::postTask() { atmosphere->tick(TickTimespan); }
+
+void ScalingReactorPerfTest::cleanup()
+{
+    reactor.reset();
+    atmosphere.reset();
+}
+
+//
+// ScalingReactorBatchPerfTest
+//
+
+ScalingReactorBatchPerfTest::ScalingReactorBatchPerfTest(
+    const std::string&                                   name,
+    const std::variant<size_t, std::chrono::nanoseconds> limit,
+    const size_t                                         replicaCount,
+    const bool                                           isBatched) noexcept :
+    TimedTest(name + '_' + std::to_string(replicaCount), limit),
+    replicaCount(replicaCount),
+    isBatched(isBatched)
+{}
+
+void ScalingReactorBatchPerfTest::setup()
+{
+    atmosphere = Atmosphere::createDefaultAtmosphere();
+    atmosphere->setOverflowTarget(dump);
+
+    Reactor prototype(*atmosphere, 100.0_L);
+    prototype.add(Molecule("CC(=O)O"), 4.0_mol);
+    prototype.add(Molecule("CCO"), 4.0_mol);
+    prototype.add(Molecule("O"), 2.0_mol);
+
+    if (isBatched)
+        batch.emplace(prototype, replicaCount);
+    else {
+        replicas.reserve(replicaCount);
+        for (size_t i = 0; i < replicaCount; ++i)
+            replicas.emplace_back(prototype.makeCopy());
+    }
+
+    // Replicas only differ in their energy, so they keep reacting at different rates.
+    for (size_t i = 0; i < replicaCount; ++i) {
+        auto& replica = isBatched ? batch->getReplica(i) : replicas[i];
+        replica.addEnergy(100.0_J * static_cast<float_s>(i));
+    }
+}
+
+void ScalingReactorBatchPerfTest::task()
+{
+    if (isBatched) {
+        batch->tick(TickTimespan);
+        return;
+    }
+
+    for (auto& r : replicas)
+        r.tick(TickTimespan);
+}
+
+void ScalingReactorBatchPerfTest::postTask() { atmosphere->tick(TickTimespan); }
+
+void ScalingReactorBatchPerfTest::cleanup()
+{
+    batch.reset();
+    replicas.clear();
+    atmosphere.reset();
+}
+
+//
+// ScalingPerfTests
+//
+
+ScalingPerfTests::ScalingPerfTests(
+    std::string&&      name,
+    const std::regex&  filter,
+    const std::string& defModulePath,
+    const std::string& radicalsPath) noexcept :
+    PerfTestGroup(std::move(name), filter)
+{
+    registerTest<PerfTestSetup<AccessorTestSetup>>("setup", dataStore, defModulePath);
+
+    // Structures: N atoms with N/10 rings.
+    registerTest<ScalingSMILESPerfTest>("SMILES", std::chrono::seconds(4), c_size(10), 1);
+    registerTest<ScalingSMILESPerfTest>("SMILES", std::chrono::seconds(4), c_size(100), 1);
+    registerTest<ScalingSMILESPerfTest>("SMILES", std::chrono::seconds(4), c_size(1'000), 1);
+    registerTest<ScalingSMILESPerfTest>("SMILES", std::chrono::seconds(4), c_size(10'000), 1);
+
+    registerTest<ScalingMinimalCyclePerfTest>("min_cycle", std::chrono::seconds(4), c_size(10), 2);
+    registerTest<ScalingMinimalCyclePerfTest>("min_cycle", std::chrono::seconds(4), c_size(100), 2);
+    registerTest<ScalingMinimalCyclePerfTest>("min_cycle", std::chrono::seconds(4), c_size(1'000), 2);
+    registerTest<ScalingMinimalCyclePerfTest>("min_cycle", size_t(5), c_size(10'000), 2);
+
+    // Reaction libraries: N generic reactions.
+    registerTest<PerfTestSetup<CreateDirTestSetup>>("setup", "./temp");
+    for (const size_t reactionCount : {10, 100, 1'000, 10'000}) {
+        auto path = "./temp/reactions_" + std::to_string(reactionCount) + ".cdef";
+        registerTest<PerfTestSetup<ReactionLibrarySetup>>("setup", utils::copy(path), reactionCount, 3);
+        registerTest<ScalingReactionLoadPerfTest>(
+            "reaction_load",
+            reactionCount < 1'000 ? std::variant<size_t, std::chrono::nanoseconds>(std::chrono::seconds(4))
+                                  : size_t(5),
+            reactionCount,
+            utils::copy(radicalsPath),
+            std::move(path));
+    }
+    registerTest<PerfTestSetup<RemoveDirTestSetup>>("cleanup", "./temp");
+
+    // Reactors: M species.
+    // Reaction discovery iterates over all reactant arrangements, so 10k species is left out for now.
+    registerTest<PerfTestSetup<AccessorTestSetup>>("setup", dataStore);
+    registerTest<ScalingReactorPerfTest>("reactor", std::chrono::seconds(8), size_t(10), 4);
+    registerTest<ScalingReactorPerfTest>("reactor", std::chrono::seconds(8), size_t(100), 4);
+    registerTest<ScalingReactorPerfTest>("reactor", std::chrono::seconds(8), size_t(1'000), 4);
+
+    // Reactor ensembles: N replicas of the same reactor.
+    for (const size_t replicaCount : {16, 256}) {
+        registerTest<ScalingReactorBatchPerfTest>("reactor_replicas", std::chrono::seconds(8), replicaCount, false);
+        registerTest<ScalingReactorBatchPerfTest>("reactor_batch", std::chrono::seconds(8), replicaCount, true);
+    }
+
+    registerTest<PerfTestSetup<AccessorTestCleanup>>("cleanup");
+}
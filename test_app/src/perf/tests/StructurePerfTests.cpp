@@ -1,5 +1,9 @@
 #include "perf/tests/StructurePerfTests.hpp"
 
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+
 //
 // StructureSMILESPerfTest
 //
@@ -66,6 +70,153 @@ void StructureMaximalAtomMapPerfTest::task()
     dontOptimize = static_cast<bool>(target.maximalMapTo(pattern).first.size());
 }
 
+//
+// StructureBaselineMaximalAtomMapPerfTest
+//
+
+namespace
+{
+
+uint8_t getBaselineBondSimilarity(const BondedAtomBase& a, const BondedAtomBase& b)
+{
+    uint8_t                                       score = 255;
+    std::array<int8_t, BondType::BOND_TYPE_COUNT> counts{};
+
+    for (const auto& bondA : a.bonds)
+        ++counts[bondA.getType()];
+    for (const auto& bondB : b.bonds)
+        --counts[bondB.getType()];
+
+    const auto scorePerBond = static_cast<uint8_t>(a.bonds.size() / 255);
+    for (const auto& c : counts)
+        score -= c * scorePerBond;
+
+    return score;
+}
+
+uint8_t getBaselineSimilarity(const Bond& nextA, const Bond& nextB)
+{
+    if (nextA.getType() != nextB.getType())
+        return 0;
+
+    if (not nextB.getOther().getAtom().equals(nextA.getOther().getAtom()))
+        return 0;
+
+    return getBaselineBondSimilarity(nextA.getOther(), nextB.getOther());
+}
+
+std::pair<std::unordered_map<c_size, c_size>, uint8_t> baselineDFSMaximal(
+    const BondedAtomBase&       a,
+    std::unordered_set<c_size>& mappedA,
+    const BondedAtomBase&       b,
+    std::unordered_set<c_size>& mappedB)
+{
+    std::pair<std::unordered_map<c_size, c_size>, uint8_t> newMap;
+    newMap.first.emplace(a.index, b.index);
+    mappedA.emplace(a.index);
+    mappedB.emplace(b.index);
+
+    for (const auto& bondB : b.bonds) {
+        if (mappedB.contains(bondB.getOther().index))
+            continue;
+
+        // Only the largest mapping is added into the final but states need to be copied
+        std::pair<std::unordered_map<c_size, c_size>, uint8_t> maxMapping;
+        std::unordered_set<c_size>                             maxMappedA;
+        std::unordered_set<c_size>                             maxMappedB;
+        for (const auto& bondA : a.bonds) {
+            if (mappedA.contains(bondA.getOther().index))
+                continue;
+
+            const auto score = getBaselineSimilarity(bondA, bondB);
+            if (score == 0)
+                continue;
+
+            // Reversing bad branches isn't possible here, so copies are needed
+            auto mappedACopy = mappedA;
+            auto mappedBCopy = mappedB;
+            auto subMap      = baselineDFSMaximal(bondA.getOther(), mappedACopy, bondB.getOther(), mappedBCopy);
+
+            if (subMap.first.size() > maxMapping.first.size() ||
+                (subMap.first.size() == maxMapping.first.size() && score > maxMapping.second)) {
+                maxMapping = std::move(subMap);
+                maxMappedA = std::move(mappedACopy);
+                maxMappedB = std::move(mappedBCopy);
+            }
+        }
+
+        newMap.first.merge(std::move(maxMapping.first));
+        newMap.second = maxMapping.second;
+        mappedA.merge(std::move(maxMappedA));
+        mappedB.merge(std::move(maxMappedB));
+    }
+
+    return newMap;
+}
+
+/// <summary>
+/// The maximal mapping as it was before MolecularStructure::maximalMapTo() became a branch-and-bound search.
+/// It greedily commits to the best branch of every pattern neighbor, so it may miss larger mappings.
+/// </summary>
+std::pair<std::unordered_map<c_size, c_size>, uint8_t>
+baselineMaximalMapTo(const MolecularStructure& target, const MolecularStructure& pattern)
+{
+    std::pair<std::unordered_map<c_size, c_size>, uint8_t> maxMapping;
+    uint8_t                                                maxScore = 0;
+    for (c_size i = 0; i < target.getNonImpliedAtomCount(); ++i) {
+        if (maxMapping.first.contains(i))
+            continue;
+
+        const auto& targetAtom = target.getBondedAtom(i);
+        for (c_size j = 0; j < pattern.getNonImpliedAtomCount(); ++j) {
+            const auto& patternAtom = pattern.getBondedAtom(j);
+            if (patternAtom.getAtom().equals(targetAtom.getAtom()) == false)
+                continue;
+
+            const auto score = getBaselineBondSimilarity(targetAtom, patternAtom);
+
+            std::unordered_set<c_size> mappedA, mappedB;
+            auto                       map = baselineDFSMaximal(targetAtom, mappedA, patternAtom, mappedB);
+
+            // Picks largest mapping, then best 2nd comp. score, then best 1st comp. score
+            if (map.first.size() > maxMapping.first.size() ||
+                (map.first.size() == maxMapping.first.size() &&
+                 (map.second > maxMapping.second || (map.second == maxMapping.second && score > maxScore)))) {
+                maxMapping = std::move(map);
+                maxScore   = score;
+            }
+        }
+    }
+
+    return maxMapping;
+}
+
+}  // namespace
+
+void StructureBaselineMaximalAtomMapPerfTest::task()
+{
+    dontOptimize = static_cast<bool>(baselineMaximalMapTo(target, pattern).first.size());
+}
+
+//
+// StructureBudgetedMaximalAtomMapPerfTest
+//
+
+StructureBudgetedMaximalAtomMapPerfTest::StructureBudgetedMaximalAtomMapPerfTest(
+    const std::string&                                   name,
+    const std::variant<size_t, std::chrono::nanoseconds> limit,
+    const std::string&                                   targetSmiles,
+    const std::string&                                   patternSmiles,
+    const size_t                                         nodeCount) noexcept :
+    StructureComparePerfTestBase(name, limit, targetSmiles, patternSmiles),
+    budget{.nodeCount = nodeCount}
+{}
+
+void StructureBudgetedMaximalAtomMapPerfTest::task()
+{
+    dontOptimize = static_cast<bool>(target.maximalMapTo(pattern, {}, {}, budget).first.size());
+}
+
 //
 // StructureSubstitutionPerfTest
 //
@@ -143,6 +294,7 @@ StructurePerfTests::StructurePerfTests(
     registerTest<StructureSMILESPerfTest>(
         "SMILES", std::chrono::seconds(8), "CCNC14CC(CC=C1C2=C(OC)C=CC3=C2C(=C[N]3)C4)C(=O)N(C)C");
     registerTest<StructureSMILESPerfTest>("SMILES", std::chrono::seconds(8), "S(-O)(-O)(-O)(OCC)(OCCC(N(C)C)=O)C#N");
+    registerTest<StructureSMILESPerfTest>("SMILES", std::chrono::seconds(8), "C2CC1CC3C1C7C2CCC6CC4CC5CC3C45C67");
     registerTest<StructureSMILESPerfTest>(
         "SMILES",
         std::chrono::seconds(8),
@@ -203,16 +355,55 @@ StructurePerfTests::StructurePerfTests(
         std::chrono::seconds(10),
         "C(C)C(CC(C(C)C(C(C)C)(C(C)C))(C(C)C)C)CC",
         "C(C)C(CC(C(C)C(C(C)C)(C(C)C))(C(C)C)C)CC");
+    registerTest<StructureBaselineMaximalAtomMapPerfTest>(
+        "maximal_map_baseline",
+        std::chrono::seconds(10),
+        "C(C)C(CC(C(C)C(C(C)C)(C(C)C))(C(C)C)C)CC",
+        "C(C)C(CC(C(C)C(C(C)C)(C(C)C))(C(C)C)C)CC");
     registerTest<StructureMaximalAtomMapPerfTest>(
         "maximal_map",
         std::chrono::seconds(10),
         "C2CC1CC3C1C7C2CCC6CC4CC5CC3C45C67",
         "C2CC1CC3C1C7C2CCC6CC4CC5CC3C45C67");
+    registerTest<StructureBaselineMaximalAtomMapPerfTest>(
+        "maximal_map_baseline",
+        std::chrono::seconds(10),
+        "C2CC1CC3C1C7C2CCC6CC4CC5CC3C45C67",
+        "C2CC1CC3C1C7C2CCC6CC4CC5CC3C45C67");
     registerTest<StructureMaximalAtomMapPerfTest>(
         "maximal_map",
         std::chrono::seconds(10),
         "CCNC14CC(CC=C1C2=C(OC)C=CC3=C2C(=C[N]3)C4)C(=O)N(C)C",
         "N(R)C14CC(CC=C1C2=C(OR)C=CC3=C2C(=C[N]3)C4)C(=O)N(R)R");
+    registerTest<StructureBaselineMaximalAtomMapPerfTest>(
+        "maximal_map_baseline",
+        std::chrono::seconds(10),
+        "CCNC14CC(CC=C1C2=C(OC)C=CC3=C2C(=C[N]3)C4)C(=O)N(C)C",
+        "N(R)C14CC(CC=C1C2=C(OR)C=CC3=C2C(=C[N]3)C4)C(=O)N(R)R");
+
+    registerTest<StructureMaximalAtomMapPerfTest>(
+        "maximal_map",
+        std::chrono::seconds(10),
+        "CC(=O)OC(CCC2C1C(C(CC(CC=C)CC)CC2)C=O)C1",
+        "C1C2C(CC(C=O)CC2CCCC)CCC1CC(=O)OC");
+    registerTest<StructureBaselineMaximalAtomMapPerfTest>(
+        "maximal_map_baseline",
+        std::chrono::seconds(10),
+        "CC(=O)OC(CCC2C1C(C(CC(CC=C)CC)CC2)C=O)C1",
+        "C1C2C(CC(C=O)CC2CCCC)CCC1CC(=O)OC");
+
+    registerTest<StructureBudgetedMaximalAtomMapPerfTest>(
+        "maximal_map_budget",
+        std::chrono::seconds(10),
+        "CCNC14CC(CC=C1C2=C(OC)C=CC3=C2C(=C[N]3)C4)C(=O)N(C)C",
+        "N(R)C14CC(CC=C1C2=C(OR)C=CC3=C2C(=C[N]3)C4)C(=O)N(R)R",
+        1000);
+    registerTest<StructureBudgetedMaximalAtomMapPerfTest>(
+        "maximal_map_budget",
+        std::chrono::seconds(10),
+        "CC(=O)OC(CCC2C1C(C(CC(CC=C)CC)CC2)C=O)C1",
+        "C1C2C(CC(C=O)CC2CCCC)CCC1CC(=O)OC",
+        1000);
 
     registerTest<StructureSubstitutionPerfTest>(
         "substitute", std::chrono::seconds(10), "C(=O)O", "CC(=O)OCCCCCC(CCCCCC(CCC)CCC)CCCCCC");
@@ -231,6 +422,11 @@ StructurePerfTests::StructurePerfTests(
         "minimal_cycle", std::chrono::seconds(10), "CCNC14CC(CC=C1C2=C(OC)C=CC3=C2C(=C[N]3)C4)C(=O)N(C)C");
     registerTest<StructureMinimalCyclePerfTest>(
         "minimal_cycle", std::chrono::seconds(10), "C2CC1CC3C1C7C2CCC6CC4CC5CC3C45C67");
+    registerTest<StructureMinimalCyclePerfTest>(
+        "minimal_cycle",
+        std::chrono::seconds(10),
+        "C3=CC27CC18C=CC16C=C%10CCC%12C%11C=C5C=C4C(C=C2C3)C49C5=C(C6C789)C%10%11%12");
+    registerTest<StructureMinimalCyclePerfTest>("minimal_cycle", std::chrono::seconds(10), "C12C3C4C1C5C2C3C45");
 
     registerTest<ASCIIPrintTest>(
         "ascii_print", std::chrono::seconds(30), "CCN(CC)C(=O)C1CN(C2CC3=CNC4=CC=CC(=C34)C2=C1)C");
@@ -1,6 +1,8 @@
 #include "unit/tests/DefUnitTests.hpp"
 
 #include "data/def/DefinitionParser.hpp"
+#include "molecules/kinds/Molecule.hpp"
+#include "utils/ThreadPool.hpp"
 
 DefUnitTest::DefUnitTest(std::string&& name, std::string&& defLine) noexcept :
     UnitTest(std::move(name)),
@@ -109,6 +111,57 @@ bool DefClearUnitTest::run()
     return dataStore.totalDefinitionCount() == 0;
 }
 
+DefFreezeUnitTest::DefFreezeUnitTest(
+    std::string&&              name,
+    DataStore&                 dataStore,
+    std::vector<std::string>&& discoveredSmiles,
+    const size_t               taskCount) noexcept :
+    UnitTest(std::move(name)),
+    dataStore(dataStore),
+    discoveredSmiles(std::move(discoveredSmiles)),
+    taskCount(taskCount)
+{}
+
+bool DefFreezeUnitTest::run()
+{
+    dataStore.freeze();
+
+    LogBase::hide(LogType::FATAL);
+    const auto loaded = dataStore.load("./data/builtin.cdef");
+    LogBase::unhide();
+    if (loaded) {
+        Log(this).error("Frozen data store accepted new definitions.");
+        return false;
+    }
+
+    // Every task discovers the same molecules concurrently, each of them must be added exactly once.
+    const auto                           sizeBefore = dataStore.molecules.size();
+    std::vector<std::vector<MoleculeId>> ids(taskCount);
+    {
+        ThreadPool pool;
+        for (size_t i = 0; i < taskCount; ++i)
+            pool.submit([this, &ids, i]() {
+                for (const auto& smiles : discoveredSmiles)
+                    ids[i].emplace_back(Molecule(smiles).getId());
+            });
+    }
+
+    for (size_t i = 1; i < taskCount; ++i) {
+        if (ids[i] != ids.front()) {
+            Log(this).error("Task: {} discovered different molecules than task: 0.", i);
+            return false;
+        }
+    }
+
+    const auto added = dataStore.molecules.size() - sizeBefore;
+    if (added != discoveredSmiles.size()) {
+        Log(this).error("Added molecule count: {} differs from the expected count: {}.", added, discoveredSmiles.size());
+        return false;
+    }
+
+    return true;
+}
+
 DefUnitTests::DefUnitTests(std::string&& name, const std::regex& filter, const std::string& baseDefFilePath) noexcept :
     UnitTestGroup(std::move(name), filter)
 {
@@ -253,6 +306,11 @@ DefUnitTests::DefUnitTests(std::string&& name, const std::regex& filter, const s
     registerTest<DefClearUnitTest>("clear", dataStore);
     registerTest<DefLoadUnitTest>("load_pretty", dataStore, "./temp/builtin_pretty.cdef", true);
     registerTest<DefCountUnitTest>("count", dataStore, 214);
+    registerTest<DefFreezeUnitTest>(
+        "freeze",
+        dataStore,
+        std::vector<std::string>{"CCCCCCCCCCCCO", "NCCCCCCCCCN", "OCC(O)CCCCCCN", "C1CCCCCCC1"},
+        16);
     registerTest<DefClearUnitTest>("clear", dataStore);
 
     registerTest<UnitTestSetup<RemoveDirTestSetup>>("cleanup", "./temp");
@@ -1,8 +1,17 @@
 #include "unit/tests/MixtureUnitTests.hpp"
 
+#include "io/Checkpoint.hpp"
 #include "io/StringTable.hpp"
+#include "labware/LabRecorder.hpp"
+#include "labware/kinds/Flask.hpp"
+#include "mixtures/MixtureTransaction.hpp"
+#include "mixtures/ReactorBatch.hpp"
 #include "utils/Build.hpp"
 
+#include <cmath>
+#include <limits>
+#include <sstream>
+
 ReactorUnitTest::ReactorUnitTest(
     std::string&&                 name,
     const Amount<Unit::LITER>     maxVolume,
@@ -334,6 +343,531 @@ bool BoilUnitTest::run()
     return true;
 }
 
+TemporaryStateUnitTest::TemporaryStateUnitTest(
+    std::string&&             name,
+    const Amount<Unit::LITER> maxVolume,
+    const ContentInitializer& content,
+    const Molecule&           solute) noexcept :
+    ReactorUnitTest(std::move(name), maxVolume, content, TickMode::ENABLE_ENERGY),
+    solute(solute)
+{}
+
+bool TemporaryStateUnitTest::run()
+{
+    const auto getAmount = [&](const LayerType layer) {
+        return reactor.getContent().getAmountOf(ReactantId(solute.getId(), layer));
+    };
+
+    const auto initialAmount = getAmount(LayerType::POLAR);
+    reactor.addEnergy(energy);
+    reactor.tick(tickTimespan);
+
+    const auto boilingPoint = solute.getBoilingPointAt(reactor.getPressure());
+    if (reactor.getLayer(LayerType::POLAR).getTemperature() <= boilingPoint) {
+        Log(this).error("Polar layer was not heated past the boiling point of the solute, test is inconclusive.");
+        return false;
+    }
+
+    // The superheated solute has to evaporate, taking the excess energy of the layer with it.
+    for (size_t i = 0; i < ticks; ++i)
+        reactor.tick(tickTimespan);
+
+    const auto liquidAmount = getAmount(LayerType::POLAR);
+    const auto gasAmount    = getAmount(LayerType::GASEOUS);
+    const auto totalAmount  = liquidAmount + gasAmount;
+    if (not totalAmount.equals(initialAmount, threshold)) {
+        Log(this).error(
+            "Amount of solute changed from: {} to: {} while evaporating.",
+            initialAmount.toString(),
+            totalAmount.toString());
+        return false;
+    }
+
+    if (gasAmount <= 0.0 || reactor.getLayer(LayerType::POLAR).getTemperature() > boilingPoint) {
+        Log(this).error("Superheated solute did not evaporate.");
+        return false;
+    }
+
+    // The evaporated solute must be removed with the volume it had in the liquid. Layer volumes don't follow
+    // thermal expansion, so only a relative match is expected.
+    const auto& polarLayer = reactor.getLayer(LayerType::POLAR);
+    auto        volume     = 0.0_L;
+    for (const auto& r : polarLayer)
+        volume += r.getVolume();
+
+    if (std::abs((polarLayer.getVolume() - volume).asStd()) > volume.asStd() * volumeTolerance) {
+        Log(this).error(
+            "Polar layer volume: {} does not match the volume of its content: {}.",
+            polarLayer.getVolume().toString(),
+            volume.toString());
+        return false;
+    }
+
+    return true;
+}
+
+RejectedReactantUnitTest::RejectedReactantUnitTest(
+    std::string&&             name,
+    const Amount<Unit::LITER> maxVolume,
+    const ContentInitializer& content,
+    const Molecule&           absent) noexcept :
+    ReactorUnitTest(std::move(name), maxVolume, content),
+    absent(absent)
+{}
+
+bool RejectedReactantUnitTest::run()
+{
+    const auto reference = reactor.makeCopy();
+
+    // The content rejects the removal, so the layers must not account for it either.
+    Mixture& mixture = reactor;
+    LogBase::hide(LogType::FATAL);
+    mixture.add(Reactant(absent, LayerType::POLAR, -1.0_mol));
+    LogBase::unhide();
+
+    if (reactor.getContent().contains(ReactantId(absent.getId(), LayerType::POLAR))) {
+        Log(this).error("Content accepted the removal of an absent reactant.");
+        return false;
+    }
+
+    if (not reactor.hasSameLayers(reference)) {
+        Log(this).error(
+            "Layers changed after a rejected removal, polar layer moles: {} (expected: {}).",
+            reactor.getLayer(LayerType::POLAR).getMoles().toString(),
+            reference.getLayer(LayerType::POLAR).getMoles().toString());
+        return false;
+    }
+
+    return true;
+}
+
+bool ImplicitKineticsUnitTest::run()
+{
+    reactor.enableImplicitKinetics();
+    auto implicit = reactor.makeCopy();
+
+    // The reference uses ticks small enough for the result not to depend on the tick timespan. Explicit
+    // references are avoided since their result depends on the order in which reactions are applied.
+    for (size_t i = 0; i < referenceTicks; ++i)
+        reactor.tick(referenceTimespan);
+    for (size_t i = 0; i < implicitTicks; ++i)
+        implicit.tick(implicitTimespan);
+
+    if (not reactor.getTotalMass().equals(implicit.getTotalMass(), threshold)) {
+        Log(this).error(
+            "Implicit reactor mass: {} differs from the reference mass: {}.",
+            implicit.getTotalMass().toString(),
+            reactor.getTotalMass().toString());
+        return false;
+    }
+
+    for (const auto& [_, r] : reactor.getContent()) {
+        const auto actual = implicit.getAmountOf(r);
+        if (not actual.equals(r.amount, threshold)) {
+            Log(this).error(
+                "Implicit amount: {} of: '{}' differs from the reference amount: {}.",
+                actual.toString(),
+                r.molecule.getStructure().toSMILES(),
+                r.amount.toString());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool EquilibriumUnitTest::run()
+{
+    // A + B <=> C + D, the reference being the steady state reached by integrating the rate system.
+    const std::vector<float_h> initialAmounts = {2.0, 3.0, 0.1, 0.0};
+
+    KineticsSolver    kinetics;
+    EquilibriumSolver equilibrium;
+    for (const auto a : initialAmounts) {
+        kinetics.addSpecies(a);
+        equilibrium.addSpecies(a);
+    }
+
+    const auto forward  = [k = forwardConstant](const float_h amount) { return k * amount; };
+    const auto backward = [k = backwardConstant](const float_h amount) { return k * amount; };
+    kinetics.addReaction({{0, 1.0}, {1, 1.0}}, {{2, 1.0}, {3, 1.0}}, forward);
+    kinetics.addReaction({{2, 1.0}, {3, 1.0}}, {{0, 1.0}, {1, 1.0}}, backward);
+    equilibrium.addReaction({{0, 1.0}, {1, 1.0}}, {{2, 1.0}, {3, 1.0}}, forward, backward);
+
+    kinetics.integrate(kineticsTimespan);
+    if (not equilibrium.solve()) {
+        Log(this).error("Equilibrium solution did not converge, imbalance: {}.", equilibrium.getImbalance());
+        return false;
+    }
+
+    for (size_t i = 0; i < initialAmounts.size(); ++i) {
+        const auto expected = kinetics.getAmount(i);
+        const auto actual   = equilibrium.getAmount(i);
+        if (not utils::floatEqual(actual, expected, threshold)) {
+            Log(this).error("Equilibrium amount: {} of species {} differs from the reference: {}.", actual, i, expected);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SteadyStateUnitTest::run()
+{
+    uint32_t settleTicks = 0;
+    for (auto revision = reactor.getRevision(); settleTicks < maxSettleTicks; ++settleTicks) {
+        reactor.tick(tickTimespan);
+        if (reactor.getRevision() == revision)
+            break;
+        revision = reactor.getRevision();
+    }
+
+    if (settleTicks == maxSettleTicks) {
+        Log(this).error("Reactor did not reach a steady state after {} ticks.", maxSettleTicks);
+        return false;
+    }
+
+    const auto steady = reactor.makeCopy();
+    for (size_t i = 0; i < steadyTicks; ++i)
+        reactor.tick(tickTimespan);
+
+    if (reactor.getRevision() != steady.getRevision() || not reactor.isSame(steady)) {
+        Log(this).error("Reactor state changed after reaching a steady state.");
+        return false;
+    }
+
+    // Changes must wake the skipped phases up.
+    reactor.addEnergy(energyStep);
+    reactor.tick(tickTimespan);
+    if (reactor.getLayerTemperature(LayerType::POLAR) <= steady.getLayerTemperature(LayerType::POLAR)) {
+        Log(this).error("Energy added to a steady state reactor was not consumed.");
+        return false;
+    }
+
+    return true;
+}
+
+bool SleepUnitTest::run()
+{
+    for (size_t i = 0; i < maxSettleTicks && not reactor.isSleeping(); ++i)
+        reactor.tick(tickTimespan);
+
+    if (not reactor.isSleeping()) {
+        Log(this).error("Quiescent reactor did not go to sleep after {} ticks.", maxSettleTicks);
+        return false;
+    }
+
+    const auto water = Molecule("O");
+    reactor.add(water, 1.0_mol);
+    if (reactor.isSleeping()) {
+        Log(this).error("Adding: '{}' did not wake the reactor up.", water.getStructure().toSMILES());
+        return false;
+    }
+
+    const auto temperature = reactor.getLayerTemperature(LayerType::POLAR);
+    reactor.addEnergy(1000.0_J);
+    reactor.tick(tickTimespan);
+    if (reactor.getLayerTemperature(LayerType::POLAR) <= temperature) {
+        Log(this).error("Energy added to a sleeping reactor was not consumed.");
+        return false;
+    }
+
+    return true;
+}
+
+bool TickModeUnitTest::run()
+{
+    const auto tickMode  = reactor.getTickMode();
+    const auto initial   = reactor.makeCopy();
+    auto       reference = reactor.makeCopy();
+
+    reactor.setTickMode(TickMode::DISABLE_ALL);
+    for (size_t i = 0; i < disabledTicks; ++i)
+        reactor.tick(tickTimespan);
+
+    if (not reactor.isSame(initial)) {
+        Log(this).error("Reactor changed while all of its phases were disabled.");
+        return false;
+    }
+
+    // Re-enabled phases must only run for the time passed since, not for the time they were disabled for.
+    reactor.setTickMode(tickMode);
+    reactor.tick(tickTimespan);
+    reference.tick(tickTimespan);
+
+    if (reactor.isSame(initial)) {
+        Log(this).error("Reactor is already in a stable state, test is inconclusive.");
+        return false;
+    }
+
+    if (not reactor.isSame(reference, threshold)) {
+        Log(this).error("Re-enabled phases ran for more than a single tick.");
+        return false;
+    }
+
+    return true;
+}
+
+bool TransactionUnitTest::run()
+{
+    const auto water   = Reactant(Molecule("O"), LayerType::POLAR, 1.0_mol);
+    const auto ethanol = Reactant(Molecule("CCO"), LayerType::POLAR, 0.5_mol);
+
+    auto               expected = reactor.makeCopy();
+    MixtureTransaction transaction(reactor);
+    transaction.add(water);
+    transaction.add(ethanol);
+    transaction.add(water.mutate(-0.25_mol));
+    transaction.add(ethanol.mutate(-0.5_mol));
+
+    if (not reactor.isSame(expected)) {
+        Log(this).error("Reactor was changed before the transaction was committed.");
+        return false;
+    }
+
+    const auto pendingAmount = transaction.getAmountOf(water);
+    if (not pendingAmount.equals(reactor.getAmountOf(water) + 0.75_mol)) {
+        Log(this).error("Invalid pending amount: {}.", pendingAmount.toString());
+        return false;
+    }
+
+    transaction.commit();
+    static_cast<Mixture&>(expected).add(water.mutate(0.75_mol));
+    if (not reactor.isSame(expected)) {
+        Log(this).error("Committed transaction does not match the equivalent direct changes.");
+        return false;
+    }
+
+    return transaction.isEmpty();
+}
+
+bool SnapshotUnitTest::run()
+{
+    const auto initial   = reactor.makeSnapshot();
+    const auto reference = initial->makeCopy();
+    for (size_t i = 0; i < ticks; ++i)
+        reactor.tick(tickTimespan);
+
+    if (reactor.isSame(*initial, threshold)) {
+        Log(this).error("Reactor is already in a stable state, test is inconclusive.");
+        return false;
+    }
+
+    reactor.restore(initial);
+    if (not reactor.isSame(*initial)) {
+        Log(this).error("Restored reactor does not match the snapshot.");
+        return false;
+    }
+    if (not reactor.getContent().isShared()) {
+        Log(this).error("Restored reactor copied the content of the snapshot.");
+        return false;
+    }
+
+    // Ticks which leave the reactor unchanged keep sharing the content. Any change of the layers copies it, even
+    // one which only adds energy, since the shared reactants read the temperatures of the snapshot.
+    const auto tickMode = reactor.getTickMode();
+    reactor.setTickMode(TickMode::DISABLE_ALL);
+    reactor.tick(tickTimespan);
+    if (not reactor.getContent().isShared()) {
+        Log(this).error("Reactor copied the content of the snapshot without changing.");
+        return false;
+    }
+
+    reactor.setTickMode(tickMode);
+    reactor.addEnergy(1.0_J);
+    if (reactor.getContent().isShared()) {
+        Log(this).error("Reactor kept sharing the content of the snapshot after its layers changed.");
+        return false;
+    }
+    reactor.restore(initial);
+
+    // Branches restored from the same snapshot must evolve identically.
+    auto branch = initial->makeCopy();
+    for (size_t i = 0; i < ticks; ++i) {
+        reactor.tick(tickTimespan);
+        branch.tick(tickTimespan);
+    }
+
+    if (not reactor.isSame(branch, threshold)) {
+        Log(this).error("Branches restored from the same snapshot diverged.");
+        return false;
+    }
+
+    // Shared content is copied on change, leaving the snapshot untouched.
+    if (reactor.getContent().isShared() || not initial->isSame(reference)) {
+        Log(this).error("Snapshot was changed by a restored reactor.");
+        return false;
+    }
+
+    return true;
+}
+
+bool CheckpointUnitTest::run()
+{
+    // Reactions are found during the first ticks, so the checkpoint also holds cached reactions.
+    for (size_t i = 0; i < ticks; ++i)
+        reactor.tick(tickTimespan);
+
+    std::stringstream stream;
+    {
+        CheckpointWriter writer(stream, Accessor<>::getDataStore());
+        reactor.toCheckpoint(writer);
+    }
+    const auto checkpoint = stream.str();
+
+    const auto load = [&](Reactor& target) {
+        std::istringstream is(checkpoint);
+        CheckpointReader   reader(is, Accessor<>::getDataStore());
+        return reader.isValid() && target.loadFromCheckpoint(reader);
+    };
+
+    Reactor branch1(*atmosphere, reactor.getMaxVolume(), dump);
+    Reactor branch2(*atmosphere, reactor.getMaxVolume(), dump);
+    if (not load(branch1) || not load(branch2)) {
+        Log(this).error("Failed to load reactor from checkpoint.");
+        return false;
+    }
+
+    if (not branch1.isSame(reactor)) {
+        Log(this).error("Loaded reactor does not match the checkpointed reactor.");
+        return false;
+    }
+
+    // Reactors loaded from the same checkpoint must evolve identically.
+    for (size_t i = 0; i < ticks; ++i) {
+        branch1.tick(tickTimespan);
+        branch2.tick(tickTimespan);
+    }
+
+    if (branch1.isSame(reactor, threshold)) {
+        Log(this).error("Reactor is already in a stable state, test is inconclusive.");
+        return false;
+    }
+
+    if (not branch1.isSame(branch2, threshold)) {
+        Log(this).error("Reactors loaded from the same checkpoint diverged.");
+        return false;
+    }
+
+    // Corrupt string sizes must fail cleanly, without allocating the announced size.
+    for (const auto size : {std::numeric_limits<uint32_t>::max(), CheckpointReader::MaxStringSize}) {
+        std::stringstream corrupt;
+        {
+            CheckpointWriter writer(corrupt, Accessor<>::getDataStore());
+            writer.write(size);
+            writer.write(std::string("CCO"));
+        }
+
+        CheckpointReader reader(corrupt, Accessor<>::getDataStore());
+        LogBase::hide(LogType::FATAL);
+        const auto str = reader.readString();
+        LogBase::unhide();
+        if (str) {
+            Log(this).error("Read a string of size: {} from a corrupt checkpoint.", str->size());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ReplayUnitTest::run()
+{
+    const auto getReactor = [](Lab& lab, const size_t systemIdx) -> const Reactor& {
+        return static_cast<const Reactor&>(lab.getSystem(systemIdx).getComponent(0).cast<Flask>()->getContent());
+    };
+
+    Lab lab;
+    lab.add<Flask>(201);
+    lab.add<Flask>(201);
+
+    std::stringstream stream;
+    {
+        LabRecorder recorder(lab, stream);
+        recorder.add(0, 0, Molecule("CCO"), 2.0_mol);
+        recorder.add(0, 0, Molecule("CC(=O)O"), 2.0_mol);
+        recorder.add(1, 0, Molecule("O"), 2.0_mol);
+        for (size_t i = 0; i < ticks; ++i) {
+            if (i == ticks / 2)
+                recorder.setTimeMultiplier(4.0f);
+            if (i % 8 == 0)
+                recorder.addEnergy(1, 0, 1000.0_J);
+
+            recorder.tick(tickTimespan);
+        }
+
+        if (not recorder.isValid()) {
+            Log(this).error("Failed to record inputs.");
+            return false;
+        }
+    }
+    const auto recording = stream.str();
+
+    const auto replay = [&](Lab& target) {
+        std::istringstream is(recording);
+        LabReplayer        replayer(is, target);
+        return replayer.replay() && replayer.getTickCount() == ticks;
+    };
+
+    Lab replay1, replay2;
+    if (not replay(replay1) || not replay(replay2)) {
+        Log(this).error("Failed to replay recording.");
+        return false;
+    }
+
+    for (size_t i = 0; i < lab.getSystemCount(); ++i) {
+        // Replays start from the recorded checkpoint, so they must be identical to each other.
+        if (not getReactor(replay1, i).isSame(getReactor(replay2, i))) {
+            Log(this).error("Replays of the same recording diverged in system: {}.", i);
+            return false;
+        }
+
+        if (not getReactor(replay1, i).isSame(getReactor(lab, i), threshold)) {
+            Log(this).error("Replay diverged from the recorded session in system: {}.", i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool BatchUnitTest::run()
+{
+    ReactorBatch         batch(reactor, replicaCount);
+    std::vector<Reactor> references;
+    references.reserve(replicaCount);
+
+    // Replicas differ in their state, but not in the species they contain.
+    for (size_t i = 0; i < replicaCount; ++i) {
+        auto& replica = batch.getReplica(i);
+        references.emplace_back(reactor.makeCopy());
+        replica.add(Molecule("CCO"), 0.25_mol * static_cast<float_s>(i));
+        references[i].add(Molecule("CCO"), 0.25_mol * static_cast<float_s>(i));
+        replica.addEnergy(500.0_J * static_cast<float_s>(i));
+        references[i].addEnergy(500.0_J * static_cast<float_s>(i));
+    }
+
+    for (size_t i = 0; i < ticks; ++i) {
+        batch.tick(tickTimespan);
+        for (auto& r : references)
+            r.tick(tickTimespan);
+    }
+
+    if (batch.getReplica(0).isSame(reactor, threshold)) {
+        Log(this).error("Reactor is already in a stable state, test is inconclusive.");
+        return false;
+    }
+
+    for (size_t i = 0; i < replicaCount; ++i) {
+        if (not batch.getReplica(i).isSame(references[i], threshold)) {
+            Log(this).error("Replica: {} diverged from the reactor ticked on its own.", i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
 IncompatibleForwardingUnitTest::IncompatibleForwardingUnitTest(std::string&& name) noexcept :
     ReactorUnitTest(
         std::move(name),
@@ -435,6 +969,95 @@ MixtureUnitTests::MixtureUnitTests(
     }),
         FlagField(TickMode::ENABLE_ALL) - TickMode::ENABLE_CONDUCTION);
 
+    registerTest<TemporaryStateUnitTest>(
+        "temporary_state_0",
+        1.0_L,
+        ContentInitializer({
+            { Molecule("O"), 5.0_mol},
+            {Molecule("CO"), 0.5_mol}
+    }),
+        Molecule("CO"));
+
+    registerTest<RejectedReactantUnitTest>(
+        "rejected_reactant_0",
+        1.0_L,
+        ContentInitializer({
+            {Molecule("O"), 5.0_mol}
+    }),
+        Molecule("CO"));
+
+    registerTest<ImplicitKineticsUnitTest>(
+        "implicit_kinetics_0",
+        1.0_L,
+        ContentInitializer({
+            {Molecule("CC(=O)O"), 2.0_mol},
+            {    Molecule("OCC"), 3.0_mol}
+    }),
+        TickMode::ENABLE_REACTIONS);
+
+    registerTest<EquilibriumUnitTest>("equilibrium_0");
+
+    registerTest<SteadyStateUnitTest>(
+        "steady_state_0",
+        1.0_L,
+        ContentInitializer({
+            {Molecule("O"), 5.0_mol}
+    }));
+
+    registerTest<SleepUnitTest>(
+        "sleep_0",
+        1.0_L,
+        ContentInitializer({
+            {Molecule("CCO"), 2.0_mol},
+            {  Molecule("O"), 3.0_mol}
+    }));
+
+    registerTest<TickModeUnitTest>(
+        "tick_mode_0",
+        1.0_L,
+        ContentInitializer({
+            {Molecule("CC(=O)O"), 2.0_mol},
+            {    Molecule("OCC"), 3.0_mol}
+    }),
+        TickMode::ENABLE_REACTIONS);
+
+    registerTest<TransactionUnitTest>(
+        "transaction_0",
+        1.0_L,
+        ContentInitializer({
+            {  Molecule("O"), 2.0_mol},
+            {Molecule("CCO"), 1.0_mol}
+    }));
+
+    registerTest<SnapshotUnitTest>(
+        "snapshot_0",
+        1.0_L,
+        ContentInitializer({
+            {    Molecule("CCO"), 2.0_mol},
+            {Molecule("CC(=O)O"), 2.0_mol},
+            {      Molecule("O"), 1.0_mol}
+    }));
+
+    registerTest<CheckpointUnitTest>(
+        "checkpoint_0",
+        1.0_L,
+        ContentInitializer({
+            {    Molecule("CCO"), 2.0_mol},
+            {Molecule("CC(=O)O"), 2.0_mol},
+            {      Molecule("O"), 1.0_mol}
+    }));
+
+    registerTest<ReplayUnitTest>("replay_0");
+
+    registerTest<BatchUnitTest>(
+        "batch_0",
+        1.0_L,
+        ContentInitializer({
+            {    Molecule("CCO"), 2.0_mol},
+            {Molecule("CC(=O)O"), 2.0_mol},
+            {      Molecule("O"), 1.0_mol}
+    }));
+
     registerTest<IncompatibleForwardingUnitTest>("forward_incompatible");
     registerTest<ImplicitForwardingUnitTest>("forward_implicit");
 
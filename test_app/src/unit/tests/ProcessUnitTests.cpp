@@ -5,6 +5,8 @@
 #include "utils/Casts.hpp"
 #include "utils/Process.hpp"
 
+#include <vector>
+
 namespace
 {
 
@@ -116,6 +118,43 @@ bool ProcessorAffinityUnitTest::run()
     return true;
 }
 
+//
+// MemoryUsageUnitTest
+//
+
+class MemoryUsageUnitTest : public UnitTest
+{
+public:
+    using UnitTest::UnitTest;
+
+    bool run() override final;
+};
+
+bool MemoryUsageUnitTest::run()
+{
+    const auto before = OS::getCurrentProcessMemoryUsage();
+    if (before == 0) {
+        Log(this).error("Process memory usage is zero.");
+        return false;
+    }
+
+    // Touch every page so that the allocation becomes resident.
+    constexpr size_t     allocationSize = 64 * 1024 * 1024;
+    std::vector<uint8_t> allocation(allocationSize, 1);
+
+    const auto after = OS::getCurrentProcessMemoryUsage();
+    if (after < before + allocationSize / 2) {
+        Log(this).error(
+            "Process memory usage did not grow after allocating {} bytes (before: {}, after: {}).",
+            allocationSize,
+            before,
+            after);
+        return false;
+    }
+
+    return allocation.back() == 1;
+}
+
 }  // namespace
 
 //
@@ -132,4 +171,5 @@ ProcessUnitTests::ProcessUnitTests(std::string&& name, const std::regex& filter)
     CHG_LINUX_ONLY(registerTest<PriorityUnitTest>("highest_priority", OS::ProcessPriority::REALTIME_PRIORITY_CLASS));
 
     registerTest<ProcessorAffinityUnitTest>("processor_affinity_mask");
+    registerTest<MemoryUsageUnitTest>("memory_usage");
 }
@@ -2,11 +2,18 @@
 
 #include "global/Charset.hpp"
 #include "io/StringTable.hpp"
+#include "molecules/ASCIICache.hpp"
+#include "molecules/MolBinBatch.hpp"
 #include "molecules/MolecularStructure.hpp"
 #include "utils/Bin.hpp"
 #include "utils/Build.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
 #include <numeric>
+#include <sstream>
 
 namespace
 {
@@ -40,6 +47,26 @@ bool fuzzLoop(const TupleT& inputs, CallableT&& test, std::tuple<Idxs...> indice
 
 }  // namespace details
 
+std::string cyclesToString(const std::vector<std::vector<c_size>>& cycles)
+{
+    std::string result;
+    for (const auto& cycle : cycles) {
+        result += '(';
+        for (size_t i = 0; i < cycle.size(); ++i)
+            result += (i ? "," : "") + std::to_string(cycle[i]);
+        result += ')';
+    }
+    return result;
+}
+
+// Sorts the atoms of each cycle and then the cycles, so that bases can be compared.
+void normalizeCycles(std::vector<std::vector<c_size>>& cycles)
+{
+    for (auto& cycle : cycles)
+        std::sort(cycle.begin(), cycle.end());
+    std::sort(cycles.begin(), cycles.end());
+}
+
 // Runs the given test over multiple generated inputs obtained by fuzzing the original inputs.
 // Fuzzing works by generating distinct SMILES notations for each input and parsing them back into
 // molecules. The order of the original inputs is preserved for the fuzzed inputs. The test is also
@@ -169,23 +196,33 @@ bool StructureAtomMapUnitTest::run()
 //
 
 StructureMaximalAtomMapUnitTest::StructureMaximalAtomMapUnitTest(
-    const std::string& name,
-    const std::string& targetSmiles,
-    const std::string& patternSmiles,
-    const size_t       expectedSize) noexcept :
+    const std::string&            name,
+    const std::string&            targetSmiles,
+    const std::string&            patternSmiles,
+    const size_t                  expectedSize,
+    const std::optional<AtomMap>& expectedMap) noexcept :
     UnitTest(name + '_' + targetSmiles + '_' + patternSmiles),
     expectedSize(expectedSize),
+    expectedMap(expectedMap),
     target(targetSmiles),
     pattern(patternSmiles)
 {}
 
 bool StructureMaximalAtomMapUnitTest::run()
 {
-    const auto size = target.maximalMapTo(pattern).first.size();
-    if (size != expectedSize) {
-        Log(this).error("Actual map size: {} is different from the expected size: {}.", size, expectedSize);
+    const auto map = target.maximalMapTo(pattern).first;
+    if (map.size() != expectedSize) {
+        Log(this).error("Actual map size: {} is different from the expected size: {}.", map.size(), expectedSize);
+        return false;
+    }
+
+    if (expectedMap && map != *expectedMap) {
+        for (const auto& [targetIdx, patternIdx] : map)
+            Log(this).error("Mapped target atom: {} to pattern atom: {}.", targetIdx, patternIdx);
+        Log(this).error("Mapping of equal size was chosen instead of the expected one.");
         return false;
     }
+
     return true;
 }
 
@@ -334,20 +371,60 @@ bool MinimalCycleUnitTest::run()
     return true;
 }
 
+//
+// MinimalCycleBasisUnitTest
+//
+
+MinimalCycleBasisUnitTest::MinimalCycleBasisUnitTest(
+    const std::string&                 name,
+    const std::string&                 moleculeSmiles,
+    std::vector<std::vector<c_size>>&& expectedCycles) noexcept :
+    UnitTest(name + '_' + moleculeSmiles),
+    expectedCycles(std::move(expectedCycles)),
+    molecule(moleculeSmiles)
+{
+    normalizeCycles(this->expectedCycles);
+}
+
+bool MinimalCycleBasisUnitTest::run()
+{
+    std::vector<std::vector<c_size>> actualCycles;
+    for (const auto& cycle : molecule.getMinimalCycleBasis()) {
+        auto& indices = actualCycles.emplace_back();
+        for (const auto atom : cycle)
+            indices.emplace_back(atom->index);
+    }
+    normalizeCycles(actualCycles);
+
+    if (actualCycles != expectedCycles) {
+        Log(this).error(
+            "Actual cycles: {} differ from the expected cycles: {}.",
+            cyclesToString(actualCycles),
+            cyclesToString(expectedCycles));
+        return false;
+    }
+
+    return true;
+}
+
 //
 // ASCIIPrintUnitTest
 //
 
 ASCIIPrintUnitTest::ASCIIPrintUnitTest(
-    const std::string& name, const std::string& moleculeSmiles, const bool allowLinearCycleExpansion) noexcept :
+    const std::string&         name,
+    const std::string&         moleculeSmiles,
+    const bool                 allowLinearCycleExpansion,
+    const ASCII::LayoutBudget& budget) noexcept :
     UnitTest(name + '_' + moleculeSmiles),
     allowLinearCycleExpansion(allowLinearCycleExpansion),
+    budget(budget),
     molecule(moleculeSmiles)
 {}
 
 bool ASCIIPrintUnitTest::run()
 {
-    const auto ascii          = molecule.toASCII().toString().toString();
+    const auto ascii          = molecule.toASCII(ASCII::PrintOptions::Default, budget).toString().toString();
     const auto parsedMolecule = MolecularStructure::fromASCII(ascii);
     if (not parsedMolecule) {
         Log(this).error("Failed to parse input ASCII:\n{}", ascii);
@@ -403,6 +480,176 @@ bool MolBinUnitTest::run()
     return true;
 }
 
+//
+// UntrustedSymbolUnitTest
+//
+
+UntrustedSymbolUnitTest::UntrustedSymbolUnitTest(
+    const std::string& name, const std::string& ascii, const std::string& molBin) noexcept :
+    UnitTest(std::string(name)),
+    ascii(ascii),
+    molBin(molBin)
+{}
+
+bool UntrustedSymbolUnitTest::run()
+{
+    const auto internedCount = Symbol::getInternedCount();
+
+    LogBase::hide(LogType::FATAL);
+    const auto fromASCII = MolecularStructure::fromASCII(ascii);
+    std::istringstream molBinStream(molBin, std::ios::in | std::ios::binary);
+    const auto fromMolBin = MolecularStructure::fromMolBin(molBinStream);
+    LogBase::unhide();
+
+    if (fromASCII || fromMolBin) {
+        Log(this).error("Parsed a structure made of undefined symbols.");
+        return false;
+    }
+
+    if (Symbol::getInternedCount() != internedCount) {
+        Log(this).error(
+            "Parsing undefined symbols interned: {} new symbols.", Symbol::getInternedCount() - internedCount);
+        return false;
+    }
+
+    return true;
+}
+
+//
+// MolBinBatchUnitTest
+//
+
+MolBinBatchUnitTest::MolBinBatchUnitTest(
+    const std::string& name, const std::vector<std::string>& moleculesSmiles) noexcept :
+    UnitTest(name + '_' + std::to_string(moleculesSmiles.size()))
+{
+    molecules.reserve(moleculesSmiles.size());
+    for (const auto& smiles : moleculesSmiles)
+        molecules.emplace_back(smiles);
+}
+
+bool MolBinBatchUnitTest::run()
+{
+    std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+    MolBinBatchWriter writer(stream);
+    for (const auto& molecule : molecules)
+        if (not writer.add(molecule))
+            return false;
+    if (not writer.finish())
+        return false;
+
+    // Batches are used in place, so the buffer must be aligned like a mapped file.
+    const auto            bytes = stream.str();
+    std::vector<uint64_t> buffer((bytes.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    std::memcpy(buffer.data(), bytes.data(), bytes.size());
+
+    const auto batch = MolBinBatch::fromBytes(std::span(reinterpret_cast<const char*>(buffer.data()), bytes.size()));
+    if (not batch || batch->size() != molecules.size()) {
+        Log(this).error("Failed to load written MolBin batch:\n{}", utils::toHex(bytes, '-', '\n'));
+        return false;
+    }
+
+    for (size_t i = 0; i < molecules.size(); ++i) {
+        const auto parsedMolecule = batch->getStructure(i);
+        if (not parsedMolecule) {
+            Log(this).error("Failed to build MolBin batch structure: {}.", i);
+            return false;
+        }
+
+        if (*parsedMolecule != molecules[i]) {
+            Log(this).error(
+                "Equality check between batch molecule: '{}' and input: '{}' failed.",
+                parsedMolecule->toSMILES(),
+                molecules[i].toSMILES());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// ASCIILayoutStoreUnitTest
+//
+
+ASCIILayoutStoreUnitTest::ASCIILayoutStoreUnitTest(
+    const std::string& name, const std::string& moleculeSmiles) noexcept :
+    UnitTest(name + '_' + moleculeSmiles),
+    molecule(moleculeSmiles)
+{}
+
+bool ASCIILayoutStoreUnitTest::run()
+{
+    const auto options  = ASCII::PrintOptions::Default | ASCII::PrintFlags::HIGHLIGHT_ATOM_ORIGIN;
+    const auto expected = molecule.toASCII(options).toString();
+
+    ASCIILayoutStore unopened;
+    unopened.render(molecule, options);
+    if (unopened.size() != 0) {
+        Log(this).error("Expected no stored rendering without a backing file, got: {}.", unopened.size());
+        return false;
+    }
+
+    const auto path = (std::filesystem::temp_directory_path() / "chemgine_layouts_unit_test.bin").string();
+    std::filesystem::remove(path);
+
+    ASCIILayoutStore store;
+    store.open(path);
+    store.render(molecule, options);
+    store.render(molecule, options | ASCII::PrintFlags::PRINT_ATOM_INDICES);
+    if (store.size() != 1) {
+        Log(this).error("Expected a single stored rendering, got: {}.", store.size());
+        return false;
+    }
+
+    if (not store.flush())
+        return false;
+
+    ASCIILayoutStore loaded;
+    const auto       success = loaded.open(path) && loaded.size() == 1;
+    std::filesystem::remove(path);
+    if (not success) {
+        Log(this).error("Failed to load saved store: '{}'.", path);
+        return false;
+    }
+
+    const auto actual = loaded.render(molecule, options).toString();
+    if (loaded.isModified() || not std::ranges::equal(actual, expected)) {
+        Log(this).error(
+            "Loaded rendering:\n{}\ndiffers from the original rendering:\n{}",
+            actual.toString(),
+            expected.toString());
+        return false;
+    }
+
+    ASCIILayoutStore bounded(0);
+    bounded.open(path);
+    bounded.render(molecule, options);
+    if (bounded.size() != 0 || bounded.isModified()) {
+        Log(this).error("Full store kept a rendering.");
+        return false;
+    }
+
+    // Corrupt sizes must be rejected without allocating the announced size.
+    std::stringstream corrupt(std::ios::in | std::ios::out | std::ios::binary);
+    corrupt << "CHGASCII";
+    bin::print(corrupt, ASCIILayoutStore::Version);
+    bin::print(corrupt, uint32_t(1));
+    bin::print(corrupt, uint8_t(0));
+    bin::print(corrupt, std::numeric_limits<uint32_t>::max());
+
+    ASCIILayoutStore corrupted;
+    LogBase::hide(LogType::FATAL);
+    const auto corruptLoaded = corrupted.load(corrupt);
+    LogBase::unhide();
+    if (corruptLoaded) {
+        Log(this).error("Loaded a layout store with a corrupt string size.");
+        return false;
+    }
+
+    return true;
+}
+
 //
 // StructureUnitTests
 //
@@ -489,6 +736,7 @@ StructureUnitTests::StructureUnitTests(
     registerTest<StructureAtomMapUnitTest>("map", "C1CC2=C1C=C2", "RC1=C(R)CC1", true);
     registerTest<StructureAtomMapUnitTest>("map", "C(C)(C)OC", "O(R)R", true);
     registerTest<StructureAtomMapUnitTest>("map", "O(CCC)CC", "O(CC)(CCC)", true);
+    registerTest<StructureAtomMapUnitTest>("map", "CC(C)CCO", "R1CCC1", false);
     registerTest<StructureAtomMapUnitTest>(
         "map",
         "CCNC14CC(CC=C1C2=C(OC)C=CC3=C2C(=C[N]3)C4)C(=O)N(C)C",
@@ -512,6 +760,18 @@ StructureUnitTests::StructureUnitTests(
     registerTest<StructureMaximalAtomMapUnitTest>("maximal_map", "C(=O)N(C)C", "C1CCC1", 1);
     registerTest<StructureMaximalAtomMapUnitTest>("maximal_map", "O(C)CC", "O(CC)C", 4);
     registerTest<StructureMaximalAtomMapUnitTest>("maximal_map", "CC2CCCC(C1CCCCC1)C2", "CC1CCCCC1", 7);
+    registerTest<StructureMaximalAtomMapUnitTest>("maximal_map", "C(C)C(CN(CC(C)C)C(O)C)CC", "C(C)(CCC)(CC)C", 6);
+    // Among mappings of equal size, the one with the smallest bond difference is chosen: the methyl rather than the
+    // isopropyl carbon, although the latter is found first.
+    registerTest<StructureMaximalAtomMapUnitTest>(
+        "maximal_map",
+        "CC(C)OC",
+        "OC",
+        2,
+        AtomMap({
+            {0, 0},
+            {4, 1}
+    }));
 
     registerTest<StructureSubstitutionUnitTest>("substitute", "CC(=O)OC", "OCCC", "O=C(OC)CC");
     registerTest<StructureSubstitutionUnitTest>("substitute", "CC(=O)OR", "OCCC", "O=C(OR)CC");
@@ -607,6 +867,56 @@ StructureUnitTests::StructureUnitTests(
             {4, 5}
     }));
 
+    // Minimum bases aren't unique, these pin the cycles returned for fused and cage structures. Among cycles of the
+    // same length, the earliest Horton candidates are kept.
+    registerTest<MinimalCycleBasisUnitTest>(
+        "minimal_cycle_basis",
+        "C2CC1CC3C1C7C2CCC6CC4CC5CC3C45C67",
+        std::vector<std::vector<c_size>>({
+            {0, 1, 9, 11, 12, 13},
+            {1, 2, 3, 13, 14, 15},
+            {1, 2, 7, 8, 9},
+            {2, 3, 4, 5},
+            {2, 5, 6, 7},
+            {10, 12, 13, 14, 17, 18},
+            {14, 15, 16, 17}
+    }));
+    registerTest<MinimalCycleBasisUnitTest>(
+        "minimal_cycle_basis",
+        "C3=CC27CC18C=CC16C=C%10CCC%12C%11C=C5C=C4C(C=C2C3)C49C5=C(C6C789)C%10%11%12",
+        std::vector<std::vector<c_size>>({
+            {0, 1, 4, 5, 13, 15},
+            {1, 3, 4, 19, 20, 21},
+            {1, 15, 16},
+            {1, 16, 17, 18, 19},
+            {2, 3, 4, 5, 6},
+            {2, 3, 21, 24},
+            {2, 6, 8, 9, 10, 26},
+            {2, 24, 25, 26},
+            {5, 6, 11, 12, 13},
+            {6, 10, 11},
+            {7, 8, 14, 26, 27},
+            {21, 22, 23, 24}
+    }));
+    registerTest<MinimalCycleBasisUnitTest>(
+        "minimal_cycle_basis",
+        "C12C3C1C23",
+        std::vector<std::vector<c_size>>({
+            {0, 1, 2},
+            {0, 2, 3},
+            {1, 2, 3}
+    }));
+    registerTest<MinimalCycleBasisUnitTest>(
+        "minimal_cycle_basis",
+        "C12C3C4C1C5C2C3C45",
+        std::vector<std::vector<c_size>>({
+            {0, 1, 2, 3},
+            {0, 1, 5, 6},
+            {0, 3, 4, 5},
+            {1, 2, 6, 7},
+            {2, 3, 4, 7}
+    }));
+
     registerTest<ASCIIPrintUnitTest>("ASCII", "HH", false);
     registerTest<ASCIIPrintUnitTest>("ASCII", "O", false);
     registerTest<ASCIIPrintUnitTest>("ASCII", "C=CCR", false);
@@ -662,6 +972,12 @@ StructureUnitTests::StructureUnitTests(
         false);
     registerTest<ASCIIPrintUnitTest>("ASCII", "CC(=O)OC1=C2OC4C(O)C=CC3C5CC(C=C1)=C2C34CCN5C", true);
 
+    // Exhausted layout budgets fall back to one-shot and linear layouts.
+    registerTest<ASCIIPrintUnitTest>("ASCII_budget", "C1CCCCCCCC1", false, ASCII::LayoutBudget{.nodeCount = 0});
+    registerTest<ASCIIPrintUnitTest>("ASCII_budget", "C1=CC=CC=C1", true, ASCII::LayoutBudget{.nodeCount = 0});
+    registerTest<ASCIIPrintUnitTest>(
+        "ASCII_budget", "C2CC1CC3C1C7C2CCC6CC4CC5CC3C45C67", true, ASCII::LayoutBudget{.nodeCount = 64});
+
     registerTest<MolBinUnitTest>("MolBin", "HH");
     registerTest<MolBinUnitTest>("MolBin", "O");
     registerTest<MolBinUnitTest>("MolBin", "SNC");
@@ -669,5 +985,23 @@ StructureUnitTests::StructureUnitTests(
     registerTest<MolBinUnitTest>("MolBin", "[Si]1=[Si][Si]=C[Si]=C1");
     registerTest<MolBinUnitTest>("MolBin", "CCN(CC)C(=O)C1CN(C2CC3=CNC4=CC=CC(=C34)C2=C1)C");
 
+    registerTest<UntrustedSymbolUnitTest>("untrusted_symbols", "Qjq - Jqj\n|\nQqq", "Qqjj;");
+
+    registerTest<MolBinBatchUnitTest>(
+        "MolBin_batch",
+        std::vector<std::string>{
+            "HH",
+            "O",
+            "SNC",
+            "P1$S=NOC#C1",
+            "[Si]1=[Si][Si]=C[Si]=C1",
+            "CCN(CC)C(=O)C1CN(C2CC3=CNC4=CC=CC(=C34)C2=C1)C",
+            "[Na]OC(C#N)([Br])S=O",
+            "C1=CC=CC=C1R"});
+
+    registerTest<ASCIILayoutStoreUnitTest>("layouts", "C1=CC=CC=C1");
+    registerTest<ASCIILayoutStoreUnitTest>("layouts", "[Na]OC(C#N)([Br])S=O");
+    registerTest<ASCIILayoutStoreUnitTest>("layouts", "CC(=O)OC1=C2OC4C(O)C=CC3C5CC(C=C1)=C2C34CCN5C");
+
     registerTest<UnitTestSetup<AccessorTestCleanup>>("cleanup");
 }
@@ -2,6 +2,7 @@
 
 #include "io/Log.hpp"
 #include "utils/STL.hpp"
+#include "utils/ThreadPool.hpp"
 
 namespace
 {
@@ -59,6 +60,46 @@ bool CompareInclusionUnitTest::run()
     return true;
 }
 
+//
+// ThreadPoolUnitTest
+//
+
+class ThreadPoolUnitTest : public UnitTest
+{
+private:
+    const size_t threadCount;
+    const size_t taskCount;
+
+public:
+    ThreadPoolUnitTest(std::string&& name, const size_t threadCount, const size_t taskCount) noexcept;
+
+    bool run() override final;
+};
+
+ThreadPoolUnitTest::ThreadPoolUnitTest(std::string&& name, const size_t threadCount, const size_t taskCount) noexcept :
+    UnitTest(std::move(name)),
+    threadCount(threadCount),
+    taskCount(taskCount)
+{}
+
+bool ThreadPoolUnitTest::run()
+{
+    std::atomic<size_t> sum = 0;
+
+    ThreadPool pool(threadCount);
+    for (size_t i = 0; i < taskCount; ++i)
+        pool.submit([i, &sum]() { sum += i; });
+    pool.wait();
+
+    const auto expected = taskCount * (taskCount - 1) / 2;
+    if (sum != expected) {
+        Log(this).error("Actual sum: {} differs from the expected sum: {}.", sum.load(), expected);
+        return false;
+    }
+
+    return true;
+}
+
 }  // namespace
 
 //
@@ -90,4 +131,6 @@ UtilsUnitTests::UtilsUnitTests(std::string&& name, const std::regex& filter) noe
         std::unordered_set<uint8_t>{1, 2},
         [](const auto x) { return x != 3; },
         0);
+    registerTest<ThreadPoolUnitTest>("thread_pool_single", 1, 1000);
+    registerTest<ThreadPoolUnitTest>("thread_pool", 4, 10000);
 }